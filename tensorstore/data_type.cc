@@ -35,6 +35,7 @@
 #include <nlohmann/json.hpp>
 #include "tensorstore/data_type_conversion.h"
 #include "tensorstore/index.h"
+#include "tensorstore/internal/data_type_conversion_kernels.h"
 #include "tensorstore/internal/integer_overflow.h"
 #include "tensorstore/internal/json/same.h"
 #include "tensorstore/internal/json/value_as.h"
@@ -585,6 +586,34 @@ struct ConvertDataType<::tensorstore::dtypes::string_t,
   }
 };
 
+namespace internal_data_type {
+
+// Conversion with a vectorized kernel for contiguous buffers.
+template <typename From, typename To>
+struct VectorizedConvertDataType {
+  void operator()(const From* from, To* to, void*) const {
+    *to = static_cast<To>(*from);
+  }
+
+  static bool ApplyContiguous(Index count, const From* from, To* to, void*) {
+    ConvertContiguous(from, to, count);
+    return true;
+  }
+};
+
+}  // namespace internal_data_type
+
+#define TENSORSTORE_INTERNAL_VECTORIZED_CONVERT(FROM, TO)                   \
+  template <>                                                               \
+  struct ConvertDataType<FROM, TO>                                          \
+      : public internal_data_type::VectorizedConvertDataType<FROM, TO> {}; \
+  /**/
+
+TENSORSTORE_INTERNAL_FOR_EACH_VECTORIZED_CONVERSION(
+    TENSORSTORE_INTERNAL_VECTORIZED_CONVERT)
+
+#undef TENSORSTORE_INTERNAL_VECTORIZED_CONVERT
+
 namespace internal {
 const std::array<DataTypeOperations::CanonicalConversionOperations,
                  kNumDataTypeIds>
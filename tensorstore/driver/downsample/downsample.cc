@@ -98,6 +98,10 @@ using ::tensorstore::internal::TransformedDriverSpec;
 
 namespace jb = tensorstore::internal_json_binding;
 
+/// Target number of base elements in each `ReadChunk` emitted by
+/// `DownsampleDriver::Read`.
+constexpr Index kTargetDownsampleChunkElements = 1 << 20;
+
 /// Obtains constraints on the base domain from constraints on the downsampled
 /// domain.
 ///
@@ -540,6 +544,13 @@ Future<IndexTransform<>> DownsampleDriver::ResolveBounds(
 ///        independently-emitted chunks.  Then for each non-covered grid cell,
 ///        we emit a separate chunk that provides a downsampled view of that
 ///        cell of `data_buffer_`.
+///
+/// The downsampling computation is performed lazily when the emitted chunks
+/// are copied by the receiver, which normally happens on the
+/// `data_copy_executor`.  To allow large regions to be downsampled in
+/// parallel, each region in 4a and 5 that contains more than
+/// `kTargetDownsampleChunkElements` elements is emitted as multiple chunks, as
+/// determined by `PartitionDownsampleDomain`.
 struct ReadState : public internal::AtomicReferenceCount<ReadState> {
   IntrusivePtr<DownsampleDriver> self_;
 
@@ -724,15 +735,20 @@ IndexTransform<> GetDownsampledRequestIdentityTransform(
 }
 
 void ReadState::EmitBufferedChunkForBox(BoxView<> base_domain) {
-  auto request_transform = GetDownsampledRequestIdentityTransform(
-      base_domain, downsample_factors_, self_->downsample_method_,
-      original_input_rank_);
-  ReadChunk downsampled_chunk;
-  downsampled_chunk.transform =
-      IdentityTransform(request_transform.domain().box());
-  downsampled_chunk.impl = BufferedReadChunkImpl{IntrusivePtr<ReadState>(this)};
-  execution::set_value(receiver_, std::move(downsampled_chunk),
-                       std::move(request_transform));
+  internal_downsample::PartitionDownsampleDomain(
+      base_domain, downsample_factors_, kTargetDownsampleChunkElements,
+      [&](BoxView<> sub_domain) {
+        auto request_transform = GetDownsampledRequestIdentityTransform(
+            sub_domain, downsample_factors_, self_->downsample_method_,
+            original_input_rank_);
+        ReadChunk downsampled_chunk;
+        downsampled_chunk.transform =
+            IdentityTransform(request_transform.domain().box());
+        downsampled_chunk.impl =
+            BufferedReadChunkImpl{IntrusivePtr<ReadState>(this)};
+        execution::set_value(receiver_, std::move(downsampled_chunk),
+                             std::move(request_transform));
+      });
 }
 
 void ReadState::EmitBufferedChunks() {
@@ -859,16 +875,22 @@ bool MaybeEmitIndependentReadChunk(
     }
   }
 
-  internal::ReadChunk downsampled_chunk;
-  auto request_transform = GetDownsampledRequestIdentityTransform(
+  // Each sub-region references the entire `base_chunk`, but only reads the
+  // portion corresponding to its own domain.
+  internal_downsample::PartitionDownsampleDomain(
       base_chunk.transform.domain().box(), state.downsample_factors_,
-      state.self_->downsample_method_, state.original_input_rank_);
-  downsampled_chunk.impl = IndependentReadChunkImpl{
-      internal::IntrusivePtr<ReadState>(&state), std::move(base_chunk)};
-  downsampled_chunk.transform =
-      IdentityTransform(request_transform.domain().box());
-  execution::set_value(state.receiver_, std::move(downsampled_chunk),
-                       request_transform);
+      kTargetDownsampleChunkElements, [&](BoxView<> sub_domain) {
+        internal::ReadChunk downsampled_chunk;
+        auto request_transform = GetDownsampledRequestIdentityTransform(
+            sub_domain, state.downsample_factors_,
+            state.self_->downsample_method_, state.original_input_rank_);
+        downsampled_chunk.impl = IndependentReadChunkImpl{
+            internal::IntrusivePtr<ReadState>(&state), base_chunk};
+        downsampled_chunk.transform =
+            IdentityTransform(request_transform.domain().box());
+        execution::set_value(state.receiver_, std::move(downsampled_chunk),
+                             request_transform);
+      });
   if (emit_buffered_chunk) {
     // This method is not called from the `data_copy_executor`.  Because it may
     // involve a significant amount of computation to exclude the
@@ -16,9 +16,13 @@
 
 #include <stdint.h>
 
+#include <algorithm>
+#include <vector>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <nlohmann/json.hpp>
+#include "absl/strings/str_cat.h"
 #include "tensorstore/array.h"
 #include "tensorstore/array_testutil.h"
 #include "tensorstore/data_type.h"
@@ -386,6 +390,96 @@ TEST(DownsampleArrayTest, ModeJson) {
               Optional(MakeArray<::nlohmann::json>({json_t(3)})));
 }
 
+// Checks that the median and mode of integer types, which are computed using
+// specialized kernels depending on the block size, match a sort-based
+// reference implementation.
+template <typename T>
+void TestIntegerMedianAndMode() {
+  for (const Index factor : {2, 3, 4, 8, 27, 64, 100, 600}) {
+    for (const Index num_distinct : {3, 1000}) {
+      SCOPED_TRACE(
+          absl::StrCat("factor=", factor, ", num_distinct=", num_distinct));
+      // Last block is partial.
+      const Index num_blocks = 5;
+      const Index size = factor * (num_blocks - 1) + 1;
+      auto input = tensorstore::AllocateArray<T>({size});
+      for (Index i = 0; i < size; ++i) {
+        input(i) = static_cast<T>(
+            static_cast<Index>((static_cast<uint64_t>(i) * 2654435761u >> 7) %
+                               num_distinct) -
+            num_distinct / 2);
+      }
+      auto expected_median = tensorstore::AllocateArray<T>({num_blocks});
+      auto expected_mode = tensorstore::AllocateArray<T>({num_blocks});
+      for (Index block = 0; block < num_blocks; ++block) {
+        std::vector<T> values(input.data() + block * factor,
+                              input.data() + std::min(size, (block + 1) *
+                                                                factor));
+        std::sort(values.begin(), values.end());
+        expected_median(block) = values[(values.size() - 1) / 2];
+        // Smallest of the most frequent values.
+        size_t best_count = 0;
+        for (size_t i = 0; i < values.size();) {
+          size_t j = i;
+          while (j < values.size() && values[j] == values[i]) ++j;
+          if (j - i > best_count) {
+            best_count = j - i;
+            expected_mode(block) = values[i];
+          }
+          i = j;
+        }
+      }
+      EXPECT_THAT(DownsampleArray(input, span<const Index>({factor}),
+                                  DownsampleMethod::kMedian),
+                  Optional(expected_median));
+      EXPECT_THAT(DownsampleArray(input, span<const Index>({factor}),
+                                  DownsampleMethod::kMode),
+                  Optional(expected_mode));
+    }
+  }
+}
+
+TEST(DownsampleArrayTest, MedianAndModeUint8) {
+  TestIntegerMedianAndMode<uint8_t>();
+}
+
+TEST(DownsampleArrayTest, MedianAndModeInt8) {
+  TestIntegerMedianAndMode<int8_t>();
+}
+
+TEST(DownsampleArrayTest, MedianAndModeUint16) {
+  TestIntegerMedianAndMode<uint16_t>();
+}
+
+TEST(DownsampleArrayTest, MedianAndModeInt32) {
+  TestIntegerMedianAndMode<int32_t>();
+}
+
+TEST(DownsampleArrayTest, MedianAndModeUint64) {
+  TestIntegerMedianAndMode<uint64_t>();
+}
+
+TEST(DownsampleArrayTest, MedianAndModeRank3) {
+  auto input = tensorstore::AllocateArray<uint64_t>({4, 4, 4});
+  for (Index i = 0; i < 4; ++i) {
+    for (Index j = 0; j < 4; ++j) {
+      for (Index k = 0; k < 4; ++k) {
+        input(i, j, k) = (i < 2 && j < 2 && k < 2) ? 5 : (i + j + k) % 3;
+      }
+    }
+  }
+  EXPECT_THAT(DownsampleArray(input, span<const Index>({2, 2, 2}),
+                              DownsampleMethod::kMode),
+              Optional(MakeArray<uint64_t>(
+                  {{{5, 0}, {0, 0}}, {{0, 0}, {0, 1}}})));
+  EXPECT_THAT(DownsampleArray(input, span<const Index>({4, 4, 4}),
+                              DownsampleMethod::kMode),
+              Optional(MakeArray<uint64_t>({{{0}}})));
+  EXPECT_THAT(DownsampleArray(input, span<const Index>({4, 4, 4}),
+                              DownsampleMethod::kMedian),
+              Optional(MakeArray<uint64_t>({{{1}}})));
+}
+
 // Tests the downsampling behaves correctly when multiple blocks along
 // downsampled dimensions are needed.
 TEST(DownsampleArrayTest, MultipleBlocks) {
@@ -12,27 +12,36 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <stdint.h>
+
 #include <vector>
 
 #include <benchmark/benchmark.h>
+#include <nlohmann/json.hpp>
 #include "absl/log/absl_check.h"
+#include "absl/random/distributions.h"
 #include "absl/random/random.h"
 #include "absl/strings/str_cat.h"
 #include "tensorstore/array.h"
 #include "tensorstore/box.h"
+#include "tensorstore/context.h"
 #include "tensorstore/data_type.h"
+#include "tensorstore/downsample.h"
 #include "tensorstore/downsample_method.h"
+#include "tensorstore/driver/array/array.h"
 #include "tensorstore/driver/downsample/downsample_array.h"
 #include "tensorstore/driver/downsample/downsample_nditerable.h"
 #include "tensorstore/driver/downsample/downsample_util.h"
 #include "tensorstore/index.h"
 #include "tensorstore/internal/data_type_random_generator.h"
 #include "tensorstore/internal/global_initializer.h"
+#include "tensorstore/tensorstore.h"
 
 namespace {
 
 using ::tensorstore::Box;
 using ::tensorstore::BoxView;
+using ::tensorstore::Context;
 using ::tensorstore::DataType;
 using ::tensorstore::DimensionIndex;
 using ::tensorstore::DownsampleMethod;
@@ -67,6 +76,108 @@ void BenchmarkDownsample(::benchmark::State& state, DataType dtype,
   state.SetItemsProcessed(total_elements);
 }
 
+// Measures the throughput of `kMedian` and `kMode` downsampling of a rank-3
+// array with the same downsample factor in every dimension, for
+// segmentation-like data with `num_labels` distinct values.
+template <typename T>
+void BenchmarkDownsampleLabels(::benchmark::State& state,
+                               DownsampleMethod downsample_method,
+                               Index downsample_factor, Index num_labels) {
+  const Index size = 64;
+  std::vector<Index> downsample_factors(3, downsample_factor);
+  absl::BitGen gen;
+  auto base_array = tensorstore::AllocateArray<T>({size, size, size});
+  for (Index i = 0; i < base_array.num_elements(); ++i) {
+    base_array.data()[i] =
+        static_cast<T>(absl::Uniform<Index>(gen, 0, num_labels));
+  }
+  auto downsampled_array = tensorstore::AllocateArray<T>(
+      {size / downsample_factor, size / downsample_factor,
+       size / downsample_factor});
+  const Index num_elements = base_array.num_elements();
+  while (state.KeepRunningBatch(num_elements)) {
+    ABSL_CHECK(DownsampleArray(base_array, downsampled_array,
+                               downsample_factors, downsample_method)
+                   .ok());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <typename T>
+void RegisterDownsampleLabelsBenchmarks() {
+  for (const DownsampleMethod downsample_method :
+       {DownsampleMethod::kMedian, DownsampleMethod::kMode}) {
+    for (const Index downsample_factor : {2, 4}) {
+      for (const Index num_labels : {4, 1000}) {
+        ::benchmark::RegisterBenchmark(
+            absl::StrCat("DownsampleLabels_", tensorstore::dtype_v<T>, "_",
+                         downsample_method, "_Factor", downsample_factor,
+                         "_Labels", num_labels)
+                .c_str(),
+            [=](auto& state) {
+              BenchmarkDownsampleLabels<T>(state, downsample_method,
+                                           downsample_factor, num_labels);
+            });
+      }
+    }
+  }
+}
+
+TENSORSTORE_GLOBAL_INITIALIZER {
+  RegisterDownsampleLabelsBenchmarks<uint8_t>();
+  RegisterDownsampleLabelsBenchmarks<uint16_t>();
+  RegisterDownsampleLabelsBenchmarks<uint32_t>();
+  RegisterDownsampleLabelsBenchmarks<uint64_t>();
+}
+
+// Measures the throughput of reading a downsampled view of an in-memory array
+// through the downsample driver, for a `data_copy_concurrency` limit given by
+// the first argument.  The downsampling computation is split into multiple
+// chunks that are processed in parallel by the `data_copy_concurrency`
+// executor, so this shows how the computation scales with the number of
+// cores.
+void BenchmarkDownsampleDriverRead(::benchmark::State& state, DataType dtype,
+                                   DownsampleMethod downsample_method) {
+  const Index size = 256;
+  const Index downsample_factor = 2;
+  ::nlohmann::json context_json{
+      {"data_copy_concurrency", {{"limit", state.range(0)}}}};
+  auto context = Context(Context::Spec::FromJson(context_json).value());
+  absl::BitGen gen;
+  auto base_array = tensorstore::internal::MakeRandomArray(
+      gen, BoxView({size, size, size}), dtype);
+  auto store = tensorstore::FromArray(base_array, context).value();
+  auto downsampled_store =
+      tensorstore::Downsample(
+          store, {downsample_factor, downsample_factor, downsample_factor},
+          downsample_method)
+          .value();
+  for (auto s : state) {
+    ABSL_CHECK(tensorstore::Read(downsampled_store).result().ok());
+  }
+  state.SetItemsProcessed(state.iterations() * base_array.num_elements());
+  state.counters["threads"] = state.range(0);
+}
+
+TENSORSTORE_GLOBAL_INITIALIZER {
+  for (const DataType dtype :
+       {tensorstore::dtype_v<uint8_t>, tensorstore::dtype_v<uint16_t>,
+        tensorstore::dtype_v<float>}) {
+    for (const DownsampleMethod downsample_method :
+         {DownsampleMethod::kMean, DownsampleMethod::kMin,
+          DownsampleMethod::kMax}) {
+      auto* benchmark = ::benchmark::RegisterBenchmark(
+          absl::StrCat("DownsampleDriverRead_", dtype, "_",
+                       downsample_method)
+              .c_str(),
+          [=](auto& state) {
+            BenchmarkDownsampleDriverRead(state, dtype, downsample_method);
+          });
+      benchmark->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+    }
+  }
+}
+
 TENSORSTORE_GLOBAL_INITIALIZER {
   for (const DataType dtype : tensorstore::kDataTypes) {
     for (const DownsampleMethod downsample_method :
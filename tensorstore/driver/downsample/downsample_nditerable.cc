@@ -29,6 +29,7 @@
 #include <vector>
 
 #include "absl/log/absl_log.h"
+#include "absl/numeric/bits.h"
 #include "absl/numeric/int128.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
@@ -404,12 +405,212 @@ struct StoreReductionTraitsBase {
   }
 };
 
+/// Specialized kernels used to compute the median and mode of integer types.
+///
+/// For integer types, all of these kernels yield exactly the same result as
+/// the generic sort-based computation: the median is the element at position
+/// `(n - 1) / 2` in sorted order, and the mode is the smallest of the most
+/// frequent values.
+template <typename Element>
+constexpr bool kUseIntegerSelectionKernels =
+    std::is_integral_v<Element> && !std::is_same_v<Element, bool>;
+
+template <typename Element>
+inline void CompareExchange(Element& a, Element& b) {
+  const Element lo = std::min(a, b);
+  const Element hi = std::max(a, b);
+  a = lo;
+  b = hi;
+}
+
+/// Sorts `input` using a sorting network if its size corresponds to a common
+/// downsampling block size (`2`, `2x2` or `2x2x2`).
+///
+/// Sorting networks are branch-free, which avoids the mispredicted branches
+/// of a comparison sort on small inputs.
+///
+/// \returns `true` if `input` was sorted, or `false` if its size is not
+///     supported.
+template <typename Element>
+bool SortSmallBlock(span<Element> input) {
+  Element* x = input.data();
+  switch (input.size()) {
+    case 2:
+      CompareExchange(x[0], x[1]);
+      return true;
+    case 4:
+      CompareExchange(x[0], x[1]);
+      CompareExchange(x[2], x[3]);
+      CompareExchange(x[0], x[2]);
+      CompareExchange(x[1], x[3]);
+      CompareExchange(x[1], x[2]);
+      return true;
+    case 8:
+      // Optimal 19-comparator network.
+      CompareExchange(x[0], x[2]);
+      CompareExchange(x[1], x[3]);
+      CompareExchange(x[4], x[6]);
+      CompareExchange(x[5], x[7]);
+      CompareExchange(x[0], x[4]);
+      CompareExchange(x[1], x[5]);
+      CompareExchange(x[2], x[6]);
+      CompareExchange(x[3], x[7]);
+      CompareExchange(x[0], x[1]);
+      CompareExchange(x[2], x[3]);
+      CompareExchange(x[4], x[5]);
+      CompareExchange(x[6], x[7]);
+      CompareExchange(x[2], x[4]);
+      CompareExchange(x[3], x[5]);
+      CompareExchange(x[1], x[4]);
+      CompareExchange(x[3], x[6]);
+      CompareExchange(x[1], x[2]);
+      CompareExchange(x[3], x[4]);
+      CompareExchange(x[5], x[6]);
+      return true;
+    default:
+      return false;
+  }
+}
+
+/// Returns the smallest of the most frequent values in `sorted`, which must
+/// be non-empty and sorted.
+template <typename Element>
+Element ModeOfSorted(span<const Element> sorted) {
+  Index most_frequent_index = 0;
+  size_t most_frequent_count = 1;
+  size_t cur_count = 1;
+  for (ptrdiff_t i = 1; i < sorted.size(); ++i) {
+    if (sorted[i] == sorted[i - 1]) {
+      ++cur_count;
+    } else {
+      if (cur_count > most_frequent_count) {
+        most_frequent_count = cur_count;
+        most_frequent_index = i - 1;
+      }
+      cur_count = 1;
+    }
+  }
+  if (cur_count > most_frequent_count) {
+    most_frequent_index = sorted.size() - 1;
+  }
+  return sorted[most_frequent_index];
+}
+
+/// Histogram over all values of an 8-bit integer type, indexed in increasing
+/// order of value.
+template <typename Element>
+struct SmallIntegerHistogram {
+  static_assert(sizeof(Element) == 1);
+  static constexpr size_t kNumBins = 256;
+
+  static size_t GetBin(Element x) {
+    return static_cast<size_t>(static_cast<int>(x) -
+                               std::numeric_limits<Element>::min());
+  }
+  static Element GetValue(size_t bin) {
+    return static_cast<Element>(static_cast<int>(bin) +
+                                std::numeric_limits<Element>::min());
+  }
+
+  Index counts[kNumBins] = {};
+};
+
+/// Computes the median of an 8-bit integer type by counting.
+template <typename Element>
+Element CountingMedian(span<const Element> input) {
+  using Histogram = SmallIntegerHistogram<Element>;
+  Histogram histogram;
+  for (const Element x : input) {
+    ++histogram.counts[Histogram::GetBin(x)];
+  }
+  Index remaining = (input.size() - 1) / 2;
+  size_t bin = 0;
+  while (histogram.counts[bin] <= remaining) {
+    remaining -= histogram.counts[bin++];
+  }
+  return Histogram::GetValue(bin);
+}
+
+/// Tracks the smallest of the most frequent values as counts are
+/// incremented.
+template <typename Element>
+struct ModeTracker {
+  Element value{};
+  Index count = 0;
+
+  void Update(Element x, Index x_count) {
+    if (x_count > count || (x_count == count && x < value)) {
+      value = x;
+      count = x_count;
+    }
+  }
+};
+
+/// Computes the mode of an 8-bit integer type by counting.
+template <typename Element>
+Element CountingMode(span<const Element> input) {
+  using Histogram = SmallIntegerHistogram<Element>;
+  Histogram histogram;
+  ModeTracker<Element> mode;
+  for (const Element x : input) {
+    mode.Update(x, ++histogram.counts[Histogram::GetBin(x)]);
+  }
+  return mode.value;
+}
+
+/// Maximum number of elements for which `HashMode` is used.  The hash table
+/// is allocated on the stack, with a size of at most `2 * kMaxHashModeElements`
+/// entries.
+constexpr Index kMaxHashModeElements = 512;
+
+/// Computes the mode of an integer type using an open-addressing hash table.
+///
+/// This is intended for segmentation labels, where there are typically only a
+/// few distinct values within each downsampling block.  Requires
+/// `input.size() <= kMaxHashModeElements`.
+template <typename Element>
+Element HashMode(span<const Element> input) {
+  assert(input.size() <= kMaxHashModeElements);
+  constexpr size_t kMaxTableSize = 2 * kMaxHashModeElements;
+  Element keys[kMaxTableSize];
+  uint32_t counts[kMaxTableSize];
+  // Table size is a power of 2 that is at least twice the number of elements.
+  const int table_bits =
+      absl::bit_width(static_cast<size_t>(input.size() - 1)) + 1;
+  const size_t table_size = size_t{1} << table_bits;
+  std::fill_n(counts, table_size, uint32_t{0});
+  ModeTracker<Element> mode;
+  for (const Element x : input) {
+    // Fibonacci hashing: the high bits of the product are well mixed.
+    size_t i = static_cast<size_t>(
+        (static_cast<uint64_t>(x) * uint64_t{0x9e3779b97f4a7c15}) >>
+        (64 - table_bits));
+    while (counts[i] != 0 && keys[i] != x) {
+      i = (i + 1) & (table_size - 1);
+    }
+    keys[i] = x;
+    mode.Update(x, ++counts[i]);
+  }
+  return mode.value;
+}
+
 template <typename Element>
 struct ReductionTraits<DownsampleMethod::kMedian, Element,
                        std::enable_if_t<IsOrderingSupported<Element>::value>>
     : public StoreReductionTraitsBase<DownsampleMethod::kMedian, Element> {
   static void ComputeOutput(Element& output, span<Element> input) {
-    auto median_it = input.begin() + (input.size() - 1) / 2;
+    const size_t median_index = (input.size() - 1) / 2;
+    if constexpr (kUseIntegerSelectionKernels<Element>) {
+      if (SortSmallBlock(input)) {
+        output = input[median_index];
+        return;
+      }
+      if constexpr (sizeof(Element) == 1) {
+        output = CountingMedian<Element>(input);
+        return;
+      }
+    }
+    auto median_it = input.begin() + median_index;
     std::nth_element(input.begin(), median_it, input.end());
     output = *median_it;
   }
@@ -434,27 +635,25 @@ template <typename Element>
 struct ReductionTraits<DownsampleMethod::kMode, Element>
     : public StoreReductionTraitsBase<DownsampleMethod::kMode, Element> {
   static void ComputeOutput(Element& output, span<Element> input) {
-    // Sort in order to determine the number of times each distinct value is
-    // repeated.
-    std::sort(input.begin(), input.end(), CompareForMode<Element>{});
-    Index most_frequent_index = 0;
-    size_t most_frequent_count = 1;
-    size_t cur_count = 1;
-    for (ptrdiff_t i = 1; i < input.size(); ++i) {
-      if (input[i] == input[i - 1]) {
-        ++cur_count;
+    if constexpr (kUseIntegerSelectionKernels<Element>) {
+      if (SortSmallBlock(input)) {
+        output = ModeOfSorted<Element>(input);
+        return;
+      }
+      if constexpr (sizeof(Element) == 1) {
+        output = CountingMode<Element>(input);
+        return;
       } else {
-        if (cur_count > most_frequent_count) {
-          most_frequent_count = cur_count;
-          most_frequent_index = i - 1;
+        if (input.size() <= kMaxHashModeElements) {
+          output = HashMode<Element>(input);
+          return;
         }
-        cur_count = 1;
       }
     }
-    if (cur_count > most_frequent_count) {
-      most_frequent_index = input.size() - 1;
-    }
-    output = input[most_frequent_index];
+    // Sort in order to determine the number of times each distinct value is
+    // repeated.
+    std::sort(input.begin(), input.end(), CompareForMode<Element>{});
+    output = ModeOfSorted<Element>(input);
   }
 };
 
@@ -485,6 +684,64 @@ struct DownsampleImpl {
     }
   }
 
+  /// Accumulates a contiguous row of `n` input elements, where `input[0]` is
+  /// at position `offset` within the first downsample block of size `factor`
+  /// and `acc[0]` corresponds to that block.
+  ///
+  /// This is equivalent to the generic loop in `ProcessInput`, and accumulates
+  /// the elements of each block in the same order, but is written such that it
+  /// can be vectorized by the compiler.  Only used for methods that accumulate
+  /// input values incrementally (`kStoreAllElements == false`).
+  static void AccumulateContiguousRow(AccumulateElement* __restrict acc,
+                                      const Element* __restrict input,
+                                      Index n, Index offset, Index factor) {
+    // Blocks with a constant trip count are vectorized even by compilers that
+    // do not vectorize loops with a variable trip count at `-O2`.
+    constexpr Index kBlockSize = 16;
+    if (factor == 1) {
+      Index i = 0;
+      for (; i + kBlockSize <= n; i += kBlockSize) {
+        for (Index j = 0; j < kBlockSize; ++j) {
+          Traits::Accumulate(acc[i + j], input[i + j]);
+        }
+      }
+      for (; i < n; ++i) {
+        Traits::Accumulate(acc[i], input[i]);
+      }
+      return;
+    }
+    // First, possibly partial, block.
+    const Index first_block_size = std::min(factor - offset, n);
+    for (Index i = 0; i < first_block_size; ++i) {
+      Traits::Accumulate(acc[0], input[i]);
+    }
+    if (first_block_size == n) return;
+    ++acc;
+    input += first_block_size;
+    n -= first_block_size;
+    // Full blocks.
+    const Index num_full_blocks = n / factor;
+    Index i = 0;
+    // Downsampling by 2 is the common case, e.g. for multiscale pyramids.
+    if (factor == 2) {
+      for (; i + kBlockSize <= num_full_blocks; i += kBlockSize) {
+        for (Index j = 0; j < kBlockSize; ++j) {
+          Traits::Accumulate(acc[i + j], input[2 * (i + j)]);
+          Traits::Accumulate(acc[i + j], input[2 * (i + j) + 1]);
+        }
+      }
+    }
+    for (Index j = 0; j < factor; ++j) {
+      for (Index k = i; k < num_full_blocks; ++k) {
+        Traits::Accumulate(acc[k], input[k * factor + j]);
+      }
+    }
+    // Last, partial, block.
+    for (Index j = num_full_blocks * factor; j < n; ++j) {
+      Traits::Accumulate(acc[num_full_blocks], input[j]);
+    }
+  }
+
   /// ElementwiseFunction LoopTemplate implementation for accumulating the
   /// total.
   struct ProcessInput {
@@ -578,6 +835,22 @@ struct DownsampleImpl {
                       element_i * num_outer_elements);
             });
       };
+      if constexpr (!Traits::kStoreAllElements &&
+                    ArrayAccessor::buffer_kind ==
+                        IterationBufferKind::kContiguous) {
+        for_each_source_index(
+            std::integral_constant<Index, 0>{},
+            [&](Index output_outer_i, Index source_outer_i, Index element_i,
+                Index num_source_elements) {
+              AccumulateContiguousRow(
+                  acc + output_outer_i * output_block_shape[1],
+                  ArrayAccessor::template GetPointerAtPosition<Element>(
+                      source_pointer, source_outer_i, 0),
+                  base_block_shape[1], base_block_offset[1],
+                  downsample_factor[1]);
+            });
+        return true;
+      }
       for_each_source_index(
           std::integral_constant<Index, 0>{},
           [&](Index output_outer_i, Index source_outer_i, Index element_i,
@@ -23,6 +23,7 @@
 
 #include "absl/base/optimization.h"
 #include "absl/container/inlined_vector.h"
+#include "absl/functional/function_ref.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
@@ -794,5 +795,46 @@ bool CanDownsampleIndexTransform(IndexTransformView<> base_transform,
   return true;
 }
 
+void PartitionDownsampleDomain(BoxView<> base_domain,
+                               span<const Index> downsample_factors,
+                               Index target_num_elements,
+                               absl::FunctionRef<void(BoxView<>)> callback) {
+  const DimensionIndex rank = base_domain.rank();
+  assert(rank == downsample_factors.size());
+  assert(target_num_elements > 0);
+  const Index num_elements = base_domain.num_elements();
+  if (num_elements > target_num_elements) {
+    for (DimensionIndex i = 0; i < rank; ++i) {
+      const Index downsample_factor = downsample_factors[i];
+      const IndexInterval base_interval = base_domain[i];
+      const IndexInterval downsampled_interval = DownsampleInterval(
+          base_interval, downsample_factor, DownsampleMethod::kMean);
+      if (downsampled_interval.size() <= 1) continue;
+      const Index num_partitions =
+          std::min(downsampled_interval.size(),
+                   CeilOfRatio(num_elements, target_num_elements));
+      const Index partition_size =
+          CeilOfRatio(downsampled_interval.size(), num_partitions);
+      Box<dynamic_rank(internal::kNumInlinedDims)> sub_domain(base_domain);
+      for (Index begin = downsampled_interval.inclusive_min();
+           begin < downsampled_interval.exclusive_max();
+           begin += partition_size) {
+        const Index end = std::min(begin + partition_size,
+                                   downsampled_interval.exclusive_max());
+        sub_domain[i] = IndexInterval::UncheckedHalfOpen(
+            begin == downsampled_interval.inclusive_min()
+                ? base_interval.inclusive_min()
+                : begin * downsample_factor,
+            end == downsampled_interval.exclusive_max()
+                ? base_interval.exclusive_max()
+                : end * downsample_factor);
+        callback(sub_domain);
+      }
+      return;
+    }
+  }
+  callback(base_domain);
+}
+
 }  // namespace internal_downsample
 }  // namespace tensorstore
@@ -18,6 +18,7 @@
 #include <iosfwd>
 
 #include "absl/container/inlined_vector.h"
+#include "absl/functional/function_ref.h"
 #include "absl/status/status.h"
 #include "tensorstore/box.h"
 #include "tensorstore/downsample_method.h"
@@ -226,6 +227,27 @@ bool CanDownsampleIndexTransform(IndexTransformView<> base_transform,
                                  BoxView<> base_bounds,
                                  span<const Index> downsample_factors);
 
+/// Partitions `base_domain` into sub-regions that can be downsampled
+/// independently, e.g. in parallel.
+///
+/// If `base_domain` contains more than `target_num_elements` elements, it is
+/// split along the outermost dimension that is downsampled to more than one
+/// element.  The split points are multiples of the downsample factor, so that
+/// each downsampled position is computed from exactly one sub-region.
+/// Otherwise, `callback` is invoked once with `base_domain`.
+///
+/// \param base_domain The base (not downsampled) region to partition.
+/// \param downsample_factors Downsample factor for each dimension of
+///     `base_domain`.
+/// \param target_num_elements Target number of elements in each sub-region.
+/// \param callback Invoked with each sub-region, in order.
+/// \dchecks `base_domain.rank() == downsample_factors.size()`
+/// \dchecks `target_num_elements > 0`
+void PartitionDownsampleDomain(BoxView<> base_domain,
+                               span<const Index> downsample_factors,
+                               Index target_num_elements,
+                               absl::FunctionRef<void(BoxView<>)> callback);
+
 }  // namespace internal_downsample
 }  // namespace tensorstore
 
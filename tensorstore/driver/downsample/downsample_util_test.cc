@@ -66,8 +66,10 @@ using ::tensorstore::internal_downsample::DownsampleArray;
 using ::tensorstore::internal_downsample::DownsampleBounds;
 using ::tensorstore::internal_downsample::DownsampleInterval;
 using ::tensorstore::internal_downsample::DownsampleTransformedArray;
+using ::tensorstore::internal_downsample::PartitionDownsampleDomain;
 using ::tensorstore::internal_downsample::PropagatedIndexTransformDownsampling;
 using ::tensorstore::internal_downsample::PropagateIndexTransformDownsampling;
+using ::testing::ElementsAre;
 using ::testing::HasSubstr;
 using ::testing::MatchesRegex;
 using ::testing::Optional;
@@ -575,4 +577,43 @@ TEST(DownsampleIntervalTest, UnboundedUpper) {
                                3, DownsampleMethod::kMean));
 }
 
+std::vector<Box<>> GetPartitions(BoxView<> base_domain,
+                                 span<const Index> downsample_factors,
+                                 Index target_num_elements) {
+  std::vector<Box<>> partitions;
+  PartitionDownsampleDomain(
+      base_domain, downsample_factors, target_num_elements,
+      [&](BoxView<> sub_domain) { partitions.emplace_back(sub_domain); });
+  return partitions;
+}
+
+TEST(PartitionDownsampleDomainTest, Small) {
+  EXPECT_THAT(GetPartitions(BoxView({1, 2}, {10, 10}), {{2, 2}}, 100),
+              ElementsAre(BoxView({1, 2}, {10, 10})));
+}
+
+TEST(PartitionDownsampleDomainTest, SplitOuterDimension) {
+  // Dimension 0 is downsampled to [0, 6), which is split into 3 partitions of
+  // 2 downsampled positions.
+  EXPECT_THAT(GetPartitions(BoxView({1, 2}, {10, 10}), {{2, 2}}, 40),
+              ElementsAre(BoxView({1, 2}, {3, 10}), BoxView({4, 2}, {4, 10}),
+                          BoxView({8, 2}, {3, 10})));
+}
+
+TEST(PartitionDownsampleDomainTest, SkipSingletonDimension) {
+  // Dimension 0 is downsampled to a single position, and cannot be split.
+  EXPECT_THAT(GetPartitions(BoxView({0, 0}, {4, 12}), {{4, 3}}, 24),
+              ElementsAre(BoxView({0, 0}, {4, 6}), BoxView({0, 6}, {4, 6})));
+}
+
+TEST(PartitionDownsampleDomainTest, LimitedByDownsampledSize) {
+  EXPECT_THAT(GetPartitions(BoxView({0}, {8}), {{4}}, 1),
+              ElementsAre(BoxView({0}, {4}), BoxView({4}, {4})));
+}
+
+TEST(PartitionDownsampleDomainTest, CannotSplit) {
+  EXPECT_THAT(GetPartitions(BoxView({0, 0}, {2, 2}), {{2, 2}}, 1),
+              ElementsAre(BoxView({0, 0}, {2, 2})));
+}
+
 }  // namespace
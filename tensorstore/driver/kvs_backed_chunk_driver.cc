@@ -137,7 +137,9 @@ bool OpenState::DataCacheUsesMetadataCachePool(const void* metadata_ptr) {
 MetadataCache::MetadataCache(Initializer initializer)
     : Base(kvstore::DriverPtr()),
       data_copy_concurrency_(std::move(initializer.data_copy_concurrency)),
-      metadata_cache_pool_(std::move(initializer.cache_pool)) {}
+      metadata_cache_pool_(std::move(initializer.cache_pool)) {
+  SetPriority(internal::CachePriority::kHigh);
+}
 
 DataCacheBase::DataCacheBase(Initializer&& initializer)
     : metadata_cache_entry_(std::move(initializer.metadata_cache_entry)),
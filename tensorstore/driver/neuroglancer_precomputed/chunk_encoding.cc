@@ -46,6 +46,7 @@
 #include "tensorstore/internal/integer_overflow.h"
 #include "tensorstore/strided_layout.h"
 #include "tensorstore/util/endian.h"
+#include "tensorstore/util/executor.h"
 #include "tensorstore/util/extents.h"
 #include "tensorstore/util/generic_stringify.h"
 #include "tensorstore/util/result.h"
@@ -326,7 +327,7 @@ Result<absl::Cord> EncodePngChunk(DataType dtype, int compression_level,
 
 Result<absl::Cord> EncodeCompressedSegmentationChunk(
     DataType dtype, span<const Index, 4> shape, ArrayView<const void> array,
-    std::array<Index, 3> block_size) {
+    std::array<Index, 3> block_size, const Executor& executor) {
   ptrdiff_t input_shape_ptrdiff_t[4] = {shape[0], shape[1], shape[2], shape[3]};
   ptrdiff_t block_shape_ptrdiff_t[3] = {block_size[2], block_size[1],
                                         block_size[0]};
@@ -338,12 +339,12 @@ Result<absl::Cord> EncodeCompressedSegmentationChunk(
     case DataTypeId::uint32_t:
       neuroglancer_compressed_segmentation::EncodeChannels(
           static_cast<const uint32_t*>(array.data()), input_shape_ptrdiff_t,
-          input_byte_strides, block_shape_ptrdiff_t, &out);
+          input_byte_strides, block_shape_ptrdiff_t, executor, &out);
       break;
     case DataTypeId::uint64_t:
       neuroglancer_compressed_segmentation::EncodeChannels(
           static_cast<const uint64_t*>(array.data()), input_shape_ptrdiff_t,
-          input_byte_strides, block_shape_ptrdiff_t, &out);
+          input_byte_strides, block_shape_ptrdiff_t, executor, &out);
       break;
     default:
       ABSL_UNREACHABLE();  // COV_NF_LINE
@@ -354,7 +355,8 @@ Result<absl::Cord> EncodeCompressedSegmentationChunk(
 Result<absl::Cord> EncodeChunk(span<const Index> chunk_indices,
                                const MultiscaleMetadata& metadata,
                                size_t scale_index,
-                               const SharedArrayView<const void>& array) {
+                               const SharedArrayView<const void>& array,
+                               const Executor& executor) {
   const auto& scale_metadata = metadata.scales[scale_index];
   std::array<Index, 4> partial_chunk_shape;
   GetChunkShape(chunk_indices, metadata, scale_index,
@@ -372,7 +374,7 @@ Result<absl::Cord> EncodeChunk(span<const Index> chunk_indices,
     case ScaleMetadata::Encoding::compressed_segmentation:
       return EncodeCompressedSegmentationChunk(
           metadata.dtype, partial_chunk_shape, array,
-          scale_metadata.compressed_segmentation_block_size);
+          scale_metadata.compressed_segmentation_block_size, executor);
   }
   ABSL_UNREACHABLE();  // COV_NF_LINE
 }
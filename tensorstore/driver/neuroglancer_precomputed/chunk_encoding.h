@@ -22,6 +22,7 @@
 #include "tensorstore/driver/neuroglancer_precomputed/metadata.h"
 #include "tensorstore/index.h"
 #include "tensorstore/strided_layout.h"
+#include "tensorstore/util/executor.h"
 #include "tensorstore/util/result.h"
 #include "tensorstore/util/span.h"
 
@@ -51,11 +52,14 @@ Result<SharedArray<const void>> DecodeChunk(span<const Index> chunk_indices,
 /// \param metadata Metadata (determines chunk format and volume bounds).
 /// \param scale_index Scale index, in range `[0, metadata.scales.size())`.
 /// \param array Chunk data, in "czyx" order.
+/// \param executor Executor used to encode multiple channels in parallel with
+///     the `compressed_segmentation` encoding.
 /// \returns The encoded chunk.
 Result<absl::Cord> EncodeChunk(span<const Index> chunk_indices,
                                const MultiscaleMetadata& metadata,
                                size_t scale_index,
-                               const SharedArrayView<const void>& array);
+                               const SharedArrayView<const void>& array,
+                               const Executor& executor);
 
 }  // namespace internal_neuroglancer_precomputed
 }  // namespace tensorstore
@@ -47,6 +47,7 @@
 #include "tensorstore/internal/image/png_reader.h"
 #include "tensorstore/static_cast.h"
 #include "tensorstore/strided_layout.h"
+#include "tensorstore/util/executor.h"
 #include "tensorstore/util/status_testutil.h"
 
 namespace {
@@ -131,7 +132,8 @@ TEST_P(ChunkEncodingTest, Roundtrip) {
   std::vector<Index> chunk_indices{0, 0, 0};
   const size_t scale_index = 0;
   TENSORSTORE_ASSERT_OK_AND_ASSIGN(
-      absl::Cord out, EncodeChunk(chunk_indices, metadata, scale_index, array));
+      absl::Cord out, EncodeChunk(chunk_indices, metadata, scale_index, array,
+                                  tensorstore::InlineExecutor{}));
   tensorstore::StridedLayout chunk_layout(tensorstore::c_order, dtype.size(),
                                           {metadata.num_channels, 5, 4, 3});
   TENSORSTORE_ASSERT_OK_AND_ASSIGN(
@@ -374,7 +374,8 @@ class DataCacheBase : public internal_kvs_backed_chunk_driver::DataCache {
       span<const SharedArray<const void>> component_arrays) override {
     assert(component_arrays.size() == 1);
     return internal_neuroglancer_precomputed::EncodeChunk(
-        chunk_indices, metadata(), scale_index_, component_arrays[0]);
+        chunk_indices, metadata(), scale_index_, component_arrays[0],
+        executor());
   }
 
   Result<IndexTransform<>> GetExternalToInternalTransform(
@@ -164,6 +164,12 @@ class ZarrArrayToArrayCodec
 
   virtual ~ZarrArrayToArrayCodec();
 
+  // Indicates if this codec transforms element values, rather than just
+  // rearranging them.  Such codecs do not support partial I/O through
+  // `PreparedState::Read` and `PreparedState::Write`, and therefore cannot
+  // precede a sharding codec.
+  virtual bool transforms_values() const { return false; }
+
   // Returns a prepared state that may be used to decode arrays of the specified
   // shape.
   virtual Result<PreparedState::Ptr> Prepare(
@@ -317,6 +317,21 @@ ZarrCodecChainSpec::Resolve(ArrayCodecResolveParameters&& decoded,
       _.With(
           CodecResolveErrorBuilder{*array_to_bytes, "resolving codec spec"}));
 
+  if (chain->array_to_bytes->is_sharding_codec()) {
+    for (size_t i = 0; i < chain->array_to_array.size(); ++i) {
+      if (!chain->array_to_array[i]->transforms_values()) continue;
+      return absl::InvalidArgumentError(absl::StrFormat(
+          "Sharding codec %s is not compatible with preceding array -> array "
+          "codec %s that transforms element values.  Instead, the array -> "
+          "array codec may be specified as an inner codec that applies to "
+          "each sub-chunk individually.",
+          jb::ToJson(array_to_bytes_codec_ptr, ZarrCodecJsonBinder)
+              .value()
+              .dump(),
+          jb::ToJson(array_to_array[i], ZarrCodecJsonBinder).value().dump()));
+    }
+  }
+
   if (chain->array_to_bytes->is_sharding_codec() && !bytes_to_bytes.empty()) {
     return absl::InvalidArgumentError(absl::StrFormat(
         "Sharding codec %s is not compatible with subsequent bytes -> "
@@ -14,7 +14,10 @@
 
 #include "tensorstore/driver/zarr3/codec/codec_test_util.h"
 
+#include <stddef.h>
+
 #include <utility>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -118,6 +121,44 @@ void TestCodecRoundTrip(const CodecRoundTripTestParams& params) {
       << "data=" << data;
 }
 
+Result<ArrayToArrayRoundTripResult> TestArrayToArrayRoundTrip(
+    ::nlohmann::json json_spec, SharedArray<const void> decoded) {
+  ZarrCodecChainSpec::FromJsonOptions from_json_options{/*.constraints=*/true};
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto codec_chain_spec,
+      ZarrCodecChainSpec::FromJson(json_spec, from_json_options));
+  ArrayCodecResolveParameters decoded_params;
+  decoded_params.rank = decoded.rank();
+  decoded_params.dtype = decoded.dtype();
+  decoded_params.fill_value = AllocateArray(span<const Index>{}, c_order,
+                                            value_init, decoded_params.dtype);
+  BytesCodecResolveParameters encoded_params;
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto codec_chain,
+      codec_chain_spec.Resolve(std::move(decoded_params), encoded_params));
+  std::vector<ZarrArrayToArrayCodec::PreparedState::Ptr> states;
+  ArrayToArrayRoundTripResult result;
+  result.encoded = decoded;
+  for (const auto& codec : codec_chain->array_to_array) {
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto state, codec->Prepare(states.empty()
+                                       ? decoded.shape()
+                                       : states.back()->encoded_shape()));
+    TENSORSTORE_ASSIGN_OR_RETURN(result.encoded,
+                                 state->EncodeArray(result.encoded));
+    states.push_back(std::move(state));
+  }
+  result.decoded = result.encoded;
+  for (size_t i = states.size(); i--;) {
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        result.decoded,
+        states[i]->DecodeArray(result.decoded,
+                               i == 0 ? decoded.shape()
+                                      : states[i - 1]->encoded_shape()));
+  }
+  return result;
+}
+
 Result<::nlohmann::json> TestCodecMerge(::nlohmann::json a, ::nlohmann::json b,
                                         bool strict) {
   ZarrCodecChainSpec::FromJsonOptions from_json_options{/*.constraints=*/true};
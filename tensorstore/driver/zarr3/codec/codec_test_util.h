@@ -20,6 +20,7 @@
 #include <vector>
 
 #include <nlohmann/json.hpp>
+#include "tensorstore/array.h"
 #include "tensorstore/data_type.h"
 #include "tensorstore/driver/zarr3/codec/codec_chain_spec.h"
 #include "tensorstore/driver/zarr3/codec/codec_spec.h"
@@ -54,6 +55,18 @@ struct CodecRoundTripTestParams {
 
 void TestCodecRoundTrip(const CodecRoundTripTestParams& params);
 
+struct ArrayToArrayRoundTripResult {
+  SharedArray<const void> encoded;
+  SharedArray<const void> decoded;
+};
+
+// Encodes `decoded` using only the "array -> array" codecs of the codec chain
+// specified by `json_spec`, and then decodes the encoded array.
+//
+// This permits testing the encoded values, as well as lossy codecs.
+Result<ArrayToArrayRoundTripResult> TestArrayToArrayRoundTrip(
+    ::nlohmann::json json_spec, SharedArray<const void> decoded);
+
 Result<::nlohmann::json> TestCodecMerge(::nlohmann::json a, ::nlohmann::json b,
                                         bool strict);
 
@@ -0,0 +1,140 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/driver/zarr3/codec/delta.h"
+
+#include <stdint.h>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_format.h"
+#include "tensorstore/data_type.h"
+#include "tensorstore/driver/zarr3/codec/codec_spec.h"
+#include "tensorstore/driver/zarr3/codec/elementwise.h"
+#include "tensorstore/driver/zarr3/codec/registry.h"
+#include "tensorstore/index.h"
+#include "tensorstore/internal/global_initializer.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/json_binding/json_binding.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/status.h"
+
+namespace tensorstore {
+namespace internal_zarr3 {
+namespace {
+
+// Differences are computed on the unsigned representation, which gives the
+// same result for signed integers but avoids undefined behavior on overflow.
+template <typename T>
+void DeltaEncode(const void* decoded, void* encoded, Index n) {
+  const T* in = static_cast<const T*>(decoded);
+  T* out = static_cast<T*>(encoded);
+  if (n == 0) return;
+  out[0] = in[0];
+  for (Index i = 1; i < n; ++i) {
+    out[i] = static_cast<T>(in[i] - in[i - 1]);
+  }
+}
+
+template <typename T>
+void DeltaDecode(const void* encoded, void* decoded, Index n) {
+  const T* in = static_cast<const T*>(encoded);
+  T* out = static_cast<T*>(decoded);
+  T sum = 0;
+  for (Index i = 0; i < n; ++i) {
+    sum = static_cast<T>(sum + in[i]);
+    out[i] = sum;
+  }
+}
+
+class DeltaCodec : public ZarrElementwiseCodec {
+ public:
+  explicit DeltaCodec(DataType dtype) : ZarrElementwiseCodec(dtype, dtype) {}
+
+ protected:
+  void Encode(const void* decoded, void* encoded, Index n) const final {
+    switch (decoded_dtype().size()) {
+      case 1:
+        return DeltaEncode<uint8_t>(decoded, encoded, n);
+      case 2:
+        return DeltaEncode<uint16_t>(decoded, encoded, n);
+      case 4:
+        return DeltaEncode<uint32_t>(decoded, encoded, n);
+      case 8:
+        return DeltaEncode<uint64_t>(decoded, encoded, n);
+    }
+  }
+
+  void Decode(const void* encoded, void* decoded, Index n) const final {
+    switch (decoded_dtype().size()) {
+      case 1:
+        return DeltaDecode<uint8_t>(encoded, decoded, n);
+      case 2:
+        return DeltaDecode<uint16_t>(encoded, decoded, n);
+      case 4:
+        return DeltaDecode<uint32_t>(encoded, decoded, n);
+      case 8:
+        return DeltaDecode<uint64_t>(encoded, decoded, n);
+    }
+  }
+};
+
+}  // namespace
+
+absl::Status DeltaCodecSpec::MergeFrom(const ZarrCodecSpec& other,
+                                       bool strict) {
+  return absl::OkStatus();
+}
+
+ZarrCodecSpec::Ptr DeltaCodecSpec::Clone() const {
+  return internal::MakeIntrusivePtr<DeltaCodecSpec>(*this);
+}
+
+Result<DataType> DeltaCodecSpec::GetEncodedDataType(
+    DataType decoded_dtype) const {
+  switch (decoded_dtype.id()) {
+    case DataTypeId::int8_t:
+    case DataTypeId::uint8_t:
+    case DataTypeId::int16_t:
+    case DataTypeId::uint16_t:
+    case DataTypeId::int32_t:
+    case DataTypeId::uint32_t:
+    case DataTypeId::int64_t:
+    case DataTypeId::uint64_t:
+      return decoded_dtype;
+    default:
+      // Floating-point differences would not round trip exactly.
+      return absl::InvalidArgumentError(absl::StrFormat(
+          "Delta codec does not support data type %v", decoded_dtype));
+  }
+}
+
+Result<internal::IntrusivePtr<const ZarrElementwiseCodec>>
+DeltaCodecSpec::ResolveElementwise(
+    DataType decoded_dtype,
+    ZarrArrayToArrayCodecSpec::Ptr* resolved_spec) const {
+  TENSORSTORE_RETURN_IF_ERROR(GetEncodedDataType(decoded_dtype));
+  if (resolved_spec) {
+    resolved_spec->reset(this);
+  }
+  return internal::MakeIntrusivePtr<DeltaCodec>(decoded_dtype);
+}
+
+TENSORSTORE_GLOBAL_INITIALIZER {
+  using Self = DeltaCodecSpec;
+  namespace jb = ::tensorstore::internal_json_binding;
+  RegisterCodec<Self>("delta", jb::Sequence());
+}
+
+}  // namespace internal_zarr3
+}  // namespace tensorstore
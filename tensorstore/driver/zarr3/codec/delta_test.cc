@@ -0,0 +1,114 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "tensorstore/array.h"
+#include "tensorstore/array_testutil.h"
+#include "tensorstore/data_type.h"
+#include "tensorstore/driver/zarr3/codec/codec_chain_spec.h"
+#include "tensorstore/driver/zarr3/codec/codec_test_util.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::dtype_v;
+using ::tensorstore::MakeArray;
+using ::tensorstore::MatchesArrayIdentically;
+using ::tensorstore::StatusIs;
+using ::tensorstore::internal_zarr3::CodecRoundTripTestParams;
+using ::tensorstore::internal_zarr3::CodecSpecRoundTripTestParams;
+using ::tensorstore::internal_zarr3::GetDefaultBytesCodecJson;
+using ::tensorstore::internal_zarr3::TestArrayToArrayRoundTrip;
+using ::tensorstore::internal_zarr3::TestCodecRoundTrip;
+using ::tensorstore::internal_zarr3::TestCodecSpecResolve;
+using ::tensorstore::internal_zarr3::TestCodecSpecRoundTrip;
+using ::testing::HasSubstr;
+
+TEST(DeltaTest, Basic) {
+  CodecSpecRoundTripTestParams p;
+  p.orig_spec = {"delta"};
+  p.expected_spec = {
+      {{"name", "delta"}},
+      GetDefaultBytesCodecJson(),
+  };
+  TestCodecSpecRoundTrip(p);
+}
+
+TEST(DeltaTest, EncodedValues) {
+  // Differences are computed in C order, and wrap around on overflow.
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto result,
+      TestArrayToArrayRoundTrip(
+          {"delta"}, MakeArray<int8_t>({{5, 7, 4}, {-128, 127, 127}})));
+  EXPECT_THAT(result.encoded, MatchesArrayIdentically(MakeArray<int8_t>(
+                                  {{5, 2, -3}, {124, -1, 0}})));
+  EXPECT_THAT(result.decoded, MatchesArrayIdentically(MakeArray<int8_t>(
+                                  {{5, 7, 4}, {-128, 127, 127}})));
+}
+
+TEST(DeltaTest, RoundTrip) {
+  for (auto dtype : {tensorstore::DataType(dtype_v<uint8_t>),
+                     tensorstore::DataType(dtype_v<int16_t>),
+                     tensorstore::DataType(dtype_v<uint32_t>),
+                     tensorstore::DataType(dtype_v<int64_t>)}) {
+    SCOPED_TRACE(dtype.name());
+    CodecRoundTripTestParams p;
+    p.dtype = dtype;
+    p.spec = {"delta", "zstd"};
+    TestCodecRoundTrip(p);
+  }
+}
+
+TEST(DeltaTest, RoundTripTransposed) {
+  CodecRoundTripTestParams p;
+  p.spec = {
+      {{"name", "transpose"}, {"configuration", {{"order", {2, 1, 0}}}}},
+      "delta",
+  };
+  TestCodecRoundTrip(p);
+}
+
+TEST(DeltaTest, UnsupportedDataType) {
+  CodecSpecRoundTripTestParams p;
+  p.resolve_params.dtype = dtype_v<float>;
+  EXPECT_THAT(TestCodecSpecResolve({"delta"}, p.resolve_params),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       HasSubstr("does not support data type float32")));
+}
+
+TEST(DeltaTest, NotSupportedBeforeSharding) {
+  CodecSpecRoundTripTestParams p;
+  p.resolve_params.rank = 2;
+  EXPECT_THAT(
+      TestCodecSpecResolve(
+          {
+              "delta",
+              {{"name", "sharding_indexed"},
+               {"configuration",
+                {
+                    {"chunk_shape", {2, 2}},
+                    {"codecs", {"bytes"}},
+                    {"index_codecs", {"bytes", "crc32c"}},
+                }}},
+          },
+          p.resolve_params),
+      StatusIs(absl::StatusCode::kInvalidArgument,
+               HasSubstr("transforms element values")));
+}
+
+}  // namespace
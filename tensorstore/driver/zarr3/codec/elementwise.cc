@@ -0,0 +1,182 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/driver/zarr3/codec/elementwise.h"
+
+#include <cassert>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "tensorstore/array.h"
+#include "tensorstore/contiguous_layout.h"
+#include "tensorstore/data_type.h"
+#include "tensorstore/driver/chunk.h"
+#include "tensorstore/driver/zarr3/codec/codec.h"
+#include "tensorstore/driver/zarr3/codec/codec_spec.h"
+#include "tensorstore/index.h"
+#include "tensorstore/index_space/index_transform.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/storage_statistics.h"
+#include "tensorstore/strided_layout.h"
+#include "tensorstore/util/execution/any_receiver.h"
+#include "tensorstore/util/execution/execution.h"
+#include "tensorstore/util/execution/sender_util.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
+#include "tensorstore/util/status.h"
+
+namespace tensorstore {
+namespace internal_zarr3 {
+namespace {
+
+// Applies `func(input_data, output_data, num_elements)` to a C order copy of
+// `input`, and returns the result as a new C order array of `output_dtype`.
+template <typename Func>
+SharedArray<const void> TransformElements(SharedArrayView<const void> input,
+                                          DataType output_dtype, Func func) {
+  // The kernels operate on contiguous buffers, which avoids per-element stride
+  // computations.
+  SharedArray<const void> input_copy;
+  const void* input_data = input.data();
+  if (!IsContiguousLayout(input.layout(), c_order, input.dtype().size())) {
+    input_copy = MakeCopy(input);
+    input_data = input_copy.data();
+  }
+  auto output =
+      AllocateArray(input.shape(), c_order, default_init, output_dtype);
+  func(input_data, output.data(), output.num_elements());
+  return output;
+}
+
+absl::Status PartialIoNotSupportedError() {
+  return absl::UnimplementedError(
+      "Partial I/O is not supported by codecs that transform element values");
+}
+
+class ElementwiseState : public ZarrArrayToArrayCodec::PreparedState {
+ public:
+  span<const Index> encoded_shape() const final { return encoded_shape_; }
+
+  Result<SharedArray<const void>> EncodeArray(
+      SharedArrayView<const void> decoded) const final {
+    return codec_->EncodeArray(std::move(decoded));
+  }
+
+  Result<SharedArray<const void>> DecodeArray(
+      SharedArrayView<const void> encoded,
+      span<const Index> decoded_shape) const final {
+    assert(internal::RangesEqual(decoded_shape, encoded.shape()));
+    return codec_->DecodeArray(std::move(encoded));
+  }
+
+  void Read(const NextReader& next, span<const Index> decoded_shape,
+            IndexTransform<> transform,
+            AnyFlowReceiver<absl::Status, internal::ReadChunk,
+                            IndexTransform<>>&& receiver) const final {
+    execution::set_error(FlowSingleReceiver{std::move(receiver)},
+                         PartialIoNotSupportedError());
+  }
+
+  void Write(const NextWriter& next, span<const Index> decoded_shape,
+             IndexTransform<> transform,
+             AnyFlowReceiver<absl::Status, internal::WriteChunk,
+                             IndexTransform<>>&& receiver) const final {
+    execution::set_error(FlowSingleReceiver{std::move(receiver)},
+                         PartialIoNotSupportedError());
+  }
+
+  void GetStorageStatistics(
+      const NextGetStorageStatistics& next, span<const Index> decoded_shape,
+      IndexTransform<> transform,
+      internal::IntrusivePtr<internal::GetStorageStatisticsAsyncOperationState>
+          state) const final {
+    // The shape is unchanged.
+    next(std::move(transform), std::move(state));
+  }
+
+  const ZarrElementwiseCodec* codec_;
+  std::vector<Index> encoded_shape_;
+};
+
+}  // namespace
+
+Result<ZarrArrayToArrayCodec::PreparedState::Ptr> ZarrElementwiseCodec::Prepare(
+    span<const Index> decoded_shape) const {
+  auto state = internal::MakeIntrusivePtr<ElementwiseState>();
+  state->codec_ = this;
+  state->encoded_shape_.assign(decoded_shape.begin(), decoded_shape.end());
+  return state;
+}
+
+Result<SharedArray<const void>> ZarrElementwiseCodec::EncodeArray(
+    SharedArrayView<const void> decoded) const {
+  assert(decoded.dtype() == decoded_dtype_);
+  return TransformElements(
+      std::move(decoded), encoded_dtype_,
+      [&](const void* input, void* output, Index n) {
+        Encode(input, output, n);
+      });
+}
+
+Result<SharedArray<const void>> ZarrElementwiseCodec::DecodeArray(
+    SharedArrayView<const void> encoded) const {
+  assert(encoded.dtype() == encoded_dtype_);
+  return TransformElements(
+      std::move(encoded), decoded_dtype_,
+      [&](const void* input, void* output, Index n) {
+        Decode(input, output, n);
+      });
+}
+
+absl::Status ZarrElementwiseCodecSpec::PropagateDataTypeAndShape(
+    const ArrayDataTypeAndShapeInfo& decoded,
+    ArrayDataTypeAndShapeInfo& encoded) const {
+  encoded = decoded;
+  if (decoded.dtype.valid()) {
+    TENSORSTORE_ASSIGN_OR_RETURN(encoded.dtype,
+                                 GetEncodedDataType(decoded.dtype));
+  }
+  return absl::OkStatus();
+}
+
+absl::Status ZarrElementwiseCodecSpec::GetDecodedChunkLayout(
+    const ArrayDataTypeAndShapeInfo& encoded_info,
+    const ArrayCodecChunkLayoutInfo& encoded,
+    const ArrayDataTypeAndShapeInfo& decoded_info,
+    ArrayCodecChunkLayoutInfo& decoded) const {
+  decoded = encoded;
+  return absl::OkStatus();
+}
+
+Result<ZarrArrayToArrayCodec::Ptr> ZarrElementwiseCodecSpec::Resolve(
+    ArrayCodecResolveParameters&& decoded, ArrayCodecResolveParameters& encoded,
+    ZarrArrayToArrayCodecSpec::Ptr* resolved_spec) const {
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto codec, ResolveElementwise(decoded.dtype, resolved_spec));
+  encoded.dtype = codec->encoded_dtype();
+  encoded.rank = decoded.rank;
+  encoded.inner_shape = std::move(decoded.inner_shape);
+  if (decoded.fill_value.valid()) {
+    TENSORSTORE_ASSIGN_OR_RETURN(encoded.fill_value,
+                                 codec->EncodeArray(decoded.fill_value));
+  }
+  encoded.read_chunk_shape = decoded.read_chunk_shape;
+  encoded.codec_chunk_shape = decoded.codec_chunk_shape;
+  encoded.inner_order = decoded.inner_order;
+  return codec;
+}
+
+}  // namespace internal_zarr3
+}  // namespace tensorstore
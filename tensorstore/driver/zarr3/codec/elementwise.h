@@ -0,0 +1,106 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_DRIVER_ZARR3_CODEC_ELEMENTWISE_H_
+#define TENSORSTORE_DRIVER_ZARR3_CODEC_ELEMENTWISE_H_
+
+#include "absl/status/status.h"
+#include "tensorstore/array.h"
+#include "tensorstore/data_type.h"
+#include "tensorstore/driver/zarr3/codec/codec.h"
+#include "tensorstore/driver/zarr3/codec/codec_spec.h"
+#include "tensorstore/index.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
+
+namespace tensorstore {
+namespace internal_zarr3 {
+
+// Base class for "array -> array" codecs that transform each element value,
+// possibly to a different data type, but preserve the shape.
+//
+// Derived classes only define the transformation of contiguous buffers of
+// elements.  Because element values are transformed, these codecs must be
+// applied to complete chunks, and cannot precede a sharding codec.
+class ZarrElementwiseCodec : public ZarrArrayToArrayCodec {
+ public:
+  explicit ZarrElementwiseCodec(DataType decoded_dtype,
+                                DataType encoded_dtype)
+      : decoded_dtype_(decoded_dtype), encoded_dtype_(encoded_dtype) {}
+
+  bool transforms_values() const final { return true; }
+
+  Result<PreparedState::Ptr> Prepare(
+      span<const Index> decoded_shape) const final;
+
+  // Encodes an array of any shape and layout.
+  //
+  // This is also used by `Resolve` to encode the fill value.
+  Result<SharedArray<const void>> EncodeArray(
+      SharedArrayView<const void> decoded) const;
+
+  // Decodes an array of any shape and layout.
+  Result<SharedArray<const void>> DecodeArray(
+      SharedArrayView<const void> encoded) const;
+
+  DataType decoded_dtype() const { return decoded_dtype_; }
+  DataType encoded_dtype() const { return encoded_dtype_; }
+
+ protected:
+  // Encodes the `n` contiguous elements of `decoded` to `encoded`.
+  virtual void Encode(const void* decoded, void* encoded, Index n) const = 0;
+
+  // Decodes the `n` contiguous elements of `encoded` to `decoded`.
+  virtual void Decode(const void* encoded, void* decoded, Index n) const = 0;
+
+ private:
+  DataType decoded_dtype_;
+  DataType encoded_dtype_;
+};
+
+// Base class for specs of `ZarrElementwiseCodec` codecs.
+class ZarrElementwiseCodecSpec : public ZarrArrayToArrayCodecSpec {
+ public:
+  absl::Status PropagateDataTypeAndShape(
+      const ArrayDataTypeAndShapeInfo& decoded,
+      ArrayDataTypeAndShapeInfo& encoded) const final;
+
+  absl::Status GetDecodedChunkLayout(
+      const ArrayDataTypeAndShapeInfo& encoded_info,
+      const ArrayCodecChunkLayoutInfo& encoded,
+      const ArrayDataTypeAndShapeInfo& decoded_info,
+      ArrayCodecChunkLayoutInfo& decoded) const final;
+
+  Result<ZarrArrayToArrayCodec::Ptr> Resolve(
+      ArrayCodecResolveParameters&& decoded,
+      ArrayCodecResolveParameters& encoded,
+      ZarrArrayToArrayCodecSpec::Ptr* resolved_spec) const final;
+
+ protected:
+  // Returns the encoded data type, or an error if `decoded_dtype` is not
+  // supported.
+  virtual Result<DataType> GetEncodedDataType(DataType decoded_dtype) const = 0;
+
+  // Returns the codec for `decoded_dtype`, and sets `*resolved_spec` if
+  // `resolved_spec` is not null.
+  virtual Result<internal::IntrusivePtr<const ZarrElementwiseCodec>>
+  ResolveElementwise(DataType decoded_dtype,
+                     ZarrArrayToArrayCodecSpec::Ptr* resolved_spec) const = 0;
+};
+
+}  // namespace internal_zarr3
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_DRIVER_ZARR3_CODEC_ELEMENTWISE_H_
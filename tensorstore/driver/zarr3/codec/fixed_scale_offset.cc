@@ -0,0 +1,268 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/driver/zarr3/codec/fixed_scale_offset.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <type_traits>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_format.h"
+#include "tensorstore/data_type.h"
+#include "tensorstore/driver/zarr3/codec/codec_spec.h"
+#include "tensorstore/driver/zarr3/codec/elementwise.h"
+#include "tensorstore/driver/zarr3/codec/registry.h"
+#include "tensorstore/index.h"
+#include "tensorstore/internal/global_initializer.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/json_binding/data_type.h"
+#include "tensorstore/internal/json_binding/json_binding.h"
+#include "tensorstore/internal/json_binding/std_optional.h"  // IWYU pragma: keep
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/status.h"
+
+namespace tensorstore {
+namespace internal_zarr3 {
+namespace {
+
+template <typename T>
+double ToDouble(T x) {
+  if constexpr (std::is_arithmetic_v<T>) {
+    return static_cast<double>(x);
+  } else {
+    return static_cast<float>(x);
+  }
+}
+
+// Converts to `T`, truncating towards zero if `T` is an integer type, like
+// `numpy.ndarray.astype`.
+//
+// NumPy leaves the result of converting NaN or an out-of-range value to an
+// integer type platform-dependent; here NaN is converted to 0 and out-of-range
+// values saturate.
+template <typename T>
+T FromDouble(double x) {
+  if constexpr (std::is_integral_v<T>) {
+    constexpr double kMin = static_cast<double>(std::numeric_limits<T>::min());
+    constexpr double kMax = static_cast<double>(std::numeric_limits<T>::max());
+    if (std::isnan(x)) return 0;
+    if (x <= kMin) return std::numeric_limits<T>::min();
+    // For 64-bit types, `kMax` is rounded up to a power of 2, which is out of
+    // range.
+    if (x >= kMax) return std::numeric_limits<T>::max();
+    return static_cast<T>(x);
+  } else if constexpr (std::is_arithmetic_v<T>) {
+    return static_cast<T>(x);
+  } else {
+    return static_cast<T>(static_cast<float>(x));
+  }
+}
+
+template <typename T>
+void LoadDoubles(const void* source, double* dest, Index n) {
+  const T* in = static_cast<const T*>(source);
+  for (Index i = 0; i < n; ++i) dest[i] = ToDouble(in[i]);
+}
+
+template <typename T>
+void StoreDoubles(const double* source, void* dest, Index n) {
+  T* out = static_cast<T*>(dest);
+  for (Index i = 0; i < n; ++i) out[i] = FromDouble<T>(source[i]);
+}
+
+// Converts between a supported data type and `double`.
+struct DoubleConversions {
+  void (*load)(const void* source, double* dest, Index n);
+  void (*store)(const double* source, void* dest, Index n);
+};
+
+std::optional<DoubleConversions> GetDoubleConversions(DataType dtype) {
+  switch (dtype.id()) {
+#define TENSORSTORE_INTERNAL_DO_CONVERSIONS(T, ...)                    \
+  case DataTypeId::T:                                                  \
+    return DoubleConversions{&LoadDoubles<::tensorstore::dtypes::T>,   \
+                             &StoreDoubles<::tensorstore::dtypes::T>}; \
+    /**/
+    TENSORSTORE_INTERNAL_DO_CONVERSIONS(int8_t)
+    TENSORSTORE_INTERNAL_DO_CONVERSIONS(uint8_t)
+    TENSORSTORE_INTERNAL_DO_CONVERSIONS(int16_t)
+    TENSORSTORE_INTERNAL_DO_CONVERSIONS(uint16_t)
+    TENSORSTORE_INTERNAL_DO_CONVERSIONS(int32_t)
+    TENSORSTORE_INTERNAL_DO_CONVERSIONS(uint32_t)
+    TENSORSTORE_INTERNAL_DO_CONVERSIONS(int64_t)
+    TENSORSTORE_INTERNAL_DO_CONVERSIONS(uint64_t)
+    TENSORSTORE_INTERNAL_DO_CONVERSIONS(float16_t)
+    TENSORSTORE_INTERNAL_DO_CONVERSIONS(bfloat16_t)
+    TENSORSTORE_INTERNAL_DO_CONVERSIONS(float32_t)
+    TENSORSTORE_INTERNAL_DO_CONVERSIONS(float64_t)
+#undef TENSORSTORE_INTERNAL_DO_CONVERSIONS
+    default:
+      return std::nullopt;
+  }
+}
+
+absl::Status ValidateDataType(DataType dtype) {
+  if (!GetDoubleConversions(dtype)) {
+    return absl::InvalidArgumentError(absl::StrFormat(
+        "Fixedscaleoffset codec does not support data type %v", dtype));
+  }
+  return absl::OkStatus();
+}
+
+// Encodes `round((x - offset) * scale)` and decodes `x / scale + offset`, like
+// the numcodecs `FixedScaleOffset` codec.  As in numcodecs, encoding rounds to
+// the nearest integer (ties to even), while decoding to an integer data type
+// truncates towards zero.
+//
+// Elements are processed in blocks via an intermediate `double` buffer, which
+// requires only one instantiation per data type, rather than one per pair of
+// decoded and encoded data types.
+class FixedScaleOffsetCodec : public ZarrElementwiseCodec {
+ public:
+  explicit FixedScaleOffsetCodec(DataType decoded_dtype, DataType encoded_dtype,
+                                 double offset, double scale)
+      : ZarrElementwiseCodec(decoded_dtype, encoded_dtype),
+        decoded_conversions_(*GetDoubleConversions(decoded_dtype)),
+        encoded_conversions_(*GetDoubleConversions(encoded_dtype)),
+        offset_(offset),
+        scale_(scale) {}
+
+ protected:
+  void Encode(const void* decoded, void* encoded, Index n) const final {
+    const Index decoded_size = decoded_dtype().size();
+    const Index encoded_size = encoded_dtype().size();
+    double buffer[kBlockSize];
+    for (Index i = 0; i < n; i += kBlockSize) {
+      const Index block_size = std::min(kBlockSize, n - i);
+      decoded_conversions_.load(
+          static_cast<const char*>(decoded) + i * decoded_size, buffer,
+          block_size);
+      for (Index j = 0; j < block_size; ++j) {
+        buffer[j] = std::nearbyint((buffer[j] - offset_) * scale_);
+      }
+      encoded_conversions_.store(
+          buffer, static_cast<char*>(encoded) + i * encoded_size, block_size);
+    }
+  }
+
+  void Decode(const void* encoded, void* decoded, Index n) const final {
+    const Index decoded_size = decoded_dtype().size();
+    const Index encoded_size = encoded_dtype().size();
+    double buffer[kBlockSize];
+    for (Index i = 0; i < n; i += kBlockSize) {
+      const Index block_size = std::min(kBlockSize, n - i);
+      encoded_conversions_.load(
+          static_cast<const char*>(encoded) + i * encoded_size, buffer,
+          block_size);
+      for (Index j = 0; j < block_size; ++j) {
+        buffer[j] = buffer[j] / scale_ + offset_;
+      }
+      decoded_conversions_.store(
+          buffer, static_cast<char*>(decoded) + i * decoded_size, block_size);
+    }
+  }
+
+ private:
+  static constexpr Index kBlockSize = 1024;
+
+  DoubleConversions decoded_conversions_;
+  DoubleConversions encoded_conversions_;
+  double offset_;
+  double scale_;
+};
+
+constexpr auto FiniteNumberBinder(bool nonzero) {
+  namespace jb = ::tensorstore::internal_json_binding;
+  return jb::Validate([nonzero](const auto& options, double* x) {
+    if (!std::isfinite(*x) || (nonzero && *x == 0)) {
+      return absl::InvalidArgumentError(
+          absl::StrFormat("Expected %s number, but received: %v",
+                          nonzero ? "finite non-zero" : "finite", *x));
+    }
+    return absl::OkStatus();
+  });
+}
+
+}  // namespace
+
+absl::Status FixedScaleOffsetCodecSpec::MergeFrom(const ZarrCodecSpec& other,
+                                                  bool strict) {
+  using Self = FixedScaleOffsetCodecSpec;
+  const auto& other_options = static_cast<const Self&>(other).options;
+  TENSORSTORE_RETURN_IF_ERROR(
+      MergeConstraint<&Options::offset>("offset", options, other_options));
+  TENSORSTORE_RETURN_IF_ERROR(
+      MergeConstraint<&Options::scale>("scale", options, other_options));
+  TENSORSTORE_RETURN_IF_ERROR(
+      MergeConstraint<&Options::astype>("astype", options, other_options));
+  return absl::OkStatus();
+}
+
+ZarrCodecSpec::Ptr FixedScaleOffsetCodecSpec::Clone() const {
+  return internal::MakeIntrusivePtr<FixedScaleOffsetCodecSpec>(*this);
+}
+
+Result<DataType> FixedScaleOffsetCodecSpec::GetEncodedDataType(
+    DataType decoded_dtype) const {
+  TENSORSTORE_RETURN_IF_ERROR(ValidateDataType(decoded_dtype));
+  if (!options.astype) return decoded_dtype;
+  TENSORSTORE_RETURN_IF_ERROR(ValidateDataType(*options.astype));
+  return *options.astype;
+}
+
+Result<internal::IntrusivePtr<const ZarrElementwiseCodec>>
+FixedScaleOffsetCodecSpec::ResolveElementwise(
+    DataType decoded_dtype,
+    ZarrArrayToArrayCodecSpec::Ptr* resolved_spec) const {
+  TENSORSTORE_ASSIGN_OR_RETURN(auto encoded_dtype,
+                               GetEncodedDataType(decoded_dtype));
+  if (!options.scale) {
+    return absl::InvalidArgumentError("\"scale\" must be specified");
+  }
+  const double offset = options.offset.value_or(0);
+  if (resolved_spec) {
+    resolved_spec->reset(new FixedScaleOffsetCodecSpec(
+        Options{offset, *options.scale, encoded_dtype}));
+  }
+  return internal::MakeIntrusivePtr<FixedScaleOffsetCodec>(
+      decoded_dtype, encoded_dtype, offset, *options.scale);
+}
+
+TENSORSTORE_GLOBAL_INITIALIZER {
+  using Self = FixedScaleOffsetCodecSpec;
+  using Options = Self::Options;
+  namespace jb = ::tensorstore::internal_json_binding;
+  RegisterCodec<Self>(
+      "fixedscaleoffset",
+      jb::Projection<&Self::options>(jb::Sequence(
+          jb::Member("offset", jb::Projection<&Options::offset>(
+                                   OptionalIfConstraintsBinder(
+                                       FiniteNumberBinder(/*nonzero=*/false)))),
+          jb::Member("scale", jb::Projection<&Options::scale>(
+                                  OptionalIfConstraintsBinder(
+                                      FiniteNumberBinder(/*nonzero=*/true)))),
+          jb::Member("astype",
+                     jb::Projection<&Options::astype>(
+                         OptionalIfConstraintsBinder(jb::DataTypeJsonBinder)))
+          //
+          )));
+}
+
+}  // namespace internal_zarr3
+}  // namespace tensorstore
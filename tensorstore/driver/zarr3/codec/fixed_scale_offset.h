@@ -0,0 +1,56 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_DRIVER_ZARR3_CODEC_FIXED_SCALE_OFFSET_H_
+#define TENSORSTORE_DRIVER_ZARR3_CODEC_FIXED_SCALE_OFFSET_H_
+
+#include <optional>
+
+#include "absl/status/status.h"
+#include "tensorstore/data_type.h"
+#include "tensorstore/driver/zarr3/codec/codec_spec.h"
+#include "tensorstore/driver/zarr3/codec/elementwise.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/util/result.h"
+
+namespace tensorstore {
+namespace internal_zarr3 {
+
+class FixedScaleOffsetCodecSpec : public ZarrElementwiseCodecSpec {
+ public:
+  struct Options {
+    std::optional<double> offset;
+    std::optional<double> scale;
+    // Encoded data type, defaults to the decoded data type.
+    std::optional<DataType> astype;
+  };
+  FixedScaleOffsetCodecSpec() = default;
+  explicit FixedScaleOffsetCodecSpec(const Options& options)
+      : options(options) {}
+  absl::Status MergeFrom(const ZarrCodecSpec& other, bool strict) override;
+  ZarrCodecSpec::Ptr Clone() const override;
+
+  Options options;
+
+ protected:
+  Result<DataType> GetEncodedDataType(DataType decoded_dtype) const final;
+  Result<internal::IntrusivePtr<const ZarrElementwiseCodec>> ResolveElementwise(
+      DataType decoded_dtype,
+      ZarrArrayToArrayCodecSpec::Ptr* resolved_spec) const final;
+};
+
+}  // namespace internal_zarr3
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_DRIVER_ZARR3_CODEC_FIXED_SCALE_OFFSET_H_
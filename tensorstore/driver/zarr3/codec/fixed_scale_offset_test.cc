@@ -0,0 +1,203 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "tensorstore/array.h"
+#include "tensorstore/array_testutil.h"
+#include "tensorstore/data_type.h"
+#include "tensorstore/driver/zarr3/codec/codec_chain_spec.h"
+#include "tensorstore/driver/zarr3/codec/codec_test_util.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::dtype_v;
+using ::tensorstore::MakeArray;
+using ::tensorstore::MatchesArrayIdentically;
+using ::tensorstore::StatusIs;
+using ::tensorstore::internal_zarr3::CodecRoundTripTestParams;
+using ::tensorstore::internal_zarr3::CodecSpecRoundTripTestParams;
+using ::tensorstore::internal_zarr3::GetDefaultBytesCodecJson;
+using ::tensorstore::internal_zarr3::TestArrayToArrayRoundTrip;
+using ::tensorstore::internal_zarr3::TestCodecMerge;
+using ::tensorstore::internal_zarr3::TestCodecRoundTrip;
+using ::tensorstore::internal_zarr3::TestCodecSpecResolve;
+using ::tensorstore::internal_zarr3::TestCodecSpecRoundTrip;
+using ::tensorstore::internal_zarr3::ZarrCodecChainSpec;
+using ::testing::HasSubstr;
+
+TEST(FixedScaleOffsetTest, Basic) {
+  CodecSpecRoundTripTestParams p;
+  p.resolve_params.dtype = dtype_v<double>;
+  p.orig_spec = {
+      {{"name", "fixedscaleoffset"},
+       {"configuration", {{"scale", 100}, {"astype", "int16"}}}},
+  };
+  p.expected_spec = {
+      {{"name", "fixedscaleoffset"},
+       {"configuration",
+        {{"offset", 0.0}, {"scale", 100.0}, {"astype", "int16"}}}},
+      GetDefaultBytesCodecJson(),
+  };
+  TestCodecSpecRoundTrip(p);
+}
+
+TEST(FixedScaleOffsetTest, DefaultAstype) {
+  CodecSpecRoundTripTestParams p;
+  p.orig_spec = {
+      {{"name", "fixedscaleoffset"},
+       {"configuration", {{"offset", 5}, {"scale", 2}}}},
+  };
+  p.expected_spec = {
+      {{"name", "fixedscaleoffset"},
+       {"configuration",
+        {{"offset", 5.0}, {"scale", 2.0}, {"astype", "uint16"}}}},
+      GetDefaultBytesCodecJson(),
+  };
+  TestCodecSpecRoundTrip(p);
+}
+
+TEST(FixedScaleOffsetTest, EncodedValues) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto result,
+      TestArrayToArrayRoundTrip(
+          {{{"name", "fixedscaleoffset"},
+            {"configuration",
+             {{"offset", 1000}, {"scale", 100}, {"astype", "int16"}}}}},
+          MakeArray<double>({1000.5, 1001.237, 999})));
+  EXPECT_THAT(result.encoded,
+              MatchesArrayIdentically(MakeArray<int16_t>({50, 124, -100})));
+  EXPECT_THAT(result.decoded,
+              MatchesArrayIdentically(
+                  MakeArray<double>({1000.5, 124.0 / 100 + 1000, 999})));
+}
+
+TEST(FixedScaleOffsetTest, Saturation) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto result,
+      TestArrayToArrayRoundTrip(
+          {{{"name", "fixedscaleoffset"},
+            {"configuration",
+             {{"offset", 0}, {"scale", 1}, {"astype", "uint8"}}}}},
+          MakeArray<float>({-1.0f, 254.6f, 1e10f})));
+  EXPECT_THAT(result.encoded,
+              MatchesArrayIdentically(MakeArray<uint8_t>({0, 255, 255})));
+}
+
+TEST(FixedScaleOffsetTest, IntegerRounding) {
+  // Encoding rounds to the nearest integer, with ties to even, while decoding
+  // to an integer type truncates towards zero, like `numpy.ndarray.astype`.
+  // The expected values are the output of:
+  //
+  //   codec = numcodecs.FixedScaleOffset(
+  //       offset=0.5, scale=1, dtype='i4', astype='i1')
+  //   codec.encode(np.array([7, -7, 8, 2, -2], dtype='i4'))
+  //   codec.decode(codec.encode(...))
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto result,
+      TestArrayToArrayRoundTrip(
+          {{{"name", "fixedscaleoffset"},
+            {"configuration",
+             {{"offset", 0.5}, {"scale", 1}, {"astype", "int8"}}}}},
+          MakeArray<int32_t>({7, -7, 8, 2, -2})));
+  EXPECT_THAT(result.encoded,
+              MatchesArrayIdentically(MakeArray<int8_t>({6, -8, 8, 2, -2})));
+  EXPECT_THAT(result.decoded,
+              MatchesArrayIdentically(MakeArray<int32_t>({6, -7, 8, 2, -1})));
+}
+
+TEST(FixedScaleOffsetTest, MatchesNumcodecs) {
+  // Example from the numcodecs `FixedScaleOffset` documentation:
+  //
+  //   x = np.linspace(1000, 1001, 10, dtype='f8')
+  //   codec = numcodecs.FixedScaleOffset(
+  //       offset=1000, scale=10, dtype='f8', astype='u1')
+  //   codec.encode(x)
+  //   # array([ 0,  1,  2,  3,  4,  6,  7,  8,  9, 10], dtype=uint8)
+  //   codec.decode(codec.encode(x))
+  //   # array([1000. , 1000.1, 1000.2, 1000.3, 1000.4, 1000.6, 1000.7,
+  //   #        1000.8, 1000.9, 1001. ])
+  auto x = tensorstore::AllocateArray<double>({10});
+  for (int i = 0; i < 10; ++i) x(i) = 1000 + i * (1.0 / 9);
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto result,
+      TestArrayToArrayRoundTrip(
+          {{{"name", "fixedscaleoffset"},
+            {"configuration",
+             {{"offset", 1000}, {"scale", 10}, {"astype", "uint8"}}}}},
+          x));
+  const uint8_t expected_encoded[] = {0, 1, 2, 3, 4, 6, 7, 8, 9, 10};
+  auto expected_decoded = tensorstore::AllocateArray<double>({10});
+  for (int i = 0; i < 10; ++i) {
+    expected_decoded(i) = expected_encoded[i] / 10.0 + 1000;
+  }
+  EXPECT_THAT(result.encoded, MatchesArrayIdentically(
+                                  MakeArray<uint8_t>(expected_encoded)));
+  EXPECT_THAT(result.decoded, MatchesArrayIdentically(expected_decoded));
+}
+
+TEST(FixedScaleOffsetTest, RoundTrip) {
+  // Lossless for integer data with a `scale` of 1, provided that the encoded
+  // values are in range.
+  CodecRoundTripTestParams p;
+  p.dtype = dtype_v<int32_t>;
+  p.spec = {
+      {{"name", "fixedscaleoffset"},
+       {"configuration",
+        {{"offset", 100}, {"scale", 1}, {"astype", "int64"}}}},
+      "zstd",
+  };
+  TestCodecRoundTrip(p);
+}
+
+TEST(FixedScaleOffsetTest, ScaleRequired) {
+  CodecSpecRoundTripTestParams p;
+  EXPECT_THAT(TestCodecSpecResolve({"fixedscaleoffset"}, p.resolve_params),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       HasSubstr("\"scale\" must be specified")));
+}
+
+TEST(FixedScaleOffsetTest, InvalidScale) {
+  EXPECT_THAT(
+      ZarrCodecChainSpec::FromJson({{{"name", "fixedscaleoffset"},
+                                     {"configuration", {{"scale", 0}}}}}),
+      StatusIs(absl::StatusCode::kInvalidArgument, HasSubstr("\"scale\"")));
+}
+
+TEST(FixedScaleOffsetTest, UnsupportedAstype) {
+  CodecSpecRoundTripTestParams p;
+  EXPECT_THAT(
+      TestCodecSpecResolve(
+          {{{"name", "fixedscaleoffset"},
+            {"configuration", {{"scale", 1}, {"astype", "complex64"}}}}},
+          p.resolve_params),
+      StatusIs(absl::StatusCode::kInvalidArgument,
+               HasSubstr("does not support data type complex64")));
+}
+
+TEST(FixedScaleOffsetTest, MergeScaleMismatch) {
+  EXPECT_THAT(TestCodecMerge({{{"name", "fixedscaleoffset"},
+                               {"configuration", {{"scale", 1}}}}},
+                             {{{"name", "fixedscaleoffset"},
+                               {"configuration", {{"scale", 2}}}}},
+                             /*strict=*/true),
+              StatusIs(absl::StatusCode::kFailedPrecondition,
+                       HasSubstr("\"scale\"")));
+}
+
+}  // namespace
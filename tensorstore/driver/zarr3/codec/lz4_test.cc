@@ -0,0 +1,126 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "tensorstore/driver/zarr3/codec/codec_chain_spec.h"
+#include "tensorstore/driver/zarr3/codec/codec_test_util.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::StatusIs;
+using ::tensorstore::internal_zarr3::CodecRoundTripTestParams;
+using ::tensorstore::internal_zarr3::CodecSpecRoundTripTestParams;
+using ::tensorstore::internal_zarr3::GetDefaultBytesCodecJson;
+using ::tensorstore::internal_zarr3::TestCodecRoundTrip;
+using ::tensorstore::internal_zarr3::TestCodecSpecResolve;
+using ::tensorstore::internal_zarr3::TestCodecSpecRoundTrip;
+using ::tensorstore::internal_zarr3::ZarrCodecChainSpec;
+using ::testing::HasSubstr;
+
+TEST(Lz4Test, EndianInferred) {
+  CodecSpecRoundTripTestParams p;
+  p.orig_spec = {
+      {{"name", "lz4"}, {"configuration", {{"level", 7}}}},
+  };
+  p.expected_spec = {
+      GetDefaultBytesCodecJson(),
+      {{"name", "lz4"},
+       {"configuration", {{"level", 7}, {"checksum", false}}}},
+  };
+  TestCodecSpecRoundTrip(p);
+}
+
+TEST(Lz4Test, Checksum) {
+  CodecSpecRoundTripTestParams p;
+  p.orig_spec = {
+      {{"name", "lz4"}, {"configuration", {{"level", 7}, {"checksum", true}}}},
+  };
+  p.expected_spec = {
+      GetDefaultBytesCodecJson(),
+      {{"name", "lz4"}, {"configuration", {{"level", 7}, {"checksum", true}}}},
+  };
+  TestCodecSpecRoundTrip(p);
+}
+
+TEST(Lz4Test, ChecksumOptionalInMetadata) {
+  CodecSpecRoundTripTestParams p;
+  p.from_json_options.constraints = false;
+  p.orig_spec = {
+      GetDefaultBytesCodecJson(),
+      {{"name", "lz4"}, {"configuration", {{"level", 7}}}},
+  };
+  p.expected_spec = {
+      GetDefaultBytesCodecJson(),
+      {{"name", "lz4"},
+       {"configuration", {{"level", 7}, {"checksum", false}}}},
+  };
+  TestCodecSpecRoundTrip(p);
+}
+
+TEST(Lz4Test, LevelRequiredInMetadata) {
+  CodecSpecRoundTripTestParams p;
+  EXPECT_THAT(
+      TestCodecSpecResolve(
+          {
+              GetDefaultBytesCodecJson(),
+              {{"name", "lz4"}},
+          },
+          p.resolve_params, /*constraints=*/false),
+      StatusIs(absl::StatusCode::kInvalidArgument, HasSubstr("\"level\"")));
+}
+
+TEST(Lz4Test, DefaultLevel) {
+  CodecSpecRoundTripTestParams p;
+  p.orig_spec = {
+      {{"name", "lz4"}},
+  };
+  p.expected_spec = {
+      GetDefaultBytesCodecJson(),
+      {{"name", "lz4"},
+       {"configuration", {{"level", 0}, {"checksum", false}}}},
+  };
+  TestCodecSpecRoundTrip(p);
+}
+
+TEST(Lz4Test, RoundTrip) {
+  CodecRoundTripTestParams p;
+  p.spec = {"lz4"};
+  TestCodecRoundTrip(p);
+}
+
+TEST(Lz4Test, RoundTripHighCompression) {
+  CodecRoundTripTestParams p;
+  p.spec = {{{"name", "lz4"}, {"configuration", {{"level", 9}}}}};
+  TestCodecRoundTrip(p);
+}
+
+TEST(Lz4Test, RoundTripAcceleration) {
+  CodecRoundTripTestParams p;
+  p.spec = {{{"name", "lz4"},
+             {"configuration", {{"level", -8}, {"checksum", true}}}}};
+  TestCodecRoundTrip(p);
+}
+
+TEST(Lz4Test, InvalidLevel) {
+  EXPECT_THAT(
+      ZarrCodecChainSpec::FromJson(
+          {{{"name", "lz4"}, {"configuration", {{"level", 13}}}}}),
+      StatusIs(absl::StatusCode::kInvalidArgument,
+               HasSubstr("Error parsing object member \"level\"")));
+}
+
+}  // namespace
@@ -0,0 +1,150 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/driver/zarr3/codec/quantize.h"
+
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_format.h"
+#include "tensorstore/data_type.h"
+#include "tensorstore/driver/zarr3/codec/codec_spec.h"
+#include "tensorstore/driver/zarr3/codec/elementwise.h"
+#include "tensorstore/driver/zarr3/codec/registry.h"
+#include "tensorstore/index.h"
+#include "tensorstore/internal/global_initializer.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/json_binding/json_binding.h"
+#include "tensorstore/internal/json_binding/std_optional.h"  // IWYU pragma: keep
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/status.h"
+
+namespace tensorstore {
+namespace internal_zarr3 {
+namespace {
+
+constexpr int kMaxDigits = 30;
+
+// Rounds each value to the nearest multiple of `1 / scale`, where `scale` is a
+// power of 2.  Multiplying and dividing by a power of 2 is exact, so only the
+// rounding introduces error.
+template <typename T>
+void Quantize(const void* decoded, void* encoded, Index n, double scale) {
+  // Computing in `float` rather than `double` for all but `float64` values
+  // permits twice the vector width, and matches numpy for `float32` values.
+  using Compute =
+      std::conditional_t<std::is_same_v<T, dtypes::float64_t>, double, float>;
+  const T* in = static_cast<const T*>(decoded);
+  T* out = static_cast<T*>(encoded);
+  const Compute s = static_cast<Compute>(scale);
+  const Compute inv_s = static_cast<Compute>(1 / scale);
+  for (Index i = 0; i < n; ++i) {
+    out[i] = static_cast<T>(
+        std::nearbyint(static_cast<Compute>(in[i]) * s) * inv_s);
+  }
+}
+
+class QuantizeCodec : public ZarrElementwiseCodec {
+ public:
+  explicit QuantizeCodec(DataType dtype, int digits)
+      : ZarrElementwiseCodec(dtype, dtype) {
+    // Same computation as numcodecs.
+    const double bits = std::ceil(std::log2(std::pow(10.0, digits)));
+    scale_ = std::ldexp(1.0, static_cast<int>(bits));
+  }
+
+ protected:
+  void Encode(const void* decoded, void* encoded, Index n) const final {
+    switch (decoded_dtype().id()) {
+      case DataTypeId::float16_t:
+        return Quantize<dtypes::float16_t>(decoded, encoded, n, scale_);
+      case DataTypeId::bfloat16_t:
+        return Quantize<dtypes::bfloat16_t>(decoded, encoded, n, scale_);
+      case DataTypeId::float32_t:
+        return Quantize<dtypes::float32_t>(decoded, encoded, n, scale_);
+      case DataTypeId::float64_t:
+        return Quantize<dtypes::float64_t>(decoded, encoded, n, scale_);
+      default:
+        break;
+    }
+  }
+
+  void Decode(const void* encoded, void* decoded, Index n) const final {
+    std::memcpy(decoded, encoded, n * decoded_dtype().size());
+  }
+
+ private:
+  double scale_;
+};
+
+}  // namespace
+
+absl::Status QuantizeCodecSpec::MergeFrom(const ZarrCodecSpec& other,
+                                          bool strict) {
+  using Self = QuantizeCodecSpec;
+  const auto& other_options = static_cast<const Self&>(other).options;
+  TENSORSTORE_RETURN_IF_ERROR(
+      MergeConstraint<&Options::digits>("digits", options, other_options));
+  return absl::OkStatus();
+}
+
+ZarrCodecSpec::Ptr QuantizeCodecSpec::Clone() const {
+  return internal::MakeIntrusivePtr<QuantizeCodecSpec>(*this);
+}
+
+Result<DataType> QuantizeCodecSpec::GetEncodedDataType(
+    DataType decoded_dtype) const {
+  switch (decoded_dtype.id()) {
+    case DataTypeId::float16_t:
+    case DataTypeId::bfloat16_t:
+    case DataTypeId::float32_t:
+    case DataTypeId::float64_t:
+      return decoded_dtype;
+    default:
+      return absl::InvalidArgumentError(absl::StrFormat(
+          "Quantize codec does not support data type %v", decoded_dtype));
+  }
+}
+
+Result<internal::IntrusivePtr<const ZarrElementwiseCodec>>
+QuantizeCodecSpec::ResolveElementwise(
+    DataType decoded_dtype,
+    ZarrArrayToArrayCodecSpec::Ptr* resolved_spec) const {
+  TENSORSTORE_RETURN_IF_ERROR(GetEncodedDataType(decoded_dtype));
+  if (!options.digits) {
+    return absl::InvalidArgumentError("\"digits\" must be specified");
+  }
+  if (resolved_spec) {
+    resolved_spec->reset(this);
+  }
+  return internal::MakeIntrusivePtr<QuantizeCodec>(decoded_dtype,
+                                                   *options.digits);
+}
+
+TENSORSTORE_GLOBAL_INITIALIZER {
+  using Self = QuantizeCodecSpec;
+  using Options = Self::Options;
+  namespace jb = ::tensorstore::internal_json_binding;
+  RegisterCodec<Self>(
+      "quantize",
+      jb::Projection<&Self::options>(jb::Sequence(jb::Member(
+          "digits", jb::Projection<&Options::digits>(
+                        OptionalIfConstraintsBinder(
+                            jb::Integer<int>(-kMaxDigits, kMaxDigits)))))));
+}
+
+}  // namespace internal_zarr3
+}  // namespace tensorstore
@@ -0,0 +1,114 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "tensorstore/array.h"
+#include "tensorstore/array_testutil.h"
+#include "tensorstore/data_type.h"
+#include "tensorstore/driver/zarr3/codec/codec_chain_spec.h"
+#include "tensorstore/driver/zarr3/codec/codec_test_util.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::dtype_v;
+using ::tensorstore::MakeArray;
+using ::tensorstore::MatchesArrayIdentically;
+using ::tensorstore::StatusIs;
+using ::tensorstore::internal_zarr3::CodecSpecRoundTripTestParams;
+using ::tensorstore::internal_zarr3::GetDefaultBytesCodecJson;
+using ::tensorstore::internal_zarr3::TestArrayToArrayRoundTrip;
+using ::tensorstore::internal_zarr3::TestCodecMerge;
+using ::tensorstore::internal_zarr3::TestCodecSpecResolve;
+using ::tensorstore::internal_zarr3::TestCodecSpecRoundTrip;
+using ::tensorstore::internal_zarr3::ZarrCodecChainSpec;
+using ::testing::HasSubstr;
+
+TEST(QuantizeTest, Basic) {
+  CodecSpecRoundTripTestParams p;
+  p.resolve_params.dtype = dtype_v<float>;
+  p.orig_spec = {
+      {{"name", "quantize"}, {"configuration", {{"digits", 2}}}},
+  };
+  p.expected_spec = {
+      {{"name", "quantize"}, {"configuration", {{"digits", 2}}}},
+      GetDefaultBytesCodecJson(),
+  };
+  TestCodecSpecRoundTrip(p);
+}
+
+TEST(QuantizeTest, EncodedValues) {
+  // With 2 digits, values are rounded to multiples of 1/128.
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto result,
+      TestArrayToArrayRoundTrip(
+          {{{"name", "quantize"}, {"configuration", {{"digits", 2}}}}},
+          MakeArray<double>({0.1, -2.345678, 1000.001})));
+  EXPECT_THAT(result.encoded,
+              MatchesArrayIdentically(MakeArray<double>(
+                  {13.0 / 128, -300.0 / 128, 128000.0 / 128})));
+  EXPECT_THAT(result.decoded, MatchesArrayIdentically(result.encoded));
+}
+
+TEST(QuantizeTest, Float32) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto result,
+      TestArrayToArrayRoundTrip(
+          {{{"name", "quantize"}, {"configuration", {{"digits", 1}}}}},
+          MakeArray<float>({0.26f, -1.5f})));
+  EXPECT_THAT(result.encoded,
+              MatchesArrayIdentically(MakeArray<float>({0.25f, -1.5f})));
+}
+
+TEST(QuantizeTest, DigitsRequired) {
+  CodecSpecRoundTripTestParams p;
+  p.resolve_params.dtype = dtype_v<float>;
+  EXPECT_THAT(TestCodecSpecResolve({"quantize"}, p.resolve_params),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       HasSubstr("\"digits\" must be specified")));
+  EXPECT_THAT(
+      TestCodecSpecResolve({{{"name", "quantize"}}, GetDefaultBytesCodecJson()},
+                           p.resolve_params, /*constraints=*/false),
+      StatusIs(absl::StatusCode::kInvalidArgument, HasSubstr("\"digits\"")));
+}
+
+TEST(QuantizeTest, InvalidDigits) {
+  EXPECT_THAT(
+      ZarrCodecChainSpec::FromJson(
+          {{{"name", "quantize"}, {"configuration", {{"digits", 31}}}}}),
+      StatusIs(absl::StatusCode::kInvalidArgument, HasSubstr("\"digits\"")));
+}
+
+TEST(QuantizeTest, UnsupportedDataType) {
+  CodecSpecRoundTripTestParams p;
+  EXPECT_THAT(
+      TestCodecSpecResolve(
+          {{{"name", "quantize"}, {"configuration", {{"digits", 2}}}}},
+          p.resolve_params),
+      StatusIs(absl::StatusCode::kInvalidArgument,
+               HasSubstr("does not support data type uint16")));
+}
+
+TEST(QuantizeTest, MergeDigitsMismatch) {
+  EXPECT_THAT(
+      TestCodecMerge(
+          {{{"name", "quantize"}, {"configuration", {{"digits", 2}}}}},
+          {{{"name", "quantize"}, {"configuration", {{"digits", 3}}}}},
+          /*strict=*/true),
+      StatusIs(absl::StatusCode::kFailedPrecondition, HasSubstr("\"digits\"")));
+}
+
+}  // namespace
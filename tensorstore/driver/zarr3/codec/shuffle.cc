@@ -0,0 +1,198 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/driver/zarr3/codec/shuffle.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "absl/base/optimization.h"
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/str_format.h"
+#include "riegeli/bytes/cord_writer.h"
+#include "riegeli/bytes/read_all.h"
+#include "riegeli/bytes/reader.h"
+#include "riegeli/bytes/string_reader.h"
+#include "riegeli/bytes/writer.h"
+#include "tensorstore/driver/zarr3/codec/codec.h"
+#include "tensorstore/driver/zarr3/codec/codec_spec.h"
+#include "tensorstore/driver/zarr3/codec/registry.h"
+#include "tensorstore/internal/compression/shuffle.h"
+#include "tensorstore/internal/global_initializer.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/json_binding/enum.h"
+#include "tensorstore/internal/json_binding/json_binding.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/status.h"
+
+namespace tensorstore {
+namespace internal_zarr3 {
+namespace {
+
+// Maximum supported `typesize`, same as for the "blosc" codec.
+constexpr size_t kMaxTypesize = 255;
+
+// Shuffles the decoded value into `base_writer`.
+//
+// Shuffling requires the entire value, so this buffers the decoded value.  The
+// buffered value is shuffled one chunk at a time, without flattening it.
+class ShuffleWriter : public riegeli::CordWriter<absl::Cord> {
+ public:
+  explicit ShuffleWriter(ShuffleMode mode, size_t typesize,
+                         riegeli::Writer& base_writer)
+      : CordWriter(riegeli::CordWriterBase::Options()),
+        mode_(mode),
+        typesize_(typesize),
+        base_writer_(base_writer) {}
+
+  void Done() override {
+    CordWriter::Done();
+    if (ABSL_PREDICT_FALSE(!ok())) return;
+    const absl::Cord& input = dest();
+    if (!base_writer_.Push(input.size())) {
+      Fail(base_writer_.status());
+      return;
+    }
+    if (mode_ == ShuffleMode::kBit) {
+      shuffle::BitShuffle(typesize_, input, base_writer_.cursor());
+    } else {
+      shuffle::ByteShuffle(typesize_, input, base_writer_.cursor());
+    }
+    base_writer_.move_cursor(input.size());
+  }
+
+ private:
+  ShuffleMode mode_;
+  size_t typesize_;
+  riegeli::Writer& base_writer_;
+};
+
+class ShuffleCodec : public ZarrBytesToBytesCodec {
+ public:
+  class State : public ZarrBytesToBytesCodec::PreparedState {
+   public:
+    int64_t encoded_size() const final { return decoded_size_; }
+
+    Result<std::unique_ptr<riegeli::Writer>> GetEncodeWriter(
+        riegeli::Writer& encoded_writer) const final {
+      return std::make_unique<ShuffleWriter>(codec_->mode, codec_->typesize,
+                                             encoded_writer);
+    }
+
+    Result<std::unique_ptr<riegeli::Reader>> GetDecodeReader(
+        riegeli::Reader& encoded_reader) const final {
+      // The encoded value is read as a cord, which shares the data of the
+      // underlying reader where possible, so that the only copy made is the
+      // unshuffled value.
+      absl::Cord encoded;
+      TENSORSTORE_RETURN_IF_ERROR(riegeli::ReadAll(encoded_reader, encoded));
+      std::string decoded(encoded.size(), '\0');
+      if (codec_->mode == ShuffleMode::kBit) {
+        shuffle::BitUnshuffle(codec_->typesize, encoded, decoded.data());
+      } else {
+        shuffle::ByteUnshuffle(codec_->typesize, encoded, decoded.data());
+      }
+      return std::make_unique<riegeli::StringReader<std::string>>(
+          std::move(decoded));
+    }
+
+    const ShuffleCodec* codec_;
+    int64_t decoded_size_;
+  };
+
+  Result<PreparedState::Ptr> Prepare(int64_t decoded_size) const final {
+    auto state = internal::MakeIntrusivePtr<State>();
+    state->codec_ = this;
+    state->decoded_size_ = decoded_size;
+    return state;
+  }
+
+  ShuffleMode mode;
+  size_t typesize;
+};
+
+constexpr auto ModeBinder() {
+  namespace jb = ::tensorstore::internal_json_binding;
+  return jb::Enum<ShuffleMode, std::string_view>({
+      {ShuffleMode::kByte, "byte"},
+      {ShuffleMode::kBit, "bit"},
+  });
+}
+
+}  // namespace
+
+absl::Status ShuffleCodecSpec::MergeFrom(const ZarrCodecSpec& other,
+                                         bool strict) {
+  using Self = ShuffleCodecSpec;
+  const auto& other_options = static_cast<const Self&>(other).options;
+  TENSORSTORE_RETURN_IF_ERROR(MergeConstraint<&Options::mode>(
+      "mode", options, other_options, ModeBinder()));
+  TENSORSTORE_RETURN_IF_ERROR(
+      MergeConstraint<&Options::typesize>("typesize", options, other_options));
+  return absl::OkStatus();
+}
+
+ZarrCodecSpec::Ptr ShuffleCodecSpec::Clone() const {
+  return internal::MakeIntrusivePtr<ShuffleCodecSpec>(*this);
+}
+
+Result<ZarrBytesToBytesCodec::Ptr> ShuffleCodecSpec::Resolve(
+    BytesCodecResolveParameters&& decoded, BytesCodecResolveParameters& encoded,
+    ZarrBytesToBytesCodecSpec::Ptr* resolved_spec) const {
+  auto codec = internal::MakeIntrusivePtr<ShuffleCodec>();
+  if (options.typesize) {
+    codec->typesize = *options.typesize;
+  } else if (decoded.item_bits > 0 && (decoded.item_bits % 8) == 0 &&
+             decoded.item_bits / 8 <= kMaxTypesize) {
+    codec->typesize = decoded.item_bits / 8;
+  } else {
+    return absl::InvalidArgumentError(
+        absl::StrFormat("typesize must be specified explicitly because "
+                        "inferred itemsize %d/8 is not supported",
+                        decoded.item_bits));
+  }
+  codec->mode = options.mode.value_or(
+      codec->typesize == 1 ? ShuffleMode::kBit : ShuffleMode::kByte);
+  if (resolved_spec) {
+    resolved_spec->reset(
+        new ShuffleCodecSpec(Options{codec->mode, codec->typesize}));
+  }
+  return codec;
+}
+
+TENSORSTORE_GLOBAL_INITIALIZER {
+  using Self = ShuffleCodecSpec;
+  using Options = Self::Options;
+  namespace jb = ::tensorstore::internal_json_binding;
+  RegisterCodec<Self>(
+      "shuffle",
+      jb::Projection<&Self::options>(jb::Sequence(
+          jb::Member("mode", jb::Projection<&Options::mode>(
+                                 OptionalIfConstraintsBinder(ModeBinder()))),
+          jb::Member("typesize",
+                     jb::Projection<&Options::typesize>(
+                         OptionalIfConstraintsBinder(
+                             jb::Integer<size_t>(1, kMaxTypesize))))  //
+          )));
+}
+
+}  // namespace internal_zarr3
+}  // namespace tensorstore
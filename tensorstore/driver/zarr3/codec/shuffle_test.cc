@@ -0,0 +1,133 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "tensorstore/data_type.h"
+#include "tensorstore/driver/zarr3/codec/codec_chain_spec.h"
+#include "tensorstore/driver/zarr3/codec/codec_test_util.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::dtype_v;
+using ::tensorstore::StatusIs;
+using ::tensorstore::internal_zarr3::CodecRoundTripTestParams;
+using ::tensorstore::internal_zarr3::CodecSpecRoundTripTestParams;
+using ::tensorstore::internal_zarr3::GetDefaultBytesCodecJson;
+using ::tensorstore::internal_zarr3::TestCodecMerge;
+using ::tensorstore::internal_zarr3::TestCodecRoundTrip;
+using ::tensorstore::internal_zarr3::TestCodecSpecResolve;
+using ::tensorstore::internal_zarr3::TestCodecSpecRoundTrip;
+using ::tensorstore::internal_zarr3::ZarrCodecChainSpec;
+using ::testing::HasSubstr;
+
+TEST(ShuffleTest, Precise) {
+  CodecSpecRoundTripTestParams p;
+  p.orig_spec = {
+      {{"name", "shuffle"},
+       {"configuration", {{"mode", "bit"}, {"typesize", 4}}}},
+  };
+  p.expected_spec = {
+      GetDefaultBytesCodecJson(),
+      {{"name", "shuffle"},
+       {"configuration", {{"mode", "bit"}, {"typesize", 4}}}},
+  };
+  TestCodecSpecRoundTrip(p);
+}
+
+TEST(ShuffleTest, DefaultsUint16) {
+  CodecSpecRoundTripTestParams p;
+  p.orig_spec = {"shuffle"};
+  p.expected_spec = {
+      GetDefaultBytesCodecJson(),
+      {{"name", "shuffle"},
+       {"configuration", {{"mode", "byte"}, {"typesize", 2}}}},
+  };
+  TestCodecSpecRoundTrip(p);
+}
+
+TEST(ShuffleTest, DefaultsUint8) {
+  CodecSpecRoundTripTestParams p;
+  p.resolve_params.dtype = dtype_v<uint8_t>;
+  p.orig_spec = {"shuffle"};
+  p.expected_spec = {
+      {{"name", "bytes"}},
+      {{"name", "shuffle"},
+       {"configuration", {{"mode", "bit"}, {"typesize", 1}}}},
+  };
+  TestCodecSpecRoundTrip(p);
+}
+
+TEST(ShuffleTest, ModeRequiredInMetadata) {
+  CodecSpecRoundTripTestParams p;
+  EXPECT_THAT(
+      TestCodecSpecResolve(
+          {
+              GetDefaultBytesCodecJson(),
+              {{"name", "shuffle"}, {"configuration", {{"typesize", 2}}}},
+          },
+          p.resolve_params, /*constraints=*/false),
+      StatusIs(absl::StatusCode::kInvalidArgument, HasSubstr("\"mode\"")));
+}
+
+TEST(ShuffleTest, InvalidTypesize) {
+  EXPECT_THAT(
+      ZarrCodecChainSpec::FromJson(
+          {{{"name", "shuffle"}, {"configuration", {{"typesize", 256}}}}}),
+      StatusIs(absl::StatusCode::kInvalidArgument, HasSubstr("\"typesize\"")));
+}
+
+TEST(ShuffleTest, MergeModeMismatch) {
+  EXPECT_THAT(
+      TestCodecMerge(
+          {{{"name", "shuffle"}, {"configuration", {{"mode", "byte"}}}}},
+          {{{"name", "shuffle"}, {"configuration", {{"mode", "bit"}}}}},
+          /*strict=*/true),
+      StatusIs(absl::StatusCode::kFailedPrecondition, HasSubstr("\"mode\"")));
+}
+
+TEST(ShuffleTest, RoundTripByte) {
+  CodecRoundTripTestParams p;
+  p.spec = {
+      {{"name", "shuffle"}, {"configuration", {{"mode", "byte"}}}},
+      "zstd",
+  };
+  TestCodecRoundTrip(p);
+}
+
+TEST(ShuffleTest, RoundTripBit) {
+  CodecRoundTripTestParams p;
+  p.spec = {
+      {{"name", "shuffle"}, {"configuration", {{"mode", "bit"}}}},
+      "gzip",
+  };
+  TestCodecRoundTrip(p);
+}
+
+TEST(ShuffleTest, RoundTripPartialElement) {
+  // The typesize need not divide the size of the chunk.
+  CodecRoundTripTestParams p;
+  p.dtype = dtype_v<uint32_t>;
+  p.spec = {
+      {{"name", "shuffle"},
+       {"configuration", {{"mode", "bit"}, {"typesize", 3}}}},
+  };
+  TestCodecRoundTrip(p);
+}
+
+}  // namespace
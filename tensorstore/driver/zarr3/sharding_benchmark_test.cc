@@ -41,6 +41,16 @@
 //   Indicates that the first dimension of the array should be evenly split into
 //   `parallelism` partitions, and parallel read or write operations are issued
 //   separately for each partition.
+//
+// Additionally, the full shard read benchmark has 1 parameter:
+//
+// BM_ReadFullShard/<data_copy_concurrency>
+//
+// data_copy_concurrency:
+//
+//   Size of the context "data_copy_concurrency" "limit".  A single shard of
+//   1024 zstd-compressed inner chunks is read in its entirety, such that all
+//   of the inner chunks may be decoded concurrently.
 
 #include <stdint.h>
 
@@ -160,6 +170,46 @@ void BM_Read(benchmark::State& state) {
                           helper.total_bytes);
 }
 
+void BM_ReadFullShard(benchmark::State& state) {
+  // A shard of shape 256x128x128 split into 1024 inner chunks of 16^3.
+  const std::vector<Index> shape{256, 128, 128};
+  ::nlohmann::json json_spec{
+      {"driver", "zarr3"},
+      {"kvstore", "memory://"},
+      {"context",
+       {{"cache_pool", {{"total_bytes_limit", 0}}},
+        {"data_copy_concurrency", {{"limit", state.range(0)}}}}},
+      {"metadata",
+       {{"shape", shape},
+        {"data_type", "uint16"},
+        {"chunk_grid",
+         {{"name", "regular"}, {"configuration", {{"chunk_shape", shape}}}}},
+        {"codecs",
+         {{{"name", "sharding_indexed"},
+           {"configuration",
+            {{"chunk_shape", {16, 16, 16}},
+             {"codecs", {{{"name", "bytes"}}, {{"name", "zstd"}}}}}}}}}}},
+      {"create", true},
+  };
+  TENSORSTORE_CHECK_OK_AND_ASSIGN(auto store,
+                                  tensorstore::Open(json_spec).result());
+
+  // Fill with a pattern that is compressible, but not trivially so.
+  auto source_data = tensorstore::AllocateArray<uint16_t>(shape);
+  uint32_t x = 1;
+  for (Index i = 0; i < source_data.num_elements(); ++i) {
+    x = x * 1664525 + 1013904223;
+    source_data.data()[i] = static_cast<uint16_t>((x >> 24) & 0x3f);
+  }
+  const int64_t total_bytes = source_data.num_elements() * sizeof(uint16_t);
+  TENSORSTORE_CHECK_OK(tensorstore::Write(source_data, store).result());
+  for (auto s : state) {
+    TENSORSTORE_CHECK_OK(tensorstore::Read(store, source_data).result());
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          total_bytes);
+}
+
 using benchmark::Benchmark;
 
 void DefineArgs(Benchmark* bench) {
@@ -176,5 +226,6 @@ void DefineArgs(Benchmark* bench) {
 
 BENCHMARK(BM_Write)->Apply(DefineArgs);
 BENCHMARK(BM_Read)->Apply(DefineArgs);
+BENCHMARK(BM_ReadFullShard)->RangeMultiplier(2)->Range(1, 32)->UseRealTime();
 
 }  // namespace
@@ -62,9 +62,22 @@ TENSORSTORE_DECLARE_AND_REGISTER_METRIC(
     MetricMetadata("/tensorstore/cache/evict_count",
                    "Number of evictions from the cache."));
 
+TENSORSTORE_DECLARE_AND_REGISTER_METRIC(
+    encoded_hit_count, Counter<int64_t>,
+    MetricMetadata("/tensorstore/cache/encoded_hit_count",
+                   "Number of lookups of retained encoded values that were "
+                   "found."));
+
+TENSORSTORE_DECLARE_AND_REGISTER_METRIC(
+    encoded_miss_count, Counter<int64_t>,
+    MetricMetadata("/tensorstore/cache/encoded_miss_count",
+                   "Number of lookups of retained encoded values that were "
+                   "not found."));
+
 namespace tensorstore {
 namespace internal_cache {
 
+using ::tensorstore::internal::CachePriority;
 using ::tensorstore::internal::PinnedCacheEntry;
 
 #if !defined(NDEBUG)
@@ -81,7 +94,16 @@ CachePoolImpl::CachePoolImpl(const CachePool::Limits& limits)
       total_bytes_(0),
       strong_references_(1),
       weak_references_(1) {
-  Initialize(LruListAccessor{}, &eviction_queue_);
+  for (auto& queue : eviction_queues_) {
+    Initialize(LruListAccessor{}, &queue.head);
+  }
+  Initialize(LruListAccessor{}, &encoded_values_lru_);
+}
+
+CachePoolImpl::~CachePoolImpl() ABSL_NO_THREAD_SAFETY_ANALYSIS {
+  for (auto* node : encoded_values_) {
+    delete node;
+  }
 }
 
 namespace {
@@ -122,25 +144,124 @@ struct DecrementCacheReferenceCount {
   size_t old_count, new_count;
 };
 
-void UnlinkListNode(LruListNode* node) noexcept {
-  Remove(LruListAccessor{}, node);
-  Initialize(LruListAccessor{}, node);
+bool IsEmpty(const CachePoolImpl::EvictionQueue& queue) {
+  return queue.head.next == &queue.head;
+}
+
+// Removes `entry` from its eviction queue, if it is in one.
+void RemoveFromEvictionQueue(CachePoolImpl* pool,
+                             CacheEntryImpl* entry) noexcept {
+  DebugAssertMutexHeld(&pool->lru_mutex_);
+  if (OnlyContainsNode(LruListAccessor{}, entry)) return;
+  Remove(LruListAccessor{}, entry);
+  Initialize(LruListAccessor{}, entry);
+  pool->eviction_queues_[entry->eviction_queue_index_].num_bytes -=
+      entry->queued_bytes_;
+}
+
+// Appends `entry`, which must not be in an eviction queue, to the most
+// recently used end of the specified queue.
+void LinkIntoEvictionQueue(CachePoolImpl* pool, CacheEntryImpl* entry,
+                           size_t queue_index, size_t num_bytes) noexcept {
+  auto& queue = pool->eviction_queues_[queue_index];
+  entry->eviction_queue_index_ = static_cast<uint8_t>(queue_index);
+  entry->queued_bytes_ = num_bytes;
+  queue.num_bytes += num_bytes;
+  InsertBefore(LruListAccessor{}, &queue.head, entry);
 }
 
 void UnregisterEntryFromPool(CacheEntryImpl* entry,
                              CachePoolImpl* pool) noexcept {
   DebugAssertMutexHeld(&pool->lru_mutex_);
-  UnlinkListNode(entry);
-  pool->total_bytes_.fetch_sub(entry->num_bytes_, std::memory_order_relaxed);
+  RemoveFromEvictionQueue(pool, entry);
+  pool->total_bytes_.fetch_sub(
+      entry->num_bytes_.load(std::memory_order_relaxed),
+      std::memory_order_relaxed);
 }
 
+// Demotes the least recently used protected entries of the specified priority
+// class to the most recently used end of the probationary segment until
+// `protected_bytes_limit` is satisfied.  They must be accessed again to be
+// promoted back to the protected segment.
+void DemoteProtectedEntries(CachePoolImpl* pool, size_t priority) noexcept {
+  auto& protected_queue =
+      pool->eviction_queues_[CachePoolImpl::EvictionQueueIndex(priority, true)];
+  while (protected_queue.num_bytes > pool->limits_.protected_bytes_limit) {
+    auto* demoted = static_cast<CacheEntryImpl*>(protected_queue.head.next);
+    const size_t num_bytes = demoted->queued_bytes_;
+    RemoveFromEvictionQueue(pool, demoted);
+    LinkIntoEvictionQueue(pool, demoted,
+                          CachePoolImpl::EvictionQueueIndex(priority, false),
+                          num_bytes);
+  }
+}
+
+// Adds `entry`, which is no longer in use, to an eviction queue if it is not
+// already in one.
 void AddToEvictionQueue(CachePoolImpl* pool, CacheEntryImpl* entry) noexcept {
   DebugAssertMutexHeld(&pool->lru_mutex_);
-  auto* eviction_queue = &pool->eviction_queue_;
-  if (!OnlyContainsNode(LruListAccessor{}, entry)) {
-    Remove(LruListAccessor{}, entry);
+  if (entry->reference_count_.load(std::memory_order_relaxed) &
+      CacheEntryImpl::kQueued) {
+    return;
   }
-  InsertBefore(LruListAccessor{}, eviction_queue, entry);
+  const auto& limits = pool->limits_;
+  // Priorities are only distinguished if high priority entries are retained.
+  const size_t priority =
+      limits.high_priority_bytes_limit != 0
+          ? static_cast<size_t>(entry->cache_->priority_)
+          : 0;
+  const bool protect =
+      limits.protected_bytes_limit != 0 &&
+      entry->accessed_again_.exchange(false, std::memory_order_relaxed);
+  LinkIntoEvictionQueue(
+      pool, entry, CachePoolImpl::EvictionQueueIndex(priority, protect),
+      entry->num_bytes_.load(std::memory_order_relaxed));
+  entry->reference_count_.fetch_or(CacheEntryImpl::kQueued,
+                                   std::memory_order_acq_rel);
+  if (protect) DemoteProtectedEntries(pool, priority);
+}
+
+// Moves `entry`, which has been accessed since it was last considered for
+// eviction, to the most recently used end of the protected segment, if
+// enabled, or otherwise of its current queue.
+void GiveSecondChance(CachePoolImpl* pool, CacheEntryImpl* entry) noexcept {
+  DebugAssertMutexHeld(&pool->lru_mutex_);
+  const size_t priority = entry->eviction_queue_index_ / 2;
+  const bool protect = pool->limits_.protected_bytes_limit != 0;
+  RemoveFromEvictionQueue(pool, entry);
+  LinkIntoEvictionQueue(pool, entry,
+                        CachePoolImpl::EvictionQueueIndex(priority, protect),
+                        entry->num_bytes_.load(std::memory_order_relaxed));
+  if (protect) DemoteProtectedEntries(pool, priority);
+}
+
+// Returns the queue from which the next entry should be evicted, or `nullptr`
+// if all queues are empty.
+CachePoolImpl::EvictionQueue* GetQueueToEvictFrom(
+    CachePoolImpl* pool) noexcept {
+  DebugAssertMutexHeld(&pool->lru_mutex_);
+  constexpr size_t kNormal = static_cast<size_t>(CachePriority::kNormal);
+  constexpr size_t kHigh = static_cast<size_t>(CachePriority::kHigh);
+  auto* queues = pool->eviction_queues_;
+  const auto get_queue = [&](size_t priority) {
+    for (bool protect : {false, true}) {
+      auto& queue =
+          queues[CachePoolImpl::EvictionQueueIndex(priority, protect)];
+      if (!IsEmpty(queue)) return &queue;
+    }
+    return static_cast<CachePoolImpl::EvictionQueue*>(nullptr);
+  };
+  // High priority entries are evicted first only if they exceed their limit.
+  const size_t high_priority_bytes =
+      queues[CachePoolImpl::EvictionQueueIndex(kHigh, false)].num_bytes +
+      queues[CachePoolImpl::EvictionQueueIndex(kHigh, true)].num_bytes;
+  CachePoolImpl::EvictionQueue* queue = nullptr;
+  if (high_priority_bytes > pool->limits_.high_priority_bytes_limit) {
+    queue = get_queue(kHigh);
+  }
+  if (!queue) queue = get_queue(kNormal);
+  if (!queue) queue = get_queue(kHigh);
+  return queue;
 }
 
 void DestroyCache(CachePoolImpl* pool, CacheImpl* cache);
@@ -170,40 +291,58 @@ void MaybeEvictEntries(CachePoolImpl* pool) noexcept {
 
   while (pool->total_bytes_.load(std::memory_order_acquire) >
          pool->limits_.total_bytes_limit) {
-    auto* queue = &pool->eviction_queue_;
-    if (queue->next == queue) {
-      // Queue empty.
+    auto* queue = GetQueueToEvictFrom(pool);
+    if (!queue) {
+      // Queues empty.
       break;
     }
-    auto* entry = static_cast<CacheEntryImpl*>(queue->next);
+    auto* entry = static_cast<CacheEntryImpl*>(queue->head.next);
+    if (entry->accessed_again_.load(std::memory_order_relaxed)) {
+      entry->accessed_again_.store(false, std::memory_order_relaxed);
+      GiveSecondChance(pool, entry);
+      continue;
+    }
     auto* cache = entry->cache_;
     bool evict = false;
     bool should_delete_cache = false;
     auto& shard = cache->ShardForKey(entry->key_);
-    if (absl::MutexLock lock(shard.mutex);
-        entry->reference_count_.load(std::memory_order_acquire) == 0) {
-      [[maybe_unused]] size_t erase_count = shard.entries.erase(entry);
-      assert(erase_count == 1);
-      if (shard.entries.empty()) {
-        if (DecrementCacheReferenceCount(cache,
-                                         CacheImpl::kNonEmptyShardIncrement)
-                .should_delete()) {
-          should_delete_cache = true;
+    {
+      absl::MutexLock lock(shard.mutex);
+      // The reference count cannot increase from zero except while holding
+      // `shard.mutex`, but may concurrently decrease to zero, since `kQueued`
+      // is set.  Therefore, `kQueued` must be cleared atomically with
+      // checking that the entry is still in use.
+      auto count = entry->reference_count_.load(std::memory_order_acquire);
+      while (true) {
+        if (count == CacheEntryImpl::kQueued) {
+          evict = true;
+          break;
+        }
+        if (entry->reference_count_.compare_exchange_weak(
+                count, count & ~CacheEntryImpl::kQueued,
+                std::memory_order_acq_rel)) {
+          break;
+        }
+      }
+      if (evict) {
+        [[maybe_unused]] size_t erase_count = shard.entries.erase(entry);
+        assert(erase_count == 1);
+        if (shard.entries.empty()) {
+          if (DecrementCacheReferenceCount(cache,
+                                           CacheImpl::kNonEmptyShardIncrement)
+                  .should_delete()) {
+            should_delete_cache = true;
+          }
         }
       }
-      evict = true;
     }
     if (!evict) {
       // Entry is still in use, remove it from LRU eviction list.  For
       // efficiency, entries aren't removed from the eviction list when the
       // reference count increases.  It will be put back on the eviction list
-      // the next time the reference count becomes 0.  There is no race
-      // condition here because both `cache->entries_mutex_` and
-      // `pool->lru_mutex_` are held, and the reference count cannot increase
-      // from zero except while holding `cache->entries_mutex_`, and the
-      // reference count cannot decrease to zero except while holding
-      // `pool->lru_mutex_`.
-      UnlinkListNode(entry);
+      // the next time the reference count becomes 0, which requires
+      // `pool->lru_mutex_` now that `kQueued` is cleared.
+      RemoveFromEvictionQueue(pool, entry);
       continue;
     }
     UnregisterEntryFromPool(entry, pool);
@@ -269,8 +408,10 @@ void DestroyCache(CachePoolImpl* pool,
     for (auto& shard : cache->shards_) {
       // absl::MutexLock lock(&shard.mutex);
       for (CacheEntryImpl* entry : shard.entries) {
-        assert(entry->reference_count_.load() >= 2 &&
-               entry->reference_count_.load() <= 3);
+        assert((entry->reference_count_.load() & ~CacheEntryImpl::kQueued) >=
+                   2 &&
+               (entry->reference_count_.load() & ~CacheEntryImpl::kQueued) <=
+                   3);
         delete Access::StaticCast<Cache::Entry>(entry);
       }
     }
@@ -335,6 +476,45 @@ inline std::unique_lock<absl::Mutex> DecrementReferenceCountWithLock(
   return lock;
 }
 
+// Same as `DecrementReferenceCountWithLock`, but for the reference count of an
+// entry of a pool with an LRU cache, where the mutex is `pool->lru_mutex_`.
+//
+// `CacheEntryImpl::kQueued` is excluded from the count.  If
+// `allow_unlocked_if_queued` is `true` and `kQueued` is set, the count may
+// decrease to `lock_threshold` or below without acquiring `lru_mutex_`, in
+// which case an unlocked `std::unique_lock` is returned.
+inline std::unique_lock<absl::Mutex> DecrementEntryReferenceCountWithLock(
+    CachePoolImpl* pool, CacheEntryImpl* entry, uint32_t& new_count,
+    uint32_t decrease_amount, uint32_t lock_threshold,
+    bool allow_unlocked_if_queued) {
+  constexpr uint32_t kQueued = CacheEntryImpl::kQueued;
+  auto& reference_count = entry->reference_count_;
+  {
+    auto count = reference_count.load(std::memory_order_relaxed);
+    while (true) {
+      if ((count & ~kQueued) <= lock_threshold + decrease_amount &&
+          !(allow_unlocked_if_queued && (count & kQueued))) {
+        break;
+      }
+      if (reference_count.compare_exchange_weak(count, count - decrease_amount,
+                                                std::memory_order_acq_rel)) {
+        new_count = count - decrease_amount;
+        return {};
+      }
+    }
+  }
+
+  std::unique_lock lock(pool->lru_mutex_);
+  auto count =
+      reference_count.fetch_sub(decrease_amount, std::memory_order_acq_rel) -
+      decrease_amount;
+  new_count = count;
+  if ((count & ~kQueued) > lock_threshold) {
+    return {};
+  }
+  return lock;
+}
+
 }  // namespace
 
 void StrongPtrTraitsCacheEntry::decrement_impl(
@@ -370,21 +550,33 @@ void StrongPtrTraitsCacheEntry::decrement_impl(
         delete entry_impl;
       }
     } else {
-      auto lock = DecrementReferenceCountWithLock(
-          entry_impl->reference_count_,
-          [pool_impl]() -> absl::Mutex& { return pool_impl->lru_mutex_; },
-          new_count,
-          /*decrease_amount=*/2, /*lock_threshold=*/1);
+      // Releasing the last strong reference to an entry that is already in an
+      // eviction queue, which is the common case for a cache hit, does not
+      // require acquiring `lru_mutex_`.
+      auto lock = DecrementEntryReferenceCountWithLock(
+          pool_impl, entry_impl, new_count,
+          /*decrease_amount=*/2, /*lock_threshold=*/1,
+          /*allow_unlocked_if_queued=*/true);
       TENSORSTORE_INTERNAL_CACHE_DEBUG_REFCOUNT("CacheEntry:decrement",
                                                 entry_impl, new_count);
-      if (!lock) return;
-      if (new_count == 0) {
-        AddToEvictionQueue(pool_impl, entry_impl);
+      if (lock) {
+        if (new_count == 0) {
+          AddToEvictionQueue(pool_impl, entry_impl);
+          MaybeEvictEntries(pool_impl);
+        }
+      } else if ((new_count & ~CacheEntryImpl::kQueued) > 1) {
+        return;
+      } else if (new_count == CacheEntryImpl::kQueued &&
+                 pool_impl->total_bytes_.load(std::memory_order_acquire) >
+                     pool_impl->limits_.total_bytes_limit) {
+        // The entry may be evicted concurrently, but the pool remains valid
+        // since the strong reference to `cache` has not yet been released.
+        absl::MutexLock lru_lock(pool_impl->lru_mutex_);
         MaybeEvictEntries(pool_impl);
       }
     }
     // `entry` may not be valid at this point.
-    assert(new_count <= 1);
+    assert((new_count & ~CacheEntryImpl::kQueued) <= 1);
   } else {
     new_count =
         entry_impl->reference_count_.fetch_sub(2, std::memory_order_acq_rel) -
@@ -505,11 +697,12 @@ PinnedCacheEntry<Cache> GetCacheEntryInternal(internal::Cache* cache,
     if (it != shard.entries.end()) {
       hit_count.Increment();
       auto* entry_impl = *it;
+      entry_impl->accessed_again_.store(true, std::memory_order_relaxed);
       auto old_count =
           entry_impl->reference_count_.fetch_add(2, std::memory_order_acq_rel);
       TENSORSTORE_INTERNAL_CACHE_DEBUG_REFCOUNT("CacheEntry:increment",
                                                 entry_impl, old_count + 2);
-      if (old_count <= 1) {
+      if ((old_count & ~CacheEntryImpl::kQueued) <= 1) {
         // When the first strong reference to an entry is acquired, also
         // acquire a strong reference to the cache to be held by the entry.
         // This ensures the Cache object is not destroyed while any of its
@@ -674,11 +867,12 @@ void intrusive_ptr_decrement(CacheEntryWeakState* p)
     }
     return;
   }
-  auto pool_lock = DecrementReferenceCountWithLock(
-      entry->reference_count_,
-      [pool]() -> absl::Mutex& { return pool->lru_mutex_; }, new_count,
-      /*decrease_amount=*/1,
-      /*lock_threshold=*/0);
+  // Unlike when releasing a strong reference, `lru_mutex_` is always acquired
+  // since there is no reference to the cache that keeps the pool alive.
+  auto pool_lock = DecrementEntryReferenceCountWithLock(
+      pool, entry, new_count,
+      /*decrease_amount=*/1, /*lock_threshold=*/0,
+      /*allow_unlocked_if_queued=*/false);
   TENSORSTORE_INTERNAL_CACHE_DEBUG_REFCOUNT("CacheEntry:decrement", entry,
                                             new_count);
   if (!pool_lock) return;
@@ -744,6 +938,105 @@ namespace internal {
 Cache::Cache() = default;
 Cache::~Cache() = default;
 
+namespace {
+using ::tensorstore::internal_cache::CacheImpl;
+using ::tensorstore::internal_cache::CachePoolImpl;
+using ::tensorstore::internal_cache::EncodedValueNode;
+using ::tensorstore::internal_cache::LruListAccessor;
+
+// Returns the key of the entry with the specified `key` in
+// `CachePoolImpl::encoded_values_`.  The length of the cache identifier is
+// included to avoid ambiguity.
+std::string GetEncodedValueKey(const CacheImpl& cache, std::string_view key) {
+  std::string encoded_key = cache.cache_type_->name();
+  encoded_key += ':';
+  encoded_key += std::to_string(cache.cache_identifier_.size());
+  encoded_key += ':';
+  encoded_key += cache.cache_identifier_;
+  encoded_key += key;
+  return encoded_key;
+}
+
+// Removes `node` from the encoded values of `pool`.  The caller is responsible
+// for deleting it.
+void UnlinkEncodedValue(CachePoolImpl* pool, EncodedValueNode* node)
+    ABSL_EXCLUSIVE_LOCKS_REQUIRED(pool->encoded_mutex_) {
+  Remove(LruListAccessor{}, node);
+  pool->encoded_values_.erase(node);
+  pool->encoded_bytes_ -= node->num_bytes;
+}
+}  // namespace
+
+bool Cache::RetainsEncodedValues() const {
+  return pool_ && pool_->limits_.encoded_bytes_limit != 0 &&
+         !cache_identifier_.empty();
+}
+
+void Cache::StoreEncodedValue(std::string_view key,
+                              std::shared_ptr<const void> value,
+                              size_t num_bytes) {
+  if (!RetainsEncodedValues()) return;
+  auto* pool = pool_;
+  auto new_node = std::make_unique<EncodedValueNode>();
+  new_node->key = GetEncodedValueKey(*this, key);
+  new_node->value = std::move(value);
+  new_node->num_bytes = new_node->key.size() + num_bytes;
+  // Discarded values are destroyed after releasing `encoded_mutex_`.
+  std::vector<std::unique_ptr<EncodedValueNode>> discarded;
+  {
+    absl::MutexLock lock(pool->encoded_mutex_);
+    auto it = pool->encoded_values_.find(std::string_view(new_node->key));
+    if (it != pool->encoded_values_.end()) {
+      auto* node = *it;
+      UnlinkEncodedValue(pool, node);
+      discarded.emplace_back(node);
+    }
+    if (new_node->num_bytes > pool->limits_.encoded_bytes_limit) {
+      return;
+    }
+    pool->encoded_bytes_ += new_node->num_bytes;
+    auto* node = new_node.release();
+    pool->encoded_values_.insert(node);
+    InsertBefore(LruListAccessor{}, &pool->encoded_values_lru_, node);
+    while (pool->encoded_bytes_ > pool->limits_.encoded_bytes_limit) {
+      auto* lru_node =
+          static_cast<EncodedValueNode*>(pool->encoded_values_lru_.next);
+      UnlinkEncodedValue(pool, lru_node);
+      discarded.emplace_back(lru_node);
+    }
+  }
+}
+
+std::shared_ptr<const void> Cache::GetEncodedValue(std::string_view key) {
+  if (!RetainsEncodedValues()) return nullptr;
+  auto* pool = pool_;
+  auto encoded_key = GetEncodedValueKey(*this, key);
+  absl::MutexLock lock(pool->encoded_mutex_);
+  auto it = pool->encoded_values_.find(std::string_view(encoded_key));
+  if (it == pool->encoded_values_.end()) {
+    encoded_miss_count.Increment();
+    return nullptr;
+  }
+  encoded_hit_count.Increment();
+  auto* node = *it;
+  // Move to the most recently used position.
+  Remove(LruListAccessor{}, node);
+  InsertBefore(LruListAccessor{}, &pool->encoded_values_lru_, node);
+  return node->value;
+}
+
+void Cache::EraseEncodedValue(std::string_view key) {
+  if (!RetainsEncodedValues()) return;
+  auto* pool = pool_;
+  auto encoded_key = GetEncodedValueKey(*this, key);
+  std::unique_ptr<EncodedValueNode> discarded;
+  absl::MutexLock lock(pool->encoded_mutex_);
+  auto it = pool->encoded_values_.find(std::string_view(encoded_key));
+  if (it == pool->encoded_values_.end()) return;
+  discarded.reset(*it);
+  UnlinkEncodedValue(pool, discarded.get());
+}
+
 size_t Cache::DoGetSizeInBytes(Cache::Entry* entry) {
   return ((internal_cache::CacheEntryImpl*)entry)->key_.capacity() +
          this->DoGetSizeofEntry();
@@ -784,7 +1077,8 @@ void CacheEntry::unlock() {
   if (!internal_cache::HasLruCache(pool_impl)) return;
 
   const size_t new_size = cache.DoGetSizeInBytes(this);
-  ptrdiff_t change = new_size - std::exchange(num_bytes_, new_size);
+  ptrdiff_t change =
+      new_size - num_bytes_.exchange(new_size, std::memory_order_relaxed);
   lock.unlock();
 
   internal_cache::UpdateTotalBytes(*pool_impl, change);
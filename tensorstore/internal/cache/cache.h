@@ -97,8 +97,22 @@ using CachePtr = internal_cache::CachePtr<CacheType>;
 /// cache pool maintains a least-recently-used eviction queue of the entries;
 /// once the user-specified `CachePool:Limits` are reached, entries are evicted
 /// in order to attempt to free memory.  The limits apply to the aggregate
-/// memory usage of all caches managed by the pool, and a single LRU eviction
-/// queue is used for all managed caches.
+/// memory usage of all caches managed by the pool, and the eviction queue is
+/// shared by all managed caches.
+///
+/// The eviction queue may optionally be segmented (see `CachePoolLimits`):
+///
+/// - Entries that have been accessed more than once are protected from
+///   eviction by entries that have only been accessed once, up to
+///   `protected_bytes_limit`, such that a large scan does not evict the
+///   working set.
+///
+/// - Entries of caches with a `CachePriority::kHigh` priority are retained in
+///   preference to other entries, up to `high_priority_bytes_limit`.
+///
+/// Additionally, caches with a non-empty identifier may retain the encoded
+/// representation of their entries, up to `encoded_bytes_limit`, which is
+/// typically much more compact than the decoded representation.
 class CachePool : private internal_cache::CachePoolImpl {
  public:
   using Limits = CachePoolLimits;
@@ -179,7 +193,7 @@ class ABSL_LOCKABLE CacheEntry : private internal_cache::CacheEntryImpl {
   ///
   /// This is intended for testing and debugging.
   uint32_t use_count() const {
-    return reference_count_.load(std::memory_order_acquire) / 2;
+    return (reference_count_.load(std::memory_order_acquire) & ~kQueued) / 2;
   }
 
   /// Derived classes may use this to protect changes to the "cached data",
@@ -282,6 +296,9 @@ class Cache : private internal_cache::CacheImpl {
   /// pointer to this same cache.
   std::string_view cache_identifier() const { return cache_identifier_; }
 
+  /// Returns the eviction priority of the entries of this cache.
+  CachePriority priority() const { return priority_; }
+
   /// Allocates a new `entry` to be stored in this cache.
   ///
   /// Usually this method can be defined as:
@@ -317,6 +334,36 @@ class Cache : private internal_cache::CacheImpl {
   /// size_t DoGetSizeofEntry() final { return sizeof(Entry); }
   virtual size_t DoGetSizeofEntry() = 0;
 
+ protected:
+  /// Sets the eviction priority of the entries of this cache.
+  ///
+  /// Must be called before any entries are created, normally from the
+  /// constructor of the derived class.
+  void SetPriority(CachePriority priority) { priority_ = priority; }
+
+  /// Returns `true` if the cache pool retains encoded values for this cache.
+  ///
+  /// This requires a non-zero `CachePoolLimits::encoded_bytes_limit` and a
+  /// non-empty `cache_identifier()`, since encoded values are shared by all
+  /// caches of the same type and identifier.
+  bool RetainsEncodedValues() const;
+
+  /// Retains `value`, the encoded representation of the entry with the
+  /// specified `key`, which occupies `num_bytes`, replacing any existing value.
+  ///
+  /// The least recently used encoded values of the pool are discarded as
+  /// needed to satisfy `CachePoolLimits::encoded_bytes_limit`.  Has no effect
+  /// if `!RetainsEncodedValues()`.
+  void StoreEncodedValue(std::string_view key,
+                         std::shared_ptr<const void> value, size_t num_bytes);
+
+  /// Returns the encoded value retained for `key`, or `nullptr` if there is
+  /// none.
+  std::shared_ptr<const void> GetEncodedValue(std::string_view key);
+
+  /// Discards the encoded value retained for `key`, if any.
+  void EraseEncodedValue(std::string_view key);
+
  private:
   friend class internal_cache::Access;
 };
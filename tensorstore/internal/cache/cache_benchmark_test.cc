@@ -0,0 +1,117 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// Benchmarks of concurrent cache hits.
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "absl/strings/str_cat.h"
+#include "absl/synchronization/blocking_counter.h"
+#include "tensorstore/internal/cache/cache.h"
+#include "tensorstore/internal/thread/thread_pool.h"
+#include "tensorstore/util/executor.h"
+
+namespace {
+
+using ::tensorstore::Executor;
+using ::tensorstore::internal::CachePool;
+using ::tensorstore::internal::CachePtr;
+using ::tensorstore::internal::GetCache;
+using ::tensorstore::internal::PinnedCacheEntry;
+
+class BenchmarkCache : public tensorstore::internal::Cache {
+ public:
+  class Entry : public Cache::Entry {
+   public:
+    using OwningCache = BenchmarkCache;
+  };
+
+  Entry* DoAllocateEntry() final { return new Entry; }
+  size_t DoGetSizeofEntry() final { return sizeof(Entry); }
+  size_t DoGetSizeInBytes(Cache::Entry* entry) final { return 1; }
+};
+
+Executor SetupThreadPoolTestEnv(size_t num_threads) {
+  if (num_threads == 0) {
+    return ::tensorstore::InlineExecutor{};
+  }
+  return ::tensorstore::internal::DetachedThreadPool(num_threads);
+}
+
+// Repeatedly looks up entries which are already present in the cache from
+// `num_threads` threads concurrently.
+//
+// Arguments are:
+//   0: Number of threads (0 to run inline).
+//   1: Number of distinct keys.
+//   2: Whether the pool has an LRU cache.  If it does not, the entries are
+//      kept alive by pinned references held by the benchmark.
+static void BM_ConcurrentCacheHit(benchmark::State& state) {
+  const size_t ops = 1024 * 1024;
+  const size_t num_threads = state.range(0) ? state.range(0) : 1;
+  const size_t num_keys = state.range(1);
+  const bool use_lru = state.range(2);
+  const size_t iters = ops / num_threads;
+
+  auto executor = SetupThreadPoolTestEnv(state.range(0));
+  auto pool = CachePool::Make(CachePool::Limits{use_lru ? ops : 0});
+  auto cache = GetCache<BenchmarkCache>(
+      pool.get(), "", [] { return std::make_unique<BenchmarkCache>(); });
+
+  std::vector<std::string> keys;
+  std::vector<PinnedCacheEntry<BenchmarkCache>> pinned;
+  for (size_t i = 0; i < num_keys; ++i) {
+    keys.push_back(absl::StrCat(i));
+    auto entry = GetCacheEntry(cache, keys.back());
+    if (!use_lru) pinned.push_back(std::move(entry));
+  }
+
+  for (auto s : state) {
+    absl::BlockingCounter done(num_threads);
+    for (size_t i = 0; i < num_threads; i++) {
+      executor([&, i] {
+        for (size_t j = 0; j < iters; j++) {
+          auto entry = GetCacheEntry(cache, keys[(i + j) % num_keys]);
+          benchmark::DoNotOptimize(entry);
+        }
+        done.DecrementCount();
+      });
+    }
+    done.Wait();
+  }
+
+  state.SetItemsProcessed(state.iterations() * iters * num_threads);
+}
+
+BENCHMARK(BM_ConcurrentCacheHit)  //
+    ->Args({0, 1, 1})             // InlineExecutor
+    ->Args({8, 1, 1})             //
+    ->Args({32, 1, 1})            //
+    ->Args({64, 1, 1})            //
+    ->Args({0, 1024, 1})          // InlineExecutor
+    ->Args({8, 1024, 1})          //
+    ->Args({32, 1024, 1})         //
+    ->Args({64, 1024, 1})         //
+    ->Args({0, 1024, 0})          // InlineExecutor
+    ->Args({8, 1024, 0})          //
+    ->Args({32, 1024, 0})         //
+    ->Args({64, 1024, 0})         //
+    ->UseRealTime();
+
+}  // namespace
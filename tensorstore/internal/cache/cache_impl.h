@@ -70,6 +70,15 @@ struct LruListNode {
 
 class CacheEntryImpl;
 
+// Encoded representation of an entry retained by the pool (see
+// `CachePoolLimits::encoded_bytes_limit`).
+struct EncodedValueNode : public LruListNode {
+  // Concatenation of the cache type name, cache identifier and entry key.
+  std::string key;
+  std::shared_ptr<const void> value;
+  size_t num_bytes;
+};
+
 // Weak reference state for a cache entry.
 //
 // This is stored in a separate heap allocation from the entry itself, in order
@@ -117,19 +126,28 @@ class CacheEntryImpl : public internal_cache::LruListNode {
 
   // Most recently computed value of `DoGetSizeInBytes` that is reflected in the
   // LRU cache state.
-  size_t num_bytes_;
+  //
+  // Only modified while holding `mutex_`, but may be read while holding just
+  // the pool's `lru_mutex_` when the entry is added to an eviction queue.
+  std::atomic<size_t> num_bytes_;
 
   // Each strong reference adds 2 to the reference count.  The least-significant
   // bit (LSB) indicates if there is at least one weak reference,
-  // `weak_state_.load()->reference_count.load() > 0`.
+  // `weak_state_.load()->reference_count.load() > 0`.  The most-significant bit
+  // (`kQueued`) indicates that the entry is linked into one of the eviction
+  // queues of the pool, and is not part of the count.
+  //
+  // When the reference count (excluding `kQueued`) is non-zero, the entry is
+  // considered "in-use" and won't be evicted due to memory pressure.
   //
-  // When the reference count is non-zero, the entry is considered "in-use" and
-  // won't be evicted due to memory pressure.  In particular, `queue_state_` may
-  // be `clean_and_not_in_use` if, and only if, `reference_count_` is 0.
-  // Conversely, `queue_state_` may be `clean_and_in_use` if, and only if,
-  // `reference_count_` is non-zero.
+  // `kQueued` is only set or cleared while holding the pool's `lru_mutex_`.
+  // While it is set, the last reference may be released without acquiring
+  // `lru_mutex_`, since the entry is already eligible for eviction.  Otherwise,
+  // the count may only become zero while holding `lru_mutex_`.
   std::atomic<uint32_t> reference_count_;
 
+  constexpr static uint32_t kQueued = 0x80000000;
+
   // Guards calls to `DoInitializeEntry`.
   absl::once_flag initialized_;
 
@@ -143,6 +161,22 @@ class CacheEntryImpl : public internal_cache::LruListNode {
   // Set if the return value of `DoGetSizeInBytes` may have changed.
   constexpr static Flags kSizeChanged = 1;
 
+  // Set when an existing entry is retrieved by `GetCacheEntry`, i.e. on a
+  // cache hit, and cleared when the entry is next considered for eviction.
+  // Rather than moving entries to the most recently used end of the eviction
+  // queue on every access, which would require locking `lru_mutex_`, entries
+  // with this bit set are given a "second chance" when they reach the front of
+  // the queue (CLOCK-style approximate LRU), and are moved to the protected
+  // segment of the eviction queue, if enabled.
+  std::atomic<bool> accessed_again_{false};
+
+  // Index into `CachePoolImpl::eviction_queues_` of the queue containing this
+  // entry, and the number of bytes accounted to that queue.  Only valid while
+  // the entry is linked into an eviction queue.  Protected by the pool's
+  // `lru_mutex_`.
+  uint8_t eviction_queue_index_ = 0;
+  size_t queued_bytes_ = 0;
+
   // Initially set to `nullptr`.  Allocated when the first weak reference is
   // obtained, and remains until the entry is destroyed even if all weak
   // references are released.
@@ -187,6 +221,10 @@ class CacheImpl {
   /// pool, and is destroyed as soon as `reference_count_` becomes zero.
   std::string cache_identifier_;
 
+  /// Eviction priority of the entries of this cache.  Must not be changed
+  /// once entries have been created.
+  internal::CachePriority priority_ = internal::CachePriority::kNormal;
+
   constexpr static size_t kNumShards = 8;
 
   /// Reference count equal to:
@@ -267,26 +305,67 @@ class CacheImpl {
 class CachePoolImpl {
  public:
   explicit CachePoolImpl(const CachePoolLimits& limits);
+  ~CachePoolImpl();
 
   using CacheKey = CacheImpl::CacheKey;
 
   CachePoolLimits limits_;
   std::atomic<size_t> total_bytes_;
 
-  // Protects access to `eviction_queue_`.  If `lru_mutex_` is held at the same
-  // time as `caches_mutex_`, `caches_mutex_` must be acquired first.  If
+  // Protects access to `eviction_queues_`.  If `lru_mutex_` is held at the
+  // same time as `caches_mutex_`, `caches_mutex_` must be acquired first.  If
   // `lru_mutex_` is held at the same time as `entries_mutex_`, `lru_mutex_`
   // must be acquired first.
+  //
+  // Cache hits on entries that are already in an eviction queue do not
+  // acquire this mutex; it is only acquired when entries are added to or
+  // removed from the eviction queues, and when entries must be evicted.
   absl::Mutex lru_mutex_;
 
-  // next points to the front of the queue, which is the first to be evicted.
-  LruListNode eviction_queue_;
+  struct EvictionQueue {
+    // next points to the front of the queue, which is the first to be evicted.
+    LruListNode head;
+
+    // Sum of `queued_bytes_` over the entries in the queue.
+    size_t num_bytes = 0;
+  };
+
+  // Entries that are not in use are segmented by priority class and, within
+  // each priority class, into a probationary segment of entries that have
+  // been accessed only once and a protected segment of entries that have been
+  // accessed more than once (similar to the "2Q" and segmented LRU policies).
+  // Entries are evicted from the probationary segment first, and the least
+  // recently used entries of the protected segment are demoted to the
+  // probationary segment when `limits_.protected_bytes_limit` is exceeded.
+  // This prevents a single large scan from evicting frequently-used entries.
+  //
+  // With the default limits, only `eviction_queues_[0]` is used, which
+  // results in plain LRU eviction.
+  constexpr static size_t kNumEvictionQueues =
+      2 * internal::kNumCachePriorities;
+  EvictionQueue eviction_queues_[kNumEvictionQueues];
+
+  constexpr static size_t EvictionQueueIndex(size_t priority,
+                                             bool protected_segment) {
+    return 2 * priority + protected_segment;
+  }
 
   // Protects access to `caches_`.
   absl::Mutex caches_mutex_;
   internal::HeterogeneousHashSet<CacheImpl*, CacheKey, &CacheImpl::cache_key>
       caches_;
 
+  // Protects access to `encoded_values_`, `encoded_values_lru_` and
+  // `encoded_bytes_`.  No other mutex is acquired while this is held.
+  absl::Mutex encoded_mutex_;
+  internal::HeterogeneousHashSet<EncodedValueNode*, std::string_view,
+                                 &EncodedValueNode::key>
+      encoded_values_ ABSL_GUARDED_BY(encoded_mutex_);
+  // next points to the least recently used encoded value.
+  LruListNode encoded_values_lru_ ABSL_GUARDED_BY(encoded_mutex_);
+  // Sum of `num_bytes` over `encoded_values_`.
+  size_t encoded_bytes_ ABSL_GUARDED_BY(encoded_mutex_) = 0;
+
   /// Initial strong reference returned when the cache pool is created.
   std::atomic<size_t> strong_references_;
   /// One weak reference is kept until strong_references_ becomes 0.
@@ -16,16 +16,52 @@
 #define TENSORSTORE_INTERNAL_CACHE_CACHE_POOL_LIMITS_H_
 
 #include <stddef.h>
+#include <stdint.h>
 
 namespace tensorstore {
 namespace internal {
 
+/// Eviction priority class of a cache.
+///
+/// Entries of `kHigh` priority caches that are not in use are only evicted
+/// once no `kNormal` priority entries remain to be evicted, up to
+/// `CachePoolLimits::high_priority_bytes_limit`.  This is intended for small,
+/// frequently-accessed caches such as metadata, shard indices and B-tree nodes,
+/// which would otherwise be evicted by a large scan over bulk chunk data.
+enum class CachePriority : uint8_t {
+  kNormal = 0,
+  kHigh = 1,
+};
+
+constexpr size_t kNumCachePriorities = 2;
+
 /// Memory limit parameters for a cache pool.
 struct CachePoolLimits {
+  /// Soft limit on the total number of bytes of all entries in the pool.  If
+  /// `0`, entries are not retained once they are no longer in use.
   size_t total_bytes_limit = 0;
 
+  /// Maximum number of bytes of entries that are not in use and have been
+  /// accessed more than once that are protected from eviction by entries that
+  /// have only been accessed once.  This limit applies separately to each
+  /// priority class.  If `0`, a single least-recently-used queue is used.
+  size_t protected_bytes_limit = 0;
+
+  /// Maximum number of bytes of entries of `CachePriority::kHigh` caches that
+  /// are not in use that are retained in preference to entries of
+  /// `CachePriority::kNormal` caches.  Any excess is evicted in
+  /// least-recently-used order along with normal priority entries.
+  size_t high_priority_bytes_limit = 0;
+
+  /// Maximum number of bytes of encoded (e.g. compressed) representations of
+  /// entries retained by the pool, in addition to `total_bytes_limit`, so that
+  /// entries that have been evicted may be reloaded without re-reading them
+  /// from storage.  If `0`, encoded representations are not retained.
+  size_t encoded_bytes_limit = 0;
+
   constexpr static auto ApplyMembers = [](auto&& x, auto f) {
-    return f(x.total_bytes_limit);
+    return f(x.total_bytes_limit, x.protected_bytes_limit,
+             x.high_priority_bytes_limit, x.encoded_bytes_limit);
   };
 };
 
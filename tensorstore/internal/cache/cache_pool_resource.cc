@@ -37,7 +37,22 @@ struct CachePoolResourceTraits
     return jb::Object(
         jb::Member("total_bytes_limit",
                    jb::Projection(&Spec::total_bytes_limit,
-                                  jb::DefaultValue([](auto* v) { *v = 0; }))));
+                                  jb::DefaultValue([](auto* v) { *v = 0; }))),
+        jb::Member(
+            "protected_bytes_limit",
+            jb::Projection(
+                &Spec::protected_bytes_limit,
+                jb::DefaultInitializedValue<jb::kNeverIncludeDefaults>())),
+        jb::Member(
+            "high_priority_bytes_limit",
+            jb::Projection(
+                &Spec::high_priority_bytes_limit,
+                jb::DefaultInitializedValue<jb::kNeverIncludeDefaults>())),
+        jb::Member(
+            "encoded_bytes_limit",
+            jb::Projection(
+                &Spec::encoded_bytes_limit,
+                jb::DefaultInitializedValue<jb::kNeverIncludeDefaults>())));
   }
   static Result<Resource> Create(const Spec& limits,
                                  ContextResourceCreationContext context) {
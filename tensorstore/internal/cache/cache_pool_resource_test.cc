@@ -16,6 +16,7 @@
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include "absl/status/status.h"
 #include <nlohmann/json.hpp>
 #include "tensorstore/context.h"
 #include "tensorstore/internal/cache/cache.h"
@@ -49,6 +50,38 @@ TEST(CachePoolResourceTest, TotalBytesLimitOnly) {
                               {{"total_bytes_limit", 100}}));
   auto cache = Context::Default().GetResource(resource_spec).value();
   EXPECT_EQ(100u, (*cache)->limits().total_bytes_limit);
+  EXPECT_EQ(0u, (*cache)->limits().protected_bytes_limit);
+  EXPECT_EQ(0u, (*cache)->limits().high_priority_bytes_limit);
+  EXPECT_EQ(0u, (*cache)->limits().encoded_bytes_limit);
+}
+
+TEST(CachePoolResourceTest, SegmentedLimits) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto resource_spec,
+      Context::Resource<CachePoolResource>::FromJson(
+          {{"total_bytes_limit", 100},
+           {"protected_bytes_limit", 50},
+           {"high_priority_bytes_limit", 20}}));
+  auto cache = Context::Default().GetResource(resource_spec).value();
+  EXPECT_EQ(100u, (*cache)->limits().total_bytes_limit);
+  EXPECT_EQ(50u, (*cache)->limits().protected_bytes_limit);
+  EXPECT_EQ(20u, (*cache)->limits().high_priority_bytes_limit);
+}
+
+TEST(CachePoolResourceTest, EncodedBytesLimit) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto resource_spec, Context::Resource<CachePoolResource>::FromJson(
+                              {{"total_bytes_limit", 100},
+                               {"encoded_bytes_limit", 1000}}));
+  auto cache = Context::Default().GetResource(resource_spec).value();
+  EXPECT_EQ(100u, (*cache)->limits().total_bytes_limit);
+  EXPECT_EQ(1000u, (*cache)->limits().encoded_bytes_limit);
+}
+
+TEST(CachePoolResourceTest, InvalidLimit) {
+  EXPECT_THAT(Context::Resource<CachePoolResource>::FromJson(
+                  {{"protected_bytes_limit", -1}}),
+              tensorstore::MatchesStatus(absl::StatusCode::kInvalidArgument));
 }
 
 }  // namespace
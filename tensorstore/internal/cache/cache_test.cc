@@ -28,6 +28,7 @@
 #include <gtest/gtest.h>
 #include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_set.h"
+#include "absl/strings/str_cat.h"
 #include "absl/synchronization/mutex.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/mutex.h"
@@ -49,6 +50,7 @@ using ::tensorstore::internal_cache::LruListNode;
 using ::tensorstore::internal_testing::TestConcurrent;
 using ::testing::ElementsAre;
 using ::testing::Pair;
+using ::testing::Pointee;
 using ::testing::UnorderedElementsAre;
 
 constexpr CachePool::Limits kSmallCacheLimits{10000000};
@@ -106,6 +108,12 @@ class TestCache : public Cache {
 
   explicit TestCache(std::shared_ptr<RequestLog> log = {}) : log_(log) {}
 
+  using Cache::EraseEncodedValue;
+  using Cache::GetEncodedValue;
+  using Cache::RetainsEncodedValues;
+  using Cache::SetPriority;
+  using Cache::StoreEncodedValue;
+
   ~TestCache() {
     if (log_) {
       absl::MutexLock lock(log_->mutex);
@@ -163,7 +171,20 @@ void AssertInvariants(const CachePool::StrongPtr& pool,
                       absl::flat_hash_set<Cache*> expected_caches)
     ABSL_NO_THREAD_SAFETY_ANALYSIS {
   auto* pool_impl = GetPoolImpl(pool);
-  auto eviction_queue_entries = GetEntrySet(&pool_impl->eviction_queue_);
+  absl::flat_hash_set<EntryIdentifier> eviction_queue_entries;
+  for (size_t i = 0; i < CachePoolImpl::kNumEvictionQueues; ++i) {
+    auto& queue = pool_impl->eviction_queues_[i];
+    size_t queued_bytes = 0;
+    for (LruListNode* node = queue.head.next; node != &queue.head;
+         node = node->next) {
+      auto* entry = Access::StaticCast<CacheEntryImpl>(node);
+      EXPECT_EQ(i, entry->eviction_queue_index_);
+      queued_bytes += entry->queued_bytes_;
+    }
+    EXPECT_EQ(queued_bytes, queue.num_bytes);
+    auto entries = GetEntrySet(&queue.head);
+    eviction_queue_entries.insert(entries.begin(), entries.end());
+  }
 
   absl::flat_hash_set<EntryIdentifier> expected_eviction_queue_entries;
 
@@ -191,10 +212,11 @@ void AssertInvariants(const CachePool::StrongPtr& pool,
         // absl::MutexLock lock(&shard.mutex);
         for (CacheEntryImpl* entry : shard.entries) {
           EXPECT_EQ(
-              entry->num_bytes_,
+              entry->num_bytes_.load(),
               cache->DoGetSizeInBytes(Access::StaticCast<Cache::Entry>(entry)));
-          expected_total_bytes += entry->num_bytes_;
-          if (entry->reference_count_.load() == 0) {
+          expected_total_bytes += entry->num_bytes_.load();
+          if ((entry->reference_count_.load() &
+               ~CacheEntryImpl::kQueued) == 0) {
             expected_eviction_queue_entries.emplace(GetEntryIdentifier(entry));
           }
         }
@@ -1129,6 +1151,157 @@ TEST(CacheTest, WeakRefOwnedByEntry) {
                                    Pair("cache2", "c")));
 }
 
+// Tests that entries accessed more than once are not evicted by a scan when
+// `protected_bytes_limit` is specified.
+TEST(CacheTest, ScanResistantEviction) {
+  for (size_t protected_bytes_limit : {0, 3}) {
+    SCOPED_TRACE(protected_bytes_limit);
+    auto log = std::make_shared<TestCache::RequestLog>();
+    CachePool::Limits limits;
+    limits.total_bytes_limit = 5;
+    limits.protected_bytes_limit = protected_bytes_limit;
+    auto pool = CachePool::Make(limits);
+    auto cache = GetTestCache(pool.get(), "cache", log);
+    for (int i = 0; i < 2; ++i) {
+      GetCacheEntry(cache, "hot1");
+      GetCacheEntry(cache, "hot2");
+    }
+    for (int i = 0; i < 10; ++i) {
+      GetCacheEntry(cache, absl::StrCat("scan", i));
+    }
+    TENSORSTORE_INTERNAL_ASSERT_CACHE_INVARIANTS(pool, {cache.get()});
+    if (protected_bytes_limit == 0) {
+      EXPECT_THAT(log->entry_destroy_log,
+                  ::testing::IsSupersetOf(
+                      {Pair("cache", "hot1"), Pair("cache", "hot2")}));
+    } else {
+      EXPECT_THAT(
+          log->entry_destroy_log,
+          ElementsAre(Pair("cache", "scan0"), Pair("cache", "scan1"),
+                      Pair("cache", "scan2"), Pair("cache", "scan3"),
+                      Pair("cache", "scan4"), Pair("cache", "scan5"),
+                      Pair("cache", "scan6")));
+    }
+  }
+}
+
+// Tests that the least recently used protected entries are demoted once
+// `protected_bytes_limit` is exceeded.
+TEST(CacheTest, ProtectedSegmentDemotion) {
+  auto log = std::make_shared<TestCache::RequestLog>();
+  CachePool::Limits limits;
+  limits.total_bytes_limit = 3;
+  limits.protected_bytes_limit = 2;
+  auto pool = CachePool::Make(limits);
+  auto cache = GetTestCache(pool.get(), "cache", log);
+  for (int i = 0; i < 2; ++i) {
+    GetCacheEntry(cache, "a");
+    GetCacheEntry(cache, "b");
+    GetCacheEntry(cache, "c");
+  }
+  TENSORSTORE_INTERNAL_ASSERT_CACHE_INVARIANTS(pool, {cache.get()});
+  EXPECT_THAT(log->entry_destroy_log, ElementsAre());
+  // "a" was demoted to the probationary segment, and is evicted first.
+  GetCacheEntry(cache, "d");
+  EXPECT_THAT(log->entry_destroy_log, ElementsAre(Pair("cache", "a")));
+  TENSORSTORE_INTERNAL_ASSERT_CACHE_INVARIANTS(pool, {cache.get()});
+}
+
+// Tests that entries of high priority caches are retained in preference to
+// entries of normal priority caches, up to `high_priority_bytes_limit`.
+TEST(CacheTest, HighPriorityCache) {
+  auto log = std::make_shared<TestCache::RequestLog>();
+  CachePool::Limits limits;
+  limits.total_bytes_limit = 4;
+  limits.high_priority_bytes_limit = 2;
+  auto pool = CachePool::Make(limits);
+  auto metadata_cache = GetTestCache(pool.get(), "metadata", log);
+  metadata_cache->SetPriority(tensorstore::internal::CachePriority::kHigh);
+  EXPECT_EQ(tensorstore::internal::CachePriority::kHigh,
+            metadata_cache->priority());
+  auto data_cache = GetTestCache(pool.get(), "data", log);
+  GetCacheEntry(metadata_cache, "m0");
+  for (int i = 0; i < 10; ++i) {
+    GetCacheEntry(data_cache, absl::StrCat("d", i));
+  }
+  TENSORSTORE_INTERNAL_ASSERT_CACHE_INVARIANTS(
+      pool, {metadata_cache.get(), data_cache.get()});
+  EXPECT_THAT(log->entry_destroy_log,
+              ::testing::Not(::testing::Contains(Pair("metadata", "m0"))));
+
+  // Once `high_priority_bytes_limit` is exceeded, the least recently used
+  // high priority entry is evicted first.
+  log->entry_destroy_log.clear();
+  GetCacheEntry(metadata_cache, "m1");
+  GetCacheEntry(metadata_cache, "m2");
+  EXPECT_THAT(log->entry_destroy_log,
+              ElementsAre(Pair("data", "d7"), Pair("data", "d8")));
+  GetCacheEntry(data_cache, "d10");
+  EXPECT_THAT(log->entry_destroy_log,
+              ElementsAre(Pair("data", "d7"), Pair("data", "d8"),
+                          Pair("metadata", "m0")));
+  TENSORSTORE_INTERNAL_ASSERT_CACHE_INVARIANTS(
+      pool, {metadata_cache.get(), data_cache.get()});
+}
+
+std::shared_ptr<const std::string> GetEncodedString(TestCache& cache,
+                                                    std::string_view key) {
+  return std::static_pointer_cast<const std::string>(
+      cache.GetEncodedValue(key));
+}
+
+TEST(CacheTest, EncodedValues) {
+  auto log = std::make_shared<TestCache::RequestLog>();
+  CachePool::Limits limits;
+  limits.encoded_bytes_limit = 300;
+  auto pool = CachePool::Make(limits);
+  auto cache = GetTestCache(pool.get(), "test", log);
+  EXPECT_TRUE(cache->RetainsEncodedValues());
+  cache->StoreEncodedValue("a", std::make_shared<std::string>("va"), 100);
+  cache->StoreEncodedValue("b", std::make_shared<std::string>("vb"), 100);
+  EXPECT_THAT(GetEncodedString(*cache, "a"), Pointee(std::string("va")));
+
+  // Storing "c" discards "b", which is the least recently used.
+  cache->StoreEncodedValue("c", std::make_shared<std::string>("vc"), 100);
+  EXPECT_EQ(nullptr, GetEncodedString(*cache, "b"));
+  EXPECT_THAT(GetEncodedString(*cache, "a"), Pointee(std::string("va")));
+  EXPECT_THAT(GetEncodedString(*cache, "c"), Pointee(std::string("vc")));
+
+  cache->EraseEncodedValue("a");
+  EXPECT_EQ(nullptr, GetEncodedString(*cache, "a"));
+
+  // Values larger than the limit are not retained, and replace any existing
+  // value.
+  cache->StoreEncodedValue("c", std::make_shared<std::string>("vc2"), 1000);
+  EXPECT_EQ(nullptr, GetEncodedString(*cache, "c"));
+
+  // Values are retained after the cache is destroyed, and shared by caches of
+  // the same type and identifier.
+  cache->StoreEncodedValue("d", std::make_shared<std::string>("vd"), 10);
+  cache.reset();
+  EXPECT_THAT(log->cache_destroy_log, ElementsAre("test"));
+  cache = GetTestCache(pool.get(), "test", log);
+  EXPECT_THAT(GetEncodedString(*cache, "d"), Pointee(std::string("vd")));
+  auto other_cache = GetTestCache(pool.get(), "other", log);
+  EXPECT_EQ(nullptr, GetEncodedString(*other_cache, "d"));
+
+  // Anonymous caches do not retain values.
+  auto anonymous_cache = GetTestCache(pool.get(), "", log);
+  EXPECT_FALSE(anonymous_cache->RetainsEncodedValues());
+  anonymous_cache->StoreEncodedValue("e", std::make_shared<std::string>("ve"),
+                                     10);
+  EXPECT_EQ(nullptr, GetEncodedString(*anonymous_cache, "e"));
+}
+
+TEST(CacheTest, EncodedValuesDisabled) {
+  auto log = std::make_shared<TestCache::RequestLog>();
+  auto pool = CachePool::Make(CachePool::Limits{});
+  auto cache = GetTestCache(pool.get(), "test", log);
+  EXPECT_FALSE(cache->RetainsEncodedValues());
+  cache->StoreEncodedValue("a", std::make_shared<std::string>("va"), 1);
+  EXPECT_EQ(nullptr, GetEncodedString(*cache, "a"));
+}
+
 TEST(CacheTest, ConcurrentReleaseStrongCachePoolEvict) {
   CachePool::StrongPtr pool;
   CachePtr<TestCache> cache1, cache2;
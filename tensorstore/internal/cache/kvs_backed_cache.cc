@@ -18,8 +18,11 @@
 #include <stdint.h>
 
 #include <array>
+#include <string>
 #include <string_view>
 
+#include "absl/strings/cord.h"
+
 #include "tensorstore/internal/metrics/counter.h"
 #include "tensorstore/internal/metrics/domain_field.h"  // iwyu: keep
 #include "tensorstore/internal/metrics/metadata.h"
@@ -62,5 +65,12 @@ void KvsBackedCache_IncrementReadErrorMetric() {
   cell.Increment();
 }
 
+absl::Cord KvsBackedCache_CompactEncodedValue(absl::Cord value) {
+  if (value.EstimatedMemoryUsage() > 2 * (sizeof(absl::Cord) + value.size())) {
+    return absl::Cord(std::string(value));
+  }
+  return value;
+}
+
 }  // namespace internal
 }  // namespace tensorstore
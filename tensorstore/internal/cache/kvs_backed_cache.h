@@ -55,6 +55,12 @@ void KvsBackedCache_IncrementReadUnchangedMetric();
 void KvsBackedCache_IncrementReadChangedMetric();
 void KvsBackedCache_IncrementReadErrorMetric();
 
+/// Returns `value` in a form suitable for retention by the cache pool.
+///
+/// A small subcord of a larger buffer keeps the entire buffer alive, so values
+/// that pin substantially more memory than their size are copied.
+absl::Cord KvsBackedCache_CompactEncodedValue(absl::Cord value);
+
 #ifdef __clang__
 // KvsBackedCache uses the CRTP pattern, and clang may emit
 // "-Winconsistent-missing-override" warnings when virtual is used
@@ -118,6 +124,14 @@ class KvsBackedCache : public Parent {
     EncodeMode encode_mode = kNormal;
   };
 
+  /// Encoded value read from the kvstore, retained by the cache pool if
+  /// `CachePoolLimits::encoded_bytes_limit` is non-zero so that entries that
+  /// have been evicted can be decoded again without re-reading them.
+  struct EncodedValue {
+    std::optional<absl::Cord> value;
+    TimestampedStorageGeneration stamp;
+  };
+
   class Entry : public Parent::Entry {
    public:
     using OwningCache = KvsBackedCache;
@@ -152,7 +166,22 @@ class KvsBackedCache : public Parent {
     struct ReadReceiverImpl {
       EntryOrNode* entry_or_node_;
       std::shared_ptr<const void> existing_read_data_;
+      // Retained encoded value on which the read was conditioned, if any.
+      std::shared_ptr<const EncodedValue> encoded_value_ = nullptr;
       void set_value(kvstore::ReadResult read_result) {
+        if (read_result.aborted() && encoded_value_) {
+          ABSL_LOG_IF(INFO, TENSORSTORE_ASYNC_CACHE_DEBUG)
+              << *entry_or_node_
+              << "Retained encoded value has not changed, stamp="
+              << read_result.stamp;
+          KvsBackedCache_IncrementReadUnchangedMetric();
+          auto& entry = GetOwningEntry(*entry_or_node_);
+          entry.RetainEncodedValue(encoded_value_->value, read_result.stamp);
+          entry.DoDecode(encoded_value_->value,
+                         DecodeReceiverImpl<EntryOrNode>{
+                             entry_or_node_, std::move(read_result.stamp)});
+          return;
+        }
         if (read_result.aborted()) {
           ABSL_LOG_IF(INFO, TENSORSTORE_ASYNC_CACHE_DEBUG)
               << *entry_or_node_
@@ -166,10 +195,14 @@ class KvsBackedCache : public Parent {
         ABSL_LOG_IF(INFO, TENSORSTORE_ASYNC_CACHE_DEBUG)
             << *entry_or_node_ << "DoDecode: " << read_result.stamp;
         KvsBackedCache_IncrementReadChangedMetric();
-        GetOwningEntry(*entry_or_node_)
-            .DoDecode(std::move(read_result).optional_value(),
-                      DecodeReceiverImpl<EntryOrNode>{
-                          entry_or_node_, std::move(read_result.stamp)});
+        auto& entry = GetOwningEntry(*entry_or_node_);
+        if constexpr (std::is_same_v<EntryOrNode, Entry>) {
+          entry.RetainEncodedValue(read_result.optional_value(),
+                                   read_result.stamp);
+        }
+        entry.DoDecode(std::move(read_result).optional_value(),
+                       DecodeReceiverImpl<EntryOrNode>{
+                           entry_or_node_, std::move(read_result.stamp)});
       }
       void set_error(absl::Status error) {
         KvsBackedCache_IncrementReadErrorMetric();
@@ -183,21 +216,64 @@ class KvsBackedCache : public Parent {
     ///
     /// Reads from the `kvstore::Driver` and invokes `DoDecode` with the result.
     ///
+    /// If the entry has not been read but the cache pool retains an encoded
+    /// value for it (e.g. because the entry was evicted), the encoded value is
+    /// decoded directly if it satisfies the staleness bound, and otherwise the
+    /// read is conditioned on its generation.
+    ///
     /// If an error occurs, calls `ReadError` directly without invoking
     /// `DoDecode`.
     void DoRead(AsyncCache::AsyncCacheReadRequest request) final {
       kvstore::ReadOptions kvstore_options;
       kvstore_options.staleness_bound = request.staleness_bound;
       auto read_state = AsyncCache::ReadLock<void>(*this).read_state();
+      auto& cache = GetOwningCache(*this);
+      std::shared_ptr<const EncodedValue> encoded_value;
+      if (StorageGeneration::IsUnknown(read_state.stamp.generation) &&
+          cache.RetainsEncodedValues()) {
+        encoded_value = std::static_pointer_cast<const EncodedValue>(
+            cache.GetEncodedValue(this->key()));
+        if (encoded_value) {
+          if (encoded_value->stamp.time >= request.staleness_bound) {
+            ABSL_LOG_IF(INFO, TENSORSTORE_ASYNC_CACHE_DEBUG)
+                << *this << "DoDecode retained: " << encoded_value->stamp;
+            this->DoDecode(
+                encoded_value->value,
+                DecodeReceiverImpl<Entry>{this, encoded_value->stamp});
+            return;
+          }
+          read_state.stamp.generation = encoded_value->stamp.generation;
+        }
+      }
       kvstore_options.generation_conditions.if_not_equal =
           std::move(read_state.stamp.generation);
       kvstore_options.batch = request.batch;
-      auto& cache = GetOwningCache(*this);
       auto future = cache.kvstore_driver_->Read(this->GetKeyValueStoreKey(),
                                                 std::move(kvstore_options));
       execution::submit(
           std::move(future),
-          ReadReceiverImpl<Entry>{this, std::move(read_state.data)});
+          ReadReceiverImpl<Entry>{this, std::move(read_state.data),
+                                  std::move(encoded_value)});
+    }
+
+    /// Retains `value`, read from the kvstore with the specified `stamp`, in
+    /// the cache pool, if enabled.
+    void RetainEncodedValue(const std::optional<absl::Cord>& value,
+                            const TimestampedStorageGeneration& stamp) {
+      auto& cache = GetOwningCache(*this);
+      if (!cache.RetainsEncodedValues()) return;
+      auto encoded_value = std::make_shared<EncodedValue>();
+      encoded_value->stamp = stamp;
+      size_t num_bytes = sizeof(EncodedValue) + stamp.generation.value.size();
+      if (value) {
+        // Charge for the memory actually retained, which may exceed
+        // `value->size()`.
+        encoded_value->value = KvsBackedCache_CompactEncodedValue(*value);
+        num_bytes +=
+            encoded_value->value->EstimatedMemoryUsage() - sizeof(absl::Cord);
+      }
+      cache.StoreEncodedValue(this->key(), std::move(encoded_value),
+                              num_bytes);
     }
 
     using DecodeReceiver =
@@ -501,6 +577,8 @@ class KvsBackedCache : public Parent {
     void KvsWritebackSuccess(
         TimestampedStorageGeneration new_stamp,
         const StorageGeneration& orig_generation) override {
+      // Any retained encoded value is now out of date.
+      GetOwningCache(*this).EraseEncodedValue(GetOwningEntry(*this).key());
       if (orig_generation.LastMutatedBy(this->mutation_id_) ||
           (!StorageGeneration::IsUnknown(new_data_generation_) &&
            StorageGeneration::Condition(new_data_generation_,
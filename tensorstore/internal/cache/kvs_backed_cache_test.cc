@@ -31,7 +31,9 @@
 #include "absl/strings/cord.h"
 #include "absl/time/clock.h"
 #include "absl/time/time.h"
+#include "tensorstore/internal/cache/async_cache.h"
 #include "tensorstore/internal/cache/cache.h"
+#include "tensorstore/internal/cache/kvs_backed_cache.h"
 #include "tensorstore/internal/cache/kvs_backed_cache_testutil.h"
 #include "tensorstore/internal/global_initializer.h"
 #include "tensorstore/kvstore/generation.h"
@@ -51,7 +53,9 @@ using ::tensorstore::StatusIs;
 using ::tensorstore::StorageGeneration;
 using ::tensorstore::TimestampedStorageGeneration;
 using ::tensorstore::Transaction;
+using ::tensorstore::internal::AsyncCache;
 using ::tensorstore::internal::CachePool;
+using ::tensorstore::internal::KvsBackedCache_CompactEncodedValue;
 using ::tensorstore::internal::KvsBackedTestCache;
 using ::tensorstore::internal::MatchesKvsReadResult;
 using ::tensorstore::internal::MockKeyValueStore;
@@ -125,6 +129,86 @@ TEST_F(MockStoreTest, ReadError) {
                        HasSubstr("Error reading \"a\": read error")));
 }
 
+TEST(KvsBackedCacheTest, RetainedEncodedValue) {
+  CachePool::Limits limits;
+  limits.encoded_bytes_limit = 1000;
+  auto pool = CachePool::Make(limits);
+  auto mock_store = MockKeyValueStore::Make();
+  auto memory_store = tensorstore::GetMemoryKeyValueStore();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto write_stamp, memory_store->Write("a", absl::Cord("abc")).result());
+  auto cache = tensorstore::internal::GetCache<KvsBackedTestCache>(
+      pool.get(), "cache",
+      [&] { return std::make_unique<KvsBackedTestCache>(mock_store); });
+
+  {
+    auto entry = GetCacheEntry(cache, "a");
+    auto read_future = entry->Read({absl::Now()});
+    auto read_req = mock_store->read_requests.pop();
+    EXPECT_EQ(StorageGeneration::Unknown(),
+              read_req.options.generation_conditions.if_not_equal);
+    read_req(memory_store);
+    TENSORSTORE_EXPECT_OK(read_future.result());
+  }
+
+  // Since `total_bytes_limit` is 0, the entry is destroyed once it is no longer
+  // in use, but its encoded value is retained.
+  {
+    auto entry = GetCacheEntry(cache, "a");
+    TENSORSTORE_EXPECT_OK(entry->Read({absl::InfinitePast()}).result());
+    EXPECT_TRUE(mock_store->read_requests.empty());
+    EXPECT_EQ(absl::Cord("abc"),
+              *AsyncCache::ReadLock<absl::Cord>(*entry).data());
+  }
+
+  // A read with a newer staleness bound is conditioned on the generation of
+  // the retained value.
+  {
+    auto entry = GetCacheEntry(cache, "a");
+    auto read_time = absl::Now();
+    auto read_future = entry->Read({read_time});
+    auto read_req = mock_store->read_requests.pop();
+    EXPECT_EQ(write_stamp.generation,
+              read_req.options.generation_conditions.if_not_equal);
+    read_req(memory_store);
+    TENSORSTORE_EXPECT_OK(read_future.result());
+    EXPECT_EQ(absl::Cord("abc"),
+              *AsyncCache::ReadLock<absl::Cord>(*entry).data());
+    EXPECT_LE(read_time, AsyncCache::ReadLock<void>(*entry).stamp().time);
+  }
+
+  // The retained value is replaced if it has changed.
+  TENSORSTORE_ASSERT_OK(memory_store->Write("a", absl::Cord("def")));
+  {
+    auto entry = GetCacheEntry(cache, "a");
+    auto read_future = entry->Read({absl::Now()});
+    mock_store->read_requests.pop()(memory_store);
+    TENSORSTORE_EXPECT_OK(read_future.result());
+    EXPECT_EQ(absl::Cord("def"),
+              *AsyncCache::ReadLock<absl::Cord>(*entry).data());
+  }
+  {
+    auto entry = GetCacheEntry(cache, "a");
+    TENSORSTORE_EXPECT_OK(entry->Read({absl::InfinitePast()}).result());
+    EXPECT_TRUE(mock_store->read_requests.empty());
+    EXPECT_EQ(absl::Cord("def"),
+              *AsyncCache::ReadLock<absl::Cord>(*entry).data());
+  }
+}
+
+TEST(KvsBackedCacheTest, CompactEncodedValue) {
+  absl::Cord buffer(std::string(100000, 'x'));
+
+  // A small subcord would otherwise keep the entire buffer alive.
+  absl::Cord value = buffer.Subcord(0, 1000);
+  absl::Cord compact = KvsBackedCache_CompactEncodedValue(value);
+  EXPECT_EQ(value, compact);
+  EXPECT_LT(compact.EstimatedMemoryUsage(), 10000);
+
+  EXPECT_EQ(buffer.EstimatedMemoryUsage(),
+            KvsBackedCache_CompactEncodedValue(buffer).EstimatedMemoryUsage());
+}
+
 TEST_F(MockStoreTest, WriteError) {
   auto entry = GetCacheEntry(cache, "a");
 
@@ -18,13 +18,27 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cstring>
+#include <memory>
 #include <string>
 #include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
 #include "tensorstore/util/endian.h"
+#include "tensorstore/util/executor.h"
+
+#if defined(__SSE2__) && \
+    (defined(__GNUC__) || defined(__clang__)) && !defined(_MSC_VER)
+#define TENSORSTORE_INTERNAL_COMPRESSED_SEGMENTATION_SSE2 1
+#include <emmintrin.h>
+#endif
 
 namespace tensorstore {
 namespace neuroglancer_compressed_segmentation {
@@ -39,12 +53,179 @@ void WriteBlockHeader(size_t encoded_value_base_offset,
                          encoded_value_base_offset);
 }
 
+namespace {
+
+#ifdef TENSORSTORE_INTERNAL_COMPRESSED_SEGMENTATION_SSE2
+/// Packs 16 indices, each less than `2**Bits`, into `2 * Bits` bytes.
+///
+/// The indices are narrowed to bytes, and then adjacent values are
+/// successively merged until each byte holds `8 / Bits` values.
+template <size_t Bits>
+inline void PackIndices16(const uint32_t* indices, char* output) {
+  static_assert(Bits <= 8);
+  const __m128i* input = reinterpret_cast<const __m128i*>(indices);
+  __m128i x = _mm_packus_epi16(
+      _mm_packs_epi32(_mm_loadu_si128(input), _mm_loadu_si128(input + 1)),
+      _mm_packs_epi32(_mm_loadu_si128(input + 2), _mm_loadu_si128(input + 3)));
+  if constexpr (Bits == 1) {
+    const uint16_t bits =
+        static_cast<uint16_t>(_mm_movemask_epi8(_mm_slli_epi16(x, 7)));
+    std::memcpy(output, &bits, 2);
+  } else {
+    const __m128i low_byte_mask = _mm_set1_epi16(0xff);
+    for (size_t width = Bits; width < 8; width *= 2) {
+      x = _mm_and_si128(_mm_or_si128(x, _mm_srli_epi16(x, 8 - width)),
+                        low_byte_mask);
+      x = _mm_packus_epi16(x, x);
+    }
+    if constexpr (Bits == 8) {
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(output), x);
+    } else if constexpr (Bits == 4) {
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(output), x);
+    } else {
+      const uint32_t word = _mm_cvtsi128_si32(x);
+      std::memcpy(output, &word, 4);
+    }
+  }
+}
+#endif  // TENSORSTORE_INTERNAL_COMPRESSED_SEGMENTATION_SSE2
+
+/// Packs `num_words * (32 / Bits)` indices, each less than `2**Bits`, into
+/// `num_words` little-endian 32-bit words.
+template <size_t Bits>
+void PackIndices(const uint32_t* __restrict indices, size_t num_words,
+                 char* __restrict output) {
+  constexpr size_t kIndicesPerWord = 32 / Bits;
+  size_t word_i = 0;
+#ifdef TENSORSTORE_INTERNAL_COMPRESSED_SEGMENTATION_SSE2
+  if constexpr (Bits <= 8) {
+    // Each group of 32 indices is packed into `Bits` words.
+    for (; word_i + Bits <= num_words; word_i += Bits) {
+      PackIndices16<Bits>(indices + word_i * kIndicesPerWord,
+                          output + word_i * 4);
+      PackIndices16<Bits>(indices + word_i * kIndicesPerWord + 16,
+                          output + word_i * 4 + Bits * 2);
+    }
+  }
+#endif
+  for (; word_i < num_words; ++word_i) {
+    uint32_t word = 0;
+    for (size_t j = 0; j < kIndicesPerWord; ++j) {
+      word |= indices[word_i * kIndicesPerWord + j] << (j * Bits);
+    }
+    little_endian::Store32(output + word_i * 4, word);
+  }
+}
+
+/// Calls `func<Bits>()` for `encoded_bits`, which must be a power of 2 in
+/// `[1, 32]`.
+template <typename Func>
+void DispatchEncodedBits(size_t encoded_bits, Func func) {
+  switch (encoded_bits) {
+    case 1:
+      return func(std::integral_constant<size_t, 1>{});
+    case 2:
+      return func(std::integral_constant<size_t, 2>{});
+    case 4:
+      return func(std::integral_constant<size_t, 4>{});
+    case 8:
+      return func(std::integral_constant<size_t, 8>{});
+    case 16:
+      return func(std::integral_constant<size_t, 16>{});
+    case 32:
+      return func(std::integral_constant<size_t, 32>{});
+    default:
+      assert(false);
+  }
+}
+
+/// Assigns consecutive ids, in order of first occurrence, to the distinct
+/// labels within a block.
+///
+/// This is an open-addressing hash table whose memory is reused for all blocks
+/// of a channel, which avoids the allocations of a node-based or per-block
+/// hash table.
 template <typename Label>
-void EncodeBlock(const Label* input, const ptrdiff_t input_shape[3],
-                 const ptrdiff_t input_byte_strides[3],
-                 const ptrdiff_t block_shape[3], size_t base_offset,
-                 size_t* encoded_bits_output, size_t* table_offset_output,
-                 EncodedValueCache<Label>* cache, std::string* output) {
+class UniqueLabelTable {
+ public:
+  /// Clears the table and ensures there is capacity for `max_labels` distinct
+  /// labels with a load factor of at most 1/2.
+  void Reset(size_t max_labels) {
+    for (const size_t slot : used_slots_) {
+      slot_ids_[slot] = kEmpty;
+    }
+    used_slots_.clear();
+    labels_.clear();
+    const size_t min_num_slots = 2 * max_labels;
+    if (slot_ids_.size() < min_num_slots) {
+      table_bits_ = 1;
+      while ((size_t{1} << table_bits_) < min_num_slots) ++table_bits_;
+      slot_ids_.assign(size_t{1} << table_bits_, kEmpty);
+      slot_labels_.resize(size_t{1} << table_bits_);
+    }
+  }
+
+  /// Returns the id of `label`, assigning a new id if it has not been seen
+  /// since the last call to `Reset`.
+  uint32_t GetId(Label label) {
+    const size_t mask = slot_ids_.size() - 1;
+    // Fibonacci hashing: the high bits of the product are well mixed.
+    size_t slot = static_cast<size_t>(
+        (static_cast<uint64_t>(label) * uint64_t{0x9e3779b97f4a7c15}) >>
+        (64 - table_bits_));
+    while (true) {
+      const uint32_t id = slot_ids_[slot];
+      if (id == kEmpty) break;
+      if (slot_labels_[slot] == label) return id;
+      slot = (slot + 1) & mask;
+    }
+    const uint32_t id = static_cast<uint32_t>(labels_.size());
+    slot_ids_[slot] = id;
+    slot_labels_[slot] = label;
+    used_slots_.push_back(slot);
+    labels_.push_back(label);
+    return id;
+  }
+
+  /// Distinct labels, indexed by id.
+  const std::vector<Label>& labels() const { return labels_; }
+
+ private:
+  static constexpr uint32_t kEmpty = ~uint32_t{0};
+  int table_bits_ = 0;
+  std::vector<uint32_t> slot_ids_;
+  std::vector<Label> slot_labels_;
+  std::vector<size_t> used_slots_;
+  std::vector<Label> labels_;
+};
+
+/// Scratch buffers used to encode a block, which may be shared by all blocks
+/// of a channel to avoid repeated allocations.
+template <typename Label>
+struct EncodeBlockBuffers {
+  UniqueLabelTable<Label> unique_labels;
+
+  // Sorted distinct labels within the block.
+  std::vector<Label> table;
+
+  // Distinct labels within the block paired with their ids, sorted by label.
+  std::vector<std::pair<Label, uint32_t>> sorted_ids;
+
+  // Maps ids assigned by `unique_labels` to indices into `table`.
+  std::vector<uint32_t> id_to_index;
+
+  // Id, and then table index, of each position within the block in C order,
+  // padded with zeros to a multiple of 32 elements.
+  std::vector<uint32_t> indices;
+};
+
+template <typename Label>
+void EncodeBlockImpl(const Label* input, const ptrdiff_t input_shape[3],
+                     const ptrdiff_t input_byte_strides[3],
+                     const ptrdiff_t block_shape[3], size_t base_offset,
+                     size_t* encoded_bits_output, size_t* table_offset_output,
+                     EncodedValueCache<Label>* cache, std::string* output,
+                     EncodeBlockBuffers<Label>& buffers) {
   if (input_shape[0] == 0 && input_shape[1] == 0 && input_shape[2] == 0) {
     *encoded_bits_output = 0;
     *table_offset_output = 0;
@@ -53,55 +234,81 @@ void EncodeBlock(const Label* input, const ptrdiff_t input_shape[3],
 
   constexpr size_t num_32bit_words_per_label = sizeof(Label) / 4;
 
-  // TODO(jbms): allow the memory allocated for these to be shared across
-  // multiple calls to EncodeBlock.
-  absl::flat_hash_map<Label, uint32_t> seen_values;
-  std::vector<Label> seen_values_inv;
-
-  // Calls `func(z, y, x, label)` for each `label` value within the block, in C
-  // order.
-  const auto ForEachElement = [&](auto func) {
+  // Calls `func(row_offset, row)` for each row (along the last dimension) of
+  // the block, where `row_offset` is the offset of the row within the block in
+  // C order.
+  const auto ForEachRow = [&](auto func) {
     auto* input_z = reinterpret_cast<const char*>(input);
     for (ptrdiff_t z = 0; z < input_shape[0]; ++z) {
       auto* input_y = input_z;
       for (ptrdiff_t y = 0; y < input_shape[1]; ++y) {
-        auto* input_x = input_y;
-        for (ptrdiff_t x = 0; x < input_shape[2]; ++x) {
-          func(z, y, x, *reinterpret_cast<const Label*>(input_x));
-          input_x += input_byte_strides[2];
-        }
+        func(block_shape[2] * (y + block_shape[1] * z), input_y);
         input_y += input_byte_strides[1];
       }
       input_z += input_byte_strides[0];
     }
   };
+  const auto GetLabel = [&](const char* row, ptrdiff_t x) {
+    return *reinterpret_cast<const Label*>(row + x * input_byte_strides[2]);
+  };
 
-  // First determine the distinct values.
-
-  // Initialize previous_value such that it is guaranteed not to equal to the
-  // first value.
-  Label previous_value = input[0] + 1;
-  ForEachElement([&](size_t z, size_t y, size_t x, Label value) {
-    // If this value matches the previous value, we can skip the more
-    // expensive hash table lookup.
-    if (value != previous_value) {
-      previous_value = value;
-      if (seen_values.emplace(value, 0).second) {
-        seen_values_inv.push_back(value);
+  // First determine the distinct values, and the id of the value at each
+  // position.
+  const size_t block_num_elements =
+      block_shape[0] * block_shape[1] * block_shape[2];
+  auto& unique_labels = buffers.unique_labels;
+  auto& indices = buffers.indices;
+  unique_labels.Reset(input_shape[0] * input_shape[1] * input_shape[2]);
+  indices.assign((block_num_elements + 31) / 32 * 32, 0);
+  {
+    // Initialize previous_value such that it is guaranteed not to equal to
+    // the first value.
+    Label previous_value = input[0] + 1;
+    uint32_t previous_id = 0;
+    ForEachRow([&](ptrdiff_t row_offset, const char* row) {
+      for (ptrdiff_t x = 0; x < input_shape[2]; ++x) {
+        const Label value = GetLabel(row, x);
+        // If this value matches the previous value, we can skip the more
+        // expensive hash table lookup.
+        if (value != previous_value) {
+          previous_value = value;
+          previous_id = unique_labels.GetId(value);
+        }
+        indices[row_offset + x] = previous_id;
       }
-    }
-  });
+    });
+  }
 
-  std::sort(seen_values_inv.begin(), seen_values_inv.end());
-  for (size_t i = 0; i < seen_values_inv.size(); ++i) {
-    seen_values[seen_values_inv[i]] = static_cast<uint32_t>(i);
+  // Sort the distinct values, and convert ids to table indices.  Positions
+  // outside `input_shape` are left as index 0, i.e. the lowest label value.
+  auto& table = buffers.table;
+  const auto& labels = unique_labels.labels();
+  table = labels;
+  if (!std::is_sorted(table.begin(), table.end())) {
+    auto& sorted_ids = buffers.sorted_ids;
+    sorted_ids.resize(labels.size());
+    for (size_t id = 0; id < labels.size(); ++id) {
+      sorted_ids[id] = {labels[id], static_cast<uint32_t>(id)};
+    }
+    std::sort(sorted_ids.begin(), sorted_ids.end());
+    auto& id_to_index = buffers.id_to_index;
+    id_to_index.resize(labels.size());
+    for (size_t i = 0; i < sorted_ids.size(); ++i) {
+      table[i] = sorted_ids[i].first;
+      id_to_index[sorted_ids[i].second] = static_cast<uint32_t>(i);
+    }
+    ForEachRow([&](ptrdiff_t row_offset, const char* row) {
+      for (ptrdiff_t x = 0; x < input_shape[2]; ++x) {
+        indices[row_offset + x] = id_to_index[indices[row_offset + x]];
+      }
+    });
   }
 
   // Determine number of bits with which to encode each index.
   size_t encoded_bits = 0;
-  if (seen_values.size() != 1) {
+  if (table.size() != 1) {
     encoded_bits = 1;
-    while ((size_t(1) << encoded_bits) < seen_values.size()) {
+    while ((size_t(1) << encoded_bits) < table.size()) {
       encoded_bits *= 2;
     }
   }
@@ -116,10 +323,10 @@ void EncodeBlock(const Label* input, const ptrdiff_t input_shape[3],
 
   bool write_table;
   {
-    auto it = cache->find(seen_values_inv);
+    auto it = cache->find(table);
     if (it == cache->end()) {
       write_table = true;
-      elements_to_write += seen_values.size() * num_32bit_words_per_label;
+      elements_to_write += table.size() * num_32bit_words_per_label;
       *table_offset_output =
           (encoded_value_base_offset - base_offset) / 4 + encoded_size_32bits;
     } else {
@@ -130,37 +337,50 @@ void EncodeBlock(const Label* input, const ptrdiff_t input_shape[3],
 
   output->resize(encoded_value_base_offset + elements_to_write * 4);
   char* output_ptr = output->data() + encoded_value_base_offset;
+
   // Write encoded representation.
-  ForEachElement([&](size_t z, size_t y, size_t x, Label value) {
-    uint32_t index = seen_values.at(value);
-    size_t output_offset = x + block_shape[2] * (y + block_shape[1] * z);
-    void* cur_ptr = output_ptr + output_offset * encoded_bits / 32 * 4;
-    little_endian::Store32(cur_ptr,
-                           little_endian::Load32(cur_ptr) |
-                               (index << (output_offset * encoded_bits % 32)));
-  });
+  if (encoded_bits != 0) {
+    DispatchEncodedBits(encoded_bits, [&](auto bits) {
+      PackIndices<decltype(bits)::value>(indices.data(), encoded_size_32bits,
+                                         output_ptr);
+    });
+  }
 
   // Write table
   if (write_table) {
     output_ptr =
         output->data() + encoded_value_base_offset + encoded_size_32bits * 4;
-    for (auto value : seen_values_inv) {
+    for (auto value : table) {
       for (size_t word_i = 0; word_i < num_32bit_words_per_label; ++word_i) {
         little_endian::Store32(output_ptr + word_i * 4,
                                static_cast<uint32_t>(value >> (32 * word_i)));
       }
       output_ptr += num_32bit_words_per_label * 4;
     }
-    cache->emplace(seen_values_inv,
-                   static_cast<uint32_t>(*table_offset_output));
+    cache->emplace(table, static_cast<uint32_t>(*table_offset_output));
   }
 }
 
+}  // namespace
+
+template <typename Label>
+void EncodeBlock(const Label* input, const ptrdiff_t input_shape[3],
+                 const ptrdiff_t input_byte_strides[3],
+                 const ptrdiff_t block_shape[3], size_t base_offset,
+                 size_t* encoded_bits_output, size_t* table_offset_output,
+                 EncodedValueCache<Label>* cache, std::string* output) {
+  EncodeBlockBuffers<Label> buffers;
+  EncodeBlockImpl(input, input_shape, input_byte_strides, block_shape,
+                  base_offset, encoded_bits_output, table_offset_output, cache,
+                  output, buffers);
+}
+
 template <class Label>
 void EncodeChannel(const Label* input, const ptrdiff_t input_shape[3],
                    const ptrdiff_t input_byte_strides[3],
                    const ptrdiff_t block_shape[3], std::string* output) {
   EncodedValueCache<Label> cache;
+  EncodeBlockBuffers<Label> buffers;
   const size_t base_offset = output->size();
   ptrdiff_t grid_shape[3];
   size_t block_index_size = kBlockHeaderSize;
@@ -185,10 +405,11 @@ void EncodeChannel(const Label* input, const ptrdiff_t input_shape[3],
         const size_t encoded_value_base_offset =
             (output->size() - base_offset) / 4;
         size_t encoded_bits, table_offset;
-        EncodeBlock(reinterpret_cast<const Label*>(
-                        reinterpret_cast<const char*>(input) + input_offset),
-                    input_block_shape, input_byte_strides, block_shape,
-                    base_offset, &encoded_bits, &table_offset, &cache, output);
+        EncodeBlockImpl(
+            reinterpret_cast<const Label*>(
+                reinterpret_cast<const char*>(input) + input_offset),
+            input_block_shape, input_byte_strides, block_shape, base_offset,
+            &encoded_bits, &table_offset, &cache, output, buffers);
         WriteBlockHeader(
             encoded_value_base_offset, table_offset, encoded_bits,
             output->data() + base_offset + block_offset * kBlockHeaderSize * 4);
@@ -213,6 +434,91 @@ void EncodeChannels(const Label* input, const ptrdiff_t input_shape[3 + 1],
   }
 }
 
+namespace {
+
+/// State shared by the tasks that encode channels in parallel.
+///
+/// Tasks submitted to the executor may start after all channels have been
+/// encoded, and therefore only access this reference-counted state.
+template <typename Label>
+struct ParallelEncodeChannelsState {
+  const Label* input;
+  ptrdiff_t input_shape[3 + 1];
+  ptrdiff_t input_byte_strides[3 + 1];
+  ptrdiff_t block_shape[3];
+
+  // Encoding of each channel.
+  std::vector<std::string> encoded_channels;
+
+  // Index of the next channel to be claimed by a task.
+  std::atomic<ptrdiff_t> next_channel{0};
+
+  absl::Mutex mutex;
+  ptrdiff_t num_channels_remaining ABSL_GUARDED_BY(mutex);
+  bool done ABSL_GUARDED_BY(mutex) = false;
+
+  // Encodes unclaimed channels until none remain.
+  void EncodeRemainingChannels() {
+    ptrdiff_t num_encoded = 0;
+    for (ptrdiff_t channel_i; (channel_i = next_channel.fetch_add(1)) <
+                              input_shape[0];) {
+      EncodeChannel(
+          reinterpret_cast<const Label*>(reinterpret_cast<const char*>(input) +
+                                         input_byte_strides[0] * channel_i),
+          input_shape + 1, input_byte_strides + 1, block_shape,
+          &encoded_channels[channel_i]);
+      ++num_encoded;
+    }
+    if (num_encoded == 0) return;
+    absl::MutexLock lock(&mutex);
+    num_channels_remaining -= num_encoded;
+    done = (num_channels_remaining == 0);
+  }
+};
+
+}  // namespace
+
+template <class Label>
+void EncodeChannels(const Label* input, const ptrdiff_t input_shape[3 + 1],
+                    const ptrdiff_t input_byte_strides[3 + 1],
+                    const ptrdiff_t block_shape[3], const Executor& executor,
+                    std::string* output) {
+  const ptrdiff_t num_channels = input_shape[0];
+  if (num_channels <= 1) {
+    EncodeChannels(input, input_shape, input_byte_strides, block_shape,
+                   output);
+    return;
+  }
+  auto state = std::make_shared<ParallelEncodeChannelsState<Label>>();
+  state->input = input;
+  std::copy_n(input_shape, 4, state->input_shape);
+  std::copy_n(input_byte_strides, 4, state->input_byte_strides);
+  std::copy_n(block_shape, 3, state->block_shape);
+  state->encoded_channels.resize(num_channels);
+  {
+    absl::MutexLock lock(&state->mutex);
+    state->num_channels_remaining = num_channels;
+  }
+  // The calling thread also encodes channels, which ensures progress even if
+  // none of the tasks are able to run.
+  for (ptrdiff_t i = 1; i < num_channels; ++i) {
+    executor([state] { state->EncodeRemainingChannels(); });
+  }
+  state->EncodeRemainingChannels();
+  {
+    // Wait for channels claimed by other tasks.
+    absl::MutexLock lock(&state->mutex);
+    state->mutex.Await(absl::Condition(&state->done));
+  }
+  const size_t base_offset = output->size();
+  output->resize(base_offset + num_channels * 4);
+  for (ptrdiff_t channel_i = 0; channel_i < num_channels; ++channel_i) {
+    little_endian::Store32(output->data() + base_offset + channel_i * 4,
+                           (output->size() - base_offset) / 4);
+    output->append(state->encoded_channels[channel_i]);
+  }
+}
+
 void ReadBlockHeader(const void* header, size_t* encoded_value_base_offset,
                      size_t* table_base_offset, size_t* encoding_bits) {
   auto h = little_endian::Load64(header);
@@ -227,24 +533,22 @@ bool DecodeBlock(size_t encoded_bits, const char* encoded_input,
                  const ptrdiff_t block_shape[3],
                  const ptrdiff_t output_shape[3],
                  const ptrdiff_t output_byte_strides[3], Label* output) {
-  // TODO(jbms): Consider specializing this function for the value of
-  // `encoded_bits` and whether `table_size` is `< 2**encoded_bits`.  If
-  // `table_size >= 2**encoded_bits`, there is no need to check below that
-  // `index <= table_size`.
-
-  // Invokes `callback(label, z, y, x)` for each block position in C order.  If
-  // `callback` returns `false`, stops iterating and returns `false`.  Otherwise
-  // returns `true` when done.
-  const auto for_each_position = [&](auto callback) {
+  if (encoded_bits > 32 || (encoded_bits & (encoded_bits - 1)) != 0) {
+    // encoded bits is not a power of 2 <= 32.
+    return false;
+  }
+
+  // Calls `func(row_offset, row)` for each row (along the last dimension) of
+  // the block, where `row_offset` is the offset of the row within the block in
+  // C order.  If `func` returns `false`, stops iterating and returns `false`.
+  // Otherwise returns `true` when done.
+  const auto for_each_row = [&](auto func) {
     auto* output_z = reinterpret_cast<char*>(output);
     for (ptrdiff_t z = 0; z < output_shape[0]; ++z) {
       auto* output_y = output_z;
       for (ptrdiff_t y = 0; y < output_shape[1]; ++y) {
-        auto* output_x = output_y;
-        for (ptrdiff_t x = 0; x < output_shape[2]; ++x) {
-          auto& label = *reinterpret_cast<Label*>(output_x);
-          if (!callback(label, z, y, x)) return false;
-          output_x += output_byte_strides[2];
+        if (!func(block_shape[2] * (y + block_shape[1] * z), output_y)) {
+          return false;
         }
         output_y += output_byte_strides[1];
       }
@@ -262,30 +566,52 @@ bool DecodeBlock(size_t encoded_bits, const char* encoded_input,
     }
   };
 
+  const ptrdiff_t output_byte_stride = output_byte_strides[2];
+  const auto set_label = [&](char* row, ptrdiff_t x, Label label) {
+    *reinterpret_cast<Label*>(row + x * output_byte_stride) = label;
+  };
+
   if (encoded_bits == 0) {
     // There are no encoded indices to read.
     if (table_size == 0) return false;
     const Label label = read_label(0);
-    return for_each_position(
-        [&](Label& output_label, ptrdiff_t z, ptrdiff_t y, ptrdiff_t x) {
-          output_label = label;
-          return true;
-        });
+    return for_each_row([&](ptrdiff_t row_offset, char* row) {
+      for (ptrdiff_t x = 0; x < output_shape[2]; ++x) {
+        set_label(row, x, label);
+      }
+      return true;
+    });
   }
 
-  const uint32_t encoded_value_mask = (1U << encoded_bits) - 1;
-  return for_each_position([&](Label& output_label, ptrdiff_t z, ptrdiff_t y,
-                               ptrdiff_t x) {
-    size_t encoded_offset = x + block_shape[2] * (y + block_shape[1] * z);
-    auto index = little_endian::Load32(
-                     encoded_input + encoded_offset * encoded_bits / 32 * 4) >>
-                     (encoded_offset * encoded_bits % 32) &
-                 encoded_value_mask;
-    if (index >= table_size) return false;
-    output_label = read_label(index);
-    return true;
+  // Indices only need to be validated if the table may be smaller than the
+  // range of encoded values.
+  const bool check_bounds =
+      encoded_bits == 32 || table_size < (size_t{1} << encoded_bits);
+  bool ok = true;
+  DispatchEncodedBits(encoded_bits, [&](auto bits) {
+    constexpr size_t kBits = decltype(bits)::value;
+    constexpr uint32_t kMask =
+        static_cast<uint32_t>((uint64_t{1} << kBits) - 1);
+    const auto get_index = [&](size_t offset) -> uint32_t {
+      const uint32_t word =
+          little_endian::Load32(encoded_input + offset * kBits / 32 * 4);
+      return (word >> (offset * kBits % 32)) & kMask;
+    };
+    ok = for_each_row([&](ptrdiff_t row_offset, char* row) {
+      if (check_bounds) {
+        uint32_t max_index = 0;
+        for (ptrdiff_t x = 0; x < output_shape[2]; ++x) {
+          max_index = std::max(max_index, get_index(row_offset + x));
+        }
+        if (max_index >= table_size) return false;
+      }
+      for (ptrdiff_t x = 0; x < output_shape[2]; ++x) {
+        set_label(row, x, read_label(get_index(row_offset + x)));
+      }
+      return true;
+    });
   });
-  return true;
+  return ok;
 }
 
 template <typename Label>
@@ -398,6 +724,11 @@ bool DecodeChannels(std::string_view input, const ptrdiff_t block_shape[3],
       const Label* input, const ptrdiff_t input_shape[3 + 1],                  \
       const ptrdiff_t input_byte_strides[3 + 1],                               \
       const ptrdiff_t block_shape[3], std::string* output);                    \
+  template void EncodeChannels<Label>(                                         \
+      const Label* input, const ptrdiff_t input_shape[3 + 1],                  \
+      const ptrdiff_t input_byte_strides[3 + 1],                               \
+      const ptrdiff_t block_shape[3], const Executor& executor,                \
+      std::string* output);                                                    \
   template bool DecodeBlock(                                                   \
       size_t encoded_bits, const char* encoded_input, const char* table_input, \
       size_t table_size, const ptrdiff_t block_shape[3],                       \
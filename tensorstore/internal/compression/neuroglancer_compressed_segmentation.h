@@ -66,6 +66,7 @@
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
+#include "tensorstore/util/executor.h"
 
 namespace tensorstore {
 namespace neuroglancer_compressed_segmentation {
@@ -136,6 +137,17 @@ void EncodeChannels(const Label* input, const ptrdiff_t input_shape[3 + 1],
                     const ptrdiff_t input_byte_strides[3 + 1],
                     const ptrdiff_t block_shape[3], std::string* output);
 
+/// Same as above, but encodes the channels in parallel using `executor`.
+///
+/// The calling thread also encodes channels, and this function returns once
+/// all channels have been encoded.  The output is identical to that of the
+/// serial version.
+template <typename Label>
+void EncodeChannels(const Label* input, const ptrdiff_t input_shape[3 + 1],
+                    const ptrdiff_t input_byte_strides[3 + 1],
+                    const ptrdiff_t block_shape[3], const Executor& executor,
+                    std::string* output);
+
 /// Decodes a single block.
 ///
 /// \tparam Label Must be `uint32_t` or `uint64_t`.
@@ -0,0 +1,133 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "absl/random/random.h"
+#include "tensorstore/internal/compression/neuroglancer_compressed_segmentation.h"
+#include "tensorstore/internal/thread/thread_pool.h"
+#include "tensorstore/util/executor.h"
+
+namespace {
+
+using ::tensorstore::neuroglancer_compressed_segmentation::DecodeChannels;
+using ::tensorstore::neuroglancer_compressed_segmentation::EncodeChannels;
+
+// Segmentation-like input volume of shape `{num_channels, 64, 64, 64}`, made
+// of runs of `run_length` equal labels chosen from `num_labels` distinct
+// values.
+template <typename Label>
+struct Volume {
+  Volume(ptrdiff_t num_channels, size_t num_labels, size_t run_length)
+      : shape{num_channels, 64, 64, 64},
+        byte_strides{64 * 64 * 64 * sizeof(Label), 64 * 64 * sizeof(Label),
+                     64 * sizeof(Label), sizeof(Label)},
+        data(num_channels * 64 * 64 * 64) {
+    absl::BitGen gen;
+    std::vector<Label> labels(num_labels);
+    for (auto& label : labels) {
+      label = absl::Uniform<Label>(gen);
+    }
+    for (size_t i = 0; i < data.size(); i += run_length) {
+      const Label label = labels[absl::Uniform<size_t>(gen, 0, num_labels)];
+      for (size_t j = i; j < std::min(data.size(), i + run_length); ++j) {
+        data[j] = label;
+      }
+    }
+  }
+
+  ptrdiff_t shape[4];
+  ptrdiff_t byte_strides[4];
+  std::vector<Label> data;
+};
+
+constexpr ptrdiff_t kBlockShape[3] = {8, 8, 8};
+
+// Arguments are the number of distinct labels and the run length.
+template <typename Label>
+void BM_Encode(benchmark::State& state) {
+  Volume<Label> volume(1, state.range(0), state.range(1));
+  for (auto s : state) {
+    std::string output;
+    EncodeChannels(volume.data.data(), volume.shape, volume.byte_strides,
+                   kBlockShape, &output);
+    benchmark::DoNotOptimize(output);
+  }
+  state.SetItemsProcessed(state.iterations() * volume.data.size());
+}
+
+template <typename Label>
+void BM_Decode(benchmark::State& state) {
+  Volume<Label> volume(1, state.range(0), state.range(1));
+  std::string encoded;
+  EncodeChannels(volume.data.data(), volume.shape, volume.byte_strides,
+                 kBlockShape, &encoded);
+  std::vector<Label> output(volume.data.size());
+  for (auto s : state) {
+    bool ok = DecodeChannels(encoded, kBlockShape, volume.shape,
+                             volume.byte_strides, output.data());
+    benchmark::DoNotOptimize(ok);
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetItemsProcessed(state.iterations() * volume.data.size());
+}
+
+// Measures encoding of 8 channels in parallel, where the argument specifies
+// the number of threads, or 0 to encode serially.
+template <typename Label>
+void BM_EncodeChannelsParallel(benchmark::State& state) {
+  Volume<Label> volume(8, 16, 8);
+  const size_t num_threads = state.range(0);
+  auto executor = tensorstore::internal::DetachedThreadPool(
+      std::max<size_t>(1, num_threads));
+  for (auto s : state) {
+    std::string output;
+    if (num_threads == 0) {
+      EncodeChannels(volume.data.data(), volume.shape, volume.byte_strides,
+                     kBlockShape, &output);
+    } else {
+      EncodeChannels(volume.data.data(), volume.shape, volume.byte_strides,
+                     kBlockShape, executor, &output);
+    }
+    benchmark::DoNotOptimize(output);
+  }
+  state.SetItemsProcessed(state.iterations() * volume.data.size());
+}
+
+void LabelArgs(benchmark::internal::Benchmark* b) {
+  for (int num_labels : {2, 16, 1000}) {
+    for (int run_length : {1, 16}) {
+      b->Args({num_labels, run_length});
+    }
+  }
+}
+
+BENCHMARK(BM_Encode<uint32_t>)->Apply(LabelArgs);
+BENCHMARK(BM_Encode<uint64_t>)->Apply(LabelArgs);
+BENCHMARK(BM_Decode<uint32_t>)->Apply(LabelArgs);
+BENCHMARK(BM_Decode<uint64_t>)->Apply(LabelArgs);
+BENCHMARK(BM_EncodeChannelsParallel<uint64_t>)
+    ->Arg(0)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->UseRealTime();
+
+}  // namespace
@@ -24,7 +24,9 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "absl/random/random.h"
+#include "tensorstore/internal/thread/thread_pool.h"
 #include "tensorstore/util/endian.h"
+#include "tensorstore/util/executor.h"
 
 namespace {
 
@@ -451,4 +453,54 @@ TEST(RoundTripTest, Random) {
                                /*num_iterations=*/100);
 }
 
+// Tests 32-bit encoding, which is required for blocks with more than 2**16
+// distinct values.
+TEST(RoundTripTest, Encoded32Bits) {
+  const ptrdiff_t input_shape[4] = {1, 1, 257, 256};
+  const ptrdiff_t block_shape[3] = {1, 257, 256};
+  std::vector<uint32_t> input(257 * 256);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<uint32_t>(input.size() - i);
+  }
+  constexpr ptrdiff_t s = sizeof(uint32_t);
+  const ptrdiff_t input_byte_strides[4] = {257 * 256 * s, 257 * 256 * s,
+                                           256 * s, s};
+  std::string output;
+  EncodeChannels(input.data(), input_shape, input_byte_strides, block_shape,
+                 &output);
+  // Block header follows the channel offset.
+  EXPECT_EQ(32, (tensorstore::little_endian::Load32(output.data() + 4) >> 24));
+  std::vector<uint32_t> decoded_output(input.size());
+  EXPECT_TRUE(DecodeChannels(output, block_shape, input_shape,
+                             input_byte_strides, decoded_output.data()));
+  EXPECT_EQ(input, decoded_output);
+}
+
+// Tests that encoding channels in parallel produces the same output as
+// encoding them serially.
+TEST(EncodeChannelsTest, Parallel) {
+  absl::BitGen gen;
+  const ptrdiff_t input_shape[4] = {5, 9, 17, 33};
+  const ptrdiff_t block_shape[3] = {4, 8, 8};
+  std::vector<uint64_t> input(5 * 9 * 17 * 33);
+  for (auto& label : input) {
+    label = absl::Uniform<uint64_t>(gen, 0, 20);
+  }
+  constexpr ptrdiff_t s = sizeof(uint64_t);
+  const ptrdiff_t input_byte_strides[4] = {9 * 17 * 33 * s, 17 * 33 * s,
+                                           33 * s, s};
+  std::string expected_output{1, 2, 3};
+  EncodeChannels(input.data(), input_shape, input_byte_strides, block_shape,
+                 &expected_output);
+  for (const auto& executor :
+       {tensorstore::Executor(tensorstore::InlineExecutor{}),
+        tensorstore::internal::DetachedThreadPool(4)}) {
+    // Use non-empty `output` to test that existing contents are preserved.
+    std::string output{1, 2, 3};
+    EncodeChannels(input.data(), input_shape, input_byte_strides, block_shape,
+                   executor, &output);
+    EXPECT_EQ(expected_output, output);
+  }
+}
+
 }  // namespace
@@ -0,0 +1,594 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/compression/shuffle.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "absl/strings/cord.h"
+
+#if (defined(__x86_64__) || defined(_M_X64)) && \
+    (defined(__GNUC__) || defined(__clang__)) && !defined(_MSC_VER)
+#define TENSORSTORE_INTERNAL_SHUFFLE_X86 1
+#include <immintrin.h>
+#define TENSORSTORE_INTERNAL_TARGET_SSSE3 __attribute__((target("ssse3")))
+#endif
+
+namespace tensorstore {
+namespace shuffle {
+namespace {
+
+// Number of elements processed at a time, chosen such that the input and
+// output of a block remain in cache while each byte position is visited.  Must
+// be a multiple of 16.
+constexpr size_t kBlockElements = 1024;
+
+ShuffleKernelIsa DetectIsa() {
+#ifdef TENSORSTORE_INTERNAL_SHUFFLE_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("ssse3")) return ShuffleKernelIsa::kSsse3;
+#endif
+  return ShuffleKernelIsa::kScalar;
+}
+
+std::atomic<ShuffleKernelIsa>& ActiveIsa() {
+  static std::atomic<ShuffleKernelIsa> isa{GetSupportedShuffleKernelIsa()};
+  return isa;
+}
+
+// The scalar loops below are written such that, for the fixed element sizes,
+// the compiler can vectorize them using the available SIMD instruction set.
+template <size_t ElementSize>
+struct FixedElementSize {
+  static constexpr size_t value = ElementSize;
+  constexpr size_t operator()() const { return ElementSize; }
+};
+
+struct DynamicElementSize {
+  size_t element_size;
+  size_t operator()() const { return element_size; }
+};
+
+template <typename Func>
+void DispatchElementSize(size_t element_size, Func func) {
+  switch (element_size) {
+    case 2:
+      return func(FixedElementSize<2>{});
+    case 4:
+      return func(FixedElementSize<4>{});
+    case 8:
+      return func(FixedElementSize<8>{});
+    default:
+      return func(DynamicElementSize{element_size});
+  }
+}
+
+// Input accessors.  `Get(offset, length, scratch)` returns a pointer to
+// `length` contiguous bytes of the input starting at `offset`, using
+// `scratch` (of at least `length` bytes) if they are not already contiguous.
+
+class FlatInput {
+ public:
+  static constexpr bool kContiguous = true;
+
+  explicit FlatInput(std::string_view data) : data_(data) {}
+
+  size_t size() const { return data_.size(); }
+
+  const unsigned char* Get(size_t offset, size_t length,
+                           unsigned char* scratch) const {
+    return reinterpret_cast<const unsigned char*>(data_.data()) + offset;
+  }
+
+ private:
+  std::string_view data_;
+};
+
+class CordInput {
+ public:
+  static constexpr bool kContiguous = false;
+
+  explicit CordInput(const absl::Cord& cord) {
+    size_t offset = 0;
+    for (std::string_view chunk : cord.Chunks()) {
+      chunks_.push_back(chunk);
+      chunk_offsets_.push_back(offset);
+      offset += chunk.size();
+    }
+    size_ = offset;
+  }
+
+  size_t size() const { return size_; }
+
+  const unsigned char* Get(size_t offset, size_t length,
+                           unsigned char* scratch) const {
+    if (length == 0) return scratch;
+    size_t i = std::upper_bound(chunk_offsets_.begin(), chunk_offsets_.end(),
+                                offset) -
+               chunk_offsets_.begin() - 1;
+    size_t chunk_offset = offset - chunk_offsets_[i];
+    if (chunk_offset + length <= chunks_[i].size()) {
+      return reinterpret_cast<const unsigned char*>(chunks_[i].data()) +
+             chunk_offset;
+    }
+    for (unsigned char* out = scratch; length > 0; ++i, chunk_offset = 0) {
+      const size_t n = std::min(length, chunks_[i].size() - chunk_offset);
+      std::memcpy(out, chunks_[i].data() + chunk_offset, n);
+      out += n;
+      length -= n;
+    }
+    return scratch;
+  }
+
+ private:
+  std::vector<std::string_view> chunks_;
+  std::vector<size_t> chunk_offsets_;
+  size_t size_;
+};
+
+// Returns a scratch buffer for reading blocks of up to `kBlockElements`
+// elements from `input`, or `nullptr` if `input` is contiguous.
+template <typename Input>
+std::unique_ptr<unsigned char[]> MakeScratch(const Input& input,
+                                             size_t element_size) {
+  if constexpr (Input::kContiguous) {
+    return nullptr;
+  } else {
+    return std::make_unique<unsigned char[]>(
+        std::min(input.size(), kBlockElements * element_size));
+  }
+}
+
+// Copies the bytes starting at `offset` that are not handled by the shuffle.
+template <typename Input>
+void CopyRemainder(size_t offset, const Input& input, char* output) {
+  if (offset >= input.size()) return;
+  const size_t length = input.size() - offset;
+  auto* out = reinterpret_cast<unsigned char*>(output) + offset;
+  const unsigned char* in = input.Get(offset, length, out);
+  if (in != out) std::memcpy(out, in, length);
+}
+
+// Byte shuffle kernels.  `planes[j]` points to byte `j` of each of the
+// `count` elements.
+
+template <typename GetElementSize>
+void ByteShuffleScalar(GetElementSize get_element_size, size_t count,
+                       const unsigned char* input,
+                       unsigned char* const* planes) {
+  const size_t element_size = get_element_size();
+  for (size_t j = 0; j < element_size; ++j) {
+    unsigned char* out = planes[j];
+    for (size_t i = 0; i < count; ++i) {
+      out[i] = input[i * element_size + j];
+    }
+  }
+}
+
+template <typename GetElementSize>
+void ByteUnshuffleScalar(GetElementSize get_element_size, size_t count,
+                         const unsigned char* const* planes,
+                         unsigned char* output) {
+  const size_t element_size = get_element_size();
+  for (size_t j = 0; j < element_size; ++j) {
+    const unsigned char* in = planes[j];
+    for (size_t i = 0; i < count; ++i) {
+      output[i * element_size + j] = in[i];
+    }
+  }
+}
+
+#ifdef TENSORSTORE_INTERNAL_SHUFFLE_X86
+
+// Each iteration transposes 16 elements, such that each byte position fills
+// one 16-byte vector.
+
+TENSORSTORE_INTERNAL_TARGET_SSSE3 inline __m128i Load(const unsigned char* p) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+
+TENSORSTORE_INTERNAL_TARGET_SSSE3 inline void Store(unsigned char* p,
+                                                    __m128i x) {
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(p), x);
+}
+
+TENSORSTORE_INTERNAL_TARGET_SSSE3 void ByteShuffle16Ssse3(
+    FixedElementSize<2>, const unsigned char* in, unsigned char* const* planes,
+    size_t i) {
+  // Groups byte 0 of each element in the low 8 bytes, and byte 1 in the high 8
+  // bytes.
+  const __m128i mask =
+      _mm_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15);
+  const __m128i v0 = _mm_shuffle_epi8(Load(in), mask);
+  const __m128i v1 = _mm_shuffle_epi8(Load(in + 16), mask);
+  Store(planes[0] + i, _mm_unpacklo_epi64(v0, v1));
+  Store(planes[1] + i, _mm_unpackhi_epi64(v0, v1));
+}
+
+TENSORSTORE_INTERNAL_TARGET_SSSE3 void ByteShuffle16Ssse3(
+    FixedElementSize<4>, const unsigned char* in, unsigned char* const* planes,
+    size_t i) {
+  // Groups byte `j` of each element in 32-bit lane `j`.
+  const __m128i mask =
+      _mm_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+  const __m128i v0 = _mm_shuffle_epi8(Load(in), mask);
+  const __m128i v1 = _mm_shuffle_epi8(Load(in + 16), mask);
+  const __m128i v2 = _mm_shuffle_epi8(Load(in + 32), mask);
+  const __m128i v3 = _mm_shuffle_epi8(Load(in + 48), mask);
+  const __m128i a0 = _mm_unpacklo_epi32(v0, v1);
+  const __m128i a1 = _mm_unpackhi_epi32(v0, v1);
+  const __m128i a2 = _mm_unpacklo_epi32(v2, v3);
+  const __m128i a3 = _mm_unpackhi_epi32(v2, v3);
+  Store(planes[0] + i, _mm_unpacklo_epi64(a0, a2));
+  Store(planes[1] + i, _mm_unpackhi_epi64(a0, a2));
+  Store(planes[2] + i, _mm_unpacklo_epi64(a1, a3));
+  Store(planes[3] + i, _mm_unpackhi_epi64(a1, a3));
+}
+
+TENSORSTORE_INTERNAL_TARGET_SSSE3 void ByteShuffle16Ssse3(
+    FixedElementSize<8>, const unsigned char* in, unsigned char* const* planes,
+    size_t i) {
+  // Groups byte `j` of both elements in 16-bit lane `j`.
+  const __m128i mask =
+      _mm_setr_epi8(0, 8, 1, 9, 2, 10, 3, 11, 4, 12, 5, 13, 6, 14, 7, 15);
+  __m128i v[8];
+  for (size_t k = 0; k < 8; ++k) {
+    v[k] = _mm_shuffle_epi8(Load(in + 16 * k), mask);
+  }
+  // 8x8 transpose of 16-bit lanes.
+  __m128i a[8], b[8];
+  for (size_t k = 0; k < 4; ++k) {
+    a[2 * k] = _mm_unpacklo_epi16(v[2 * k], v[2 * k + 1]);
+    a[2 * k + 1] = _mm_unpackhi_epi16(v[2 * k], v[2 * k + 1]);
+  }
+  for (size_t k = 0; k < 2; ++k) {
+    b[4 * k] = _mm_unpacklo_epi32(a[4 * k], a[4 * k + 2]);
+    b[4 * k + 1] = _mm_unpackhi_epi32(a[4 * k], a[4 * k + 2]);
+    b[4 * k + 2] = _mm_unpacklo_epi32(a[4 * k + 1], a[4 * k + 3]);
+    b[4 * k + 3] = _mm_unpackhi_epi32(a[4 * k + 1], a[4 * k + 3]);
+  }
+  for (size_t k = 0; k < 4; ++k) {
+    Store(planes[2 * k] + i, _mm_unpacklo_epi64(b[k], b[k + 4]));
+    Store(planes[2 * k + 1] + i, _mm_unpackhi_epi64(b[k], b[k + 4]));
+  }
+}
+
+TENSORSTORE_INTERNAL_TARGET_SSSE3 void ByteUnshuffle16Ssse3(
+    FixedElementSize<2>, const unsigned char* const* planes, size_t i,
+    unsigned char* out) {
+  const __m128i p0 = Load(planes[0] + i);
+  const __m128i p1 = Load(planes[1] + i);
+  Store(out, _mm_unpacklo_epi8(p0, p1));
+  Store(out + 16, _mm_unpackhi_epi8(p0, p1));
+}
+
+TENSORSTORE_INTERNAL_TARGET_SSSE3 void ByteUnshuffle16Ssse3(
+    FixedElementSize<4>, const unsigned char* const* planes, size_t i,
+    unsigned char* out) {
+  const __m128i p0 = Load(planes[0] + i);
+  const __m128i p1 = Load(planes[1] + i);
+  const __m128i p2 = Load(planes[2] + i);
+  const __m128i p3 = Load(planes[3] + i);
+  const __m128i q0 = _mm_unpacklo_epi8(p0, p1);
+  const __m128i q1 = _mm_unpackhi_epi8(p0, p1);
+  const __m128i q2 = _mm_unpacklo_epi8(p2, p3);
+  const __m128i q3 = _mm_unpackhi_epi8(p2, p3);
+  Store(out, _mm_unpacklo_epi16(q0, q2));
+  Store(out + 16, _mm_unpackhi_epi16(q0, q2));
+  Store(out + 32, _mm_unpacklo_epi16(q1, q3));
+  Store(out + 48, _mm_unpackhi_epi16(q1, q3));
+}
+
+TENSORSTORE_INTERNAL_TARGET_SSSE3 void ByteUnshuffle16Ssse3(
+    FixedElementSize<8>, const unsigned char* const* planes, size_t i,
+    unsigned char* out) {
+  __m128i p[8];
+  for (size_t k = 0; k < 8; ++k) p[k] = Load(planes[k] + i);
+  // Elements 0-7 come from the low halves of the planes, and elements 8-15
+  // from the high halves.
+  for (size_t h = 0; h < 2; ++h) {
+    __m128i q[4], r[4];
+    for (size_t k = 0; k < 4; ++k) {
+      q[k] = h == 0 ? _mm_unpacklo_epi8(p[2 * k], p[2 * k + 1])
+                    : _mm_unpackhi_epi8(p[2 * k], p[2 * k + 1]);
+    }
+    r[0] = _mm_unpacklo_epi16(q[0], q[1]);
+    r[1] = _mm_unpackhi_epi16(q[0], q[1]);
+    r[2] = _mm_unpacklo_epi16(q[2], q[3]);
+    r[3] = _mm_unpackhi_epi16(q[2], q[3]);
+    unsigned char* o = out + 64 * h;
+    Store(o, _mm_unpacklo_epi32(r[0], r[2]));
+    Store(o + 16, _mm_unpackhi_epi32(r[0], r[2]));
+    Store(o + 32, _mm_unpacklo_epi32(r[1], r[3]));
+    Store(o + 48, _mm_unpackhi_epi32(r[1], r[3]));
+  }
+}
+
+template <size_t ElementSize>
+TENSORSTORE_INTERNAL_TARGET_SSSE3 void ByteShuffleSsse3(
+    size_t count, const unsigned char* input, unsigned char* const* planes) {
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    ByteShuffle16Ssse3(FixedElementSize<ElementSize>{},
+                       input + i * ElementSize, planes, i);
+  }
+  unsigned char* tail_planes[ElementSize];
+  for (size_t j = 0; j < ElementSize; ++j) tail_planes[j] = planes[j] + i;
+  ByteShuffleScalar(FixedElementSize<ElementSize>{}, count - i,
+                    input + i * ElementSize, tail_planes);
+}
+
+template <size_t ElementSize>
+TENSORSTORE_INTERNAL_TARGET_SSSE3 void ByteUnshuffleSsse3(
+    size_t count, const unsigned char* const* planes, unsigned char* output) {
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    ByteUnshuffle16Ssse3(FixedElementSize<ElementSize>{}, planes, i,
+                         output + i * ElementSize);
+  }
+  const unsigned char* tail_planes[ElementSize];
+  for (size_t j = 0; j < ElementSize; ++j) tail_planes[j] = planes[j] + i;
+  ByteUnshuffleScalar(FixedElementSize<ElementSize>{}, count - i, tail_planes,
+                      output + i * ElementSize);
+}
+
+#endif  // TENSORSTORE_INTERNAL_SHUFFLE_X86
+
+template <typename GetElementSize>
+void ByteShuffleBlock(ShuffleKernelIsa isa, GetElementSize get_element_size,
+                      size_t count, const unsigned char* input,
+                      unsigned char* const* planes) {
+#ifdef TENSORSTORE_INTERNAL_SHUFFLE_X86
+  if constexpr (!std::is_same_v<GetElementSize, DynamicElementSize>) {
+    if (isa == ShuffleKernelIsa::kSsse3) {
+      return ByteShuffleSsse3<GetElementSize::value>(count, input, planes);
+    }
+  }
+#endif
+  ByteShuffleScalar(get_element_size, count, input, planes);
+}
+
+template <typename GetElementSize>
+void ByteUnshuffleBlock(ShuffleKernelIsa isa, GetElementSize get_element_size,
+                        size_t count, const unsigned char* const* planes,
+                        unsigned char* output) {
+#ifdef TENSORSTORE_INTERNAL_SHUFFLE_X86
+  if constexpr (!std::is_same_v<GetElementSize, DynamicElementSize>) {
+    if (isa == ShuffleKernelIsa::kSsse3) {
+      return ByteUnshuffleSsse3<GetElementSize::value>(count, planes, output);
+    }
+  }
+#endif
+  ByteUnshuffleScalar(get_element_size, count, planes, output);
+}
+
+// Transposes the 8x8 bit matrix in which byte `r` is row `r`, and bit `c` of
+// each byte is column `c`.
+//
+// See Hacker's Delight, 2nd edition, section 7-3.
+inline uint64_t TransposeBits8x8(uint64_t x) {
+  uint64_t t;
+  t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAull;
+  x = x ^ t ^ (t << 7);
+  t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCull;
+  x = x ^ t ^ (t << 14);
+  t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ull;
+  x = x ^ t ^ (t << 28);
+  return x;
+}
+
+// Bit shuffle kernels.  `planes[j * 8 + b]` points to bit `b` of byte `j` of
+// each of the `8 * groups` elements, packed 8 elements per byte.
+
+template <typename GetElementSize>
+void BitShuffleBlock(GetElementSize get_element_size, size_t groups,
+                     const unsigned char* input,
+                     unsigned char* const* planes) {
+  const size_t element_size = get_element_size();
+  for (size_t g = 0; g < groups; ++g) {
+    const unsigned char* in = input + g * 8 * element_size;
+    for (size_t j = 0; j < element_size; ++j) {
+      uint64_t x = 0;
+      for (size_t e = 0; e < 8; ++e) {
+        x |= static_cast<uint64_t>(in[e * element_size + j]) << (8 * e);
+      }
+      x = TransposeBits8x8(x);
+      for (size_t b = 0; b < 8; ++b) {
+        planes[j * 8 + b][g] = static_cast<unsigned char>(x >> (8 * b));
+      }
+    }
+  }
+}
+
+template <typename GetElementSize>
+void BitUnshuffleBlock(GetElementSize get_element_size, size_t groups,
+                       const unsigned char* const* planes,
+                       unsigned char* output) {
+  const size_t element_size = get_element_size();
+  for (size_t g = 0; g < groups; ++g) {
+    unsigned char* out = output + g * 8 * element_size;
+    for (size_t j = 0; j < element_size; ++j) {
+      uint64_t x = 0;
+      for (size_t b = 0; b < 8; ++b) {
+        x |= static_cast<uint64_t>(planes[j * 8 + b][g]) << (8 * b);
+      }
+      x = TransposeBits8x8(x);
+      for (size_t e = 0; e < 8; ++e) {
+        out[e * element_size + j] = static_cast<unsigned char>(x >> (8 * e));
+      }
+    }
+  }
+}
+
+template <typename Input>
+void ByteShuffleImpl(size_t element_size, const Input& input, char* output) {
+  assert(element_size > 0);
+  const size_t n = input.size() / element_size;
+  const ShuffleKernelIsa isa = ActiveIsa().load(std::memory_order_relaxed);
+  auto scratch = MakeScratch(input, element_size);
+  auto* out = reinterpret_cast<unsigned char*>(output);
+  std::vector<unsigned char*> planes(element_size);
+  DispatchElementSize(element_size, [&](auto get_element_size) {
+    for (size_t block = 0; block < n; block += kBlockElements) {
+      const size_t count = std::min(n - block, kBlockElements);
+      for (size_t j = 0; j < element_size; ++j) {
+        planes[j] = out + j * n + block;
+      }
+      ByteShuffleBlock(
+          isa, get_element_size, count,
+          input.Get(block * element_size, count * element_size, scratch.get()),
+          planes.data());
+    }
+  });
+  CopyRemainder(n * element_size, input, output);
+}
+
+template <typename Input>
+void ByteUnshuffleImpl(size_t element_size, const Input& input, char* output) {
+  assert(element_size > 0);
+  const size_t n = input.size() / element_size;
+  const ShuffleKernelIsa isa = ActiveIsa().load(std::memory_order_relaxed);
+  auto scratch = MakeScratch(input, element_size);
+  auto* out = reinterpret_cast<unsigned char*>(output);
+  std::vector<const unsigned char*> planes(element_size);
+  DispatchElementSize(element_size, [&](auto get_element_size) {
+    for (size_t block = 0; block < n; block += kBlockElements) {
+      const size_t count = std::min(n - block, kBlockElements);
+      for (size_t j = 0; j < element_size; ++j) {
+        planes[j] =
+            input.Get(j * n + block, count, scratch.get() + j * count);
+      }
+      ByteUnshuffleBlock(isa, get_element_size, count, planes.data(),
+                         out + block * element_size);
+    }
+  });
+  CopyRemainder(n * element_size, input, output);
+}
+
+template <typename Input>
+void BitShuffleImpl(size_t element_size, const Input& input, char* output) {
+  assert(element_size > 0);
+  const size_t n = input.size() / element_size;
+  const size_t m = n - n % 8;
+  const size_t plane_size = m / 8;
+  auto scratch = MakeScratch(input, element_size);
+  auto* out = reinterpret_cast<unsigned char*>(output);
+  std::vector<unsigned char*> planes(8 * element_size);
+  DispatchElementSize(element_size, [&](auto get_element_size) {
+    for (size_t block = 0; block < m; block += kBlockElements) {
+      const size_t count = std::min(m - block, kBlockElements);
+      for (size_t k = 0; k < 8 * element_size; ++k) {
+        planes[k] = out + k * plane_size + block / 8;
+      }
+      BitShuffleBlock(
+          get_element_size, count / 8,
+          input.Get(block * element_size, count * element_size, scratch.get()),
+          planes.data());
+    }
+  });
+  CopyRemainder(m * element_size, input, output);
+}
+
+template <typename Input>
+void BitUnshuffleImpl(size_t element_size, const Input& input, char* output) {
+  assert(element_size > 0);
+  const size_t n = input.size() / element_size;
+  const size_t m = n - n % 8;
+  const size_t plane_size = m / 8;
+  auto scratch = MakeScratch(input, element_size);
+  auto* out = reinterpret_cast<unsigned char*>(output);
+  std::vector<const unsigned char*> planes(8 * element_size);
+  DispatchElementSize(element_size, [&](auto get_element_size) {
+    for (size_t block = 0; block < m; block += kBlockElements) {
+      const size_t groups = std::min(m - block, kBlockElements) / 8;
+      for (size_t k = 0; k < 8 * element_size; ++k) {
+        planes[k] = input.Get(k * plane_size + block / 8, groups,
+                              scratch.get() + k * groups);
+      }
+      BitUnshuffleBlock(get_element_size, groups, planes.data(),
+                        out + block * element_size);
+    }
+  });
+  CopyRemainder(m * element_size, input, output);
+}
+
+}  // namespace
+
+ShuffleKernelIsa GetSupportedShuffleKernelIsa() {
+  static const ShuffleKernelIsa isa = DetectIsa();
+  return isa;
+}
+
+void SetShuffleKernelIsaForTesting(ShuffleKernelIsa isa) {
+  ActiveIsa().store(std::min(isa, GetSupportedShuffleKernelIsa()),
+                    std::memory_order_relaxed);
+}
+
+void ByteShuffle(size_t element_size, std::string_view input, char* output) {
+  ByteShuffleImpl(element_size, FlatInput(input), output);
+}
+
+void ByteShuffle(size_t element_size, const absl::Cord& input, char* output) {
+  if (auto flat = input.TryFlat()) {
+    return ByteShuffle(element_size, *flat, output);
+  }
+  ByteShuffleImpl(element_size, CordInput(input), output);
+}
+
+void ByteUnshuffle(size_t element_size, std::string_view input, char* output) {
+  ByteUnshuffleImpl(element_size, FlatInput(input), output);
+}
+
+void ByteUnshuffle(size_t element_size, const absl::Cord& input,
+                   char* output) {
+  if (auto flat = input.TryFlat()) {
+    return ByteUnshuffle(element_size, *flat, output);
+  }
+  ByteUnshuffleImpl(element_size, CordInput(input), output);
+}
+
+void BitShuffle(size_t element_size, std::string_view input, char* output) {
+  BitShuffleImpl(element_size, FlatInput(input), output);
+}
+
+void BitShuffle(size_t element_size, const absl::Cord& input, char* output) {
+  if (auto flat = input.TryFlat()) {
+    return BitShuffle(element_size, *flat, output);
+  }
+  BitShuffleImpl(element_size, CordInput(input), output);
+}
+
+void BitUnshuffle(size_t element_size, std::string_view input, char* output) {
+  BitUnshuffleImpl(element_size, FlatInput(input), output);
+}
+
+void BitUnshuffle(size_t element_size, const absl::Cord& input, char* output) {
+  if (auto flat = input.TryFlat()) {
+    return BitUnshuffle(element_size, *flat, output);
+  }
+  BitUnshuffleImpl(element_size, CordInput(input), output);
+}
+
+}  // namespace shuffle
+}  // namespace tensorstore
@@ -0,0 +1,92 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_COMPRESSION_SHUFFLE_H_
+#define TENSORSTORE_INTERNAL_COMPRESSION_SHUFFLE_H_
+
+/// Byte-shuffle and bit-shuffle filters, which improve the compression ratio of
+/// numerical data by grouping together the corresponding bytes (or bits) of
+/// each element.
+///
+/// On x86-64, byte shuffling of 2, 4 and 8 byte elements uses SSSE3 kernels
+/// (`pshufb`) if supported by the CPU, selected at run time.
+
+#include <stddef.h>
+
+#include <string_view>
+
+#include "absl/strings/cord.h"
+
+namespace tensorstore {
+namespace shuffle {
+
+/// Instruction set used by the byte shuffling kernels.
+enum class ShuffleKernelIsa {
+  kScalar = 0,
+  kSsse3 = 1,
+};
+
+/// Returns the best instruction set supported by the CPU.
+ShuffleKernelIsa GetSupportedShuffleKernelIsa();
+
+/// Limits the byte shuffling kernels to `isa`, or the best supported
+/// instruction set if that is lower.  Intended for testing and benchmarking.
+void SetShuffleKernelIsaForTesting(ShuffleKernelIsa isa);
+
+/// Byte-shuffles `input`, viewed as a sequence of `n = input.size() /
+/// element_size` elements of `element_size` bytes.
+///
+/// Byte `j` of element `i` is written to `output[j * n + i]`.  The remaining
+/// `input.size() % element_size` bytes are copied unchanged to the end of
+/// `output`.
+///
+/// \param element_size Element size in bytes, must be positive.
+/// \param input The input data.
+/// \param output Output buffer of `input.size()` bytes, must not overlap
+///     `input`.
+void ByteShuffle(size_t element_size, std::string_view input, char* output);
+void ByteShuffle(size_t element_size, const absl::Cord& input, char* output);
+
+/// Inverts `ByteShuffle`.
+void ByteUnshuffle(size_t element_size, std::string_view input, char* output);
+void ByteUnshuffle(size_t element_size, const absl::Cord& input, char* output);
+
+/// Bit-shuffles `input`, viewed as a sequence of `n = input.size() /
+/// element_size` elements of `element_size` bytes.
+///
+/// The first `m = n - n % 8` elements are transposed into `8 * element_size`
+/// bit planes of `m / 8` bytes each.  Bit `b` of byte `j` of element `i` is
+/// written to bit `i % 8` of byte `(j * 8 + b) * (m / 8) + i / 8` of `output`,
+/// where bits are numbered from least significant.  The remaining bytes of
+/// `input`, starting at byte `m * element_size`, are copied unchanged.
+///
+/// \param element_size Element size in bytes, must be positive.
+/// \param input The input data.
+/// \param output Output buffer of `input.size()` bytes, must not overlap
+///     `input`.
+void BitShuffle(size_t element_size, std::string_view input, char* output);
+void BitShuffle(size_t element_size, const absl::Cord& input, char* output);
+
+/// Inverts `BitShuffle`.
+void BitUnshuffle(size_t element_size, std::string_view input, char* output);
+void BitUnshuffle(size_t element_size, const absl::Cord& input, char* output);
+
+// The `absl::Cord` overloads are equivalent to the `std::string_view`
+// overloads applied to the flattened cord, but process the cord one chunk at a
+// time rather than flattening it.
+
+}  // namespace shuffle
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_COMPRESSION_SHUFFLE_H_
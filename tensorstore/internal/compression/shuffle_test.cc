@@ -0,0 +1,146 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/compression/shuffle.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "absl/random/random.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/cord_test_helpers.h"
+
+namespace {
+
+namespace shuffle = tensorstore::shuffle;
+using ::tensorstore::shuffle::ShuffleKernelIsa;
+
+std::string RandomBytes(size_t size) {
+  absl::BitGen gen;
+  std::string s(size, '\0');
+  for (auto& c : s) c = static_cast<char>(absl::Uniform<uint8_t>(gen));
+  return s;
+}
+
+// Returns `s` split into fragments of varying sizes.
+absl::Cord MakeFragmented(const std::string& s) {
+  std::vector<std::string> fragments;
+  for (size_t i = 0, n = 1; i < s.size(); i += n, n = n * 7 % 1999 + 1) {
+    fragments.push_back(s.substr(i, n));
+  }
+  return absl::MakeFragmentedCord(fragments);
+}
+
+TEST(ShuffleTest, ByteShuffle) {
+  const std::string input("\x01\x02\x03\x04\x05\x06\x07", 7);
+  std::string output(input.size(), '\0');
+  shuffle::ByteShuffle(2, input, output.data());
+  EXPECT_EQ(std::string("\x01\x03\x05\x02\x04\x06\x07", 7), output);
+}
+
+TEST(ShuffleTest, BitShuffle) {
+  // 8 elements of 1 byte form a single 8x8 bit matrix, followed by 1 byte that
+  // is copied unchanged.
+  const std::string input("\x01\x01\x01\x01\x01\x01\x01\x80\xff", 9);
+  std::string output(input.size(), '\0');
+  shuffle::BitShuffle(1, input, output.data());
+  EXPECT_EQ(std::string("\x7f\x00\x00\x00\x00\x00\x00\x80\xff", 9), output);
+}
+
+class ShuffleRoundTripTest
+    : public ::testing::TestWithParam<
+          std::tuple<size_t, size_t, ShuffleKernelIsa>> {
+ protected:
+  void SetUp() override {
+    shuffle::SetShuffleKernelIsaForTesting(std::get<2>(GetParam()));
+  }
+  void TearDown() override {
+    shuffle::SetShuffleKernelIsaForTesting(
+        shuffle::GetSupportedShuffleKernelIsa());
+  }
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    ShuffleRoundTripTestCases, ShuffleRoundTripTest,
+    ::testing::Combine(::testing::Values(1, 2, 3, 4, 8, 16),
+                       ::testing::Values(0, 1, 7, 8, 64, 65, 5003, 70000),
+                       ::testing::Values(ShuffleKernelIsa::kScalar,
+                                         ShuffleKernelIsa::kSsse3)));
+
+TEST_P(ShuffleRoundTripTest, ByteShuffle) {
+  const auto [element_size, size, isa] = GetParam();
+  const std::string input = RandomBytes(size);
+  std::string shuffled(size, '\0'), unshuffled(size, '\0');
+  shuffle::ByteShuffle(element_size, input, shuffled.data());
+  const size_t n = size / element_size;
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t j = 0; j < element_size; ++j) {
+      ASSERT_EQ(input[i * element_size + j], shuffled[j * n + i]);
+    }
+  }
+  shuffle::ByteUnshuffle(element_size, shuffled, unshuffled.data());
+  EXPECT_EQ(input, unshuffled);
+}
+
+TEST_P(ShuffleRoundTripTest, ByteShuffleFragmented) {
+  const auto [element_size, size, isa] = GetParam();
+  const std::string input = RandomBytes(size);
+  std::string expected(size, '\0'), shuffled(size, '\0'),
+      unshuffled(size, '\0');
+  shuffle::ByteShuffle(element_size, input, expected.data());
+  shuffle::ByteShuffle(element_size, MakeFragmented(input), shuffled.data());
+  EXPECT_EQ(expected, shuffled);
+  shuffle::ByteUnshuffle(element_size, MakeFragmented(shuffled),
+                         unshuffled.data());
+  EXPECT_EQ(input, unshuffled);
+}
+
+TEST_P(ShuffleRoundTripTest, BitShuffleFragmented) {
+  const auto [element_size, size, isa] = GetParam();
+  const std::string input = RandomBytes(size);
+  std::string expected(size, '\0'), shuffled(size, '\0'),
+      unshuffled(size, '\0');
+  shuffle::BitShuffle(element_size, input, expected.data());
+  shuffle::BitShuffle(element_size, MakeFragmented(input), shuffled.data());
+  EXPECT_EQ(expected, shuffled);
+  shuffle::BitUnshuffle(element_size, MakeFragmented(shuffled),
+                        unshuffled.data());
+  EXPECT_EQ(input, unshuffled);
+}
+
+TEST_P(ShuffleRoundTripTest, BitShuffle) {
+  const auto [element_size, size, isa] = GetParam();
+  const std::string input = RandomBytes(size);
+  std::string shuffled(size, '\0'), unshuffled(size, '\0');
+  shuffle::BitShuffle(element_size, input, shuffled.data());
+  const size_t n = size / element_size;
+  const size_t m = n - n % 8;
+  for (size_t i = 0; i < m; ++i) {
+    for (size_t j = 0; j < element_size; ++j) {
+      for (size_t b = 0; b < 8; ++b) {
+        ASSERT_EQ((input[i * element_size + j] >> b) & 1,
+                  (shuffled[(j * 8 + b) * (m / 8) + i / 8] >> (i % 8)) & 1);
+      }
+    }
+  }
+  shuffle::BitUnshuffle(element_size, shuffled, unshuffled.data());
+  EXPECT_EQ(input, unshuffled);
+}
+
+}  // namespace
@@ -0,0 +1,375 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "tensorstore/internal/data_type_conversion_kernels.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+
+#include "absl/base/attributes.h"
+#include <half.hpp>
+#include "tensorstore/index.h"
+#include "tensorstore/util/bfloat16.h"
+#include "tensorstore/util/float8.h"
+#include "tensorstore/util/mxfloat.h"
+
+#if (defined(__x86_64__) || defined(_M_X64)) && \
+    (defined(__GNUC__) || defined(__clang__)) && !defined(_MSC_VER)
+#define TENSORSTORE_INTERNAL_CONVERSION_KERNELS_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#define TENSORSTORE_INTERNAL_TARGET_AVX2 __attribute__((target("avx2,f16c")))
+#define TENSORSTORE_INTERNAL_TARGET_AVX512 \
+  __attribute__((target("avx2,f16c,avx512f")))
+#endif
+
+namespace tensorstore {
+namespace internal_data_type {
+namespace {
+
+ConversionKernelIsa DetectIsa() {
+#ifdef TENSORSTORE_INTERNAL_CONVERSION_KERNELS_X86
+  __builtin_cpu_init();
+  // `__builtin_cpu_supports` also verifies that the OS saves the extended
+  // register state.  F16C is checked separately since not all compilers
+  // recognize it.
+  unsigned int eax, ebx, ecx, edx;
+  const bool has_f16c =
+      __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_F16C);
+  if (!has_f16c || !__builtin_cpu_supports("avx2")) {
+    return ConversionKernelIsa::kScalar;
+  }
+  if (__builtin_cpu_supports("avx512f")) return ConversionKernelIsa::kAvx512;
+  return ConversionKernelIsa::kAvx2;
+#else
+  return ConversionKernelIsa::kScalar;
+#endif
+}
+
+std::atomic<ConversionKernelIsa>& ActiveIsa() {
+  static std::atomic<ConversionKernelIsa> isa{
+      GetSupportedConversionKernelIsa()};
+  return isa;
+}
+
+// Portable kernels.
+
+template <typename From, typename To>
+ABSL_ATTRIBUTE_ALWAYS_INLINE inline void ConvertLoop(
+    const From* __restrict from, To* __restrict to, Index count) {
+  // Blocks with a constant trip count are vectorized even by compilers that
+  // do not vectorize loops with a variable trip count at `-O2`.
+  constexpr Index kBlockSize = 16;
+  Index i = 0;
+  for (; i + kBlockSize <= count; i += kBlockSize) {
+    for (Index j = 0; j < kBlockSize; ++j) {
+      to[i + j] = static_cast<To>(from[i + j]);
+    }
+  }
+  for (; i < count; ++i) {
+    to[i] = static_cast<To>(from[i]);
+  }
+}
+
+template <typename From, typename To>
+void ConvertScalar(const From* from, To* to, Index count) {
+  ConvertLoop(from, to, count);
+}
+
+// The low-precision floating point types have at most 256 distinct values,
+// which are converted by table lookup.
+template <typename From, typename To>
+const std::array<To, 256>& GetLookupTable() {
+  static_assert(sizeof(From) == 1);
+  static const std::array<To, 256> table = [] {
+    std::array<To, 256> table;
+    for (int i = 0; i < 256; ++i) {
+      table[i] = static_cast<To>(From::FromRep(static_cast<uint8_t>(i)));
+    }
+    return table;
+  }();
+  return table;
+}
+
+template <typename From, typename To>
+void ConvertLookup(const From* from, To* to, Index count) {
+  const auto& table = GetLookupTable<From, To>();
+  for (Index i = 0; i < count; ++i) {
+    to[i] = table[from[i].rep()];
+  }
+}
+
+#ifdef TENSORSTORE_INTERNAL_CONVERSION_KERNELS_X86
+
+template <typename From, typename To>
+TENSORSTORE_INTERNAL_TARGET_AVX2 void ConvertAvx2(const From* from, To* to,
+                                                  Index count) {
+  ConvertLoop(from, to, count);
+}
+
+template <typename From, typename To>
+TENSORSTORE_INTERNAL_TARGET_AVX512 void ConvertAvx512(const From* from, To* to,
+                                                      Index count) {
+  ConvertLoop(from, to, count);
+}
+
+// bfloat16 -> float32 just shifts the bits into the upper half.
+
+TENSORSTORE_INTERNAL_TARGET_AVX2 void Bfloat16ToFloat32Avx2(
+    const BFloat16* from, float* to, Index count) {
+  Index i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256i x = _mm256_cvtepu16_epi32(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(from + i)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(to + i),
+                        _mm256_slli_epi32(x, 16));
+  }
+  ConvertScalar(from + i, to + i, count - i);
+}
+
+TENSORSTORE_INTERNAL_TARGET_AVX512 void Bfloat16ToFloat32Avx512(
+    const BFloat16* from, float* to, Index count) {
+  Index i = 0;
+  for (; i + 16 <= count; i += 16) {
+    __m512i x = _mm512_cvtepu16_epi32(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(from + i)));
+    _mm512_storeu_si512(to + i, _mm512_slli_epi32(x, 16));
+  }
+  Bfloat16ToFloat32Avx2(from + i, to + i, count - i);
+}
+
+// float32 -> bfloat16 rounds to nearest even, and preserves NaN values by
+// setting a mantissa bit that is retained after truncation, exactly as
+// `internal::Float32ToBfloat16RoundNearestEven`.
+
+TENSORSTORE_INTERNAL_TARGET_AVX2 inline __m256i Float32ToBfloat16Bits(
+    __m256i bits) {
+  const __m256i lsb =
+      _mm256_and_si256(_mm256_srli_epi32(bits, 16), _mm256_set1_epi32(1));
+  const __m256i rounded = _mm256_add_epi32(
+      bits, _mm256_add_epi32(lsb, _mm256_set1_epi32(0x7fff)));
+  const __m256i nan = _mm256_or_si256(bits, _mm256_set1_epi32(0x00200000));
+  const __m256 f = _mm256_castsi256_ps(bits);
+  const __m256i is_nan =
+      _mm256_castps_si256(_mm256_cmp_ps(f, f, _CMP_UNORD_Q));
+  return _mm256_srli_epi32(_mm256_blendv_epi8(rounded, nan, is_nan), 16);
+}
+
+TENSORSTORE_INTERNAL_TARGET_AVX2 void Float32ToBfloat16Avx2(
+    const float* from, BFloat16* to, Index count) {
+  Index i = 0;
+  for (; i + 16 <= count; i += 16) {
+    __m256i a = Float32ToBfloat16Bits(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(from + i)));
+    __m256i b = Float32ToBfloat16Bits(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(from + i + 8)));
+    // `packus` interleaves the 128-bit lanes of `a` and `b`.
+    __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(a, b),
+                                              _MM_SHUFFLE(3, 1, 2, 0));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(to + i), packed);
+  }
+  ConvertScalar(from + i, to + i, count - i);
+}
+
+TENSORSTORE_INTERNAL_TARGET_AVX512 void Float32ToBfloat16Avx512(
+    const float* from, BFloat16* to, Index count) {
+  const __m512i one = _mm512_set1_epi32(1);
+  const __m512i bias = _mm512_set1_epi32(0x7fff);
+  const __m512i quiet = _mm512_set1_epi32(0x00200000);
+  Index i = 0;
+  for (; i + 16 <= count; i += 16) {
+    const __m512i bits = _mm512_loadu_si512(from + i);
+    const __m512i lsb = _mm512_and_si512(_mm512_srli_epi32(bits, 16), one);
+    const __m512i rounded =
+        _mm512_add_epi32(bits, _mm512_add_epi32(lsb, bias));
+    const __m512 f = _mm512_castsi512_ps(bits);
+    const __mmask16 is_nan = _mm512_cmp_ps_mask(f, f, _CMP_UNORD_Q);
+    const __m512i result = _mm512_srli_epi32(
+        _mm512_mask_or_epi32(rounded, is_nan, bits, quiet), 16);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(to + i),
+                        _mm512_cvtepi32_epi16(result));
+  }
+  Float32ToBfloat16Avx2(from + i, to + i, count - i);
+}
+
+// float16 <-> float32 use the F16C conversion instructions, which round to
+// nearest even like `half_float::half`.
+
+TENSORSTORE_INTERNAL_TARGET_AVX2 void Float16ToFloat32Avx2(
+    const half_float::half* from, float* to, Index count) {
+  Index i = 0;
+  for (; i + 8 <= count; i += 8) {
+    _mm256_storeu_ps(to + i, _mm256_cvtph_ps(_mm_loadu_si128(
+                                 reinterpret_cast<const __m128i*>(from + i))));
+  }
+  ConvertScalar(from + i, to + i, count - i);
+}
+
+TENSORSTORE_INTERNAL_TARGET_AVX512 void Float16ToFloat32Avx512(
+    const half_float::half* from, float* to, Index count) {
+  Index i = 0;
+  for (; i + 16 <= count; i += 16) {
+    _mm512_storeu_ps(to + i,
+                     _mm512_cvtph_ps(_mm256_loadu_si256(
+                         reinterpret_cast<const __m256i*>(from + i))));
+  }
+  Float16ToFloat32Avx2(from + i, to + i, count - i);
+}
+
+TENSORSTORE_INTERNAL_TARGET_AVX2 void Float32ToFloat16Avx2(
+    const float* from, half_float::half* to, Index count) {
+  Index i = 0;
+  for (; i + 8 <= count; i += 8) {
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i*>(to + i),
+        _mm256_cvtps_ph(_mm256_loadu_ps(from + i),
+                        _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+  }
+  ConvertScalar(from + i, to + i, count - i);
+}
+
+TENSORSTORE_INTERNAL_TARGET_AVX512 void Float32ToFloat16Avx512(
+    const float* from, half_float::half* to, Index count) {
+  Index i = 0;
+  for (; i + 16 <= count; i += 16) {
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(to + i),
+        _mm512_cvtps_ph(_mm512_loadu_ps(from + i),
+                        _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+  }
+  Float32ToFloat16Avx2(from + i, to + i, count - i);
+}
+
+#endif  // TENSORSTORE_INTERNAL_CONVERSION_KERNELS_X86
+
+// Selects the kernel for each conversion.
+template <typename From, typename To>
+struct Kernels {
+  using Fn = void (*)(const From*, To*, Index);
+  static constexpr Fn kScalar = &ConvertScalar<From, To>;
+#ifdef TENSORSTORE_INTERNAL_CONVERSION_KERNELS_X86
+  static constexpr Fn kAvx2 = &ConvertAvx2<From, To>;
+  static constexpr Fn kAvx512 = &ConvertAvx512<From, To>;
+#endif
+};
+
+#define TENSORSTORE_INTERNAL_DEFINE_KERNELS(FROM, TO, SCALAR, AVX2, AVX512) \
+  template <>                                                               \
+  struct Kernels<FROM, TO> {                                                \
+    using Fn = void (*)(const FROM*, TO*, Index);                           \
+    static constexpr Fn kScalar = SCALAR;                                   \
+    static constexpr Fn kAvx2 = AVX2;                                       \
+    static constexpr Fn kAvx512 = AVX512;                                   \
+  };                                                                        \
+  /**/
+
+#ifdef TENSORSTORE_INTERNAL_CONVERSION_KERNELS_X86
+TENSORSTORE_INTERNAL_DEFINE_KERNELS(BFloat16, float,
+                                    (&ConvertScalar<BFloat16, float>),
+                                    &Bfloat16ToFloat32Avx2,
+                                    &Bfloat16ToFloat32Avx512)
+TENSORSTORE_INTERNAL_DEFINE_KERNELS(float, BFloat16,
+                                    (&ConvertScalar<float, BFloat16>),
+                                    &Float32ToBfloat16Avx2,
+                                    &Float32ToBfloat16Avx512)
+TENSORSTORE_INTERNAL_DEFINE_KERNELS(half_float::half, float,
+                                    (&ConvertScalar<half_float::half, float>),
+                                    &Float16ToFloat32Avx2,
+                                    &Float16ToFloat32Avx512)
+TENSORSTORE_INTERNAL_DEFINE_KERNELS(float, half_float::half,
+                                    (&ConvertScalar<float, half_float::half>),
+                                    &Float32ToFloat16Avx2,
+                                    &Float32ToFloat16Avx512)
+#endif  // TENSORSTORE_INTERNAL_CONVERSION_KERNELS_X86
+
+#ifdef TENSORSTORE_INTERNAL_CONVERSION_KERNELS_X86
+#define TENSORSTORE_INTERNAL_DEFINE_LOOKUP_KERNELS(FROM, TO)               \
+  TENSORSTORE_INTERNAL_DEFINE_KERNELS(FROM, TO, (&ConvertLookup<FROM, TO>), \
+                                      (&ConvertLookup<FROM, TO>),           \
+                                      (&ConvertLookup<FROM, TO>))           \
+  /**/
+#else
+#define TENSORSTORE_INTERNAL_DEFINE_LOOKUP_KERNELS(FROM, TO)               \
+  template <>                                                              \
+  struct Kernels<FROM, TO> {                                               \
+    using Fn = void (*)(const FROM*, TO*, Index);                          \
+    static constexpr Fn kScalar = &ConvertLookup<FROM, TO>;                \
+  };                                                                       \
+  /**/
+#endif
+
+#define TENSORSTORE_INTERNAL_DEFINE_FLOAT8_KERNELS(FROM)               \
+  TENSORSTORE_INTERNAL_FOR_EACH_FLOAT8_CONVERSION(                     \
+      TENSORSTORE_INTERNAL_DEFINE_LOOKUP_KERNELS, ::tensorstore::FROM) \
+  /**/
+
+TENSORSTORE_INTERNAL_DEFINE_FLOAT8_KERNELS(Float8e3m4)
+TENSORSTORE_INTERNAL_DEFINE_FLOAT8_KERNELS(Float8e4m3fn)
+TENSORSTORE_INTERNAL_DEFINE_FLOAT8_KERNELS(Float8e4m3fnuz)
+TENSORSTORE_INTERNAL_DEFINE_FLOAT8_KERNELS(Float8e4m3b11fnuz)
+TENSORSTORE_INTERNAL_DEFINE_LOOKUP_KERNELS(::tensorstore::Float8e5m2, float)
+TENSORSTORE_INTERNAL_DEFINE_LOOKUP_KERNELS(::tensorstore::Float8e5m2,
+                                           ::tensorstore::BFloat16)
+TENSORSTORE_INTERNAL_DEFINE_FLOAT8_KERNELS(Float8e5m2fnuz)
+TENSORSTORE_INTERNAL_DEFINE_FLOAT8_KERNELS(Float8e8m0fnu)
+TENSORSTORE_INTERNAL_DEFINE_FLOAT8_KERNELS(Float4e2m1fn)
+
+#undef TENSORSTORE_INTERNAL_DEFINE_FLOAT8_KERNELS
+#undef TENSORSTORE_INTERNAL_DEFINE_LOOKUP_KERNELS
+#undef TENSORSTORE_INTERNAL_DEFINE_KERNELS
+
+}  // namespace
+
+ConversionKernelIsa GetSupportedConversionKernelIsa() {
+  static const ConversionKernelIsa isa = DetectIsa();
+  return isa;
+}
+
+ConversionKernelIsa GetConversionKernelIsa() {
+  return ActiveIsa().load(std::memory_order_relaxed);
+}
+
+void SetConversionKernelIsaForTesting(ConversionKernelIsa isa) {
+  ActiveIsa().store(std::min(isa, GetSupportedConversionKernelIsa()),
+                    std::memory_order_relaxed);
+}
+
+template <typename From, typename To>
+void ConvertContiguous(const From* from, To* to, Index count) {
+  using K = Kernels<From, To>;
+#ifdef TENSORSTORE_INTERNAL_CONVERSION_KERNELS_X86
+  switch (GetConversionKernelIsa()) {
+    case ConversionKernelIsa::kAvx512:
+      return K::kAvx512(from, to, count);
+    case ConversionKernelIsa::kAvx2:
+      return K::kAvx2(from, to, count);
+    case ConversionKernelIsa::kScalar:
+      break;
+  }
+#endif
+  return K::kScalar(from, to, count);
+}
+
+#define TENSORSTORE_INTERNAL_INSTANTIATE_CONVERT_CONTIGUOUS(FROM, TO) \
+  template void ConvertContiguous<FROM, TO>(const FROM*, TO*, Index); \
+  /**/
+TENSORSTORE_INTERNAL_FOR_EACH_VECTORIZED_CONVERSION(
+    TENSORSTORE_INTERNAL_INSTANTIATE_CONVERT_CONTIGUOUS)
+#undef TENSORSTORE_INTERNAL_INSTANTIATE_CONVERT_CONTIGUOUS
+
+}  // namespace internal_data_type
+}  // namespace tensorstore
@@ -0,0 +1,139 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef TENSORSTORE_INTERNAL_DATA_TYPE_CONVERSION_KERNELS_H_
+#define TENSORSTORE_INTERNAL_DATA_TYPE_CONVERSION_KERNELS_H_
+
+/// \file
+/// Vectorized kernels for converting contiguous buffers between numeric data
+/// types.
+///
+/// The per-element conversion functions defined by `ConvertDataType` are
+/// invoked through `ElementwiseFunction`, which for the low-precision floating
+/// point types results in a scalar loop.  The kernels defined here are used
+/// instead for contiguous buffers (`IterationBufferKind::kContiguous`), and
+/// produce results identical to the per-element conversions.
+///
+/// On x86-64, the kernel variant is selected at run time based on the
+/// instruction sets supported by the CPU:
+///
+/// - float32 <-> bfloat16 and float32 <-> float16 are implemented explicitly
+///   using AVX2 (with F16C) and AVX-512F intrinsics.
+///
+/// - Integer -> float and float32 <-> float64 use a simple loop that is
+///   compiled separately for each instruction set and auto-vectorized.
+///
+/// - float8 and float4 -> float32/bfloat16/float16 use a 256-entry lookup
+///   table computed from the per-element conversion.  (float8_e5m2 ->
+///   float16 is excluded, since it is just a shift that is already
+///   vectorized.)
+///
+/// On other platforms, only the portable variant is available.
+
+#include <stdint.h>
+
+#include <half.hpp>
+#include "tensorstore/index.h"
+#include "tensorstore/util/bfloat16.h"
+#include "tensorstore/util/float8.h"
+#include "tensorstore/util/mxfloat.h"
+
+namespace tensorstore {
+namespace internal_data_type {
+
+/// Instruction set used by the conversion kernels.
+enum class ConversionKernelIsa {
+  kScalar = 0,
+  kAvx2 = 1,
+  kAvx512 = 2,
+};
+
+/// Returns the best instruction set supported by the CPU.
+ConversionKernelIsa GetSupportedConversionKernelIsa();
+
+/// Returns the instruction set currently used by the conversion kernels.
+ConversionKernelIsa GetConversionKernelIsa();
+
+/// Limits the conversion kernels to `isa`, or the best supported instruction
+/// set if that is lower.  Intended for testing and benchmarking.
+void SetConversionKernelIsaForTesting(ConversionKernelIsa isa);
+
+/// Converts `count` contiguous elements of `from` to `to`.
+///
+/// Equivalent to `to[i] = static_cast<To>(from[i])` for `0 <= i < count`,
+/// except that the payload of a signaling NaN may be quieted when converting
+/// float16 -> float32 (which matches the behavior of the per-element
+/// conversion when F16C instructions are enabled at compile time).
+///
+/// Only defined for the pairs listed by
+/// `TENSORSTORE_INTERNAL_FOR_EACH_VECTORIZED_CONVERSION`.
+///
+/// \dchecks `from` and `to` do not overlap.
+template <typename From, typename To>
+void ConvertContiguous(const From* from, To* to, Index count);
+
+#define TENSORSTORE_INTERNAL_FOR_EACH_FLOAT8_CONVERSION(X, FROM, ...) \
+  X(FROM, float, ##__VA_ARGS__)                                       \
+  X(FROM, ::tensorstore::BFloat16, ##__VA_ARGS__)                     \
+  X(FROM, ::half_float::half, ##__VA_ARGS__)                          \
+  /**/
+
+#define TENSORSTORE_INTERNAL_FOR_EACH_INT_CONVERSION(X, FROM, ...) \
+  X(FROM, float, ##__VA_ARGS__)                                    \
+  X(FROM, double, ##__VA_ARGS__)                                   \
+  /**/
+
+/// Invokes `X(From, To, ...)` for each pair of element types supported by
+/// `ConvertContiguous`.
+#define TENSORSTORE_INTERNAL_FOR_EACH_VECTORIZED_CONVERSION(X, ...)          \
+  X(float, ::tensorstore::BFloat16, ##__VA_ARGS__)                           \
+  X(::tensorstore::BFloat16, float, ##__VA_ARGS__)                           \
+  X(float, ::half_float::half, ##__VA_ARGS__)                                \
+  X(::half_float::half, float, ##__VA_ARGS__)                                \
+  X(float, double, ##__VA_ARGS__)                                            \
+  X(double, float, ##__VA_ARGS__)                                            \
+  TENSORSTORE_INTERNAL_FOR_EACH_INT_CONVERSION(X, int8_t, ##__VA_ARGS__)     \
+  TENSORSTORE_INTERNAL_FOR_EACH_INT_CONVERSION(X, uint8_t, ##__VA_ARGS__)    \
+  TENSORSTORE_INTERNAL_FOR_EACH_INT_CONVERSION(X, int16_t, ##__VA_ARGS__)    \
+  TENSORSTORE_INTERNAL_FOR_EACH_INT_CONVERSION(X, uint16_t, ##__VA_ARGS__)   \
+  TENSORSTORE_INTERNAL_FOR_EACH_INT_CONVERSION(X, int32_t, ##__VA_ARGS__)    \
+  TENSORSTORE_INTERNAL_FOR_EACH_INT_CONVERSION(X, uint32_t, ##__VA_ARGS__)   \
+  TENSORSTORE_INTERNAL_FOR_EACH_FLOAT8_CONVERSION(                           \
+      X, ::tensorstore::Float8e3m4, ##__VA_ARGS__)                           \
+  TENSORSTORE_INTERNAL_FOR_EACH_FLOAT8_CONVERSION(                           \
+      X, ::tensorstore::Float8e4m3fn, ##__VA_ARGS__)                         \
+  TENSORSTORE_INTERNAL_FOR_EACH_FLOAT8_CONVERSION(                           \
+      X, ::tensorstore::Float8e4m3fnuz, ##__VA_ARGS__)                       \
+  TENSORSTORE_INTERNAL_FOR_EACH_FLOAT8_CONVERSION(                           \
+      X, ::tensorstore::Float8e4m3b11fnuz, ##__VA_ARGS__)                    \
+  X(::tensorstore::Float8e5m2, float, ##__VA_ARGS__)                         \
+  X(::tensorstore::Float8e5m2, ::tensorstore::BFloat16, ##__VA_ARGS__)       \
+  TENSORSTORE_INTERNAL_FOR_EACH_FLOAT8_CONVERSION(                           \
+      X, ::tensorstore::Float8e5m2fnuz, ##__VA_ARGS__)                       \
+  TENSORSTORE_INTERNAL_FOR_EACH_FLOAT8_CONVERSION(                           \
+      X, ::tensorstore::Float8e8m0fnu, ##__VA_ARGS__)                        \
+  TENSORSTORE_INTERNAL_FOR_EACH_FLOAT8_CONVERSION(                           \
+      X, ::tensorstore::Float4e2m1fn, ##__VA_ARGS__)                         \
+  /**/
+
+#define TENSORSTORE_INTERNAL_DECLARE_CONVERT_CONTIGUOUS(FROM, TO)        \
+  extern template void ConvertContiguous<FROM, TO>(const FROM*, TO*, Index); \
+  /**/
+TENSORSTORE_INTERNAL_FOR_EACH_VECTORIZED_CONVERSION(
+    TENSORSTORE_INTERNAL_DECLARE_CONVERT_CONTIGUOUS)
+#undef TENSORSTORE_INTERNAL_DECLARE_CONVERT_CONTIGUOUS
+
+}  // namespace internal_data_type
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_DATA_TYPE_CONVERSION_KERNELS_H_
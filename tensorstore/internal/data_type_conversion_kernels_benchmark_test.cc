@@ -0,0 +1,106 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <stdint.h>
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "tensorstore/data_type.h"
+#include "tensorstore/data_type_conversion.h"
+#include "tensorstore/index.h"
+#include "tensorstore/internal/data_type_conversion_kernels.h"
+#include "tensorstore/internal/elementwise_function.h"
+
+namespace {
+
+using ::tensorstore::dtype_v;
+using ::tensorstore::Index;
+using ::tensorstore::internal::IterationBufferKind;
+using ::tensorstore::internal::IterationBufferPointer;
+using ::tensorstore::internal_data_type::ConversionKernelIsa;
+using ::tensorstore::internal_data_type::GetSupportedConversionKernelIsa;
+using ::tensorstore::internal_data_type::SetConversionKernelIsaForTesting;
+
+// Measures the throughput of converting a contiguous buffer through the
+// type-erased conversion function, as used by `tensorstore::Cast` and
+// `CopyConvertedArray`.
+//
+// The first argument specifies the `ConversionKernelIsa`: 0 (portable), 1
+// (AVX2) or 2 (AVX-512).  The second argument specifies the number of
+// elements.
+template <typename From, typename To>
+void BM_Convert(benchmark::State& state) {
+  const auto isa = static_cast<ConversionKernelIsa>(state.range(0));
+  if (isa > GetSupportedConversionKernelIsa()) {
+    state.SkipWithError("Instruction set not supported");
+    return;
+  }
+  SetConversionKernelIsaForTesting(isa);
+  const Index n = state.range(1);
+  std::vector<From> source(n);
+  for (Index i = 0; i < n; ++i) {
+    source[i] = static_cast<From>(static_cast<float>(i % 251) * 0.25f);
+  }
+  std::vector<To> target(n);
+  auto converter =
+      tensorstore::internal::GetDataTypeConverter(dtype_v<From>, dtype_v<To>);
+  auto* function = converter.closure.function;
+  for (auto s : state) {
+    bool ok = (*function)[IterationBufferKind::kContiguous](
+        converter.closure.context, {1, n},
+        IterationBufferPointer(source.data(), 0, sizeof(From)),
+        IterationBufferPointer(target.data(), 0, sizeof(To)), nullptr);
+    benchmark::DoNotOptimize(ok);
+    benchmark::DoNotOptimize(target.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+  state.SetBytesProcessed(state.iterations() * n * sizeof(From));
+  SetConversionKernelIsaForTesting(GetSupportedConversionKernelIsa());
+}
+
+void DefineArgs(benchmark::internal::Benchmark* bench) {
+  for (int isa = 0; isa <= 2; ++isa) {
+    bench->Args({isa, 64});
+    bench->Args({isa, 64 * 1024});
+  }
+}
+
+#define TENSORSTORE_INTERNAL_CONVERT_BENCHMARK(FROM, TO)                \
+  BENCHMARK_TEMPLATE(BM_Convert, ::tensorstore::dtypes::FROM,           \
+                     ::tensorstore::dtypes::TO)                         \
+      ->Apply(DefineArgs);                                              \
+  /**/
+
+TENSORSTORE_INTERNAL_CONVERT_BENCHMARK(float32_t, bfloat16_t)
+TENSORSTORE_INTERNAL_CONVERT_BENCHMARK(bfloat16_t, float32_t)
+TENSORSTORE_INTERNAL_CONVERT_BENCHMARK(float32_t, float16_t)
+TENSORSTORE_INTERNAL_CONVERT_BENCHMARK(float16_t, float32_t)
+TENSORSTORE_INTERNAL_CONVERT_BENCHMARK(float32_t, float64_t)
+TENSORSTORE_INTERNAL_CONVERT_BENCHMARK(float64_t, float32_t)
+TENSORSTORE_INTERNAL_CONVERT_BENCHMARK(uint8_t, float32_t)
+TENSORSTORE_INTERNAL_CONVERT_BENCHMARK(int16_t, float32_t)
+TENSORSTORE_INTERNAL_CONVERT_BENCHMARK(uint16_t, float32_t)
+TENSORSTORE_INTERNAL_CONVERT_BENCHMARK(int32_t, float32_t)
+TENSORSTORE_INTERNAL_CONVERT_BENCHMARK(uint32_t, float64_t)
+TENSORSTORE_INTERNAL_CONVERT_BENCHMARK(float8_e4m3fn_t, float32_t)
+TENSORSTORE_INTERNAL_CONVERT_BENCHMARK(float8_e5m2_t, bfloat16_t)
+TENSORSTORE_INTERNAL_CONVERT_BENCHMARK(float8_e4m3fn_t, float16_t)
+
+// Conversions without a vectorized kernel, for comparison.
+TENSORSTORE_INTERNAL_CONVERT_BENCHMARK(float32_t, float8_e4m3fn_t)
+TENSORSTORE_INTERNAL_CONVERT_BENCHMARK(float32_t, int32_t)
+
+#undef TENSORSTORE_INTERNAL_CONVERT_BENCHMARK
+
+}  // namespace
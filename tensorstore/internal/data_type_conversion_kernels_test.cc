@@ -0,0 +1,187 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "tensorstore/internal/data_type_conversion_kernels.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "absl/random/random.h"
+#include <half.hpp>
+#include "tensorstore/util/bfloat16.h"
+#include "tensorstore/util/float8.h"
+#include "tensorstore/util/mxfloat.h"
+
+namespace {
+
+using ::tensorstore::BFloat16;
+using ::tensorstore::internal_data_type::ConversionKernelIsa;
+using ::tensorstore::internal_data_type::ConvertContiguous;
+using ::tensorstore::internal_data_type::GetConversionKernelIsa;
+using ::tensorstore::internal_data_type::GetSupportedConversionKernelIsa;
+using ::tensorstore::internal_data_type::SetConversionKernelIsaForTesting;
+using half = ::half_float::half;
+
+template <typename T>
+T FromBits(uint64_t bits) {
+  T value;
+  std::memcpy(static_cast<void*>(&value), &bits, sizeof(T));
+  return value;
+}
+
+template <typename T>
+bool IsNan(T value) {
+  if constexpr (std::numeric_limits<T>::is_integer) {
+    return false;
+  } else {
+    return std::isnan(static_cast<double>(static_cast<float>(value)));
+  }
+}
+
+// Checks that `ConvertContiguous` matches `static_cast` for every supported
+// instruction set.
+template <typename From, typename To>
+void TestConvert(const std::vector<From>& input) {
+  const ConversionKernelIsa supported = GetSupportedConversionKernelIsa();
+  for (auto isa : {ConversionKernelIsa::kScalar, ConversionKernelIsa::kAvx2,
+                   ConversionKernelIsa::kAvx512}) {
+    if (isa > supported) break;
+    SCOPED_TRACE(static_cast<int>(isa));
+    SetConversionKernelIsaForTesting(isa);
+    EXPECT_EQ(isa, GetConversionKernelIsa());
+    // Convert a suffix of the input as well to exercise the remainder loops.
+    for (size_t offset : {size_t{0}, size_t{3}}) {
+      if (offset > input.size()) continue;
+      std::vector<To> output(input.size() - offset);
+      ConvertContiguous(input.data() + offset, output.data(),
+                        static_cast<ptrdiff_t>(output.size()));
+      for (size_t i = 0; i < output.size(); ++i) {
+        const To expected = static_cast<To>(input[i + offset]);
+        if (IsNan(expected)) {
+          // The payload of a signaling NaN may be quieted.
+          EXPECT_TRUE(IsNan(output[i])) << "i=" << i + offset;
+        } else {
+          EXPECT_EQ(0, std::memcmp(&expected, &output[i], sizeof(To)))
+              << "i=" << i + offset;
+        }
+      }
+    }
+  }
+  SetConversionKernelIsaForTesting(supported);
+}
+
+template <typename T>
+std::vector<T> AllBitPatterns() {
+  static_assert(sizeof(T) <= 2);
+  std::vector<T> values;
+  for (uint64_t bits = 0; bits < (uint64_t{1} << (8 * sizeof(T))); ++bits) {
+    values.push_back(FromBits<T>(bits));
+  }
+  return values;
+}
+
+template <typename T>
+std::vector<T> RandomValues(size_t n = 10007) {
+  absl::BitGen gen;
+  std::vector<T> values;
+  for (size_t i = 0; i < n; ++i) {
+    values.push_back(FromBits<T>(absl::Uniform<uint64_t>(gen)));
+  }
+  return values;
+}
+
+std::vector<float> Float32TestValues() {
+  auto values = RandomValues<float>();
+  for (float x :
+       {0.0f, -0.0f, 1.0f, -1.0f, std::numeric_limits<float>::min(),
+        std::numeric_limits<float>::denorm_min(),
+        std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(),
+        std::numeric_limits<float>::infinity(),
+        -std::numeric_limits<float>::infinity(),
+        std::numeric_limits<float>::quiet_NaN(),
+        std::numeric_limits<float>::signaling_NaN(), 65504.0f, 65520.0f,
+        6.0e-8f, 3.0e-8f}) {
+    values.push_back(x);
+  }
+  // Values that are exactly halfway between two bfloat16 or float16 values,
+  // and values just above and below them.
+  absl::BitGen gen;
+  for (int i = 0; i < 4096; ++i) {
+    const uint32_t high = absl::Uniform<uint32_t>(gen) & 0xffff0000u;
+    for (uint32_t low : {0x8000u, 0x7fffu, 0x8001u, 0x1000u, 0x0fffu}) {
+      values.push_back(FromBits<float>(high | low));
+    }
+    // NaN values with a payload that would be lost by truncation.
+    values.push_back(FromBits<float>(
+        (high & 0x80000000u) | 0x7f800000u |
+        absl::Uniform<uint32_t>(absl::IntervalClosed, gen, 1, 0xffff)));
+  }
+  return values;
+}
+
+TEST(ConvertContiguousTest, Bfloat16) {
+  TestConvert<BFloat16, float>(AllBitPatterns<BFloat16>());
+  TestConvert<float, BFloat16>(Float32TestValues());
+}
+
+TEST(ConvertContiguousTest, Float16) {
+  TestConvert<half, float>(AllBitPatterns<half>());
+  TestConvert<float, half>(Float32TestValues());
+}
+
+TEST(ConvertContiguousTest, Float32Float64) {
+  TestConvert<float, double>(Float32TestValues());
+  TestConvert<double, float>(RandomValues<double>());
+}
+
+TEST(ConvertContiguousTest, Integer) {
+  TestConvert<int8_t, float>(AllBitPatterns<int8_t>());
+  TestConvert<uint8_t, double>(AllBitPatterns<uint8_t>());
+  TestConvert<int16_t, float>(AllBitPatterns<int16_t>());
+  TestConvert<uint16_t, float>(AllBitPatterns<uint16_t>());
+  TestConvert<uint16_t, double>(AllBitPatterns<uint16_t>());
+  TestConvert<int32_t, float>(RandomValues<int32_t>());
+  TestConvert<int32_t, double>(RandomValues<int32_t>());
+  TestConvert<uint32_t, float>(RandomValues<uint32_t>());
+  TestConvert<uint32_t, double>(RandomValues<uint32_t>());
+}
+
+template <typename T>
+class ConvertContiguousFloat8Test : public ::testing::Test {};
+
+using Float8Types =
+    ::testing::Types<::tensorstore::Float8e3m4, ::tensorstore::Float8e4m3fn,
+                     ::tensorstore::Float8e4m3fnuz,
+                     ::tensorstore::Float8e4m3b11fnuz,
+                     ::tensorstore::Float8e5m2, ::tensorstore::Float8e5m2fnuz,
+                     ::tensorstore::Float8e8m0fnu,
+                     ::tensorstore::Float4e2m1fn>;
+TYPED_TEST_SUITE(ConvertContiguousFloat8Test, Float8Types);
+
+TYPED_TEST(ConvertContiguousFloat8Test, AllValues) {
+  const auto values = AllBitPatterns<TypeParam>();
+  TestConvert<TypeParam, float>(values);
+  TestConvert<TypeParam, BFloat16>(values);
+  if constexpr (!std::is_same_v<TypeParam, ::tensorstore::Float8e5m2>) {
+    TestConvert<TypeParam, half>(values);
+  }
+}
+
+}  // namespace
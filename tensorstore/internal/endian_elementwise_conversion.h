@@ -19,6 +19,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cstring>
 #include <string>
 #include <string_view>
 
@@ -32,6 +33,7 @@
 #include "tensorstore/internal/riegeli/delimited.h"
 #include "tensorstore/internal/riegeli/json_input.h"
 #include "tensorstore/internal/riegeli/json_output.h"
+#include "tensorstore/internal/swap_endian_kernels.h"
 #include "tensorstore/util/endian.h"
 #include "tensorstore/util/utf8_string.h"
 
@@ -58,6 +60,25 @@ struct SwapEndianUnalignedLoopImpl {
     SwapEndianUnaligned<SubElementSize, NumSubElements>(source, target);
   }
 
+  bool ApplyContiguous(Index count, UnalignedValue* value, void* arg) const {
+    if constexpr (SubElementSize != 1) {
+      SwapEndianContiguous<SubElementSize>(value, value,
+                                           count * NumSubElements);
+    }
+    return true;
+  }
+
+  bool ApplyContiguous(Index count, const UnalignedValue* source,
+                       UnalignedValue* target, void* arg) const {
+    if constexpr (SubElementSize == 1) {
+      std::memcpy(target, source, count * sizeof(UnalignedValue));
+    } else {
+      SwapEndianContiguous<SubElementSize>(source, target,
+                                           count * NumSubElements);
+    }
+    return true;
+  }
+
   using InplaceLoopImpl = internal_elementwise_function::SimpleLoopTemplate<
       SwapEndianUnalignedLoopImpl<SubElementSize, NumSubElements>(
           UnalignedValue),
@@ -264,14 +285,12 @@ struct WriteSwapEndianLoopTemplate {
         const Index end_element_i = std::min(
             shape[1], static_cast<Index>(
                           element_i + (writer.available() / sizeof(Element))));
-        char* cursor = writer.cursor();
-        for (; element_i < end_element_i; ++element_i) {
-          SwapEndianUnaligned<SubElementSize, NumSubElements>(input, cursor);
-          input++;
-          cursor += sizeof(Element);
-        }
+        const size_t n = end_element_i - element_i;
+        SwapEndianContiguous<SubElementSize>(input, writer.cursor(),
+                                             n * NumSubElements);
+        input += n;
         element_i = end_element_i;
-        writer.set_cursor(cursor);
+        writer.move_cursor(n * sizeof(Element));
       }
     }
     return true;
@@ -403,14 +422,13 @@ struct ReadSwapEndianLoopTemplate {
         const Index end_element_i = std::min(
             shape[1], static_cast<Index>(
                           element_i + (reader.available() / sizeof(Element))));
-        const char* cursor = reader.cursor();
-        for (; element_i < end_element_i; ++element_i) {
-          SwapEndianUnaligned<SubElementSize, NumSubElements>(cursor, output);
-          cursor += sizeof(Element);
-          output++;
-        }
+        // Swap directly from the reader's buffer into the destination array.
+        const size_t n = end_element_i - element_i;
+        SwapEndianContiguous<SubElementSize>(reader.cursor(), output,
+                                             n * NumSubElements);
+        output += n;
         element_i = end_element_i;
-        reader.set_cursor(cursor);
+        reader.move_cursor(n * sizeof(Element));
       }
     }
     return true;
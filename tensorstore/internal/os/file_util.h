@@ -111,6 +111,18 @@ Result<ptrdiff_t> ReadFromFile(FileDescriptor fd,
 Result<ptrdiff_t> PReadFromFile(FileDescriptor fd,
                                 tensorstore::span<char> buffer, int64_t offset);
 
+/// Reads from an open file into multiple buffers, filled in order from a
+/// contiguous range of the file.
+///
+/// \param fd Open file descriptor.
+/// \param buffers[out] Memory where data will be stored.
+/// \param offset Byte offset within file at which to start reading.
+/// \returns Total number of bytes read, which may be less than the combined
+///     size of `buffers`, or a failure absl::Status code.
+Result<ptrdiff_t> PReadVFromFile(
+    FileDescriptor fd, tensorstore::span<const tensorstore::span<char>> buffers,
+    int64_t offset);
+
 /// Reads the entire file into a string.
 ///
 /// \param fd Open file descriptor.
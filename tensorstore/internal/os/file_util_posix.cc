@@ -340,6 +340,38 @@ Result<ptrdiff_t> PReadFromFile(FileDescriptor fd,
   return std::move(tspan).EndWithStatus(std::move(status));
 }
 
+Result<ptrdiff_t> PReadVFromFile(
+    FileDescriptor fd, tensorstore::span<const tensorstore::span<char>> buffers,
+    int64_t offset) {
+  TENSORSTORE_INVOKE_TEST_HOOK(ReadOpTag, fd);
+  LoggedTraceSpan tspan(
+      __func__, detail_logging.Level(1),
+      {{"fd", fd}, {"buffers", buffers.size()}, {"offset", offset}});
+
+  absl::InlinedVector<iovec, 16> iovs;
+  size_t count = 0;
+  for (const auto& buffer : buffers) {
+    struct iovec iov;
+    iov.iov_base = buffer.data();
+    iov.iov_len = buffer.size();
+    iovs.emplace_back(iov);
+    count += buffer.size();
+    if (iovs.size() >= TENSORSTORE_MAXIOV) break;
+  }
+  ssize_t n;
+  do {
+    PotentiallyBlockingRegion region;
+    n = ::preadv(fd, iovs.data(), iovs.size(), static_cast<off_t>(offset));
+  } while ((n < 0) &&
+           (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK));
+  if (n >= 0) {
+    return n;
+  }
+  auto status = StatusFromOsError(errno).Format(
+      "Failed to read %d bytes from file at offset %d", count, offset);
+  return std::move(tspan).EndWithStatus(std::move(status));
+}
+
 Result<ptrdiff_t> WriteToFile(FileDescriptor fd, const void* buf,
                               size_t count) {
   TENSORSTORE_INVOKE_TEST_HOOK(WriteOpTag, fd);
@@ -55,6 +55,7 @@ using ::tensorstore::internal_os::MemmapFileReadOnly;
 using ::tensorstore::internal_os::OpenFileWrapper;
 using ::tensorstore::internal_os::OpenFlags;
 using ::tensorstore::internal_os::PReadFromFile;
+using ::tensorstore::internal_os::PReadVFromFile;
 using ::tensorstore::internal_os::ReadAllToString;
 using ::tensorstore::internal_os::ReadFromFile;
 using ::tensorstore::internal_os::RenameOpenFile;
@@ -108,6 +109,15 @@ TEST(FileUtilTest, Basics) {
                 IsOkAndHolds(3));
     EXPECT_THAT(std::string_view(buf, 3), testing::StrEq("foo"));
 
+    char buf2[4];
+    tensorstore::span<char> buffers[] = {tensorstore::span(buf, 2),
+                                         tensorstore::span(buf2, 4)};
+    EXPECT_THAT(PReadVFromFile(f->get(), buffers, 0), IsOkAndHolds(6));
+    EXPECT_THAT(std::string_view(buf, 2), testing::StrEq("fo"));
+    EXPECT_THAT(std::string_view(buf2, 4), testing::StrEq("obar"));
+    EXPECT_THAT(PReadVFromFile(f->get(), buffers, 3), IsOkAndHolds(3));
+    EXPECT_THAT(std::string_view(buf, 2), testing::StrEq("ba"));
+
     // Check the file info
     FileInfo info;
     EXPECT_THAT(GetFileInfo(f->get(), &info), IsOk());
@@ -365,6 +365,22 @@ Result<ptrdiff_t> PReadFromFile(FileDescriptor fd,
   return std::move(tspan).EndWithStatus(std::move(status));
 }
 
+Result<ptrdiff_t> PReadVFromFile(
+    FileDescriptor fd, tensorstore::span<const tensorstore::span<char>> buffers,
+    int64_t offset) {
+  // Windows has no equivalent of `preadv` for buffered handles; issue one
+  // read per buffer, stopping at the first short read.
+  ptrdiff_t total = 0;
+  for (const auto& buffer : buffers) {
+    TENSORSTORE_ASSIGN_OR_RETURN(auto n,
+                                 PReadFromFile(fd, buffer, offset + total));
+    ABSL_CHECK_GE(n, 0);
+    total += n;
+    if (static_cast<size_t>(n) < buffer.size()) break;
+  }
+  return total;
+}
+
 Result<ptrdiff_t> WriteToFile(FileDescriptor fd, const void* buf,
                               size_t count) {
   TENSORSTORE_INVOKE_TEST_HOOK(WriteOpTag, fd);
@@ -0,0 +1,87 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/os/io_uring.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "absl/status/status.h"
+#include "tensorstore/internal/os/error_code.h"
+#include "tensorstore/internal/os/file_descriptor.h"
+#include "tensorstore/util/span.h"
+
+namespace tensorstore {
+namespace internal_os {
+
+IoUring::Operation IoUring::Operation::Read(FileDescriptor fd,
+                                            tensorstore::span<char> buffer,
+                                            int64_t offset, Callback callback) {
+  Operation op;
+  op.kind = Kind::kRead;
+  op.fd = fd;
+  op.buffer = buffer.data();
+  op.size = buffer.size();
+  op.offset = offset;
+  op.callback = std::move(callback);
+  return op;
+}
+
+IoUring::Operation IoUring::Operation::Write(
+    FileDescriptor fd, tensorstore::span<const char> buffer, int64_t offset,
+    Callback callback) {
+  Operation op;
+  op.kind = Kind::kWrite;
+  op.fd = fd;
+  // The buffer is only read by write operations.
+  op.buffer = const_cast<char*>(buffer.data());
+  op.size = buffer.size();
+  op.offset = offset;
+  op.callback = std::move(callback);
+  return op;
+}
+
+IoUring::Operation IoUring::Operation::Fsync(FileDescriptor fd,
+                                             Callback callback) {
+  Operation op;
+  op.kind = Kind::kFsync;
+  op.fd = fd;
+  op.callback = std::move(callback);
+  return op;
+}
+
+IoUring::Operation IoUring::Operation::Rename(std::string old_path,
+                                              std::string new_path,
+                                              Callback callback) {
+  Operation op;
+  op.kind = Kind::kRename;
+  op.old_path = std::move(old_path);
+  op.new_path = std::move(new_path);
+  op.callback = std::move(callback);
+  return op;
+}
+
+absl::Status IoUringResultToStatus(int32_t result, std::string_view action) {
+  if (result >= 0) return absl::OkStatus();
+  return internal::StatusFromOsError(
+             static_cast<internal::OsErrorCode>(-result))
+      .Format("%s", action);
+}
+
+}  // namespace internal_os
+}  // namespace tensorstore
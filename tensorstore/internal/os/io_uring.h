@@ -0,0 +1,116 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_OS_IO_URING_H_
+#define TENSORSTORE_INTERNAL_OS_IO_URING_H_
+
+/// \file
+/// Asynchronous file I/O backed by the Linux io_uring interface.
+///
+/// A single process-wide submission/completion ring is created on first use.
+/// Operations are submitted by the calling thread, with one system call per
+/// `Submit` batch, and completions are reaped by a single dedicated thread
+/// which invokes the per-operation callback.  Callbacks should be cheap; any
+/// non-trivial work should be forwarded to an executor.
+///
+/// On platforms other than Linux, or when io_uring is not available (e.g. an
+/// old kernel, or disabled by a seccomp policy), `IoUring::Get()` returns an
+/// error and callers are expected to fall back to blocking I/O.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "absl/functional/any_invocable.h"
+#include "absl/status/status.h"
+#include "tensorstore/internal/os/file_descriptor.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
+
+namespace tensorstore {
+namespace internal_os {
+
+class IoUring {
+ public:
+  /// Invoked with the result of an operation: a non-negative value on success
+  /// (the number of bytes transferred, for reads and writes), or the negated
+  /// `errno` value on failure.
+  using Callback = absl::AnyInvocable<void(int32_t result) &&>;
+
+  /// A single I/O operation.
+  ///
+  /// Any buffers referenced by the operation must remain valid until the
+  /// callback is invoked.  Paths are owned by the operation.
+  struct Operation {
+    enum class Kind : unsigned char {
+      kRead,
+      kWrite,
+      kFsync,
+      kRename,
+    };
+
+    Kind kind;
+    FileDescriptor fd = InvalidFileDescriptor();
+    char* buffer = nullptr;
+    size_t size = 0;
+    int64_t offset = 0;
+    std::string old_path;
+    std::string new_path;
+    Callback callback;
+
+    /// Reads up to `buffer.size()` bytes from `fd` at `offset`.
+    static Operation Read(FileDescriptor fd, tensorstore::span<char> buffer,
+                          int64_t offset, Callback callback);
+
+    /// Writes up to `buffer.size()` bytes to `fd` at `offset`.
+    static Operation Write(FileDescriptor fd,
+                           tensorstore::span<const char> buffer,
+                           int64_t offset, Callback callback);
+
+    /// Flushes `fd` to stable storage.
+    static Operation Fsync(FileDescriptor fd, Callback callback);
+
+    /// Renames `old_path` to `new_path`.
+    static Operation Rename(std::string old_path, std::string new_path,
+                            Callback callback);
+  };
+
+  virtual ~IoUring() = default;
+
+  /// Returns the process-wide ring, or an error if io_uring is not supported.
+  static Result<IoUring*> Get();
+
+  /// Submits all of `ops`.
+  ///
+  /// Operations may complete in any order.  If more operations are outstanding
+  /// than the ring can hold, the excess is queued and submitted as earlier
+  /// operations complete.  Callbacks are normally invoked on the completion
+  /// thread, but may be invoked on the calling thread if an operation fails
+  /// to submit or is not natively supported by the kernel.
+  virtual void Submit(std::vector<Operation> ops) = 0;
+};
+
+/// Converts the result passed to an `IoUring::Callback` to an `absl::Status`.
+///
+/// \param result Operation result, negative on failure.
+/// \param action Description of the operation, used in the error message.
+absl::Status IoUringResultToStatus(int32_t result, std::string_view action);
+
+}  // namespace internal_os
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_OS_IO_URING_H_
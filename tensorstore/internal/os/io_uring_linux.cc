@@ -0,0 +1,447 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __linux__
+#error "Use io_uring_unsupported.cc instead."
+#endif
+
+#include "tensorstore/internal/os/io_uring.h"
+//
+
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <deque>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/log/absl_log.h"
+#include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/log/verbose_flag.h"
+#include "tensorstore/internal/os/error_code.h"
+#include "tensorstore/internal/thread/thread.h"
+#include "tensorstore/util/result.h"
+
+namespace tensorstore {
+namespace internal_os {
+namespace {
+
+using ::tensorstore::internal::StatusFromOsError;
+
+ABSL_CONST_INIT internal_log::VerboseFlag io_uring_logging("io_uring");
+
+// Number of submission queue entries requested from the kernel.  The
+// completion queue is twice this size by default.
+constexpr unsigned kRingEntries = 256;
+
+// Delay before the completion thread retries submission when the kernel is
+// temporarily unable to accept new entries (EAGAIN/EBUSY).
+constexpr absl::Duration kSubmitRetryDelay = absl::Microseconds(100);
+
+int SysIoUringSetup(unsigned entries, io_uring_params* p) {
+  return static_cast<int>(::syscall(__NR_io_uring_setup, entries, p));
+}
+
+int SysIoUringEnter(int fd, unsigned to_submit, unsigned min_complete,
+                    unsigned flags) {
+  return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit,
+                                    min_complete, flags, nullptr, 0));
+}
+
+int SysIoUringRegister(int fd, unsigned opcode, void* arg, unsigned nr_args) {
+  return static_cast<int>(
+      ::syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+// The ring indices are shared with the kernel, so all accesses use
+// acquire/release semantics as required by the io_uring ABI.
+inline uint32_t LoadAcquire(const uint32_t* p) {
+  return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+inline void StoreRelease(uint32_t* p, uint32_t v) {
+  __atomic_store_n(p, v, __ATOMIC_RELEASE);
+}
+
+class IoUringImpl final : public IoUring {
+ public:
+  ~IoUringImpl() override;
+
+  static Result<std::unique_ptr<IoUringImpl>> Create();
+
+  void Submit(std::vector<Operation> ops) override;
+
+  // Completion thread main loop.
+  void ReapCompletions();
+
+ private:
+  IoUringImpl() = default;
+
+  // Writes the SQE for `op` and advances the local submission tail.
+  void PrepareSqe(Operation* op) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  // Publishes all prepared SQEs and submits all queued SQEs.  Any operations
+  // which the kernel refuses are removed from the ring and appended to
+  // `failed`.  If the kernel is temporarily unable to accept more entries,
+  // returns without waiting and sets `sq_blocked_`; the completion thread
+  // then retries once `mutex_` is released so that completions can be reaped.
+  void FlushSqes(std::vector<std::pair<Operation*, int32_t>>& failed)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  // Returns `true` if the completion thread has entries to resubmit or
+  // completions to wait for.
+  bool HasCompletionWork() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return sq_blocked_ || in_flight_ > 0;
+  }
+
+  // Runs `op` synchronously; used for operations the kernel does not support.
+  static void RunSynchronously(std::unique_ptr<Operation> op);
+
+  // Invokes the callbacks of `ops` and clears it.
+  static void RunCallbacks(std::vector<std::pair<Operation*, int32_t>>& ops);
+
+  int ring_fd_ = -1;
+
+  // Submission queue ring.
+  void* sq_ring_ = nullptr;
+  size_t sq_ring_size_ = 0;
+  uint32_t* sq_head_ = nullptr;
+  uint32_t* sq_tail_ = nullptr;
+  uint32_t* sq_array_ = nullptr;
+  uint32_t sq_mask_ = 0;
+  uint32_t sq_entries_ = 0;
+  io_uring_sqe* sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+
+  // Completion queue ring.  May alias `sq_ring_`.
+  void* cq_ring_ = nullptr;
+  size_t cq_ring_size_ = 0;
+  uint32_t* cq_head_ = nullptr;
+  uint32_t* cq_tail_ = nullptr;
+  uint32_t cq_mask_ = 0;
+  io_uring_cqe* cqes_ = nullptr;
+
+  bool rename_supported_ = false;
+
+  absl::Mutex mutex_;
+  // Number of SQEs prepared but not yet published to the kernel.
+  uint32_t unsubmitted_ ABSL_GUARDED_BY(mutex_) = 0;
+  // Set if the last `FlushSqes` left entries queued in the submission ring
+  // because the kernel returned EAGAIN or EBUSY.
+  bool sq_blocked_ ABSL_GUARDED_BY(mutex_) = false;
+  // Number of operations submitted to the kernel and not yet reaped.  Bounded
+  // by the completion queue size to avoid completion queue overflow.
+  size_t in_flight_ ABSL_GUARDED_BY(mutex_) = 0;
+  size_t max_in_flight_ = 0;
+  std::deque<std::unique_ptr<Operation>> pending_ ABSL_GUARDED_BY(mutex_);
+};
+
+IoUringImpl::~IoUringImpl() {
+  if (sqes_) ::munmap(sqes_, sqes_size_);
+  if (cq_ring_ && cq_ring_ != sq_ring_) ::munmap(cq_ring_, cq_ring_size_);
+  if (sq_ring_) ::munmap(sq_ring_, sq_ring_size_);
+  if (ring_fd_ >= 0) ::close(ring_fd_);
+}
+
+Result<std::unique_ptr<IoUringImpl>> IoUringImpl::Create() {
+  std::unique_ptr<IoUringImpl> ring(new IoUringImpl);
+
+  io_uring_params p;
+  memset(&p, 0, sizeof(p));
+  ring->ring_fd_ = SysIoUringSetup(kRingEntries, &p);
+  if (ring->ring_fd_ < 0) {
+    return StatusFromOsError(errno).Format("io_uring_setup failed");
+  }
+
+  ring->sq_ring_size_ = p.sq_off.array + p.sq_entries * sizeof(uint32_t);
+  ring->cq_ring_size_ = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+  const bool single_mmap = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (single_mmap) {
+    ring->sq_ring_size_ = ring->cq_ring_size_ =
+        std::max(ring->sq_ring_size_, ring->cq_ring_size_);
+  }
+
+  void* sq_ring =
+      ::mmap(nullptr, ring->sq_ring_size_, PROT_READ | PROT_WRITE,
+             MAP_SHARED | MAP_POPULATE, ring->ring_fd_, IORING_OFF_SQ_RING);
+  if (sq_ring == MAP_FAILED) {
+    return StatusFromOsError(errno).Format("Failed to map io_uring SQ ring");
+  }
+  ring->sq_ring_ = sq_ring;
+
+  if (single_mmap) {
+    ring->cq_ring_ = sq_ring;
+  } else {
+    void* cq_ring =
+        ::mmap(nullptr, ring->cq_ring_size_, PROT_READ | PROT_WRITE,
+               MAP_SHARED | MAP_POPULATE, ring->ring_fd_, IORING_OFF_CQ_RING);
+    if (cq_ring == MAP_FAILED) {
+      return StatusFromOsError(errno).Format("Failed to map io_uring CQ ring");
+    }
+    ring->cq_ring_ = cq_ring;
+  }
+
+  ring->sqes_size_ = p.sq_entries * sizeof(io_uring_sqe);
+  void* sqes =
+      ::mmap(nullptr, ring->sqes_size_, PROT_READ | PROT_WRITE,
+             MAP_SHARED | MAP_POPULATE, ring->ring_fd_, IORING_OFF_SQES);
+  if (sqes == MAP_FAILED) {
+    return StatusFromOsError(errno).Format("Failed to map io_uring SQEs");
+  }
+  ring->sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+  char* sq_base = static_cast<char*>(ring->sq_ring_);
+  ring->sq_head_ = reinterpret_cast<uint32_t*>(sq_base + p.sq_off.head);
+  ring->sq_tail_ = reinterpret_cast<uint32_t*>(sq_base + p.sq_off.tail);
+  ring->sq_array_ = reinterpret_cast<uint32_t*>(sq_base + p.sq_off.array);
+  ring->sq_mask_ = *reinterpret_cast<uint32_t*>(sq_base + p.sq_off.ring_mask);
+  ring->sq_entries_ = p.sq_entries;
+
+  char* cq_base = static_cast<char*>(ring->cq_ring_);
+  ring->cq_head_ = reinterpret_cast<uint32_t*>(cq_base + p.cq_off.head);
+  ring->cq_tail_ = reinterpret_cast<uint32_t*>(cq_base + p.cq_off.tail);
+  ring->cq_mask_ = *reinterpret_cast<uint32_t*>(cq_base + p.cq_off.ring_mask);
+  ring->cqes_ = reinterpret_cast<io_uring_cqe*>(cq_base + p.cq_off.cqes);
+  ring->max_in_flight_ = std::min<size_t>(p.sq_entries, p.cq_entries);
+
+  // Verify that the required opcodes are supported; IORING_OP_READ and
+  // IORING_OP_WRITE require Linux 5.6, and IORING_OP_RENAMEAT requires 5.11.
+  constexpr unsigned kMaxProbeOps = 256;
+  std::vector<char> probe_storage(sizeof(io_uring_probe) +
+                                  kMaxProbeOps * sizeof(io_uring_probe_op));
+  auto* probe = reinterpret_cast<io_uring_probe*>(probe_storage.data());
+  if (SysIoUringRegister(ring->ring_fd_, IORING_REGISTER_PROBE, probe,
+                         kMaxProbeOps) < 0) {
+    return StatusFromOsError(errno).Format("io_uring probe failed");
+  }
+  auto is_supported = [&](unsigned op) {
+    return op <= probe->last_op &&
+           (probe->ops[op].flags & IO_URING_OP_SUPPORTED) != 0;
+  };
+  if (!is_supported(IORING_OP_READ) || !is_supported(IORING_OP_WRITE) ||
+      !is_supported(IORING_OP_FSYNC)) {
+    return absl::UnimplementedError(
+        "io_uring does not support required read/write/fsync operations");
+  }
+  ring->rename_supported_ = is_supported(IORING_OP_RENAMEAT);
+  return ring;
+}
+
+void IoUringImpl::PrepareSqe(Operation* op) {
+  const uint32_t tail = *sq_tail_ + unsubmitted_;
+  const uint32_t index = tail & sq_mask_;
+  io_uring_sqe* sqe = &sqes_[index];
+  memset(sqe, 0, sizeof(*sqe));
+  switch (op->kind) {
+    case Operation::Kind::kRead:
+      sqe->opcode = IORING_OP_READ;
+      sqe->fd = op->fd;
+      sqe->addr = reinterpret_cast<uintptr_t>(op->buffer);
+      sqe->len = static_cast<uint32_t>(op->size);
+      sqe->off = static_cast<uint64_t>(op->offset);
+      break;
+    case Operation::Kind::kWrite:
+      sqe->opcode = IORING_OP_WRITE;
+      sqe->fd = op->fd;
+      sqe->addr = reinterpret_cast<uintptr_t>(op->buffer);
+      sqe->len = static_cast<uint32_t>(op->size);
+      sqe->off = static_cast<uint64_t>(op->offset);
+      break;
+    case Operation::Kind::kFsync:
+      sqe->opcode = IORING_OP_FSYNC;
+      sqe->fd = op->fd;
+      break;
+    case Operation::Kind::kRename:
+      sqe->opcode = IORING_OP_RENAMEAT;
+      sqe->fd = AT_FDCWD;
+      sqe->addr = reinterpret_cast<uintptr_t>(op->old_path.c_str());
+      sqe->len = static_cast<uint32_t>(AT_FDCWD);
+      sqe->addr2 = reinterpret_cast<uintptr_t>(op->new_path.c_str());
+      break;
+  }
+  sqe->user_data = reinterpret_cast<uintptr_t>(op);
+  sq_array_[index] = index;
+  ++unsubmitted_;
+  ++in_flight_;
+}
+
+void IoUringImpl::FlushSqes(
+    std::vector<std::pair<Operation*, int32_t>>& failed) {
+  if (unsubmitted_ > 0) {
+    // Publish the new tail to the kernel.
+    StoreRelease(sq_tail_, *sq_tail_ + unsubmitted_);
+    unsubmitted_ = 0;
+  }
+  sq_blocked_ = false;
+  while (true) {
+    const uint32_t tail = *sq_tail_;
+    const uint32_t head = LoadAcquire(sq_head_);
+    if (head == tail) return;
+    int n = SysIoUringEnter(ring_fd_, tail - head, 0, 0);
+    if (n > 0 || (n < 0 && errno == EINTR)) continue;
+    if (n == 0 || errno == EAGAIN || errno == EBUSY) {
+      // Spinning here would prevent completions from being reaped, which may
+      // be what the kernel is waiting for.  Leave the entries queued.
+      sq_blocked_ = true;
+      return;
+    }
+    // The kernel did not consume the remaining entries; retract them.
+    const int error = errno;
+    for (uint32_t i = head; i != tail; ++i) {
+      auto* op = reinterpret_cast<Operation*>(
+          static_cast<uintptr_t>(sqes_[sq_array_[i & sq_mask_]].user_data));
+      failed.emplace_back(op, -error);
+      --in_flight_;
+    }
+    StoreRelease(sq_tail_, head);
+    return;
+  }
+}
+
+void IoUringImpl::RunSynchronously(std::unique_ptr<Operation> op) {
+  int32_t result = 0;
+  switch (op->kind) {
+    case Operation::Kind::kRename:
+      if (::rename(op->old_path.c_str(), op->new_path.c_str()) != 0) {
+        result = -errno;
+      }
+      break;
+    default:
+      result = -EOPNOTSUPP;
+      break;
+  }
+  std::move(op->callback)(result);
+}
+
+void IoUringImpl::RunCallbacks(
+    std::vector<std::pair<Operation*, int32_t>>& ops) {
+  for (auto& [op, result] : ops) {
+    std::unique_ptr<Operation> owned(op);
+    std::move(owned->callback)(result);
+  }
+  ops.clear();
+}
+
+void IoUringImpl::Submit(std::vector<Operation> ops) {
+  std::vector<std::pair<Operation*, int32_t>> failed;
+  std::vector<std::unique_ptr<Operation>> unsupported;
+  {
+    absl::MutexLock lock(&mutex_);
+    for (auto& op : ops) {
+      auto owned = std::make_unique<Operation>(std::move(op));
+      if (owned->kind == Operation::Kind::kRename && !rename_supported_) {
+        unsupported.push_back(std::move(owned));
+        continue;
+      }
+      if (in_flight_ >= max_in_flight_ || !pending_.empty()) {
+        pending_.push_back(std::move(owned));
+        continue;
+      }
+      PrepareSqe(owned.release());
+    }
+    FlushSqes(failed);
+  }
+  for (auto& op : unsupported) {
+    RunSynchronously(std::move(op));
+  }
+  // Entries left queued by a blocked submission are resubmitted by the
+  // completion thread.
+  RunCallbacks(failed);
+}
+
+void IoUringImpl::ReapCompletions() {
+  std::vector<std::pair<Operation*, int32_t>> completed;
+  std::vector<std::pair<Operation*, int32_t>> failed;
+  while (true) {
+    uint32_t head = *cq_head_;
+    uint32_t tail = LoadAcquire(cq_tail_);
+    if (head == tail) {
+      bool sq_blocked;
+      {
+        absl::MutexLock lock(&mutex_);
+        // Waiting in the kernel is only useful if entries have reached it; a
+        // blocked `Submit` leaves them queued and wakes this thread instead.
+        mutex_.Await(absl::Condition(this, &IoUringImpl::HasCompletionWork));
+        if (sq_blocked_) FlushSqes(failed);
+        sq_blocked = sq_blocked_;
+      }
+      RunCallbacks(failed);
+      if (sq_blocked) {
+        // Entries are still queued; poll rather than blocking on a completion
+        // that may never be posted.
+        absl::SleepFor(kSubmitRetryDelay);
+        continue;
+      }
+      int n = SysIoUringEnter(ring_fd_, 0, 1, IORING_ENTER_GETEVENTS);
+      if (n < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+        ABSL_LOG(ERROR) << "io_uring_enter failed waiting for completions: "
+                        << StatusFromOsError(errno).Default();
+      }
+      continue;
+    }
+    for (; head != tail; ++head) {
+      const io_uring_cqe& cqe = cqes_[head & cq_mask_];
+      completed.emplace_back(
+          reinterpret_cast<Operation*>(static_cast<uintptr_t>(cqe.user_data)),
+          cqe.res);
+    }
+    StoreRelease(cq_head_, head);
+
+    {
+      absl::MutexLock lock(&mutex_);
+      in_flight_ -= completed.size();
+      while (!pending_.empty() && in_flight_ < max_in_flight_) {
+        PrepareSqe(pending_.front().release());
+        pending_.pop_front();
+      }
+      FlushSqes(failed);
+    }
+    ABSL_LOG_IF(INFO, io_uring_logging)
+        << "io_uring reaped " << completed.size() << " completions";
+    RunCallbacks(completed);
+    RunCallbacks(failed);
+  }
+}
+
+}  // namespace
+
+Result<IoUring*> IoUring::Get() {
+  static Result<IoUring*> ring = []() -> Result<IoUring*> {
+    TENSORSTORE_ASSIGN_OR_RETURN(auto impl, IoUringImpl::Create());
+    // The ring is intentionally leaked, since the completion thread runs for
+    // the lifetime of the process.
+    IoUringImpl* ptr = impl.release();
+    internal::Thread::StartDetached({"ts_io_uring"},
+                                    [ptr] { ptr->ReapCompletions(); });
+    return ptr;
+  }();
+  return ring;
+}
+
+}  // namespace internal_os
+}  // namespace tensorstore
@@ -0,0 +1,140 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/os/io_uring.h"
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/synchronization/blocking_counter.h"
+#include "tensorstore/internal/os/file_util.h"
+#include "tensorstore/internal/os/open_flags.h"
+#include "tensorstore/internal/testing/scoped_directory.h"
+#include "tensorstore/util/span.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::IsOkAndHolds;
+using ::tensorstore::StatusIs;
+using ::tensorstore::internal_os::IoUring;
+using ::tensorstore::internal_os::IoUringResultToStatus;
+using ::tensorstore::internal_os::OpenFileWrapper;
+using ::tensorstore::internal_os::OpenFlags;
+using ::tensorstore::internal_os::ReadAllToString;
+using ::tensorstore::internal_testing::ScopedTemporaryDirectory;
+
+// Submits `ops` and waits for all of them to complete.
+std::vector<int32_t> SubmitAndWait(IoUring& ring,
+                                   std::vector<IoUring::Operation> ops) {
+  std::vector<int32_t> results(ops.size());
+  absl::BlockingCounter counter(static_cast<int>(ops.size()));
+  for (size_t i = 0; i < ops.size(); ++i) {
+    ops[i].callback = [&results, &counter, i](int32_t result) {
+      results[i] = result;
+      counter.DecrementCount();
+    };
+  }
+  ring.Submit(std::move(ops));
+  counter.Wait();
+  return results;
+}
+
+TEST(IoUringTest, ResultToStatus) {
+  EXPECT_TRUE(IoUringResultToStatus(0, "read").ok());
+  EXPECT_TRUE(IoUringResultToStatus(10, "read").ok());
+  EXPECT_THAT(IoUringResultToStatus(-ENOENT, "read"),
+              StatusIs(absl::StatusCode::kNotFound));
+}
+
+TEST(IoUringTest, WriteReadFsyncRename) {
+  auto ring_result = IoUring::Get();
+  if (!ring_result.ok()) {
+    GTEST_SKIP() << ring_result.status();
+  }
+  IoUring& ring = **ring_result;
+
+  ScopedTemporaryDirectory tempdir;
+  std::string path = tempdir.path() + "/data";
+  std::string renamed_path = tempdir.path() + "/renamed";
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto fd, OpenFileWrapper(path, OpenFlags::OpenReadWrite |
+                                         OpenFlags::Create |
+                                         OpenFlags::CloseOnExec));
+
+  std::string data(64 * 1024, '\0');
+  for (size_t i = 0; i < data.size(); ++i) data[i] = 'a' + (i % 26);
+
+  {
+    std::vector<IoUring::Operation> ops;
+    ops.push_back(IoUring::Operation::Write(
+        fd.get(), tensorstore::span<const char>(data.data(), data.size()), 0,
+        {}));
+    EXPECT_THAT(SubmitAndWait(ring, std::move(ops)),
+                ::testing::ElementsAre(data.size()));
+  }
+
+  // Issue more reads than fit in the ring at once.
+  constexpr size_t kNumReads = 1000;
+  constexpr size_t kReadSize = 32;
+  std::vector<char> buffer(kNumReads * kReadSize);
+  {
+    std::vector<IoUring::Operation> ops;
+    for (size_t i = 0; i < kNumReads; ++i) {
+      ops.push_back(IoUring::Operation::Read(
+          fd.get(),
+          tensorstore::span<char>(buffer.data() + i * kReadSize, kReadSize),
+          i * 61, {}));
+    }
+    auto results = SubmitAndWait(ring, std::move(ops));
+    for (size_t i = 0; i < kNumReads; ++i) {
+      EXPECT_EQ(kReadSize, results[i]);
+      EXPECT_EQ(std::string_view(buffer.data() + i * kReadSize, kReadSize),
+                std::string_view(data).substr(i * 61, kReadSize));
+    }
+  }
+
+  {
+    std::vector<IoUring::Operation> ops;
+    ops.push_back(IoUring::Operation::Fsync(fd.get(), {}));
+    EXPECT_THAT(SubmitAndWait(ring, std::move(ops)),
+                ::testing::ElementsAre(0));
+  }
+
+  {
+    std::vector<IoUring::Operation> ops;
+    ops.push_back(IoUring::Operation::Rename(path, renamed_path, {}));
+    EXPECT_THAT(SubmitAndWait(ring, std::move(ops)),
+                ::testing::ElementsAre(0));
+  }
+  EXPECT_THAT(ReadAllToString(renamed_path), IsOkAndHolds(data));
+
+  {
+    std::vector<IoUring::Operation> ops;
+    ops.push_back(IoUring::Operation::Rename(path, renamed_path, {}));
+    EXPECT_THAT(SubmitAndWait(ring, std::move(ops)),
+                ::testing::ElementsAre(-ENOENT));
+  }
+}
+
+}  // namespace
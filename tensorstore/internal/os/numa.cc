@@ -0,0 +1,59 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/os/numa.h"
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif defined(_WIN32)
+#include "tensorstore/internal/os/include_windows.h"
+#endif
+
+namespace tensorstore {
+namespace internal_os {
+
+#if defined(__linux__)
+
+int GetCurrentNumaNode() {
+  unsigned cpu = 0;
+  unsigned node = 0;
+  // getcpu(2) is only called when a thread is assigned to a task provider, so
+  // the cost of the system call is negligible.
+  if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) {
+    return 0;
+  }
+  return static_cast<int>(node);
+}
+
+#elif defined(_WIN32)
+
+int GetCurrentNumaNode() {
+  PROCESSOR_NUMBER processor;
+  GetCurrentProcessorNumberEx(&processor);
+  USHORT node = 0;
+  if (!GetNumaProcessorNodeEx(&processor, &node)) {
+    return 0;
+  }
+  return static_cast<int>(node);
+}
+
+#else
+
+int GetCurrentNumaNode() { return 0; }
+
+#endif
+
+}  // namespace internal_os
+}  // namespace tensorstore
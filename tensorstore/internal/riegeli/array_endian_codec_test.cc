@@ -14,6 +14,12 @@
 
 #include "tensorstore/internal/riegeli/array_endian_codec.h"
 
+#include <stdint.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "absl/strings/cord.h"
@@ -325,4 +331,25 @@ TEST(DecodeArrayEndianTest, Fragmented) {
   EXPECT_THAT(decoded, MakeTestArray<uint16_t>(c_order));
 }
 
+TEST(DecodeArrayEndianTest, FragmentedSwapped) {
+  // Fragment boundaries do not coincide with element boundaries, so that some
+  // elements straddle two fragments.
+  auto orig_array = MakeTestArray<uint64_t>(c_order, 100, 200);
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto encoded, EncodeArrayAsCord(orig_array, endian::big, c_order));
+  std::string flat(encoded.Flatten());
+  std::vector<std::string> parts;
+  for (size_t start = 0; start < flat.size();) {
+    size_t length = std::min(flat.size() - start, size_t{1001});
+    parts.push_back(flat.substr(start, length));
+    start += length;
+  }
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto decoded,
+      DecodeArrayFromCord(dtype_v<uint64_t>, orig_array.shape(),
+                          absl::MakeFragmentedCord(parts), endian::big,
+                          c_order));
+  EXPECT_EQ(orig_array, decoded);
+}
+
 }  // namespace
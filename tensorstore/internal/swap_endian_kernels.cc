@@ -0,0 +1,171 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/swap_endian_kernels.h"
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <atomic>
+
+#include "absl/base/attributes.h"
+#include "absl/base/macros.h"
+#include "tensorstore/util/endian.h"
+
+#if (defined(__x86_64__) || defined(_M_X64)) && \
+    (defined(__GNUC__) || defined(__clang__)) && !defined(_MSC_VER)
+#define TENSORSTORE_INTERNAL_SWAP_ENDIAN_KERNELS_X86 1
+#include <immintrin.h>
+#define TENSORSTORE_INTERNAL_TARGET_SSSE3 __attribute__((target("ssse3")))
+#define TENSORSTORE_INTERNAL_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace tensorstore {
+namespace internal {
+namespace {
+
+SwapEndianKernelIsa DetectIsa() {
+#ifdef TENSORSTORE_INTERNAL_SWAP_ENDIAN_KERNELS_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) return SwapEndianKernelIsa::kAvx2;
+  if (__builtin_cpu_supports("ssse3")) return SwapEndianKernelIsa::kSsse3;
+#endif
+  return SwapEndianKernelIsa::kScalar;
+}
+
+std::atomic<SwapEndianKernelIsa>& ActiveIsa() {
+  static std::atomic<SwapEndianKernelIsa> isa{
+      GetSupportedSwapEndianKernelIsa()};
+  return isa;
+}
+
+template <size_t ElementSize>
+ABSL_ATTRIBUTE_ALWAYS_INLINE inline void SwapEndianScalar(const char* source,
+                                                          char* dest,
+                                                          size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    SwapEndianUnaligned<ElementSize>(source + i * ElementSize,
+                                     dest + i * ElementSize);
+  }
+}
+
+#ifdef TENSORSTORE_INTERNAL_SWAP_ENDIAN_KERNELS_X86
+
+// Returns the `pshufb` control mask that reverses each `ElementSize`-byte
+// group within a 16-byte lane.
+template <size_t ElementSize>
+TENSORSTORE_INTERNAL_TARGET_SSSE3 inline __m128i GetShuffleMask() {
+  alignas(16) char mask[16];
+  for (size_t i = 0; i < 16; ++i) {
+    mask[i] = static_cast<char>((i / ElementSize + 1) * ElementSize - 1 -
+                                i % ElementSize);
+  }
+  return _mm_load_si128(reinterpret_cast<const __m128i*>(mask));
+}
+
+template <size_t ElementSize>
+TENSORSTORE_INTERNAL_TARGET_SSSE3 void SwapEndianSsse3(const char* source,
+                                                       char* dest,
+                                                       size_t count) {
+  constexpr size_t kElementsPerVector = 16 / ElementSize;
+  const __m128i mask = GetShuffleMask<ElementSize>();
+  size_t i = 0;
+  for (; i + kElementsPerVector <= count; i += kElementsPerVector) {
+    const size_t offset = i * ElementSize;
+    __m128i x =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + offset));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + offset),
+                     _mm_shuffle_epi8(x, mask));
+  }
+  SwapEndianScalar<ElementSize>(source + i * ElementSize,
+                                dest + i * ElementSize, count - i);
+}
+
+template <size_t ElementSize>
+TENSORSTORE_INTERNAL_TARGET_AVX2 void SwapEndianAvx2(const char* source,
+                                                     char* dest,
+                                                     size_t count) {
+  // `vpshufb` shuffles within each 128-bit lane, so the same mask is used for
+  // both lanes.
+  constexpr size_t kElementsPerVector = 32 / ElementSize;
+  const __m256i mask =
+      _mm256_broadcastsi128_si256(GetShuffleMask<ElementSize>());
+  size_t i = 0;
+  for (; i + 2 * kElementsPerVector <= count; i += 2 * kElementsPerVector) {
+    const size_t offset = i * ElementSize;
+    __m256i x0 =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + offset));
+    __m256i x1 = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(source + offset + 32));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + offset),
+                        _mm256_shuffle_epi8(x0, mask));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + offset + 32),
+                        _mm256_shuffle_epi8(x1, mask));
+  }
+  for (; i + kElementsPerVector <= count; i += kElementsPerVector) {
+    const size_t offset = i * ElementSize;
+    __m256i x =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + offset));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + offset),
+                        _mm256_shuffle_epi8(x, mask));
+  }
+  SwapEndianScalar<ElementSize>(source + i * ElementSize,
+                                dest + i * ElementSize, count - i);
+}
+
+#endif  // TENSORSTORE_INTERNAL_SWAP_ENDIAN_KERNELS_X86
+
+}  // namespace
+
+SwapEndianKernelIsa GetSupportedSwapEndianKernelIsa() {
+  static const SwapEndianKernelIsa isa = DetectIsa();
+  return isa;
+}
+
+SwapEndianKernelIsa GetSwapEndianKernelIsa() {
+  return ActiveIsa().load(std::memory_order_relaxed);
+}
+
+void SetSwapEndianKernelIsaForTesting(SwapEndianKernelIsa isa) {
+  ActiveIsa().store(std::min(isa, GetSupportedSwapEndianKernelIsa()),
+                    std::memory_order_relaxed);
+}
+
+template <size_t ElementSize>
+void SwapEndianContiguous(const void* source, void* dest, size_t count) {
+  static_assert(ElementSize == 2 || ElementSize == 4 || ElementSize == 8);
+  const char* source_char = static_cast<const char*>(source);
+  char* dest_char = static_cast<char*>(dest);
+  ABSL_ASSERT(source == dest ||
+              source_char + count * ElementSize <= dest_char ||
+              dest_char + count * ElementSize <= source_char);
+#ifdef TENSORSTORE_INTERNAL_SWAP_ENDIAN_KERNELS_X86
+  switch (GetSwapEndianKernelIsa()) {
+    case SwapEndianKernelIsa::kAvx2:
+      return SwapEndianAvx2<ElementSize>(source_char, dest_char, count);
+    case SwapEndianKernelIsa::kSsse3:
+      return SwapEndianSsse3<ElementSize>(source_char, dest_char, count);
+    case SwapEndianKernelIsa::kScalar:
+      break;
+  }
+#endif
+  SwapEndianScalar<ElementSize>(source_char, dest_char, count);
+}
+
+template void SwapEndianContiguous<2>(const void*, void*, size_t);
+template void SwapEndianContiguous<4>(const void*, void*, size_t);
+template void SwapEndianContiguous<8>(const void*, void*, size_t);
+
+}  // namespace internal
+}  // namespace tensorstore
@@ -0,0 +1,69 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_SWAP_ENDIAN_KERNELS_H_
+#define TENSORSTORE_INTERNAL_SWAP_ENDIAN_KERNELS_H_
+
+/// \file
+/// Vectorized kernels for swapping the byte order of contiguous buffers.
+///
+/// These are used by the contiguous loops of `SwapEndianUnalignedLoopTemplate`,
+/// `WriteSwapEndianLoopTemplate` and `ReadSwapEndianLoopTemplate` in place of
+/// per-element calls to `SwapEndianUnaligned`.
+///
+/// On x86-64, the kernel variant is selected at run time based on the
+/// instruction sets supported by the CPU: SSSE3 (`pshufb`) or AVX2
+/// (`vpshufb`).  On other platforms, only the portable variant is available.
+
+#include <stddef.h>
+
+namespace tensorstore {
+namespace internal {
+
+/// Instruction set used by the byte swapping kernels.
+enum class SwapEndianKernelIsa {
+  kScalar = 0,
+  kSsse3 = 1,
+  kAvx2 = 2,
+};
+
+/// Returns the best instruction set supported by the CPU.
+SwapEndianKernelIsa GetSupportedSwapEndianKernelIsa();
+
+/// Returns the instruction set currently used by the byte swapping kernels.
+SwapEndianKernelIsa GetSwapEndianKernelIsa();
+
+/// Limits the byte swapping kernels to `isa`, or the best supported
+/// instruction set if that is lower.  Intended for testing and benchmarking.
+void SetSwapEndianKernelIsaForTesting(SwapEndianKernelIsa isa);
+
+/// Swaps the byte order of `count` contiguous elements of `ElementSize` bytes
+/// from `source`, and stores the result in `dest`.
+///
+/// Equivalent to calling `SwapEndianUnaligned<ElementSize>` for each element.
+/// There is no alignment requirement on `source` or `dest`.
+///
+/// \tparam ElementSize Size in bytes of each element, must be 2, 4, or 8.
+/// \dchecks Either `source == dest`, or the ranges do not overlap.
+template <size_t ElementSize>
+void SwapEndianContiguous(const void* source, void* dest, size_t count);
+
+extern template void SwapEndianContiguous<2>(const void*, void*, size_t);
+extern template void SwapEndianContiguous<4>(const void*, void*, size_t);
+extern template void SwapEndianContiguous<8>(const void*, void*, size_t);
+
+}  // namespace internal
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_SWAP_ENDIAN_KERNELS_H_
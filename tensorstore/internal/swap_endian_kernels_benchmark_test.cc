@@ -0,0 +1,113 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <complex>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "riegeli/bytes/string_reader.h"
+#include "tensorstore/data_type.h"
+#include "tensorstore/index.h"
+#include "tensorstore/internal/elementwise_function.h"
+#include "tensorstore/internal/swap_endian_kernels.h"
+#include "tensorstore/internal/unaligned_data_type_functions.h"
+
+namespace {
+
+using ::tensorstore::dtype_v;
+using ::tensorstore::Index;
+using ::tensorstore::internal::GetSupportedSwapEndianKernelIsa;
+using ::tensorstore::internal::IterationBufferKind;
+using ::tensorstore::internal::IterationBufferPointer;
+using ::tensorstore::internal::kUnalignedDataTypeFunctions;
+using ::tensorstore::internal::SetSwapEndianKernelIsaForTesting;
+using ::tensorstore::internal::SwapEndianKernelIsa;
+
+// Measures the throughput of decoding a contiguous array with swapped byte
+// order from a `riegeli::Reader`, as done by `DecodeArrayEndian`.
+//
+// The first argument specifies the `SwapEndianKernelIsa`: 0 (portable), 1
+// (SSSE3) or 2 (AVX2).  The second argument specifies the number of elements.
+template <typename T>
+void BM_ReadSwapped(benchmark::State& state) {
+  const auto isa = static_cast<SwapEndianKernelIsa>(state.range(0));
+  if (isa > GetSupportedSwapEndianKernelIsa()) {
+    state.SkipWithError("Instruction set not supported");
+    return;
+  }
+  SetSwapEndianKernelIsaForTesting(isa);
+  const Index n = state.range(1);
+  std::string encoded(n * sizeof(T), '\x5a');
+  std::vector<T> target(n);
+  const auto& functions = kUnalignedDataTypeFunctions[static_cast<size_t>(
+      dtype_v<T>.id())];
+  for (auto s : state) {
+    riegeli::StringReader reader(encoded);
+    bool ok = functions.read_swapped_endian[IterationBufferKind::kContiguous](
+        &reader, {1, n}, IterationBufferPointer(target.data(), 0, sizeof(T)),
+        nullptr);
+    benchmark::DoNotOptimize(ok);
+    benchmark::DoNotOptimize(target.data());
+  }
+  state.SetBytesProcessed(state.iterations() * n * sizeof(T));
+  SetSwapEndianKernelIsaForTesting(GetSupportedSwapEndianKernelIsa());
+}
+
+// Measures the throughput of swapping the byte order in place, as done by
+// `DecodeArrayEndian` when the source buffer can be used directly.
+template <typename T>
+void BM_SwapInplace(benchmark::State& state) {
+  const auto isa = static_cast<SwapEndianKernelIsa>(state.range(0));
+  if (isa > GetSupportedSwapEndianKernelIsa()) {
+    state.SkipWithError("Instruction set not supported");
+    return;
+  }
+  SetSwapEndianKernelIsaForTesting(isa);
+  const Index n = state.range(1);
+  std::vector<T> data(n);
+  const auto& functions = kUnalignedDataTypeFunctions[static_cast<size_t>(
+      dtype_v<T>.id())];
+  for (auto s : state) {
+    bool ok =
+        (*functions.swap_endian_inplace)[IterationBufferKind::kContiguous](
+            nullptr, {1, n}, IterationBufferPointer(data.data(), 0, sizeof(T)),
+            nullptr);
+    benchmark::DoNotOptimize(ok);
+    benchmark::DoNotOptimize(data.data());
+  }
+  state.SetBytesProcessed(state.iterations() * n * sizeof(T));
+  SetSwapEndianKernelIsaForTesting(GetSupportedSwapEndianKernelIsa());
+}
+
+void DefineArgs(benchmark::internal::Benchmark* bench) {
+  for (int isa = 0; isa <= 2; ++isa) {
+    bench->Args({isa, 64});
+    bench->Args({isa, 64 * 1024});
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_ReadSwapped, uint16_t)->Apply(DefineArgs);
+BENCHMARK_TEMPLATE(BM_ReadSwapped, uint32_t)->Apply(DefineArgs);
+BENCHMARK_TEMPLATE(BM_ReadSwapped, uint64_t)->Apply(DefineArgs);
+BENCHMARK_TEMPLATE(BM_ReadSwapped, std::complex<float>)->Apply(DefineArgs);
+
+BENCHMARK_TEMPLATE(BM_SwapInplace, uint16_t)->Apply(DefineArgs);
+BENCHMARK_TEMPLATE(BM_SwapInplace, uint32_t)->Apply(DefineArgs);
+BENCHMARK_TEMPLATE(BM_SwapInplace, uint64_t)->Apply(DefineArgs);
+
+}  // namespace
@@ -0,0 +1,84 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/swap_endian_kernels.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "tensorstore/util/endian.h"
+
+namespace {
+
+using ::tensorstore::internal::GetSupportedSwapEndianKernelIsa;
+using ::tensorstore::internal::GetSwapEndianKernelIsa;
+using ::tensorstore::internal::SetSwapEndianKernelIsaForTesting;
+using ::tensorstore::internal::SwapEndianContiguous;
+using ::tensorstore::internal::SwapEndianKernelIsa;
+using ::tensorstore::internal::SwapEndianUnaligned;
+
+// Checks that `SwapEndianContiguous` matches `SwapEndianUnaligned` for every
+// supported instruction set, for unaligned buffers and for counts that
+// exercise the remainder loops.
+template <size_t ElementSize>
+void TestSwapEndian() {
+  const SwapEndianKernelIsa supported = GetSupportedSwapEndianKernelIsa();
+  for (auto isa : {SwapEndianKernelIsa::kScalar, SwapEndianKernelIsa::kSsse3,
+                   SwapEndianKernelIsa::kAvx2}) {
+    if (isa > supported) break;
+    SCOPED_TRACE(static_cast<int>(isa));
+    SetSwapEndianKernelIsaForTesting(isa);
+    EXPECT_EQ(isa, GetSwapEndianKernelIsa());
+    for (size_t count : {0, 1, 3, 7, 8, 15, 16, 17, 31, 33, 64, 100, 1001}) {
+      for (size_t offset : {0, 1}) {
+        SCOPED_TRACE(count);
+        SCOPED_TRACE(offset);
+        const size_t num_bytes = count * ElementSize;
+        std::vector<unsigned char> source(num_bytes + offset);
+        for (size_t i = 0; i < source.size(); ++i) {
+          source[i] = static_cast<unsigned char>(i * 7 + 3);
+        }
+        std::vector<unsigned char> expected(num_bytes);
+        for (size_t i = 0; i < count; ++i) {
+          SwapEndianUnaligned<ElementSize>(&source[offset + i * ElementSize],
+                                           &expected[i * ElementSize]);
+        }
+
+        std::vector<unsigned char> dest(num_bytes + offset);
+        SwapEndianContiguous<ElementSize>(source.data() + offset,
+                                          dest.data() + offset, count);
+        EXPECT_EQ(expected, std::vector<unsigned char>(
+                                dest.begin() + offset, dest.end()));
+
+        // In place.
+        SwapEndianContiguous<ElementSize>(source.data() + offset,
+                                          source.data() + offset, count);
+        EXPECT_EQ(expected, std::vector<unsigned char>(
+                                source.begin() + offset, source.end()));
+      }
+    }
+  }
+  SetSwapEndianKernelIsaForTesting(supported);
+}
+
+TEST(SwapEndianContiguousTest, Size2) { TestSwapEndian<2>(); }
+
+TEST(SwapEndianContiguousTest, Size4) { TestSwapEndian<4>(); }
+
+TEST(SwapEndianContiguousTest, Size8) { TestSwapEndian<8>(); }
+
+}  // namespace
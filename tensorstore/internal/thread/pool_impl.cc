@@ -18,15 +18,19 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <optional>
 #include <utility>
 
 #include "absl/base/attributes.h"
 #include "absl/base/thread_annotations.h"
+#include "absl/flags/flag.h"
 #include "absl/log/absl_log.h"
 #include "absl/synchronization/mutex.h"
 #include "absl/time/clock.h"
 #include "absl/time/time.h"
+#include "tensorstore/internal/env.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/log/verbose_flag.h"
 #include "tensorstore/internal/metrics/counter.h"
@@ -35,6 +39,12 @@
 #include "tensorstore/internal/thread/task_provider.h"
 #include "tensorstore/internal/thread/thread.h"
 
+ABSL_FLAG(std::optional<bool>, tensorstore_thread_pool_work_stealing,
+          std::nullopt,
+          "Enables work-stealing between the per-thread task queues of the "
+          "shared thread pool. "
+          "Overrides TENSORSTORE_THREAD_POOL_WORK_STEALING.");
+
 TENSORSTORE_DECLARE_AND_REGISTER_METRIC(
     thread_pool_started, Counter<int64_t>,
     MetricMetadata("/tensorstore/thread_pool/started",
@@ -61,16 +71,37 @@ constexpr absl::Duration kOverseerIdleBeforeExit = absl::Seconds(20);
 
 ABSL_CONST_INIT internal_log::VerboseFlag thread_pool_logging("thread_pool");
 
+bool IsWorkStealingEnabled() {
+  return internal::GetFlagOrEnvValue(
+             FLAGS_tensorstore_thread_pool_work_stealing,
+             "TENSORSTORE_THREAD_POOL_WORK_STEALING")
+      .value_or(false);
+}
+
 }  // namespace
 
-SharedThreadPool::SharedThreadPool() : waiting_(128) {
+SharedThreadPool::SharedThreadPool()
+    : work_stealing_(IsWorkStealingEnabled()), waiting_(128) {
   ABSL_LOG_IF(INFO, thread_pool_logging) << "SharedThreadPool: " << this;
 }
 
 void SharedThreadPool::NotifyWorkAvailable(
     internal::IntrusivePtr<TaskProvider> task_provider) {
+  // Fast path, in work-stealing mode: the task provider is already queued,
+  // and will be examined by the overseer or an idle worker.  The fence pairs
+  // with the one in `FindActiveTaskProvider`: either the queued flag is
+  // observed to be clear here, or the work added by the caller is observed by
+  // `EstimateThreadsRequired`.
+  if (work_stealing_) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (task_provider->pool_queued_.load(std::memory_order_relaxed)) {
+      return;
+    }
+  }
+
   absl::MutexLock lock(mutex_);
-  if (in_queue_.insert(task_provider.get()).second) {
+  if (!task_provider->pool_queued_.load(std::memory_order_relaxed)) {
+    task_provider->pool_queued_.store(true, std::memory_order_relaxed);
     waiting_.push_back(std::move(task_provider));
   }
 
@@ -86,14 +117,14 @@ SharedThreadPool::FindActiveTaskProvider() {
   for (int i = waiting_.size(); i > 0; i--) {
     internal::IntrusivePtr<TaskProvider> ptr = std::move(waiting_.front());
     waiting_.pop_front();
+    ptr->pool_queued_.store(false, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
     auto work = ptr->EstimateThreadsRequired();
     if (work == 0) {
-      in_queue_.erase(ptr.get());
       continue;
     }
-    if (work == 1) {
-      in_queue_.erase(ptr.get());
-    } else {
+    if (work > 1) {
+      ptr->pool_queued_.store(true, std::memory_order_relaxed);
       waiting_.push_back(ptr);
     }
     thread_pool_task_providers.Set(waiting_.size());
@@ -234,6 +265,12 @@ void SharedThreadPool::Worker::WorkerBody() {
       // The idle loop has completed.
       if (task_provider_) {
         pool_->queue_assignment_time_ = now;
+        // In work-stealing mode, task providers which are already queued do
+        // not signal the overseer when more work is added, so wake it to
+        // start additional workers.
+        if (pool_->work_stealing_ && !pool_->waiting_.empty()) {
+          pool_->overseer_condvar_.Signal();
+        }
       } else {
         pool_->worker_threads_--;
         pool_->last_thread_exit_time_ = now;
@@ -20,7 +20,6 @@
 #include <cassert>
 
 #include "absl/base/thread_annotations.h"
-#include "absl/container/flat_hash_set.h"
 #include "absl/synchronization/mutex.h"
 #include "absl/time/time.h"
 #include "tensorstore/internal/container/circular_queue.h"
@@ -47,9 +46,18 @@ class SharedThreadPool
   /// TaskProviderMethod:  Notify that there is work available.
   /// If the task provider identified by the token is not in the waiting_
   /// queue, add it.
+  ///
+  /// In work-stealing mode, this does not acquire the pool mutex when the task
+  /// provider is already queued, so task providers may call it each time work
+  /// is added.
   void NotifyWorkAvailable(internal::IntrusivePtr<TaskProvider>)
       ABSL_LOCKS_EXCLUDED(mutex_);
 
+  /// Indicates whether work-stealing mode is enabled, via the
+  /// `--tensorstore_thread_pool_work_stealing` flag or the
+  /// `TENSORSTORE_THREAD_POOL_WORK_STEALING` environment variable.
+  bool work_stealing() const { return work_stealing_; }
+
  private:
   struct Overseer;
   struct Worker;
@@ -66,6 +74,8 @@ class SharedThreadPool
   void StartWorker(internal::IntrusivePtr<TaskProvider>, absl::Time now)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
+  const bool work_stealing_;
+
   absl::Mutex mutex_;
   size_t worker_threads_ ABSL_GUARDED_BY(mutex_) = 0;
   size_t idle_threads_ ABSL_GUARDED_BY(mutex_) = 0;
@@ -82,7 +92,6 @@ class SharedThreadPool
   absl::Time queue_assignment_time_ ABSL_GUARDED_BY(mutex_) =
       absl::InfinitePast();
 
-  absl::flat_hash_set<TaskProvider*> in_queue_ ABSL_GUARDED_BY(mutex_);
   internal_container::CircularQueue<internal::IntrusivePtr<TaskProvider>>
       waiting_ ABSL_GUARDED_BY(mutex_);
 };
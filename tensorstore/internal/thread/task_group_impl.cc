@@ -34,6 +34,7 @@
 #include "tensorstore/internal/metrics/metadata.h"
 #include "tensorstore/internal/metrics/registration.h"
 #include "tensorstore/internal/os/fork_detection.h"
+#include "tensorstore/internal/os/numa.h"
 #include "tensorstore/internal/thread/pool_impl.h"
 #include "tensorstore/internal/thread/task.h"
 #include "tensorstore/internal/thread/task_provider.h"
@@ -78,6 +79,12 @@ inline size_t ItemsToMigrateToGlobalQueue(size_t available) {
   return (std::min)(size_t{16}, available >> 1);
 }
 
+// Tunable parameter: In work-stealing mode, steal up to 1/2 the pending items
+// (max 32) and move them to the local queue.
+inline size_t ItemsToStealToLocalQueue(size_t available) {
+  return (std::min)(size_t{32}, available >> 1);
+}
+
 // Tunable parameter: Self-assign up to 2 additional tasks (max 1/8 available).
 inline size_t ItemsToSelfAssign(size_t default_assign, size_t available) {
   return (std::min)(default_assign, available >> 3);
@@ -133,19 +140,31 @@ struct TaskGroup::PerThreadData {
   size_t default_assign = 1;
   InFlightTaskQueue queue{128};
   size_t slot = 0;
+
+  // Used in work-stealing mode.  `steal_index` is only accessed by the thread
+  // assigned to the slot, while `numa_node` is read by other threads.
+  size_t steal_index = 0;
+  std::atomic<int> numa_node{0};
 };
 
 TaskGroup::TaskGroup(private_t, internal::IntrusivePtr<SharedThreadPool> pool,
                      size_t thread_limit)
     : pool_(std::move(pool)),
       thread_limit_(thread_limit),
+      work_stealing_(pool_->work_stealing()),
       threads_blocked_(0),
       threads_in_use_(0),
+      slots_(new std::atomic<PerThreadData*>[thread_limit] {}),
+      num_slots_(0),
       steal_index_(0) {}
 
 TaskGroup::~TaskGroup() {
   assert(threads_in_use_.load(std::memory_order_relaxed) == 0);
   assert(queue_.empty());
+  const size_t n = num_slots_.load(std::memory_order_relaxed);
+  for (size_t i = 0; i < n; ++i) {
+    delete slots_[i].load(std::memory_order_relaxed);
+  }
 }
 
 int64_t TaskGroup::EstimateThreadsRequired() {
@@ -155,11 +174,15 @@ int64_t TaskGroup::EstimateThreadsRequired() {
   }
 
   // Otherwise check the available tasks.
-  absl::MutexLock lock(mutex_);
-  if (!queue_.empty()) {
-    return std::min(n, queue_.size());
+  {
+    absl::MutexLock lock(mutex_);
+    if (!queue_.empty()) {
+      return std::min(n, queue_.size());
+    }
   }
-  for (auto* p : thread_queues_) {
+  const size_t num_slots = num_slots_.load(std::memory_order_acquire);
+  for (size_t i = 0; i < num_slots; ++i) {
+    auto* p = slots_[i].load(std::memory_order_acquire);
     if (!p->queue.empty()) return std::min(n, p->queue.size());
   }
   return 0;
@@ -168,18 +191,32 @@ int64_t TaskGroup::EstimateThreadsRequired() {
 void TaskGroup::DoWorkOnThread() {
   assert(per_thread_data == nullptr);
 
-  auto data = std::make_shared<PerThreadData>();
-  data->owner = this;
-
+  PerThreadData* data;
   {
     absl::MutexLock lock(mutex_);
     if (threads_in_use_.load(std::memory_order_relaxed) == thread_limit_) {
       return;
     }
     threads_in_use_.fetch_add(1, std::memory_order_relaxed);
-    thread_queues_.push_back(data.get());
-    data->slot = thread_queues_.size() - 1;
-    per_thread_data = data.get();
+    if (!free_slots_.empty()) {
+      data = slots_[free_slots_.back()].load(std::memory_order_relaxed);
+      free_slots_.pop_back();
+    } else {
+      // Every slot is in use, so fewer than `thread_limit_` exist.
+      const size_t slot = num_slots_.load(std::memory_order_relaxed);
+      assert(slot < thread_limit_);
+      data = new PerThreadData;
+      data->owner = this;
+      data->slot = slot;
+      slots_[slot].store(data, std::memory_order_release);
+      num_slots_.store(slot + 1, std::memory_order_release);
+    }
+    data->default_assign = 1;
+    per_thread_data = data;
+  }
+  if (work_stealing_) {
+    data->numa_node.store(internal_os::GetCurrentNumaNode(),
+                          std::memory_order_relaxed);
   }
 
   int64_t last_run_ns = absl::GetCurrentTimeNanos();
@@ -188,7 +225,7 @@ void TaskGroup::DoWorkOnThread() {
   // As long as there is work available, do it on this thread.
   while (true) {
     // Acquire a task to work on.
-    auto task = AcquireTask(data.get(), kThreadAssignmentLifetime);
+    auto task = AcquireTask(data, kThreadAssignmentLifetime);
     if (task) {
       metrics.OnStart(task->start_nanos);
       task->Run();
@@ -209,13 +246,11 @@ void TaskGroup::DoWorkOnThread() {
   metrics.Update();
 
   {
+    // Any tasks remaining in the slot's queue may still be stolen, or run by
+    // the next thread assigned to the slot.
     absl::MutexLock lock(mutex_);
     threads_in_use_.fetch_sub(1, std::memory_order_relaxed);
-    if (data->slot != thread_queues_.size() - 1) {
-      thread_queues_[data->slot] = thread_queues_.back();
-      thread_queues_[data->slot]->slot = data->slot;
-    }
-    thread_queues_.pop_back();
+    free_slots_.push_back(data->slot);
   }
 
   per_thread_data = nullptr;
@@ -237,6 +272,14 @@ std::unique_ptr<InFlightTask> TaskGroup::AcquireTask(PerThreadData* thread_data,
     return std::unique_ptr<InFlightTask>(t);
   }
 
+  // In work-stealing mode, steal from other threads' queues before acquiring
+  // the mutex.
+  if (work_stealing_) {
+    if (auto task = StealTask(thread_data)) {
+      return task;
+    }
+  }
+
   absl::MutexLock lock(mutex_);
   while (true) {
     // Second, attempt to acquire a task from the global queue.
@@ -261,22 +304,10 @@ std::unique_ptr<InFlightTask> TaskGroup::AcquireTask(PerThreadData* thread_data,
     thread_data->default_assign = 1;
 
     // Third, migrate tasks from per-thread queues.
-    for (size_t i = 0; i < thread_queues_.size(); ++i, ++steal_index_) {
-      if (steal_index_ >= thread_queues_.size()) steal_index_ = 0;
-      auto* other_data = thread_queues_[steal_index_];
-      if (!other_data || other_data == thread_data) continue;
-      std::unique_ptr<InFlightTask> task(other_data->queue.try_steal());
-      if (!task) continue;
-      // Tunable parameter: Items to steal and move to the global queue.
-      size_t x = ItemsToMigrateToGlobalQueue(other_data->queue.size());
-      while (x--) {
-        std::unique_ptr<InFlightTask> t(other_data->queue.try_steal());
-        if (!t) break;
-        queue_.push_back(std::move(t));
+    if (!work_stealing_) {
+      if (auto task = MigrateTask(thread_data)) {
+        return task;
       }
-
-      thread_pool_steal_count.IncrementBy(1);
-      return task;
     }
 
     // No tasks acquired; wait until more work appears on the global queue.
@@ -291,6 +322,68 @@ std::unique_ptr<InFlightTask> TaskGroup::AcquireTask(PerThreadData* thread_data,
   ABSL_UNREACHABLE();
 }
 
+/// Steal tasks and move them to the global queue.
+std::unique_ptr<InFlightTask> TaskGroup::MigrateTask(
+    PerThreadData* thread_data) {
+  const size_t n = num_slots_.load(std::memory_order_relaxed);
+  for (size_t i = 0; i < n; ++i, ++steal_index_) {
+    if (steal_index_ >= n) steal_index_ = 0;
+    auto* other_data = slots_[steal_index_].load(std::memory_order_relaxed);
+    if (other_data == thread_data) continue;
+    std::unique_ptr<InFlightTask> task(other_data->queue.try_steal());
+    if (!task) continue;
+    // Tunable parameter: Items to steal and move to the global queue.
+    size_t x = ItemsToMigrateToGlobalQueue(other_data->queue.size());
+    while (x--) {
+      std::unique_ptr<InFlightTask> t(other_data->queue.try_steal());
+      if (!t) break;
+      queue_.push_back(std::move(t));
+    }
+
+    thread_pool_steal_count.IncrementBy(1);
+    return task;
+  }
+  return nullptr;
+}
+
+/// Steal tasks in work-stealing mode.
+std::unique_ptr<InFlightTask> TaskGroup::StealTask(PerThreadData* thread_data) {
+  const size_t n = num_slots_.load(std::memory_order_acquire);
+  const int numa_node = thread_data->numa_node.load(std::memory_order_relaxed);
+  // The first pass considers only victims on the same NUMA node, the second
+  // pass considers the remaining victims.
+  for (int pass = 0; pass < 2; ++pass) {
+    for (size_t i = 0; i < n; ++i) {
+      const size_t index = (thread_data->steal_index + i) % n;
+      auto* other_data = slots_[index].load(std::memory_order_acquire);
+      if (other_data == thread_data) continue;
+      if ((other_data->numa_node.load(std::memory_order_relaxed) ==
+           numa_node) != (pass == 0)) {
+        continue;
+      }
+      std::unique_ptr<InFlightTask> task(other_data->queue.try_steal());
+      if (!task) continue;
+      // Tunable parameter: Items to steal and move to the local queue, which
+      // other threads may in turn steal from.
+      size_t x = ItemsToStealToLocalQueue(other_data->queue.size());
+      while (x--) {
+        std::unique_ptr<InFlightTask> t(other_data->queue.try_steal());
+        if (!t) break;
+        if (thread_data->queue.push(t.get())) {
+          t.release();
+        } else {
+          absl::MutexLock lock(mutex_);
+          queue_.push_back(std::move(t));
+        }
+      }
+      thread_data->steal_index = index + 1;
+      thread_pool_steal_count.IncrementBy(1);
+      return task;
+    }
+  }
+  return nullptr;
+}
+
 /////////////////////////////////////////////////////////////////////////////
 
 void TaskGroup::AddTask(std::unique_ptr<InFlightTask> task) {
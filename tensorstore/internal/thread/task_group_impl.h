@@ -45,6 +45,14 @@ using InFlightTaskQueue =
 /// TaskGroup is TaskProvider which allows adding additional tasks to a
 /// task provider, and allowing up to a specific number of threads to
 /// work on the tasks concurrently.
+///
+/// Each thread assigned to the TaskGroup owns a local queue of tasks, to which
+/// tasks added from that thread are pushed.  Idle threads steal from other
+/// threads' queues.  By default stolen tasks are moved to the global queue.
+/// When work-stealing mode is enabled (see `SharedThreadPool::work_stealing`),
+/// they are instead moved to the local queue of the thief without acquiring
+/// the TaskGroup mutex, and threads on the same NUMA node are preferred as
+/// victims.
 class TaskGroup : public TaskProvider {
   struct private_t {};
 
@@ -83,17 +91,35 @@ class TaskGroup : public TaskProvider {
   std::unique_ptr<InFlightTask> AcquireTask(PerThreadData* thread_data,
                                             absl::Duration timeout);
 
+  /// Worker method: Steal tasks from another thread's queue and move some of
+  /// them to the global queue, returning one of them.
+  std::unique_ptr<InFlightTask> MigrateTask(PerThreadData* thread_data)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  /// Worker method: In work-stealing mode, steal tasks from another thread's
+  /// queue into the local queue, returning one of them.
+  std::unique_ptr<InFlightTask> StealTask(PerThreadData* thread_data)
+      ABSL_LOCKS_EXCLUDED(mutex_);
+
   const internal::IntrusivePtr<SharedThreadPool> pool_;
   const size_t thread_limit_;
+  const bool work_stealing_;
 
   // worker thread state counters; updated under lock, read without locks.
   ABSL_CACHELINE_ALIGNED std::atomic<int64_t> threads_blocked_;
   std::atomic<int64_t> threads_in_use_;
 
+  // Per-thread queues, of which there are at most `thread_limit_`.  A slot is
+  // assigned to a thread while it works on this TaskGroup, and is then reused
+  // by later threads.  Slots are only freed by the destructor, so that any
+  // thread may steal from the first `num_slots_` slots without locking.
+  const std::unique_ptr<std::atomic<PerThreadData*>[]> slots_;
+  std::atomic<size_t> num_slots_;
+
   absl::Mutex mutex_;
   internal_container::BlockQueue<std::unique_ptr<InFlightTask>> queue_
       ABSL_GUARDED_BY(mutex_);
-  std::vector<PerThreadData*> thread_queues_ ABSL_GUARDED_BY(mutex_);
+  std::vector<size_t> free_slots_ ABSL_GUARDED_BY(mutex_);
   size_t steal_index_ ABSL_GUARDED_BY(mutex_);
 };
 
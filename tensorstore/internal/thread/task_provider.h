@@ -17,11 +17,15 @@
 
 #include <stdint.h>
 
+#include <atomic>
+
 #include "tensorstore/internal/intrusive_ptr.h"
 
 namespace tensorstore {
 namespace internal_thread_impl {
 
+class SharedThreadPool;
+
 /// In conjunction with SharedThreadPool
 class TaskProvider : public internal::AtomicReferenceCount<TaskProvider> {
  public:
@@ -32,6 +36,13 @@ class TaskProvider : public internal::AtomicReferenceCount<TaskProvider> {
 
   /// Worker Method: Assign a thread to this task provider.
   virtual void DoWorkOnThread() = 0;
+
+ private:
+  friend class SharedThreadPool;
+
+  /// Whether this provider is in the `SharedThreadPool` waiting queue.
+  /// Written under the pool mutex, but may be read without it.
+  std::atomic<bool> pool_queued_{false};
 };
 
 }  // namespace internal_thread_impl
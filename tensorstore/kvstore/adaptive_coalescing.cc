@@ -0,0 +1,169 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/adaptive_coalescing.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/base/no_destructor.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/metrics/gauge.h"
+#include "tensorstore/internal/metrics/metadata.h"
+#include "tensorstore/internal/metrics/registration.h"
+#include "tensorstore/kvstore/batch_util.h"
+
+TENSORSTORE_DECLARE_AND_REGISTER_METRIC(
+    coalescing_request_overhead_us, (Gauge<int64_t, std::string>),
+    MetricMetadata("/tensorstore/kvstore/coalescing/request_overhead_us",
+                   "Estimated fixed cost of a kvstore read request, across "
+                   "all instances of the driver",
+                   Units::kMicroseconds),
+    "kvstore");
+
+TENSORSTORE_DECLARE_AND_REGISTER_METRIC(
+    coalescing_bytes_per_second, (Gauge<double, std::string>),
+    MetricMetadata("/tensorstore/kvstore/coalescing/bytes_per_second",
+                   "Estimated marginal throughput of kvstore read requests, "
+                   "across all instances of the driver"),
+    "kvstore");
+
+TENSORSTORE_DECLARE_AND_REGISTER_METRIC(
+    coalescing_max_extra_read_bytes, (Gauge<int64_t, std::string>),
+    MetricMetadata("/tensorstore/kvstore/coalescing/max_extra_read_bytes",
+                   "Maximum gap between coalesced kvstore read requests, "
+                   "estimated across all instances of the driver",
+                   Units::kBytes),
+    "kvstore");
+
+namespace tensorstore {
+namespace internal_kvstore_batch {
+
+AdaptiveCoalescingPolicy::AdaptiveCoalescingPolicy(Options options)
+    : options_(std::move(options)),
+      aggregate_(options_.kvstore.empty() ? nullptr : &GetAggregate(options_)),
+      export_metrics_(false),
+      coalescing_options_(options_.initial) {}
+
+AdaptiveCoalescingPolicy::AdaptiveCoalescingPolicy(Options options,
+                                                   AggregateTag)
+    : options_(std::move(options)),
+      aggregate_(nullptr),
+      export_metrics_(true),
+      coalescing_options_(options_.initial) {}
+
+AdaptiveCoalescingPolicy& AdaptiveCoalescingPolicy::GetAggregate(
+    const Options& options) {
+  static absl::NoDestructor<absl::Mutex> mutex;
+  static absl::NoDestructor<absl::flat_hash_map<
+      std::string, std::unique_ptr<AdaptiveCoalescingPolicy>>>
+      aggregates;
+  absl::MutexLock lock(mutex.get());
+  auto& aggregate = (*aggregates)[options.kvstore];
+  if (!aggregate) {
+    // Policies with the same label are expected to use the same options.
+    aggregate.reset(new AdaptiveCoalescingPolicy(options, AggregateTag{}));
+  }
+  return *aggregate;
+}
+
+void AdaptiveCoalescingPolicy::RecordRequest(int64_t bytes,
+                                             absl::Duration latency) {
+  if (aggregate_) aggregate_->RecordRequest(bytes, latency);
+  const double x = static_cast<double>(bytes);
+  const double y = absl::ToDoubleSeconds(latency);
+  absl::MutexLock lock(&mutex_);
+  ++cost_model_.num_samples;
+  // Weight the first samples equally, so that the initial estimate is not
+  // biased towards zero.
+  const double w = std::max(options_.sample_weight,
+                            1.0 / static_cast<double>(cost_model_.num_samples));
+  const double dx = x - mean_bytes_;
+  const double dy = y - mean_seconds_;
+  mean_bytes_ += w * dx;
+  mean_seconds_ += w * dy;
+  var_bytes_ = (1 - w) * (var_bytes_ + w * dx * dx);
+  cov_bytes_seconds_ = (1 - w) * (cov_bytes_seconds_ + w * dx * dy);
+  UpdateLocked();
+}
+
+void AdaptiveCoalescingPolicy::UpdateLocked() {
+  // Without sufficient variation in request sizes, the overhead and the
+  // throughput cannot be distinguished.
+  double seconds_per_byte = 0;
+  if (var_bytes_ > 0 &&
+      std::sqrt(var_bytes_) > 0.01 * std::max(mean_bytes_, 1.0)) {
+    seconds_per_byte = cov_bytes_seconds_ / var_bytes_;
+  }
+  if (seconds_per_byte <= 0) {
+    cost_model_.bytes_per_second = 0;
+    cost_model_.request_overhead = absl::Seconds(mean_seconds_);
+  } else {
+    cost_model_.bytes_per_second = 1 / seconds_per_byte;
+    cost_model_.request_overhead = absl::Seconds(
+        std::max(0.0, mean_seconds_ - seconds_per_byte * mean_bytes_));
+  }
+
+  coalescing_options_ = options_.initial;
+  if (cost_model_.num_samples >= options_.min_samples &&
+      cost_model_.bytes_per_second > 0) {
+    const double extra_bytes =
+        absl::ToDoubleSeconds(cost_model_.request_overhead) *
+        cost_model_.bytes_per_second;
+    coalescing_options_.max_extra_read_bytes = static_cast<int64_t>(
+        std::clamp(extra_bytes,
+                   static_cast<double>(options_.min_extra_read_bytes),
+                   static_cast<double>(options_.max_extra_read_bytes)));
+  }
+
+  if (export_metrics_) {
+    coalescing_request_overhead_us.Set(
+        absl::ToInt64Microseconds(cost_model_.request_overhead),
+        options_.kvstore);
+    coalescing_bytes_per_second.Set(cost_model_.bytes_per_second,
+                                    options_.kvstore);
+    coalescing_max_extra_read_bytes.Set(
+        coalescing_options_.max_extra_read_bytes, options_.kvstore);
+  }
+}
+
+CoalescingOptions AdaptiveCoalescingPolicy::GetCoalescingOptions() const {
+  absl::MutexLock lock(&mutex_);
+  return coalescing_options_;
+}
+
+ReadCostModel AdaptiveCoalescingPolicy::GetCostModel() const {
+  absl::MutexLock lock(&mutex_);
+  return cost_model_;
+}
+
+AdaptiveCoalescingPolicy::Options RemoteStorageAdaptiveCoalescingOptions(
+    std::string kvstore) {
+  AdaptiveCoalescingPolicy::Options options;
+  options.kvstore = std::move(kvstore);
+  options.initial = kDefaultRemoteStorageCoalescingOptions;
+  options.min_extra_read_bytes =
+      kDefaultRemoteStorageCoalescingOptions.max_extra_read_bytes;
+  return options;
+}
+
+}  // namespace internal_kvstore_batch
+}  // namespace tensorstore
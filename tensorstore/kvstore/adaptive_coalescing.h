@@ -0,0 +1,131 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_KVSTORE_ADAPTIVE_COALESCING_H_
+#define TENSORSTORE_KVSTORE_ADAPTIVE_COALESCING_H_
+
+#include <stdint.h>
+
+#include <string>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "tensorstore/kvstore/batch_util.h"
+
+namespace tensorstore {
+namespace internal_kvstore_batch {
+
+// Estimated cost of a read request, as observed by `AdaptiveCoalescingPolicy`.
+struct ReadCostModel {
+  // Fixed cost of issuing a request, independent of its size.
+  absl::Duration request_overhead = absl::ZeroDuration();
+
+  // Marginal throughput, in bytes per second, or 0 if unknown.
+  double bytes_per_second = 0;
+
+  // Number of requests observed.
+  int64_t num_samples = 0;
+};
+
+// Derives `CoalescingOptions` from the observed latency and size of read
+// requests.
+//
+// Read latency is modeled as `request_overhead + bytes / bytes_per_second`,
+// where both parameters are estimated by exponentially-weighted least squares
+// regression over recent requests.  Coalescing two requests separated by a gap
+// is worthwhile when reading the gap costs less than issuing a separate
+// request, so `max_extra_read_bytes` is set to
+// `request_overhead * bytes_per_second`, clamped to the configured bounds.
+//
+// For example, for a remote store with 50ms of overhead per request and
+// 100MB/s of throughput, gaps of up to 5MB are coalesced, while for a local
+// disk with 100us of overhead and 2GB/s of throughput, gaps of up to 200KB are
+// coalesced.
+//
+// The estimate is exported via the `/tensorstore/kvstore/coalescing/...`
+// metrics, labeled by `kvstore`.  Since a process may open many instances of a
+// driver, the metrics are derived from a separate estimate over the requests
+// of all policies with the same label.
+//
+// This class is thread-safe.
+class AdaptiveCoalescingPolicy {
+ public:
+  struct Options {
+    // Label of the exported metrics, typically the driver id.  If empty, no
+    // metrics are exported.
+    std::string kvstore;
+
+    // Options used until `min_samples` requests have been observed, or while
+    // the throughput cannot be estimated.  The `target_coalesced_size` is
+    // always used as specified.
+    CoalescingOptions initial;
+
+    // Bounds on the derived `max_extra_read_bytes`.
+    int64_t min_extra_read_bytes = 0;
+    int64_t max_extra_read_bytes = int64_t{16} << 20;
+
+    // Number of requests to observe before adapting.
+    int64_t min_samples = 16;
+
+    // Weight of each new observation in the exponentially-weighted estimate.
+    double sample_weight = 0.05;
+  };
+
+  explicit AdaptiveCoalescingPolicy(Options options);
+
+  // Records a completed read request of `bytes` that took `latency`.
+  void RecordRequest(int64_t bytes, absl::Duration latency);
+
+  // Returns the coalescing options derived from the current estimate.
+  CoalescingOptions GetCoalescingOptions() const;
+
+  // Returns the current estimate.
+  ReadCostModel GetCostModel() const;
+
+ private:
+  struct AggregateTag {};
+  AdaptiveCoalescingPolicy(Options options, AggregateTag);
+
+  // Returns the process-wide policy which aggregates the requests of all
+  // policies labeled `options.kvstore`, and exports the metrics.
+  static AdaptiveCoalescingPolicy& GetAggregate(const Options& options);
+
+  void UpdateLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  const Options options_;
+  AdaptiveCoalescingPolicy* const aggregate_;
+  const bool export_metrics_;
+
+  mutable absl::Mutex mutex_;
+
+  // Exponentially-weighted moments of the observed (bytes, seconds) pairs.
+  double mean_bytes_ ABSL_GUARDED_BY(mutex_) = 0;
+  double mean_seconds_ ABSL_GUARDED_BY(mutex_) = 0;
+  double var_bytes_ ABSL_GUARDED_BY(mutex_) = 0;
+  double cov_bytes_seconds_ ABSL_GUARDED_BY(mutex_) = 0;
+
+  ReadCostModel cost_model_ ABSL_GUARDED_BY(mutex_);
+  CoalescingOptions coalescing_options_ ABSL_GUARDED_BY(mutex_);
+};
+
+// Returns options for remote storage drivers, which start from
+// `kDefaultRemoteStorageCoalescingOptions` and never coalesce less than it.
+AdaptiveCoalescingPolicy::Options RemoteStorageAdaptiveCoalescingOptions(
+    std::string kvstore);
+
+}  // namespace internal_kvstore_batch
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_KVSTORE_ADAPTIVE_COALESCING_H_
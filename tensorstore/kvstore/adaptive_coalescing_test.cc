@@ -0,0 +1,164 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/adaptive_coalescing.h"
+
+#include <stdint.h>
+
+#include <string>
+#include <variant>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/time/time.h"
+#include "tensorstore/internal/metrics/collect.h"
+#include "tensorstore/internal/metrics/registry.h"
+#include "tensorstore/kvstore/batch_util.h"
+
+namespace {
+
+using ::tensorstore::internal_kvstore_batch::AdaptiveCoalescingPolicy;
+using ::tensorstore::internal_metrics::GetMetricRegistry;
+using ::testing::DoubleNear;
+
+// Records requests of varying sizes with latency
+// `overhead + bytes / bytes_per_second`.
+void RecordRequests(AdaptiveCoalescingPolicy& policy, absl::Duration overhead,
+                    double bytes_per_second, int count) {
+  for (int i = 0; i < count; ++i) {
+    int64_t bytes = (i % 8 + 1) * 65536;
+    policy.RecordRequest(
+        bytes, overhead + absl::Seconds(bytes / bytes_per_second));
+  }
+}
+
+AdaptiveCoalescingPolicy::Options TestOptions() {
+  AdaptiveCoalescingPolicy::Options options;
+  options.initial.max_extra_read_bytes = 4095;
+  options.initial.target_coalesced_size = 1 << 30;
+  options.min_samples = 10;
+  return options;
+}
+
+TEST(AdaptiveCoalescingPolicyTest, Initial) {
+  AdaptiveCoalescingPolicy policy(TestOptions());
+  EXPECT_EQ(4095, policy.GetCoalescingOptions().max_extra_read_bytes);
+  EXPECT_EQ(1 << 30, policy.GetCoalescingOptions().target_coalesced_size);
+
+  // Not enough samples to adapt.
+  RecordRequests(policy, absl::Milliseconds(50), 100e6, 9);
+  EXPECT_EQ(4095, policy.GetCoalescingOptions().max_extra_read_bytes);
+  EXPECT_EQ(9, policy.GetCostModel().num_samples);
+}
+
+TEST(AdaptiveCoalescingPolicyTest, Remote) {
+  AdaptiveCoalescingPolicy policy(TestOptions());
+  RecordRequests(policy, absl::Milliseconds(50), 100e6, 100);
+  auto cost_model = policy.GetCostModel();
+  EXPECT_THAT(absl::ToDoubleSeconds(cost_model.request_overhead),
+              DoubleNear(0.05, 1e-4));
+  EXPECT_THAT(cost_model.bytes_per_second, DoubleNear(100e6, 1e4));
+  EXPECT_THAT(
+      static_cast<double>(policy.GetCoalescingOptions().max_extra_read_bytes),
+      DoubleNear(5e6, 1e3));
+  EXPECT_EQ(1 << 30, policy.GetCoalescingOptions().target_coalesced_size);
+}
+
+TEST(AdaptiveCoalescingPolicyTest, Local) {
+  AdaptiveCoalescingPolicy policy(TestOptions());
+  RecordRequests(policy, absl::Microseconds(100), 2e9, 100);
+  EXPECT_THAT(
+      static_cast<double>(policy.GetCoalescingOptions().max_extra_read_bytes),
+      DoubleNear(2e5, 1e2));
+}
+
+TEST(AdaptiveCoalescingPolicyTest, Bounds) {
+  auto options = TestOptions();
+  options.min_extra_read_bytes = 4095;
+  options.max_extra_read_bytes = 1 << 20;
+  {
+    AdaptiveCoalescingPolicy policy(options);
+    RecordRequests(policy, absl::Milliseconds(50), 100e6, 100);
+    EXPECT_EQ(1 << 20, policy.GetCoalescingOptions().max_extra_read_bytes);
+  }
+  {
+    AdaptiveCoalescingPolicy policy(options);
+    RecordRequests(policy, absl::Microseconds(1), 1e9, 100);
+    EXPECT_EQ(4095, policy.GetCoalescingOptions().max_extra_read_bytes);
+  }
+}
+
+TEST(AdaptiveCoalescingPolicyTest, UniformSizes) {
+  // The throughput cannot be estimated when all requests are the same size.
+  AdaptiveCoalescingPolicy policy(TestOptions());
+  for (int i = 0; i < 100; ++i) {
+    policy.RecordRequest(65536, absl::Milliseconds(10));
+  }
+  EXPECT_EQ(0, policy.GetCostModel().bytes_per_second);
+  EXPECT_THAT(absl::ToDoubleSeconds(policy.GetCostModel().request_overhead),
+              DoubleNear(0.01, 1e-9));
+  EXPECT_EQ(4095, policy.GetCoalescingOptions().max_extra_read_bytes);
+}
+
+TEST(AdaptiveCoalescingPolicyTest, Metrics) {
+  auto options = TestOptions();
+  options.kvstore = "adaptive_coalescing_test";
+  AdaptiveCoalescingPolicy policy(options);
+  RecordRequests(policy, absl::Milliseconds(50), 100e6, 100);
+
+  auto metric = GetMetricRegistry().Collect(
+      "/tensorstore/kvstore/coalescing/max_extra_read_bytes");
+  ASSERT_TRUE(metric.has_value());
+  bool found = false;
+  for (const auto& value : metric->values) {
+    if (value.fields.size() == 1 &&
+        value.fields[0] == "adaptive_coalescing_test") {
+      found = true;
+      EXPECT_EQ(policy.GetCoalescingOptions().max_extra_read_bytes,
+                std::get<int64_t>(value.value));
+    }
+  }
+  EXPECT_TRUE(found);
+}
+
+// Returns the exported max_extra_read_bytes for `kvstore`, or -1.
+int64_t GetMaxExtraReadBytesMetric(const std::string& kvstore) {
+  auto metric = GetMetricRegistry().Collect(
+      "/tensorstore/kvstore/coalescing/max_extra_read_bytes");
+  if (!metric.has_value()) return -1;
+  for (const auto& value : metric->values) {
+    if (value.fields.size() == 1 && value.fields[0] == kvstore) {
+      return std::get<int64_t>(value.value);
+    }
+  }
+  return -1;
+}
+
+TEST(AdaptiveCoalescingPolicyTest, MetricsAggregateInstances) {
+  auto options = TestOptions();
+  options.kvstore = "adaptive_coalescing_test_aggregate";
+  AdaptiveCoalescingPolicy policy1(options);
+  RecordRequests(policy1, absl::Milliseconds(50), 100e6, 100);
+  const int64_t adapted = policy1.GetCoalescingOptions().max_extra_read_bytes;
+  EXPECT_EQ(adapted, GetMaxExtraReadBytesMetric(options.kvstore));
+
+  // A new instance which has not yet adapted does not overwrite the metric.
+  AdaptiveCoalescingPolicy policy2(options);
+  RecordRequests(policy2, absl::Milliseconds(50), 100e6, 1);
+  EXPECT_EQ(4095, policy2.GetCoalescingOptions().max_extra_read_bytes);
+  EXPECT_THAT(GetMaxExtraReadBytesMetric(options.kvstore),
+              DoubleNear(adapted, adapted * 0.01));
+}
+
+}  // namespace
@@ -0,0 +1,843 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \file
+///
+/// Key-value store adapter which keeps a persistent copy of values read from a
+/// (typically remote) base kvstore in a second (typically local) kvstore.
+///
+/// Each cached read is stored as a single record in the cache kvstore, keyed
+/// by a digest of the base kvstore URL and the key, along with the requested
+/// byte range.  The record holds the storage generation and timestamp of the
+/// value, which allows it to be served without contacting the base kvstore
+/// when permitted by `ReadOptions::staleness_bound`, and otherwise to be
+/// revalidated by a conditional (`if_not_equal`) read of the base kvstore.
+///
+/// The total size of the records is bounded by `bytes_limit`; the least
+/// recently used records are deleted when the limit is exceeded.  The order of
+/// use is only tracked in memory: persisting it would require a write to the
+/// cache kvstore for every cache hit.  When the index is rebuilt on open from a
+/// listing of the cache kvstore, existing records are treated as less recently
+/// used than any record accessed since, in listing order.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <cassert>
+#include <list>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "absl/base/attributes.h"
+#include "absl/base/thread_annotations.h"
+#include "absl/container/btree_map.h"
+#include "absl/log/absl_log.h"
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/escaping.h"
+#include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "riegeli/bytes/cord_reader.h"
+#include "riegeli/bytes/cord_writer.h"
+#include "riegeli/endian/endian_reading.h"
+#include "riegeli/endian/endian_writing.h"
+#include "tensorstore/internal/digest/sha256.h"
+#include "tensorstore/internal/global_initializer.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/json_binding/json_binding.h"
+#include "tensorstore/internal/log/verbose_flag.h"
+#include "tensorstore/internal/metrics/counter.h"
+#include "tensorstore/internal/metrics/metadata.h"
+#include "tensorstore/internal/metrics/registry.h"
+#include "tensorstore/kvstore/byte_range.h"
+#include "tensorstore/kvstore/common_metrics.h"
+#include "tensorstore/kvstore/driver.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/kvstore/key_range.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/kvstore/registry.h"
+#include "tensorstore/kvstore/spec.h"
+#include "tensorstore/kvstore/supported_features.h"
+#include "tensorstore/transaction.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/garbage_collection/fwd.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/status.h"
+
+// specializations
+#include "tensorstore/util/apply_members/apply_members.h"  // IWYU pragma: keep
+
+namespace tensorstore {
+namespace internal_cache_kvstore {
+namespace {
+
+namespace jb = tensorstore::internal_json_binding;
+
+using ::tensorstore::internal::IntrusivePtr;
+using ::tensorstore::kvstore::ListEntry;
+using ::tensorstore::kvstore::ListReceiver;
+using ::tensorstore::kvstore::ReadResult;
+using ::tensorstore::kvstore::SupportedFeatures;
+
+ABSL_CONST_INIT internal_log::VerboseFlag cache_logging("kvstore_cache");
+
+struct CacheMetrics : public internal_kvstore::CommonReadMetrics,
+                      public internal_kvstore::CommonWriteMetrics {
+  internal_metrics::Counter<int64_t> hit;
+  internal_metrics::Counter<int64_t> miss;
+  internal_metrics::Counter<int64_t> revalidated;
+  internal_metrics::Counter<int64_t> evicted;
+};
+ABSL_CONST_INIT static CacheMetrics cache_metrics;
+
+TENSORSTORE_GLOBAL_INITIALIZER {
+  TENSORSTORE_KVSTORE_REGISTER_COMMON_READ_METRICS(&cache_metrics, cache);
+  TENSORSTORE_KVSTORE_REGISTER_COMMON_WRITE_METRICS(&cache_metrics, cache);
+  auto& r = internal_metrics::GetMetricRegistry();
+  r.Register(&cache_metrics.hit,
+             internal_metrics::MetricMetadata(
+                 "/tensorstore/kvstore/cache/hit",
+                 "cache kvstore::Reads served without reading the base"));
+  r.Register(&cache_metrics.miss,
+             internal_metrics::MetricMetadata(
+                 "/tensorstore/kvstore/cache/miss",
+                 "cache kvstore::Reads with no cached value"));
+  r.Register(&cache_metrics.revalidated,
+             internal_metrics::MetricMetadata(
+                 "/tensorstore/kvstore/cache/revalidated",
+                 "cache kvstore::Reads served from a cached value after "
+                 "revalidation against the base"));
+  r.Register(&cache_metrics.evicted,
+             internal_metrics::MetricMetadata(
+                 "/tensorstore/kvstore/cache/evicted",
+                 "cache kvstore records evicted due to bytes_limit"));
+}
+
+// -----------------------------------------------------------------------------
+// Record format.
+//
+// Each record is encoded as:
+//
+//   magic: uint32le
+//   key_length: uint32le
+//   key: byte[key_length]
+//   byte_range_inclusive_min: int64le
+//   byte_range_exclusive_max: int64le
+//   time: int64le (nanoseconds since the unix epoch)
+//   state: uint8 (`ReadResult::State`, either kMissing or kValue)
+//   generation_length: uint32le
+//   generation: byte[generation_length]
+//   value: byte[*] (remainder of the record)
+
+constexpr uint32_t kRecordMagic = 0x5453'4b43;  // "CKST"
+
+struct Record {
+  std::string key;
+  OptionalByteRangeRequest byte_range;
+  ReadResult read_result;
+};
+
+absl::Cord EncodeRecord(std::string_view key,
+                        OptionalByteRangeRequest byte_range,
+                        const ReadResult& read_result) {
+  absl::Cord record;
+  riegeli::CordWriter writer(&record);
+  const auto& generation = read_result.stamp.generation.value;
+  riegeli::WriteLittleEndian<uint32_t>(kRecordMagic, writer);
+  riegeli::WriteLittleEndian<uint32_t>(key.size(), writer);
+  writer.Write(key);
+  riegeli::WriteLittleEndian<uint64_t>(byte_range.inclusive_min, writer);
+  riegeli::WriteLittleEndian<uint64_t>(byte_range.exclusive_max, writer);
+  riegeli::WriteLittleEndian<uint64_t>(
+      absl::ToUnixNanos(read_result.stamp.time), writer);
+  riegeli::WriteLittleEndian<uint8_t>(static_cast<uint8_t>(read_result.state),
+                                      writer);
+  riegeli::WriteLittleEndian<uint32_t>(generation.size(), writer);
+  writer.Write(generation);
+  if (read_result.has_value()) writer.Write(read_result.value);
+  // Writing to a `Cord` cannot fail.
+  [[maybe_unused]] bool closed = writer.Close();
+  assert(closed);
+  return record;
+}
+
+Result<Record> DecodeRecord(const absl::Cord& encoded) {
+  riegeli::CordReader reader(&encoded);
+  Record record;
+  uint32_t magic;
+  uint32_t key_length;
+  uint64_t inclusive_min;
+  uint64_t exclusive_max;
+  uint64_t time_nanos;
+  uint8_t state;
+  uint32_t generation_length;
+  if (!riegeli::ReadLittleEndian<uint32_t>(reader, magic) ||
+      magic != kRecordMagic ||
+      !riegeli::ReadLittleEndian<uint32_t>(reader, key_length) ||
+      !reader.Read(key_length, record.key) ||
+      !riegeli::ReadLittleEndian<uint64_t>(reader, inclusive_min) ||
+      !riegeli::ReadLittleEndian<uint64_t>(reader, exclusive_max) ||
+      !riegeli::ReadLittleEndian<uint64_t>(reader, time_nanos) ||
+      !riegeli::ReadLittleEndian<uint8_t>(reader, state) ||
+      !riegeli::ReadLittleEndian<uint32_t>(reader, generation_length) ||
+      !reader.Read(generation_length,
+                   record.read_result.stamp.generation.value)) {
+    return absl::DataLossError("Invalid cache record header");
+  }
+  record.byte_range.inclusive_min = static_cast<int64_t>(inclusive_min);
+  record.byte_range.exclusive_max = static_cast<int64_t>(exclusive_max);
+  record.read_result.stamp.time =
+      absl::FromUnixNanos(static_cast<int64_t>(time_nanos));
+  record.read_result.state = static_cast<ReadResult::State>(state);
+  if (record.read_result.has_value()) {
+    // The value is the remainder of the record, and shares its storage.
+    record.read_result.value = encoded.Subcord(
+        reader.pos(), encoded.size() - static_cast<size_t>(reader.pos()));
+  } else if (!record.read_result.not_found() ||
+             reader.pos() != encoded.size()) {
+    return absl::DataLossError("Invalid cache record state");
+  }
+  return record;
+}
+
+// -----------------------------------------------------------------------------
+
+struct CacheKvStoreSpecData {
+  kvstore::Spec base;
+  kvstore::Spec cache;
+  uint64_t bytes_limit;
+
+  constexpr static auto ApplyMembers = [](auto&& x, auto f) {
+    return f(x.base, x.cache, x.bytes_limit);
+  };
+
+  constexpr static auto default_json_binder = jb::Object(
+      jb::Member("base", jb::Projection<&CacheKvStoreSpecData::base>()),
+      jb::Member("cache", jb::Projection<&CacheKvStoreSpecData::cache>()),
+      jb::Member("bytes_limit",
+                 jb::Projection<&CacheKvStoreSpecData::bytes_limit>()));
+};
+
+class CacheKvStoreSpec
+    : public internal_kvstore::RegisteredDriverSpec<CacheKvStoreSpec,
+                                                    CacheKvStoreSpecData> {
+ public:
+  static constexpr char id[] = "cache";
+
+  Future<kvstore::DriverPtr> DoOpen() const override;
+
+  absl::Status ApplyOptions(kvstore::DriverSpecOptions&& options) override {
+    return data_.base.driver.Set(std::move(options));
+  }
+
+  Result<kvstore::Spec> GetBase(std::string_view path) const override {
+    return data_.base;
+  }
+};
+
+// Defines the "cache" key value store adapter.
+class CacheKvStore
+    : public internal_kvstore::RegisteredDriver<CacheKvStore,
+                                                CacheKvStoreSpec> {
+ public:
+  Future<ReadResult> Read(Key key, ReadOptions options) override;
+
+  Future<TimestampedStorageGeneration> Write(Key key,
+                                             std::optional<Value> value,
+                                             WriteOptions options) override;
+
+  Future<const void> DeleteRange(KeyRange range) override;
+
+  void ListImpl(ListOptions options, ListReceiver receiver) override;
+
+  std::string DescribeKey(std::string_view key) override {
+    return base_.driver->DescribeKey(absl::StrCat(base_.path, key));
+  }
+
+  absl::Status GetBoundSpecData(CacheKvStoreSpecData& spec) const {
+    spec = spec_data_;
+    return absl::OkStatus();
+  }
+
+  SupportedFeatures GetSupportedFeatures(
+      const KeyRange& key_range) const final {
+    return base_.driver->GetSupportedFeatures(
+        KeyRange::AddPrefix(base_.path, key_range));
+  }
+
+  Result<KvStore> GetBase(std::string_view path,
+                          const Transaction& transaction) const override {
+    return KvStore(base_.driver, base_.path, transaction);
+  }
+
+  /// Returns the prefix of the cache kvstore under which all records for
+  /// `key` are stored.
+  std::string GetRecordPrefix(std::string_view key) const;
+
+  /// Returns the cache kvstore key of the record for `key` and `byte_range`.
+  static std::string GetRecordKey(std::string_view record_prefix,
+                                  OptionalByteRangeRequest byte_range) {
+    return absl::StrCat(record_prefix, byte_range.inclusive_min, "_",
+                        byte_range.exclusive_max);
+  }
+
+  struct IndexEntry {
+    size_t size;
+    // Key of the base kvstore, or `std::nullopt` for records found when the
+    // index is rebuilt on open which have not been read since.
+    std::optional<std::string> key;
+    // Latest time at which the record is known to be up to date, in addition
+    // to the time stored in the record itself.
+    absl::Time validated_time = absl::InfinitePast();
+    // Indicates that the time stored in the record may not be relied upon,
+    // because the record was possibly affected by a `DeleteRange`.
+    bool must_revalidate = false;
+    std::list<std::string>::iterator lru_position;
+  };
+  using Index = absl::btree_map<std::string, IndexEntry>;
+
+  /// Populates the index from a listing of the cache kvstore.
+  void InitializeIndex(std::vector<ListEntry> entries);
+
+  struct RecordState {
+    absl::Time validated_time;
+    bool must_revalidate;
+    bool key_known;
+  };
+
+  /// Returns the state of `record_key`, marking it as recently used, or
+  /// `std::nullopt` if there is no such record.
+  std::optional<RecordState> LookupRecord(const std::string& record_key);
+
+  /// Records that `record_key` holds a value for `key`.
+  void SetRecordKey(const std::string& record_key, std::string_view key);
+
+  /// Records that `record_key` was found to be up to date as of `time`.
+  void MarkRecordValidated(const std::string& record_key, absl::Time time);
+
+  /// Removes `record_key` from the index, and deletes it from the cache
+  /// kvstore.
+  void EraseRecord(const std::string& record_key);
+
+  /// Writes a new record, unless the key is invalidated in the meantime.
+  void StoreRecord(std::string record_key, std::string_view key,
+                   OptionalByteRangeRequest byte_range,
+                   const ReadResult& read_result, uint64_t epoch);
+
+  /// Removes all records for keys in `range` of the cache kvstore.
+  Future<const void> InvalidateRecords(KeyRange range);
+
+  /// Removes all records for keys in `range` of the base kvstore.  Records
+  /// whose key is not known are instead marked as requiring revalidation.
+  Future<const void> InvalidateKeyRange(const KeyRange& range);
+
+  uint64_t epoch() {
+    absl::MutexLock lock(mutex_);
+    return epoch_;
+  }
+
+  void InsertIntoIndexLocked(const std::string& record_key, size_t size,
+                             std::optional<std::string> key,
+                             absl::Time validated_time)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  Index::iterator EraseFromIndexLocked(Index::iterator it)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  std::vector<std::string> EvictLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void DeleteRecords(std::vector<std::string> record_keys);
+
+  CacheKvStoreSpecData spec_data_;
+  kvstore::KvStore base_;
+  kvstore::KvStore cache_;
+  std::string base_identifier_;
+
+  absl::Mutex mutex_;
+  Index index_ ABSL_GUARDED_BY(mutex_);
+  // Most recently used records are at the front.
+  std::list<std::string> lru_ ABSL_GUARDED_BY(mutex_);
+  uint64_t total_bytes_ ABSL_GUARDED_BY(mutex_) = 0;
+  // Incremented whenever records are invalidated by a write, to prevent
+  // concurrent reads from storing values which may be out of date.
+  uint64_t epoch_ ABSL_GUARDED_BY(mutex_) = 0;
+};
+
+Future<kvstore::DriverPtr> CacheKvStoreSpec::DoOpen() const {
+  auto base_future = kvstore::Open(data_.base);
+  auto cache_future = kvstore::Open(data_.cache);
+  return PromiseFuturePair<kvstore::DriverPtr>::LinkValue(
+             [spec = IntrusivePtr<const CacheKvStoreSpec>(this)](
+                 Promise<kvstore::DriverPtr> promise,
+                 ReadyFuture<kvstore::KvStore> base_future,
+                 ReadyFuture<kvstore::KvStore> cache_future) {
+               auto driver = internal::MakeIntrusivePtr<CacheKvStore>();
+               driver->spec_data_ = spec->data_;
+               driver->base_ = std::move(base_future.value());
+               driver->cache_ = std::move(cache_future.value());
+               if (auto url = driver->base_.ToUrl(); url.ok()) {
+                 driver->base_identifier_ = *std::move(url);
+               } else {
+                 driver->base_identifier_ =
+                     driver->base_.driver->DescribeKey(driver->base_.path);
+               }
+               driver->SetBatchNestingDepth(
+                   std::max(driver->base_.driver->BatchNestingDepth(),
+                            driver->cache_.driver->BatchNestingDepth()) +
+                   1);
+               auto list_future = kvstore::ListFuture(driver->cache_);
+               LinkValue(
+                   [driver = std::move(driver)](
+                       Promise<kvstore::DriverPtr> promise,
+                       ReadyFuture<std::vector<ListEntry>> list_future) {
+                     driver->InitializeIndex(std::move(list_future.value()));
+                     promise.SetResult(std::move(driver));
+                   },
+                   std::move(promise), std::move(list_future));
+             },
+             std::move(base_future), std::move(cache_future))
+      .future;
+}
+
+std::string CacheKvStore::GetRecordPrefix(std::string_view key) const {
+  internal::SHA256Digester digester;
+  digester.Write(base_identifier_);
+  digester.Write(std::string_view("\0", 1));
+  digester.Write(key);
+  auto digest = digester.Digest();
+  std::string hex = absl::BytesToHexString(std::string_view(
+      reinterpret_cast<const char*>(digest.data()), digest.size()));
+  // Records are distributed among 256 directories.
+  return absl::StrCat(std::string_view(hex).substr(0, 2), "/",
+                      std::string_view(hex).substr(2), "/");
+}
+
+void CacheKvStore::InitializeIndex(std::vector<ListEntry> entries) {
+  std::vector<std::string> evicted;
+  {
+    absl::MutexLock lock(mutex_);
+    for (auto& entry : entries) {
+      InsertIntoIndexLocked(entry.key, std::max<int64_t>(entry.size, 0),
+                            std::nullopt, absl::InfinitePast());
+    }
+    evicted = EvictLocked();
+  }
+  DeleteRecords(std::move(evicted));
+}
+
+void CacheKvStore::InsertIntoIndexLocked(const std::string& record_key,
+                                         size_t size,
+                                         std::optional<std::string> key,
+                                         absl::Time validated_time) {
+  auto [it, inserted] = index_.try_emplace(record_key);
+  if (!inserted) {
+    total_bytes_ -= it->second.size;
+    lru_.erase(it->second.lru_position);
+  }
+  it->second.size = size;
+  it->second.key = std::move(key);
+  it->second.validated_time = validated_time;
+  it->second.must_revalidate = false;
+  lru_.push_front(record_key);
+  it->second.lru_position = lru_.begin();
+  total_bytes_ += size;
+}
+
+CacheKvStore::Index::iterator CacheKvStore::EraseFromIndexLocked(
+    Index::iterator it) {
+  total_bytes_ -= it->second.size;
+  lru_.erase(it->second.lru_position);
+  return index_.erase(it);
+}
+
+std::vector<std::string> CacheKvStore::EvictLocked() {
+  std::vector<std::string> evicted;
+  while (total_bytes_ > spec_data_.bytes_limit && !lru_.empty()) {
+    auto it = index_.find(lru_.back());
+    evicted.push_back(it->first);
+    EraseFromIndexLocked(it);
+  }
+  cache_metrics.evicted.IncrementBy(evicted.size());
+  return evicted;
+}
+
+void CacheKvStore::DeleteRecords(std::vector<std::string> record_keys) {
+  for (auto& record_key : record_keys) {
+    kvstore::Delete(cache_, record_key)
+        .ExecuteWhenReady(
+            [record_key](ReadyFuture<TimestampedStorageGeneration> future) {
+              if (!future.result().ok()) {
+                ABSL_LOG_IF(INFO, cache_logging)
+                    << "Failed to delete cache record " << record_key << ": "
+                    << future.result().status();
+              }
+            });
+  }
+}
+
+std::optional<CacheKvStore::RecordState> CacheKvStore::LookupRecord(
+    const std::string& record_key) {
+  absl::MutexLock lock(mutex_);
+  auto it = index_.find(record_key);
+  if (it == index_.end()) return std::nullopt;
+  lru_.splice(lru_.begin(), lru_, it->second.lru_position);
+  return RecordState{it->second.validated_time, it->second.must_revalidate,
+                     it->second.key.has_value()};
+}
+
+void CacheKvStore::SetRecordKey(const std::string& record_key,
+                                std::string_view key) {
+  absl::MutexLock lock(mutex_);
+  auto it = index_.find(record_key);
+  if (it == index_.end()) return;
+  it->second.key = std::string(key);
+}
+
+void CacheKvStore::MarkRecordValidated(const std::string& record_key,
+                                       absl::Time time) {
+  absl::MutexLock lock(mutex_);
+  auto it = index_.find(record_key);
+  if (it == index_.end()) return;
+  it->second.validated_time = std::max(it->second.validated_time, time);
+  it->second.must_revalidate = false;
+}
+
+void CacheKvStore::EraseRecord(const std::string& record_key) {
+  {
+    absl::MutexLock lock(mutex_);
+    auto it = index_.find(record_key);
+    if (it != index_.end()) EraseFromIndexLocked(it);
+  }
+  DeleteRecords({record_key});
+}
+
+void CacheKvStore::StoreRecord(std::string record_key, std::string_view key,
+                               OptionalByteRangeRequest byte_range,
+                               const ReadResult& read_result, uint64_t epoch) {
+  absl::Cord encoded = EncodeRecord(key, byte_range, read_result);
+  const size_t size = encoded.size();
+  if (size > spec_data_.bytes_limit) return;
+  kvstore::Write(cache_, record_key, std::move(encoded))
+      .ExecuteWhenReady(
+          [self = IntrusivePtr<CacheKvStore>(this),
+           record_key = std::move(record_key), key = std::string(key), size,
+           time = read_result.stamp.time,
+           epoch](ReadyFuture<TimestampedStorageGeneration> future) {
+            if (!future.result().ok()) {
+              ABSL_LOG_IF(INFO, cache_logging)
+                  << "Failed to write cache record " << record_key << ": "
+                  << future.result().status();
+              return;
+            }
+            std::vector<std::string> evicted;
+            {
+              absl::MutexLock lock(self->mutex_);
+              if (self->epoch_ != epoch) {
+                // The key may have been written since the value was read.
+                evicted.push_back(record_key);
+              } else {
+                self->InsertIntoIndexLocked(record_key, size, std::move(key),
+                                            time);
+                evicted = self->EvictLocked();
+              }
+            }
+            self->DeleteRecords(std::move(evicted));
+          });
+}
+
+Future<const void> CacheKvStore::InvalidateRecords(KeyRange range) {
+  {
+    absl::MutexLock lock(mutex_);
+    ++epoch_;
+    auto it = index_.lower_bound(range.inclusive_min);
+    while (it != index_.end() && range.Contains(it->first)) {
+      it = EraseFromIndexLocked(it);
+    }
+  }
+  return kvstore::DeleteRange(cache_, std::move(range));
+}
+
+Future<const void> CacheKvStore::InvalidateKeyRange(const KeyRange& range) {
+  std::vector<std::string> record_keys;
+  {
+    absl::MutexLock lock(mutex_);
+    ++epoch_;
+    for (auto it = index_.begin(); it != index_.end();) {
+      auto& entry = it->second;
+      if (!entry.key) {
+        // The record may hold a value for a key in `range`; it is checked
+        // against the base kvstore when next read.
+        entry.validated_time = absl::InfinitePast();
+        entry.must_revalidate = true;
+        ++it;
+      } else if (range.Contains(*entry.key)) {
+        record_keys.push_back(it->first);
+        it = EraseFromIndexLocked(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  std::vector<AnyFuture> futures;
+  futures.reserve(record_keys.size());
+  for (const auto& record_key : record_keys) {
+    futures.push_back(kvstore::Delete(cache_, record_key));
+  }
+  return WaitAllFuture(futures);
+}
+
+// -----------------------------------------------------------------------------
+
+/// State of a single `Read` operation.
+struct ReadState : public internal::AtomicReferenceCount<ReadState> {
+  IntrusivePtr<CacheKvStore> owner_;
+  std::string key_;
+  kvstore::ReadOptions options_;
+  std::string record_prefix_;
+  uint64_t epoch_;
+
+  // Cached record used to answer the read, if any.
+  std::string record_key_;
+  std::optional<Record> record_;
+  absl::Time validated_time_ = absl::InfinitePast();
+  bool must_revalidate_ = false;
+  bool key_known_ = false;
+
+  /// Reads the record matching the requested byte range, falling back to a
+  /// record of the full value.
+  void Start(Promise<ReadResult> promise) {
+    const std::string exact_key =
+        CacheKvStore::GetRecordKey(record_prefix_, options_.byte_range);
+    const std::string full_key =
+        CacheKvStore::GetRecordKey(record_prefix_, OptionalByteRangeRequest{});
+    std::optional<CacheKvStore::RecordState> state;
+    if ((state = owner_->LookupRecord(exact_key))) {
+      record_key_ = exact_key;
+    } else if ((state = owner_->LookupRecord(full_key))) {
+      record_key_ = full_key;
+    } else {
+      cache_metrics.miss.Increment();
+      ReadBase(std::move(promise));
+      return;
+    }
+    validated_time_ = state->validated_time;
+    must_revalidate_ = state->must_revalidate;
+    key_known_ = state->key_known;
+    kvstore::ReadOptions record_options;
+    record_options.batch = options_.batch;
+    // Errors reading the cache kvstore are not propagated; the base kvstore is
+    // read instead.
+    kvstore::Read(owner_->cache_, record_key_, std::move(record_options))
+        .ExecuteWhenReady([self = IntrusivePtr<ReadState>(this),
+                           promise = std::move(promise)](
+                              ReadyFuture<ReadResult> future) mutable {
+          if (!promise.result_needed()) return;
+          self->OnRecordRead(std::move(promise), future.result());
+        });
+  }
+
+  void OnRecordRead(Promise<ReadResult> promise,
+                    Result<ReadResult>& read_result) {
+    absl::Status status;
+    if (!read_result.ok()) {
+      status = read_result.status();
+    } else if (read_result->has_value()) {
+      if (auto decoded = DecodeRecord(read_result->value); decoded.ok()) {
+        record_ = *std::move(decoded);
+        if (record_->key != key_) {
+          status = absl::DataLossError("Cache record is for a different key");
+        }
+      } else {
+        status = decoded.status();
+      }
+    } else {
+      status = absl::NotFoundError("Cache record was evicted");
+    }
+    if (!status.ok()) {
+      ABSL_LOG_IF(INFO, cache_logging)
+          << "Failed to read cache record " << record_key_ << ": " << status;
+      owner_->EraseRecord(record_key_);
+      record_ = std::nullopt;
+      cache_metrics.miss.Increment();
+      ReadBase(std::move(promise));
+      return;
+    }
+    if (!key_known_) {
+      owner_->SetRecordKey(record_key_, key_);
+    }
+    if (must_revalidate_) {
+      record_->read_result.stamp.time = absl::InfinitePast();
+    }
+    record_->read_result.stamp.time =
+        std::max(record_->read_result.stamp.time, validated_time_);
+    if (record_->read_result.stamp.time >= options_.staleness_bound) {
+      cache_metrics.hit.Increment();
+      promise.SetResult(GetResultFromRecord(record_->read_result.stamp));
+      return;
+    }
+    ReadBase(std::move(promise));
+  }
+
+  /// Returns the result of the read given that the record is up to date as of
+  /// `stamp`.
+  Result<ReadResult> GetResultFromRecord(TimestampedStorageGeneration stamp) {
+    auto& read_result = record_->read_result;
+    if (!options_.generation_conditions.Matches(stamp.generation)) {
+      return ReadResult::Unspecified(std::move(stamp));
+    }
+    if (!read_result.has_value()) {
+      return ReadResult::Missing(std::move(stamp));
+    }
+    if (record_->byte_range == options_.byte_range) {
+      return ReadResult::Value(read_result.value, std::move(stamp));
+    }
+    // Slice the requested byte range from the full value.
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto byte_range,
+        options_.byte_range.Validate(read_result.value.size()));
+    return ReadResult::Value(
+        internal::GetSubCord(read_result.value, byte_range), std::move(stamp));
+  }
+
+  void ReadBase(Promise<ReadResult> promise) {
+    auto options = options_;
+    bool revalidating = false;
+    if (record_ && !options.generation_conditions) {
+      // Only the generation is needed if the cached value is still current.
+      options.generation_conditions.if_not_equal =
+          record_->read_result.stamp.generation;
+      revalidating = true;
+    }
+    LinkValue(
+        [self = IntrusivePtr<ReadState>(this), revalidating](
+            Promise<ReadResult> promise, ReadyFuture<ReadResult> future) {
+          self->OnBaseRead(std::move(promise), std::move(future.value()),
+                           revalidating);
+        },
+        std::move(promise),
+        kvstore::Read(owner_->base_, key_, std::move(options)));
+  }
+
+  void OnBaseRead(Promise<ReadResult> promise, ReadResult read_result,
+                  bool revalidating) {
+    if (revalidating && read_result.aborted()) {
+      // The cached value is unchanged.
+      cache_metrics.revalidated.Increment();
+      owner_->MarkRecordValidated(record_key_, read_result.stamp.time);
+      read_result.stamp.generation = record_->read_result.stamp.generation;
+      promise.SetResult(GetResultFromRecord(std::move(read_result.stamp)));
+      return;
+    }
+    if (!read_result.aborted() &&
+        !StorageGeneration::IsUnknown(read_result.stamp.generation)) {
+      owner_->StoreRecord(
+          CacheKvStore::GetRecordKey(record_prefix_, options_.byte_range),
+          key_, options_.byte_range, read_result, epoch_);
+    }
+    promise.SetResult(std::move(read_result));
+  }
+};
+
+Future<ReadResult> CacheKvStore::Read(Key key, ReadOptions options) {
+  cache_metrics.read.Increment();
+  if (options.byte_range.IsStat()) {
+    // Stat requests are not worth caching.
+    return kvstore::Read(base_, key, std::move(options));
+  }
+  if (options.staleness_bound > absl::Now()) {
+    options.staleness_bound = absl::Now();
+  }
+  auto state = internal::MakeIntrusivePtr<ReadState>();
+  state->owner_.reset(this);
+  state->record_prefix_ = GetRecordPrefix(key);
+  state->key_ = std::move(key);
+  state->options_ = std::move(options);
+  state->epoch_ = epoch();
+  auto [promise, future] = PromiseFuturePair<ReadResult>::Make();
+  state->Start(std::move(promise));
+  return std::move(future);
+}
+
+Future<TimestampedStorageGeneration> CacheKvStore::Write(
+    Key key, std::optional<Value> value, WriteOptions options) {
+  cache_metrics.write.Increment();
+  auto record_prefix = GetRecordPrefix(key);
+  // The stale records are removed once the base write completes, even if the
+  // returned future is no longer referenced.  The returned future does not
+  // become ready until they have been removed, so that subsequent reads
+  // observe the write.
+  auto [promise, future] =
+      PromiseFuturePair<TimestampedStorageGeneration>::Make();
+  kvstore::Write(base_, key, std::move(value), std::move(options))
+      .ExecuteWhenReady(
+          [self = IntrusivePtr<CacheKvStore>(this),
+           record_prefix = std::move(record_prefix),
+           promise = std::move(promise)](
+              ReadyFuture<TimestampedStorageGeneration> write_future) mutable {
+            self->InvalidateRecords(KeyRange::Prefix(record_prefix))
+                .ExecuteWhenReady(
+                    [promise = std::move(promise),
+                     write_future = std::move(write_future)](
+                        ReadyFuture<const void> invalidate_future) {
+                      promise.SetResult(write_future.result());
+                    });
+          });
+  return std::move(future);
+}
+
+Future<const void> CacheKvStore::DeleteRange(KeyRange range) {
+  cache_metrics.delete_range.Increment();
+  // As for `Write`, the records are removed regardless of whether the returned
+  // future is still referenced.
+  auto [promise, future] = PromiseFuturePair<void>::Make();
+  kvstore::DeleteRange(base_, range).ExecuteWhenReady(
+      [self = IntrusivePtr<CacheKvStore>(this), range = std::move(range),
+       promise = std::move(promise)](
+          ReadyFuture<const void> delete_future) mutable {
+        self->InvalidateKeyRange(range).ExecuteWhenReady(
+            [promise = std::move(promise),
+             delete_future = std::move(delete_future)](
+                ReadyFuture<const void> invalidate_future) {
+              promise.SetResult(delete_future.result());
+            });
+      });
+  return std::move(future);
+}
+
+void CacheKvStore::ListImpl(ListOptions options, ListReceiver receiver) {
+  cache_metrics.list.Increment();
+  options.range = KeyRange::AddPrefix(base_.path, std::move(options.range));
+  options.strip_prefix_length += base_.path.size();
+  base_.driver->ListImpl(std::move(options), std::move(receiver));
+}
+
+}  // namespace
+}  // namespace internal_cache_kvstore
+}  // namespace tensorstore
+
+TENSORSTORE_DECLARE_GARBAGE_COLLECTION_NOT_REQUIRED(
+    tensorstore::internal_cache_kvstore::CacheKvStore)
+
+// Registers the driver.
+namespace {
+const tensorstore::internal_kvstore::DriverRegistration<
+    tensorstore::internal_cache_kvstore::CacheKvStoreSpec>
+    registration;
+}  // namespace
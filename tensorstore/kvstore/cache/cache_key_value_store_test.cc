@@ -0,0 +1,300 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/strings/cord.h"
+#include "absl/time/time.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/context.h"
+#include "tensorstore/internal/global_initializer.h"
+#include "tensorstore/internal/testing/json_gtest.h"
+#include "tensorstore/kvstore/key_range.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/mock_kvstore.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/spec.h"
+#include "tensorstore/kvstore/test_matchers.h"
+#include "tensorstore/kvstore/test_util.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+namespace kvstore = ::tensorstore::kvstore;
+
+using ::tensorstore::Context;
+using ::tensorstore::JsonSubValueMatches;
+using ::tensorstore::KeyRange;
+using ::tensorstore::Result;
+using ::tensorstore::internal::KeyValueStoreOpsTestParameters;
+using ::tensorstore::internal::MatchesKvsReadResult;
+using ::tensorstore::internal::MatchesKvsReadResultNotFound;
+using ::tensorstore::internal::MockKeyValueStore;
+using ::tensorstore::internal::MockKeyValueStoreResource;
+using ::tensorstore::kvstore::KvStore;
+using ::testing::AllOf;
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+using ::testing::Not;
+using ::testing::SizeIs;
+
+class CacheKvStoreTest : public ::testing::Test {
+ public:
+  CacheKvStoreTest() : context_(Context::Default()) {
+    TENSORSTORE_CHECK_OK_AND_ASSIGN(
+        base_, kvstore::Open("memory://").result());
+    TENSORSTORE_CHECK_OK_AND_ASSIGN(
+        auto mock_key_value_store_resource,
+        context_.GetResource<MockKeyValueStoreResource>());
+    mock_store_ = mock_key_value_store_resource->get();
+    mock_store_->forward_to = base_.driver;
+    mock_store_->log_requests = true;
+  }
+
+  Result<KvStore> OpenCache(int64_t bytes_limit = 1 << 20) {
+    return kvstore::Open({{"driver", "cache"},
+                          {"base", {{"driver", "mock_key_value_store"}}},
+                          {"cache", "memory://cache/"},
+                          {"bytes_limit", bytes_limit}},
+                         context_)
+        .result();
+  }
+
+  Result<KvStore> OpenCacheStore() {
+    return kvstore::Open("memory://cache/", context_).result();
+  }
+
+  Context context_;
+  KvStore base_;
+  MockKeyValueStore* mock_store_;
+};
+
+TEST_F(CacheKvStoreTest, Spec) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store, OpenCache(1000));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto spec, store.spec());
+  EXPECT_THAT(spec.ToJson(),
+              ::testing::Optional(AllOf(
+                  JsonSubValueMatches("/driver", "cache"),
+                  JsonSubValueMatches("/base/driver", "mock_key_value_store"),
+                  JsonSubValueMatches("/cache/driver", "memory"),
+                  JsonSubValueMatches("/cache/path", "cache/"),
+                  JsonSubValueMatches("/bytes_limit", 1000))));
+}
+
+TEST_F(CacheKvStoreTest, RevalidatesCachedValue) {
+  TENSORSTORE_ASSERT_OK(kvstore::Write(base_, "a", absl::Cord("value_a")));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store, OpenCache());
+  mock_store_->request_log.pop_all();
+
+  // The first read is forwarded to the base kvstore unconditionally.
+  EXPECT_THAT(kvstore::Read(store, "a").result(),
+              MatchesKvsReadResult(absl::Cord("value_a")));
+  EXPECT_THAT(mock_store_->request_log.pop_all(),
+              ElementsAre(AllOf(JsonSubValueMatches("/type", "read"),
+                                JsonSubValueMatches("/key", "a"),
+                                Not(JsonSubValueMatches(
+                                    "/if_not_equal", ::testing::_)))));
+
+  // Subsequent reads only revalidate the cached generation.
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto read_result,
+                                   kvstore::Read(store, "a").result());
+  EXPECT_EQ(absl::Cord("value_a"), read_result.value);
+  EXPECT_THAT(
+      mock_store_->request_log.pop_all(),
+      ElementsAre(AllOf(JsonSubValueMatches("/type", "read"),
+                        JsonSubValueMatches(
+                            "/if_not_equal",
+                            read_result.stamp.generation.value))));
+}
+
+TEST_F(CacheKvStoreTest, StalenessBound) {
+  TENSORSTORE_ASSERT_OK(kvstore::Write(base_, "a", absl::Cord("value_a")));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store, OpenCache());
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto read_result,
+                                   kvstore::Read(store, "a").result());
+  mock_store_->request_log.pop_all();
+
+  // A read which accepts the cached value does not access the base kvstore.
+  kvstore::ReadOptions options;
+  options.staleness_bound = read_result.stamp.time;
+  EXPECT_THAT(kvstore::Read(store, "a", options).result(),
+              MatchesKvsReadResult(absl::Cord("value_a"),
+                                   read_result.stamp.generation));
+  options.byte_range = tensorstore::OptionalByteRangeRequest::Range(1, 3);
+  EXPECT_THAT(kvstore::Read(store, "a", options).result(),
+              MatchesKvsReadResult(absl::Cord("al"),
+                                   read_result.stamp.generation));
+  EXPECT_THAT(mock_store_->request_log.pop_all(), IsEmpty());
+
+  // The cached value persists across instances.
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store2, OpenCache());
+  mock_store_->request_log.pop_all();
+  EXPECT_THAT(kvstore::Read(store2, "a", options).result(),
+              MatchesKvsReadResult(absl::Cord("al"),
+                                   read_result.stamp.generation));
+  EXPECT_THAT(mock_store_->request_log.pop_all(), IsEmpty());
+}
+
+TEST_F(CacheKvStoreTest, WriteInvalidates) {
+  TENSORSTORE_ASSERT_OK(kvstore::Write(base_, "a", absl::Cord("value_a")));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store, OpenCache());
+  TENSORSTORE_ASSERT_OK(kvstore::Read(store, "a").result());
+
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "a", absl::Cord("new_a")));
+  mock_store_->request_log.pop_all();
+
+  kvstore::ReadOptions options;
+  options.staleness_bound = absl::InfinitePast();
+  EXPECT_THAT(kvstore::Read(store, "a", options).result(),
+              MatchesKvsReadResult(absl::Cord("new_a")));
+  EXPECT_THAT(mock_store_->request_log.pop_all(),
+              ElementsAre(JsonSubValueMatches("/type", "read")));
+}
+
+TEST_F(CacheKvStoreTest, BytesLimit) {
+  TENSORSTORE_ASSERT_OK(kvstore::Write(base_, "a", absl::Cord("value_a")));
+  TENSORSTORE_ASSERT_OK(kvstore::Write(base_, "b", absl::Cord("value_b")));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store, OpenCache(80));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto cache_store, OpenCacheStore());
+
+  TENSORSTORE_ASSERT_OK(kvstore::Read(store, "a").result());
+  EXPECT_THAT(kvstore::ListFuture(cache_store).result(),
+              ::testing::Optional(SizeIs(1)));
+
+  // Only one record fits within the limit.
+  TENSORSTORE_ASSERT_OK(kvstore::Read(store, "b").result());
+  EXPECT_THAT(kvstore::ListFuture(cache_store).result(),
+              ::testing::Optional(SizeIs(1)));
+}
+
+TEST_F(CacheKvStoreTest, CorruptRecordFallsBackToBase) {
+  TENSORSTORE_ASSERT_OK(kvstore::Write(base_, "a", absl::Cord("value_a")));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store, OpenCache());
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto cache_store, OpenCacheStore());
+  TENSORSTORE_ASSERT_OK(kvstore::Read(store, "a").result());
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto entries,
+                                   kvstore::ListFuture(cache_store).result());
+  ASSERT_THAT(entries, SizeIs(1));
+  TENSORSTORE_ASSERT_OK(
+      kvstore::Write(cache_store, entries[0].key, absl::Cord("corrupt")));
+  mock_store_->request_log.pop_all();
+
+  // The corrupt record is discarded, and the value is read from the base.
+  kvstore::ReadOptions options;
+  options.staleness_bound = absl::InfinitePast();
+  EXPECT_THAT(kvstore::Read(store, "a", options).result(),
+              MatchesKvsReadResult(absl::Cord("value_a")));
+  EXPECT_THAT(mock_store_->request_log.pop_all(),
+              ElementsAre(AllOf(JsonSubValueMatches("/type", "read"),
+                                Not(JsonSubValueMatches(
+                                    "/if_not_equal", ::testing::_)))));
+}
+
+TEST_F(CacheKvStoreTest, DeleteRangeInvalidatesRange) {
+  TENSORSTORE_ASSERT_OK(kvstore::Write(base_, "a", absl::Cord("value_a")));
+  TENSORSTORE_ASSERT_OK(kvstore::Write(base_, "b", absl::Cord("value_b")));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store, OpenCache());
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto cache_store, OpenCacheStore());
+  TENSORSTORE_ASSERT_OK(kvstore::Read(store, "a").result());
+  TENSORSTORE_ASSERT_OK(kvstore::Read(store, "b").result());
+
+  TENSORSTORE_ASSERT_OK(
+      kvstore::DeleteRange(store, KeyRange::Singleton("a")));
+  EXPECT_THAT(kvstore::ListFuture(cache_store).result(),
+              ::testing::Optional(SizeIs(1)));
+  mock_store_->request_log.pop_all();
+
+  // The record for "b" is still used.
+  kvstore::ReadOptions options;
+  options.staleness_bound = absl::InfinitePast();
+  EXPECT_THAT(kvstore::Read(store, "b", options).result(),
+              MatchesKvsReadResult(absl::Cord("value_b")));
+  EXPECT_THAT(mock_store_->request_log.pop_all(), IsEmpty());
+  EXPECT_THAT(kvstore::Read(store, "a", options).result(),
+              MatchesKvsReadResultNotFound());
+}
+
+TEST_F(CacheKvStoreTest, DeleteRangeRevalidatesUnknownRecords) {
+  TENSORSTORE_ASSERT_OK(kvstore::Write(base_, "a", absl::Cord("value_a")));
+  {
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store, OpenCache());
+    TENSORSTORE_ASSERT_OK(kvstore::Read(store, "a").result());
+  }
+
+  // The key of the record is not known to a new instance until it is read.
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store, OpenCache());
+  TENSORSTORE_ASSERT_OK(
+      kvstore::DeleteRange(store, KeyRange::Singleton("a")));
+  mock_store_->request_log.pop_all();
+
+  kvstore::ReadOptions options;
+  options.staleness_bound = absl::InfinitePast();
+  EXPECT_THAT(kvstore::Read(store, "a", options).result(),
+              MatchesKvsReadResultNotFound());
+  EXPECT_THAT(mock_store_->request_log.pop_all(),
+              ElementsAre(JsonSubValueMatches("/if_not_equal", ::testing::_)));
+}
+
+TEST_F(CacheKvStoreTest, DroppedWriteFutureInvalidates) {
+  TENSORSTORE_ASSERT_OK(kvstore::Write(base_, "a", absl::Cord("value_a")));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store, OpenCache());
+  TENSORSTORE_ASSERT_OK(kvstore::Read(store, "a").result());
+
+  // The base write completes only after the returned future is dropped.
+  mock_store_->forward_to = {};
+  kvstore::Write(store, "a", absl::Cord("new_a")).IgnoreFuture();
+  mock_store_->write_requests.pop()(base_.driver);
+  mock_store_->forward_to = base_.driver;
+
+  kvstore::ReadOptions options;
+  options.staleness_bound = absl::InfinitePast();
+  EXPECT_THAT(kvstore::Read(store, "a", options).result(),
+              MatchesKvsReadResult(absl::Cord("new_a")));
+}
+
+TEST_F(CacheKvStoreTest, DroppedDeleteRangeFutureInvalidates) {
+  TENSORSTORE_ASSERT_OK(kvstore::Write(base_, "a", absl::Cord("value_a")));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store, OpenCache());
+  TENSORSTORE_ASSERT_OK(kvstore::Read(store, "a").result());
+
+  // The base delete completes only after the returned future is dropped.
+  mock_store_->forward_to = {};
+  kvstore::DeleteRange(store, KeyRange::Singleton("a")).IgnoreFuture();
+  mock_store_->delete_range_requests.pop()(base_.driver);
+  mock_store_->forward_to = base_.driver;
+
+  kvstore::ReadOptions options;
+  options.staleness_bound = absl::InfinitePast();
+  EXPECT_THAT(kvstore::Read(store, "a", options).result(),
+              MatchesKvsReadResultNotFound());
+}
+
+TENSORSTORE_GLOBAL_INITIALIZER {
+  KeyValueStoreOpsTestParameters params;
+  params.test_name = "Basic";
+  params.get_store = [](auto callback) {
+    auto context = Context::Default();
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto store, kvstore::Open({{"driver", "cache"},
+                                   {"base", "memory://base/"},
+                                   {"cache", "memory://cache/"},
+                                   {"bytes_limit", 1 << 20}},
+                                  context)
+                        .result());
+    callback(store);
+  };
+  RegisterKeyValueStoreOpsTests(params);
+}
+
+}  // namespace
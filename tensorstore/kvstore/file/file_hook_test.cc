@@ -222,6 +222,81 @@ INSTANTIATE_TEST_SUITE_P(AllModes, FileHookTest,
                          ::testing::Values("os", "lockfile", "none",
                                            "non_atomic"));
 
+// In io_uring mode, reads, writes, fsyncs and renames are issued through the
+// ring rather than `file_util`, but are subject to the same hooks.  If io_uring
+// is unavailable the driver falls back to the default io mode.
+tensorstore::KvStore OpenIoUringStore(const std::string& root) {
+  return kvstore::Open({{"driver", "file"},
+                        {"path", root + "/"},
+                        {"file_io_locking", {{"mode", "lockfile"}}},
+                        {"file_io_mode", {{"mode", "io_uring"}}}})
+      .value();
+}
+
+TEST(FileIoUringHookTest, PutFailsOnWrite) {
+  ScopedTemporaryDirectory tempdir;
+  auto store = OpenIoUringStore(tempdir.path() + "/root");
+
+  bool hook_called = false;
+  ScopedTestHook<WriteOpTag> scoped_hook(
+      [&](FileDescriptor fd) -> std::optional<absl::Status> {
+        hook_called = true;
+        return absl::DataLossError("Injected write failure");
+      });
+  auto result = kvstore::Write(store, "foo", absl::Cord("abc")).result();
+  EXPECT_THAT(result, StatusIs(absl::StatusCode::kDataLoss));
+  EXPECT_TRUE(hook_called);
+}
+
+TEST(FileIoUringHookTest, ReadFailsOnRead) {
+  ScopedTemporaryDirectory tempdir;
+  auto store = OpenIoUringStore(tempdir.path() + "/root");
+
+  TENSORSTORE_ASSERT_OK(
+      kvstore::Write(store, "foo", absl::Cord("abc")).result());
+
+  bool hook_called = false;
+  ScopedTestHook<ReadOpTag> scoped_hook(
+      [&](FileDescriptor fd) -> std::optional<absl::Status> {
+        hook_called = true;
+        return absl::DataLossError("Injected read failure");
+      });
+  auto result = kvstore::Read(store, "foo").result();
+  EXPECT_THAT(result, StatusIs(absl::StatusCode::kDataLoss));
+  EXPECT_TRUE(hook_called);
+}
+
+TEST(FileIoUringHookTest, PutFailsOnFsync) {
+  ScopedTemporaryDirectory tempdir;
+  auto store = OpenIoUringStore(tempdir.path() + "/root");
+
+  bool hook_called = false;
+  ScopedTestHook<FsyncOpTag> scoped_hook(
+      [&](FileDescriptor fd) -> std::optional<absl::Status> {
+        hook_called = true;
+        return absl::DataLossError("Injected fsync failure");
+      });
+  auto result = kvstore::Write(store, "foo", absl::Cord("abc")).result();
+  EXPECT_THAT(result, StatusIs(absl::StatusCode::kDataLoss));
+  EXPECT_TRUE(hook_called);
+}
+
+TEST(FileIoUringHookTest, PutFailsOnRename) {
+  ScopedTemporaryDirectory tempdir;
+  auto store = OpenIoUringStore(tempdir.path() + "/root");
+
+  bool hook_called = false;
+  ScopedTestHook<RenameOpTag> scoped_hook(
+      [&](FileDescriptor fd, const std::string& old_name,
+          const std::string& new_name) -> std::optional<absl::Status> {
+        hook_called = true;
+        return absl::DataLossError("Injected rename failure");
+      });
+  auto result = kvstore::Write(store, "foo", absl::Cord("abc")).result();
+  EXPECT_THAT(result, StatusIs(absl::StatusCode::kDataLoss));
+  EXPECT_TRUE(hook_called);
+}
+
 }  // namespace
 
 #endif  // TENSORSTORE_INTERNAL_TEST_HOOKS
@@ -88,15 +88,18 @@
 #include <atomic>
 #include <cassert>
 #include <limits>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <tuple>  // IWYU pragma: keep for std::get<>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "absl/base/attributes.h"
 #include "absl/base/optimization.h"
+#include "absl/container/inlined_vector.h"
 #include "absl/functional/function_ref.h"
 #include "absl/log/absl_check.h"  // IWYU pragma: keep
 #include "absl/log/absl_log.h"
@@ -106,11 +109,13 @@
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
+#include "absl/synchronization/blocking_counter.h"
 #include "absl/time/clock.h"
 #include "absl/time/time.h"
 #include "tensorstore/batch.h"
 #include "tensorstore/context.h"
 #include "tensorstore/internal/file_io_concurrency_resource.h"
+#include "tensorstore/internal/flat_cord_builder.h"
 #include "tensorstore/internal/global_initializer.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/json_binding/json_binding.h"
@@ -121,11 +126,16 @@
 #include "tensorstore/internal/os/error_code.h"
 #include "tensorstore/internal/os/file_descriptor.h"
 #include "tensorstore/internal/os/file_info.h"
+#include "tensorstore/internal/os/file_test_hooks.h"
+#include "tensorstore/internal/os/hugepages.h"
+#include "tensorstore/internal/os/io_uring.h"
 #include "tensorstore/internal/os/memory_region.h"
 #include "tensorstore/internal/os/open_flags.h"
 #include "tensorstore/internal/path.h"
+#include "tensorstore/internal/testing/test_hook.h"
 #include "tensorstore/internal/uri/parse.h"
 #include "tensorstore/internal/uri/path.h"
+#include "tensorstore/kvstore/adaptive_coalescing.h"
 #include "tensorstore/kvstore/batch_util.h"
 #include "tensorstore/kvstore/byte_range.h"
 #include "tensorstore/kvstore/common_metrics.h"
@@ -169,10 +179,12 @@ using ::tensorstore::internal_file_util::IsKeyValid;
 using ::tensorstore::internal_file_util::LongestDirectoryPrefix;
 using ::tensorstore::internal_file_util::OpenParentDirectory;
 using ::tensorstore::internal_file_util::ReadFromFileDescriptor;
+using ::tensorstore::internal_file_util::ReadScatteredFromFileDescriptor;
 using ::tensorstore::internal_os::AcquireExclusiveFile;
 using ::tensorstore::internal_os::AcquireFileLock;
 using ::tensorstore::internal_os::FileDescriptor;
 using ::tensorstore::internal_os::FileInfo;
+using ::tensorstore::internal_os::IoUring;
 using ::tensorstore::internal_os::kLockSuffix;
 using ::tensorstore::internal_os::MemmapFileReadOnly;
 using ::tensorstore::internal_os::OpenFlags;
@@ -193,6 +205,7 @@ struct FileMetrics : public internal_kvstore::CommonMetrics {
   internal_metrics::Counter<int64_t> open_read;
   internal_metrics::Counter<int64_t> lock_contention;
   internal_metrics::Counter<int64_t> direct_io_read;
+  internal_metrics::Counter<int64_t> io_uring_read;
 };
 ABSL_CONST_INIT static FileMetrics file_metrics;
 
@@ -211,6 +224,10 @@ TENSORSTORE_GLOBAL_INITIALIZER {
              internal_metrics::MetricMetadata(
                  "/tensorstore/kvstore/file/direct_io_read",
                  "file kvstore::Reads using direct IO"));
+  r.Register(&file_metrics.io_uring_read,
+             internal_metrics::MetricMetadata(
+                 "/tensorstore/kvstore/file/io_uring_read",
+                 "file kvstore::Reads using io_uring"));
 }
 
 ABSL_CONST_INIT internal_log::VerboseFlag verbose_logging("file");
@@ -285,6 +302,17 @@ class FileKeyValueStoreSpec
   }
 };
 
+// Local reads have little per-request overhead, so coalescing starts from
+// small gaps and adapts to the measured latency of the underlying device.
+internal_kvstore_batch::AdaptiveCoalescingPolicy::Options
+FileCoalescingPolicyOptions() {
+  internal_kvstore_batch::AdaptiveCoalescingPolicy::Options options;
+  options.kvstore = "file";
+  options.initial.max_extra_read_bytes = 255;
+  options.max_extra_read_bytes = 1 << 20;
+  return options;
+}
+
 class FileKeyValueStore
     : public internal_kvstore::RegisteredDriver<FileKeyValueStore,
                                                 FileKeyValueStoreSpec> {
@@ -325,7 +353,22 @@ class FileKeyValueStore
     return *spec_.file_io_locking;
   }
 
+  /// Returns the io_uring to use for io, or `nullptr` if io_uring mode is not
+  /// selected or not supported.
+  IoUring* io_uring() const {
+    if (file_io_mode() != FileIoModeResource::IoMode::kIoUring) return nullptr;
+    auto ring = IoUring::Get();
+    if (!ring.ok()) {
+      ABSL_LOG_FIRST_N(WARNING, 1)
+          << "io_uring unavailable, using default file io: " << ring.status();
+      return nullptr;
+    }
+    return *ring;
+  }
+
   FileKeyValueStoreSpecData spec_;
+  internal_kvstore_batch::AdaptiveCoalescingPolicy coalescing_policy_{
+      FileCoalescingPolicyOptions()};
 };
 
 absl::Status ValidateKey(std::string_view key) {
@@ -348,6 +391,26 @@ StorageGeneration GetFileGeneration(const FileInfo& info) {
                                        absl::ToUnixNanos(info.GetMTime()));
 }
 
+/// Submits `ops` to `ring` and blocks until all have completed.
+///
+/// Any callbacks already set on `ops` are replaced.
+///
+/// \returns The result of each operation, in order.
+std::vector<int32_t> SubmitAndWait(IoUring& ring,
+                                   std::vector<IoUring::Operation> ops) {
+  std::vector<int32_t> results(ops.size());
+  absl::BlockingCounter counter(static_cast<int>(ops.size()));
+  for (size_t i = 0; i < ops.size(); ++i) {
+    ops[i].callback = [&results, &counter, i](int32_t result) {
+      results[i] = result;
+      counter.DecrementCount();
+    };
+  }
+  ring.Submit(std::move(ops));
+  counter.Wait();
+  return results;
+}
+
 /// ----------------------------------------------------------------------------
 
 Result<UniqueFileDescriptor> OpenValueFile(const std::string& path,
@@ -410,11 +473,12 @@ class BatchReadTask final
     absl::Time start_time = absl::Now();
     auto read_result =
         ReadFromFileDescriptor(fd_.get(), byte_range, block_alignment_);
+    const absl::Duration latency = absl::Now() - start_time;
     if (read_result.ok()) {
       file_metrics.bytes_read.IncrementBy(read_result->size());
+      driver().coalescing_policy_.RecordRequest(read_result->size(), latency);
     }
-    file_metrics.read_latency_ms.Observe(
-        absl::ToInt64Milliseconds(absl::Now() - start_time));
+    file_metrics.read_latency_ms.Observe(absl::ToInt64Milliseconds(latency));
 
     if (!read_result.ok()) {
       return StatusBuilder(std::move(read_result).status())
@@ -455,6 +519,9 @@ class BatchReadTask final
       case FileIoModeResource::IoMode::kDirect:
         PrepareDirectIoRead(requests);
         break;
+      case FileIoModeResource::IoMode::kIoUring:
+        if (HandleIoUringRead(requests)) return;
+        break;
       case FileIoModeResource::IoMode::kDefault:
         break;
     }
@@ -468,8 +535,8 @@ class BatchReadTask final
 
     const auto& executor = driver().executor();
 
-    internal_kvstore_batch::CoalescingOptions coalescing_options;
-    coalescing_options.max_extra_read_bytes = 255;
+    internal_kvstore_batch::CoalescingOptions coalescing_options =
+        driver().coalescing_policy_.GetCoalescingOptions();
     internal_kvstore_batch::ForEachCoalescedRequest<Request>(
         requests, coalescing_options,
         [&](OptionalByteRangeRequest coalesced_byte_range,
@@ -508,6 +575,8 @@ class BatchReadTask final
             requests, std::move(mapped_result).status());
         return true;
       } else if (mapped_result.ok()) {
+        // Pages are only read on first access, so the cost of the read is
+        // not known here and is not recorded in the coalescing policy.
         absl::Cord file_contents = std::move(mapped_result).value().as_cord();
         for (const auto& req : requests) {
           ByteRange byte_range = req.byte_range.AsByteRange();
@@ -553,6 +622,12 @@ class BatchReadTask final
 
   void ProcessCoalescedRead(ByteRange coalesced_byte_range,
                             tensorstore::span<Request> coalesced_requests) {
+    // Direct IO requires block-aligned buffers, so it always reads the
+    // coalesced range into a single buffer.
+    if (coalesced_requests.size() > 1 && block_alignment_ == 0) {
+      ProcessScatteredRead(coalesced_requests);
+      return;
+    }
     TENSORSTORE_ASSIGN_OR_RETURN(auto read_result,
                                  DoByteRangeRead(coalesced_byte_range),
                                  internal_kvstore_batch::SetCommonResult(
@@ -560,6 +635,179 @@ class BatchReadTask final
     internal_kvstore_batch::ResolveCoalescedRequests(
         coalesced_byte_range, coalesced_requests, std::move(read_result));
   }
+
+  /// Reads `coalesced_requests` with vectored reads into a separate buffer per
+  /// group of overlapping requests.
+  ///
+  /// Unlike `DoByteRangeRead`, the bytes between requests are discarded rather
+  /// than retained by the results, and each result references only a buffer
+  /// sized to its own group of requests rather than the whole coalesced range.
+  void ProcessScatteredRead(tensorstore::span<Request> coalesced_requests) {
+    // `ForEachCoalescedRequest` sorts requests by `inclusive_min`.
+    absl::InlinedVector<ByteRange, 8> segments;
+    for (const auto& request : coalesced_requests) {
+      ByteRange byte_range = request.byte_range.AsByteRange();
+      if (!segments.empty() &&
+          byte_range.inclusive_min < segments.back().exclusive_max) {
+        segments.back().exclusive_max =
+            std::max(segments.back().exclusive_max, byte_range.exclusive_max);
+      } else {
+        segments.push_back(byte_range);
+      }
+    }
+
+    file_metrics.batch_read.Increment();
+    absl::Time start_time = absl::Now();
+    auto read_result =
+        ReadScatteredFromFileDescriptor(fd_.get(), tensorstore::span(segments));
+    const absl::Duration latency = absl::Now() - start_time;
+    file_metrics.read_latency_ms.Observe(absl::ToInt64Milliseconds(latency));
+    if (!read_result.ok()) {
+      absl::Status status =
+          StatusBuilder(std::move(read_result).status())
+              .Format("Error reading from open file %s",
+                      std::get<std::string>(batch_entry_key));
+      internal_kvstore_batch::SetCommonResult(coalesced_requests,
+                                              std::move(status));
+      return;
+    }
+    // The gaps between segments are also read, into a scratch buffer.
+    const int64_t bytes_read =
+        segments.back().exclusive_max - segments.front().inclusive_min;
+    file_metrics.bytes_read.IncrementBy(bytes_read);
+    driver().coalescing_policy_.RecordRequest(bytes_read, latency);
+
+    size_t segment_i = 0;
+    for (auto& request : coalesced_requests) {
+      ByteRange byte_range = request.byte_range.AsByteRange();
+      while (byte_range.inclusive_min < segments[segment_i].inclusive_min ||
+             byte_range.exclusive_max > segments[segment_i].exclusive_max) {
+        ++segment_i;
+      }
+      const ByteRange& segment = segments[segment_i];
+      const absl::Cord& segment_value = (*read_result)[segment_i];
+      request.promise.SetResult(kvstore::ReadResult::Value(
+          segment_value.Subcord(
+              byte_range.inclusive_min - segment.inclusive_min,
+              byte_range.size()),
+          stamp_));
+    }
+  }
+
+  /// State of a single coalesced read issued via io_uring.
+  struct IoUringRead {
+    internal::IntrusivePtr<BatchReadTask> self;
+    IoUring* ring;
+    ByteRange byte_range;
+    tensorstore::span<Request> requests;
+    internal::FlatCordBuilder buffer;
+    absl::Time start_time;
+  };
+
+  /// Invokes the `ReadOpTag` test hook, which `ReadFromFile` invokes for reads
+  /// that are not issued via io_uring.
+  static absl::Status InvokeIoUringReadTestHook(FileDescriptor fd) {
+    TENSORSTORE_INVOKE_TEST_HOOK(internal_os::ReadOpTag, fd);
+    return absl::OkStatus();
+  }
+
+  /// Submits all coalesced reads for the batch to the io_uring with a single
+  /// system call.  Returns `false` if io_uring is not available.
+  bool HandleIoUringRead(tensorstore::span<Request> requests) {
+    IoUring* ring = driver().io_uring();
+    if (!ring) return false;
+    if (absl::Status status = InvokeIoUringReadTestHook(fd_.get());
+        !status.ok()) {
+      status = StatusBuilder(std::move(status))
+                   .Format("Error reading from open file %s",
+                           std::get<std::string>(batch_entry_key));
+      internal_kvstore_batch::SetCommonResult(requests, std::move(status));
+      return true;
+    }
+
+    std::vector<IoUring::Operation> ops;
+    internal_kvstore_batch::CoalescingOptions coalescing_options =
+        driver().coalescing_policy_.GetCoalescingOptions();
+    internal_kvstore_batch::ForEachCoalescedRequest<Request>(
+        requests, coalescing_options,
+        [&](OptionalByteRangeRequest coalesced_byte_range,
+            tensorstore::span<Request> coalesced_requests) {
+          ByteRange byte_range = coalesced_byte_range.AsByteRange();
+          file_metrics.batch_read.Increment();
+          file_metrics.io_uring_read.Increment();
+          auto read = std::make_unique<IoUringRead>(IoUringRead{
+              internal::IntrusivePtr<BatchReadTask>(this), ring, byte_range,
+              coalesced_requests,
+              internal::FlatCordBuilder(
+                  internal_os::AllocateHugePageRegionWithFallback(
+                      0, byte_range.size()),
+                  0),
+              absl::Now()});
+          ops.push_back(MakeIoUringReadOperation(std::move(read)));
+        });
+    ring->Submit(std::move(ops));
+    return true;
+  }
+
+  /// Returns an operation which reads the remaining bytes of `read`.
+  ///
+  /// The completion callback resubmits on a short read, and otherwise hands
+  /// off to the executor to resolve the requests.
+  static IoUring::Operation MakeIoUringReadOperation(
+      std::unique_ptr<IoUringRead> read) {
+    // io_uring transfer lengths are 32-bit; larger reads complete as a
+    // sequence of short reads.
+    constexpr size_t kMaxTransferSize = size_t{1} << 30;
+    auto buffer = read->buffer.available_span();
+    const int64_t offset = read->byte_range.exclusive_max - buffer.size();
+    FileDescriptor fd = read->self->fd_.get();
+    return IoUring::Operation::Read(
+        fd, buffer.first(std::min<size_t>(buffer.size(), kMaxTransferSize)),
+        offset, [read = std::move(read)](int32_t result) mutable {
+          if (result > 0) {
+            read->buffer.set_inuse(read->buffer.size() -
+                                   read->buffer.available() + result);
+            if (read->buffer.available() > 0) {
+              IoUring* ring = read->ring;
+              std::vector<IoUring::Operation> ops;
+              ops.push_back(MakeIoUringReadOperation(std::move(read)));
+              ring->Submit(std::move(ops));
+              return;
+            }
+          }
+          // Resolving requests may run arbitrary continuations, which must not
+          // block the io_uring completion thread.
+          const Executor& executor = read->self->driver().executor();
+          executor([read = std::move(read), result] {
+            read->self->FinishIoUringRead(*read, result);
+          });
+        });
+  }
+
+  void FinishIoUringRead(IoUringRead& read, int32_t result) {
+    const absl::Duration latency = absl::Now() - read.start_time;
+    file_metrics.read_latency_ms.Observe(absl::ToInt64Milliseconds(latency));
+    absl::Status status;
+    if (result < 0) {
+      status = internal_os::IoUringResultToStatus(result,
+                                                  "Failed to read from file");
+    } else if (read.buffer.available() > 0) {
+      status = absl::UnavailableError(
+          "Unexpected EOF encountered reading from file.");
+    }
+    if (!status.ok()) {
+      status = StatusBuilder(std::move(status))
+                   .Format("Error reading from open file %s",
+                           std::get<std::string>(batch_entry_key));
+      internal_kvstore_batch::SetCommonResult(read.requests, std::move(status));
+      return;
+    }
+    file_metrics.bytes_read.IncrementBy(read.byte_range.size());
+    driver().coalescing_policy_.RecordRequest(read.byte_range.size(), latency);
+    internal_kvstore_batch::ResolveCoalescedRequests(
+        read.byte_range, read.requests,
+        kvstore::ReadResult::Value(std::move(read.buffer).Build(), stamp_));
+  }
 };
 
 Future<ReadResult> FileKeyValueStore::Read(Key key, ReadOptions options) {
@@ -575,10 +823,93 @@ Future<ReadResult> FileKeyValueStore::Read(Key key, ReadOptions options) {
 
 /// ----------------------------------------------------------------------------
 
+/// Runs a single operation via `ring` and blocks until it completes.
+absl::Status RunIoUringOperation(IoUring& ring, IoUring::Operation op,
+                                 std::string_view action) {
+  std::vector<IoUring::Operation> ops;
+  ops.push_back(std::move(op));
+  return internal_os::IoUringResultToStatus(
+      SubmitAndWait(ring, std::move(ops))[0], action);
+}
+
+/// Writes `value` to `fd` starting at offset 0 via `ring`, submitting each
+/// chunk of the cord as a separate write in a single batch.
+absl::Status WriteCordWithIoUring(IoUring& ring, FileDescriptor fd,
+                                  absl::Cord value) {
+  TENSORSTORE_INVOKE_TEST_HOOK(internal_os::WriteOpTag, fd);
+  // io_uring transfer lengths are 32-bit.
+  constexpr size_t kMaxTransferSize = size_t{1} << 30;
+  int64_t offset = 0;
+  while (!value.empty()) {
+    std::vector<IoUring::Operation> ops;
+    std::vector<size_t> sizes;
+    int64_t chunk_offset = offset;
+    for (std::string_view chunk : value.Chunks()) {
+      while (!chunk.empty()) {
+        size_t n = std::min(chunk.size(), kMaxTransferSize);
+        ops.push_back(IoUring::Operation::Write(
+            fd, tensorstore::span<const char>(chunk.data(), n), chunk_offset,
+            {}));
+        sizes.push_back(n);
+        chunk_offset += n;
+        chunk.remove_prefix(n);
+      }
+    }
+    auto results = SubmitAndWait(ring, std::move(ops));
+    // Advance past the longest fully-written prefix; anything after a short
+    // write is rewritten by the next batch.
+    size_t written = 0;
+    for (size_t i = 0; i < results.size(); ++i) {
+      TENSORSTORE_RETURN_IF_ERROR(
+          internal_os::IoUringResultToStatus(results[i], "Failed to write"));
+      written += results[i];
+      if (static_cast<size_t>(results[i]) < sizes[i]) break;
+    }
+    if (written == 0) {
+      return absl::UnavailableError("Unexpected zero-length write");
+    }
+    file_metrics.bytes_written.IncrementBy(written);
+    value.RemovePrefix(written);
+    offset += written;
+  }
+  return absl::OkStatus();
+}
+
+/// Fsyncs `fd` via `ring`; the io_uring equivalent of `FsyncFile`.
+absl::Status FsyncFileWithIoUring(IoUring& ring, FileDescriptor fd) {
+  TENSORSTORE_INVOKE_TEST_HOOK(internal_os::FsyncOpTag, fd);
+  return RunIoUringOperation(ring, IoUring::Operation::Fsync(fd, {}),
+                             "Failed to fsync file");
+}
+
+/// Renames `old_name` to `new_name` via `ring`; the io_uring equivalent of
+/// `RenameOpenFile`.
+absl::Status RenameOpenFileWithIoUring(IoUring& ring, FileDescriptor fd,
+                                       const std::string& old_name,
+                                       const std::string& new_name) {
+  TENSORSTORE_INVOKE_TEST_HOOK(internal_os::RenameOpTag, fd, old_name,
+                               new_name);
+  return RunIoUringOperation(
+      ring, IoUring::Operation::Rename(old_name, new_name, {}),
+      absl::StrFormat("Failed to rename %v to: %v", QuoteString(old_name),
+                      QuoteString(new_name)));
+}
+
 absl::Status WriteWithSync(FileDescriptor fd, const std::string& fd_path,
-                           absl::Cord value, bool sync) {
+                           absl::Cord value, bool sync, IoUring* io_uring) {
   assert(fd != internal_os::InvalidFileDescriptor());
   auto start_write = absl::Now();
+  if (io_uring) {
+    TENSORSTORE_RETURN_IF_ERROR(
+        WriteCordWithIoUring(*io_uring, fd, std::move(value)))
+        .Format("Failed writing: %v", QuoteString(fd_path));
+    if (sync) {
+      TENSORSTORE_RETURN_IF_ERROR(FsyncFileWithIoUring(*io_uring, fd));
+    }
+    file_metrics.write_latency_ms.Observe(
+        absl::ToInt64Milliseconds(absl::Now() - start_write));
+    return absl::OkStatus();
+  }
   while (!value.empty()) {
     TENSORSTORE_ASSIGN_OR_RETURN(
         auto n, internal_os::WriteCordToFile(fd, value),
@@ -602,6 +933,8 @@ struct WriteTask {
   kvstore::WriteOptions options;
   bool sync;
   FileIoLockingResource::Spec file_io_locking;
+  // When non-null, write, fsync and rename operations are issued via io_uring.
+  IoUring* io_uring;
 
   Result<TimestampedStorageGeneration> operator()() const {
     ABSL_LOG_IF(INFO, verbose_logging) << "WriteTask " << full_path;
@@ -664,22 +997,34 @@ struct WriteTask {
       }
 
       TENSORSTORE_RETURN_IF_ERROR(WriteWithSync(
-          lock_helper.fd(), lock_helper.lock_path(), value, sync));
+          lock_helper.fd(), lock_helper.lock_path(), value, sync, io_uring));
       // Stat and Rename
       FileInfo info;
       TENSORSTORE_RETURN_IF_ERROR(
           internal_os::GetFileInfo(lock_helper.fd(), &info));
 
       if (lock_helper.lock_path() != full_path) {
-        TENSORSTORE_RETURN_IF_ERROR(internal_os::RenameOpenFile(
-            lock_helper.fd(), lock_helper.lock_path(), full_path));
+        if (io_uring) {
+          TENSORSTORE_RETURN_IF_ERROR(RenameOpenFileWithIoUring(
+              *io_uring, lock_helper.fd(), lock_helper.lock_path(),
+              full_path));
+        } else {
+          TENSORSTORE_RETURN_IF_ERROR(internal_os::RenameOpenFile(
+              lock_helper.fd(), lock_helper.lock_path(), full_path));
+        }
       }
 
       delete_lock_file = false;
       r.generation = GetFileGeneration(info);
       if (sync) {
         // fsync the parent directory to ensure the `rename` is durable.
-        TENSORSTORE_RETURN_IF_ERROR(internal_os::FsyncDirectory(dir_fd.get()))
+        absl::Status fsync_status =
+            io_uring ? RunIoUringOperation(
+                           *io_uring,
+                           IoUring::Operation::Fsync(dir_fd.get(), {}),
+                           "Failed to fsync directory")
+                     : internal_os::FsyncDirectory(dir_fd.get());
+        TENSORSTORE_RETURN_IF_ERROR(fsync_status)
             .Format("Error calling fsync on parent directory of: %s",
                     full_path);
       }
@@ -781,9 +1126,9 @@ Future<TimestampedStorageGeneration> FileKeyValueStore::Write(
   file_metrics.write.Increment();
   TENSORSTORE_RETURN_IF_ERROR(ValidateKey(key));
   if (value) {
-    return MapFuture(executor(),
-                     WriteTask{std::move(key), std::move(*value),
-                               std::move(options), sync(), file_io_locking()});
+    return MapFuture(executor(), WriteTask{std::move(key), std::move(*value),
+                                           std::move(options), sync(),
+                                           file_io_locking(), io_uring()});
   } else {
     return MapFuture(executor(), DeleteTask{std::move(key), std::move(options),
                                             sync(), file_io_locking()});
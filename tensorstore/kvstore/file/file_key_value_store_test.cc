@@ -208,6 +208,16 @@ TENSORSTORE_GLOBAL_INITIALIZER {
           },
           p);
     }
+    register_with_spec(
+        "IoUring",
+        [](std::string path) -> ::nlohmann::json {
+          return {
+              {"driver", "file"},
+              {"path", path},
+              {"file_io_mode", {{"mode", "io_uring"}}},
+          };
+        },
+        params);
     register_with_spec(
         "UrlOpen",
         [](std::string path) -> ::nlohmann::json { return AsFileUri(path); },
@@ -601,6 +611,22 @@ TEST(FileKeyValueStoreTest, BatchRead) {
   tensorstore::internal::TestBatchReadGenericCoalescing(store, options);
 }
 
+TEST(FileKeyValueStoreTest, BatchReadIoUring) {
+  ScopedTemporaryDirectory tempdir;
+  auto store = kvstore::Open({
+                                 {"driver", "file"},
+                                 {"path", tempdir.path() + "/"},
+                                 {"file_io_mode", {{"mode", "io_uring"}}},
+                             })
+                   .value();
+
+  tensorstore::internal::BatchReadGenericCoalescingTestOptions options;
+  options.coalescing_options.max_extra_read_bytes = 255;
+  options.metric_prefix = "/tensorstore/kvstore/file/";
+  options.has_file_open_metric = true;
+  tensorstore::internal::TestBatchReadGenericCoalescing(store, options);
+}
+
 #if 0
 // TODO: Make this test reasonable for mmap cases.
 TEST(FileKeyValueStoreTest, BatchReadMemmap) {
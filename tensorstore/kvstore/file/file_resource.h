@@ -131,6 +131,9 @@ struct FileIoModeResource
 
     /// Use direct io.
     kDirect,
+
+    /// Submit io asynchronously via Linux io_uring.
+    kIoUring,
   };
 
   struct Spec {
@@ -154,6 +157,7 @@ struct FileIoModeResource
                 {IoMode::kDefault, "default"},
                 {IoMode::kMemmap, "memmap"},
                 {IoMode::kDirect, "direct"},
+                {IoMode::kIoUring, "io_uring"},
             }))))
                       /**/);
   }
@@ -17,10 +17,13 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <algorithm>
 #include <cassert>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/strings/cord.h"
@@ -35,6 +38,7 @@
 #include "tensorstore/kvstore/key_range.h"
 #include "tensorstore/util/division.h"
 #include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
 #include "tensorstore/util/status.h"
 #include "tensorstore/util/status_builder.h"
 
@@ -188,5 +192,72 @@ Result<absl::Cord> ReadFromFileDescriptor(FileDescriptor fd,
       byte_range.size());
 }
 
+Result<std::vector<absl::Cord>> ReadScatteredFromFileDescriptor(
+    FileDescriptor fd, tensorstore::span<const ByteRange> byte_ranges) {
+  assert(fd != InvalidFileDescriptor());
+  std::vector<absl::Cord> result;
+  if (byte_ranges.empty()) return result;
+
+  int64_t max_gap = 0;
+  for (ptrdiff_t i = 1; i < byte_ranges.size(); ++i) {
+    assert(byte_ranges[i].inclusive_min >= byte_ranges[i - 1].exclusive_max);
+    max_gap = std::max(max_gap, byte_ranges[i].inclusive_min -
+                                    byte_ranges[i - 1].exclusive_max);
+  }
+
+  // All gaps share a single scratch buffer, since their contents are
+  // discarded.
+  std::unique_ptr<char[]> scratch(new char[max_gap]);
+  std::vector<internal::FlatCordBuilder> buffers;
+  std::vector<tensorstore::span<char>> iovs;
+  buffers.reserve(byte_ranges.size());
+  iovs.reserve(byte_ranges.size() * 2);
+  for (ptrdiff_t i = 0; i < byte_ranges.size(); ++i) {
+    if (i > 0) {
+      int64_t gap =
+          byte_ranges[i].inclusive_min - byte_ranges[i - 1].exclusive_max;
+      if (gap > 0) iovs.push_back(tensorstore::span<char>(scratch.get(), gap));
+    }
+    auto& buffer = buffers.emplace_back(
+        internal_os::AllocateHugePageRegionWithFallback(0,
+                                                        byte_ranges[i].size()));
+    if (buffer.size() > 0) {
+      iovs.push_back(tensorstore::span<char>(buffer.data(), buffer.size()));
+    }
+  }
+
+  int64_t offset = byte_ranges[0].inclusive_min;
+  tensorstore::span<tensorstore::span<char>> remaining(iovs);
+  while (!remaining.empty()) {
+    auto n = internal_os::PReadVFromFile(fd, remaining, offset);
+    if (!n.ok()) {
+      return StatusBuilder(std::move(n).status())
+          .Format("Failed to read from file");
+    }
+    if (*n == 0) {
+      // EOF.
+      return absl::UnavailableError(
+          "Unexpected EOF encountered reading from file.");
+    }
+    offset += *n;
+    // Advance past the buffers which were completely filled.
+    for (ptrdiff_t read = *n; read > 0;) {
+      if (read >= remaining[0].size()) {
+        read -= remaining[0].size();
+        remaining = remaining.subspan(1);
+      } else {
+        remaining[0] = remaining[0].subspan(read);
+        read = 0;
+      }
+    }
+  }
+
+  result.reserve(buffers.size());
+  for (auto& buffer : buffers) {
+    result.push_back(std::move(buffer).Build());
+  }
+  return result;
+}
+
 }  // namespace internal_file_util
 }  // namespace tensorstore
@@ -19,12 +19,14 @@
 
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include "absl/strings/cord.h"
 #include "tensorstore/internal/os/file_descriptor.h"
 #include "tensorstore/kvstore/byte_range.h"
 #include "tensorstore/kvstore/key_range.h"
 #include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
 
 namespace tensorstore {
 namespace internal_file_util {
@@ -50,6 +52,19 @@ Result<absl::Cord> ReadFromFileDescriptor(internal_os::FileDescriptor fd,
                                           ByteRange byte_range,
                                           int64_t block_alignment);
 
+/// Reads multiple byte ranges from a file descriptor using vectored reads.
+///
+/// Each byte range is read directly into its own buffer, and the bytes in any
+/// gaps between consecutive ranges are read into a scratch buffer and
+/// discarded, so that the entire span is covered by as few system calls as
+/// possible.
+///
+/// \param byte_ranges Byte ranges, sorted and non-overlapping.
+/// \returns The contents of each byte range, in order.
+Result<std::vector<absl::Cord>> ReadScatteredFromFileDescriptor(
+    internal_os::FileDescriptor fd,
+    tensorstore::span<const ByteRange> byte_ranges);
+
 }  // namespace internal_file_util
 }  // namespace tensorstore
 
@@ -14,19 +14,35 @@
 
 #include "tensorstore/kvstore/file/util.h"
 
+#include <string>
 #include <string_view>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "tensorstore/internal/os/file_util.h"
 #include "tensorstore/internal/testing/on_windows.h"
+#include "tensorstore/internal/testing/scoped_directory.h"
+#include "tensorstore/kvstore/byte_range.h"
 #include "tensorstore/kvstore/key_range.h"
+#include "tensorstore/util/status_testutil.h"
 
 namespace {
 
+using ::tensorstore::ByteRange;
+using ::tensorstore::IsOkAndHolds;
 using ::tensorstore::KeyRange;
+using ::tensorstore::StatusIs;
 using ::tensorstore::internal_file_util::IsKeyValid;
 using ::tensorstore::internal_file_util::LongestDirectoryPrefix;
+using ::tensorstore::internal_file_util::ReadScatteredFromFileDescriptor;
+using ::tensorstore::internal_os::OpenFileWrapper;
+using ::tensorstore::internal_os::OpenFlags;
+using ::tensorstore::internal_os::WriteCordToFile;
 using ::tensorstore::internal_testing::OnWindows;
+using ::tensorstore::internal_testing::ScopedTemporaryDirectory;
+using ::testing::ElementsAre;
 
 TEST(IsKeyValid, InvalidKeys) {
   EXPECT_FALSE(IsKeyValid("", ""));
@@ -98,4 +114,24 @@ TEST(LongestDirectoryPrefix, Basic) {
   EXPECT_EQ("/a", LongestDirectoryPrefix(KeyRange{"/a/a", "/a/b"}));
 }
 
+TEST(ReadScatteredFromFileDescriptor, Basic) {
+  ScopedTemporaryDirectory tempdir;
+  std::string path = tempdir.path() + "/data";
+  {
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto fd, OpenFileWrapper(path, OpenFlags::DefaultWrite));
+    TENSORSTORE_ASSERT_OK(WriteCordToFile(fd.get(), absl::Cord("0123456789")));
+  }
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto fd, OpenFileWrapper(path, OpenFlags::DefaultRead));
+
+  const ByteRange byte_ranges[] = {{1, 3}, {3, 3}, {5, 6}, {8, 10}};
+  EXPECT_THAT(ReadScatteredFromFileDescriptor(fd.get(), byte_ranges),
+              IsOkAndHolds(ElementsAre("12", "", "5", "89")));
+
+  const ByteRange past_eof[] = {{1, 3}, {8, 12}};
+  EXPECT_THAT(ReadScatteredFromFileDescriptor(fd.get(), past_eof),
+              StatusIs(absl::StatusCode::kUnavailable));
+}
+
 }  // namespace
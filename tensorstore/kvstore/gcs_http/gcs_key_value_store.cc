@@ -15,6 +15,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
 #include <memory>
@@ -31,8 +32,10 @@
 #include "absl/random/random.h"
 #include "absl/status/status.h"
 #include "absl/strings/cord.h"
+#include "absl/strings/numbers.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
+#include "absl/strings/strip.h"
 #include "absl/synchronization/mutex.h"
 #include "absl/time/clock.h"
 #include "absl/time/time.h"
@@ -63,6 +66,7 @@
 #include "tensorstore/internal/thread/schedule_at.h"
 #include "tensorstore/internal/uri/parse.h"
 #include "tensorstore/internal/uri/percent_coder.h"
+#include "tensorstore/kvstore/adaptive_coalescing.h"
 #include "tensorstore/kvstore/batch_util.h"
 #include "tensorstore/kvstore/byte_range.h"
 #include "tensorstore/kvstore/common_metrics.h"
@@ -75,6 +79,7 @@
 #include "tensorstore/kvstore/generation.h"
 #include "tensorstore/kvstore/generic_coalescing_batch_util.h"
 #include "tensorstore/kvstore/http/byte_range_util.h"
+#include "tensorstore/kvstore/http/parallel_read_util.h"
 #include "tensorstore/kvstore/key_range.h"
 #include "tensorstore/kvstore/operations.h"
 #include "tensorstore/kvstore/read_result.h"
@@ -259,6 +264,15 @@ std::string BucketUploadRoot(std::string_view bucket) {
                       bucket);
 }
 
+// Values larger than this are written using a resumable upload by default.
+constexpr uint64_t kDefaultResumableUploadThreshold = uint64_t{32} << 20;
+
+// Resumable upload chunks must be a multiple of 256KiB, except for the final
+// chunk.
+// https://cloud.google.com/storage/docs/performing-resumable-uploads#chunked-upload
+constexpr uint64_t kResumableUploadChunkAlignment = uint64_t{256} << 10;
+constexpr uint64_t kDefaultResumableUploadChunkSize = uint64_t{16} << 20;
+
 struct GcsKeyValueStoreSpecData {
   std::string bucket;
 
@@ -267,10 +281,14 @@ struct GcsKeyValueStoreSpecData {
   Context::Resource<GcsUserProjectResource> user_project;
   Context::Resource<GcsRequestRetries> retries;
   Context::Resource<DataCopyConcurrencyResource> data_copy_concurrency;
+  std::optional<uint64_t> resumable_upload_threshold;
+  std::optional<uint64_t> resumable_upload_chunk_size;
+  std::optional<uint64_t> parallel_read_part_size;
 
   constexpr static auto ApplyMembers = [](auto& x, auto f) {
     return f(x.bucket, x.request_concurrency, x.rate_limiter, x.user_project,
-             x.retries, x.data_copy_concurrency);
+             x.retries, x.data_copy_concurrency, x.resumable_upload_threshold,
+             x.resumable_upload_chunk_size, x.parallel_read_part_size);
   };
 
   constexpr static auto default_json_binder = jb::Object(
@@ -301,7 +319,33 @@ struct GcsKeyValueStoreSpecData {
                  jb::Projection<&GcsKeyValueStoreSpecData::retries>()),
       jb::Member(DataCopyConcurrencyResource::id,
                  jb::Projection<
-                     &GcsKeyValueStoreSpecData::data_copy_concurrency>()) /**/
+                     &GcsKeyValueStoreSpecData::data_copy_concurrency>()),
+      jb::Member("resumable_upload_threshold",
+                 jb::Projection<
+                     &GcsKeyValueStoreSpecData::resumable_upload_threshold>()),
+      jb::Member(
+          "resumable_upload_chunk_size",
+          jb::Projection<&GcsKeyValueStoreSpecData::resumable_upload_chunk_size>(
+              jb::Validate([](const auto& options, const auto* x) {
+                if (x->has_value() &&
+                    (**x == 0 || **x % kResumableUploadChunkAlignment != 0)) {
+                  return absl::InvalidArgumentError(absl::StrFormat(
+                      "\"resumable_upload_chunk_size\" must be a positive "
+                      "multiple of %d",
+                      kResumableUploadChunkAlignment));
+                }
+                return absl::OkStatus();
+              }))),
+      jb::Member(
+          "parallel_read_part_size",
+          jb::Projection<&GcsKeyValueStoreSpecData::parallel_read_part_size>(
+              jb::Validate([](const auto& options, const auto* x) {
+                if (x->has_value() && **x == 0) {
+                  return absl::InvalidArgumentError(
+                      "\"parallel_read_part_size\" must be positive");
+                }
+                return absl::OkStatus();
+              }))) /**/
   );
 };
 
@@ -350,12 +394,15 @@ class GcsKeyValueStore
 
   internal_kvstore_batch::CoalescingOptions GetBatchReadCoalescingOptions()
       const {
-    return internal_kvstore_batch::kDefaultRemoteStorageCoalescingOptions;
+    return coalescing_policy_.GetCoalescingOptions();
   }
 
   Future<ReadResult> Read(Key key, ReadOptions options) override;
 
-  Future<ReadResult> ReadImpl(Key&& key, ReadOptions&& options);
+  /// Reads `key`.  If `allow_parallel_read` is `false`, the read is issued as
+  /// a single request even if it exceeds the parallel read part size.
+  Future<ReadResult> ReadImpl(Key&& key, ReadOptions&& options,
+                              bool allow_parallel_read = true);
 
   Future<TimestampedStorageGeneration> Write(Key key,
                                              std::optional<Value> value,
@@ -405,6 +452,22 @@ class GcsKeyValueStore
 
   RateLimiter& admission_queue() { return *spec_.request_concurrency->queue; }
 
+  uint64_t GetResumableUploadThreshold() const {
+    return spec_.resumable_upload_threshold.value_or(
+        kDefaultResumableUploadThreshold);
+  }
+
+  uint64_t GetResumableUploadChunkSize() const {
+    return spec_.resumable_upload_chunk_size.value_or(
+        kDefaultResumableUploadChunkSize);
+  }
+
+  // Returns the part size used to split large reads, or 0 if reads are not
+  // split.
+  int64_t GetParallelReadPartSize() const {
+    return static_cast<int64_t>(spec_.parallel_read_part_size.value_or(0));
+  }
+
   absl::Status GetBoundSpecData(SpecData& spec) const {
     spec = spec_;
     return absl::OkStatus();
@@ -450,6 +513,8 @@ class GcsKeyValueStore
   std::string upload_root_;    // bucket upload root.
   std::string encoded_user_project_;
   NoRateLimiter no_rate_limiter_;
+  internal_kvstore_batch::AdaptiveCoalescingPolicy coalescing_policy_{
+      internal_kvstore_batch::RemoteStorageAdaptiveCoalescingOptions("gcs")};
 
   std::shared_ptr<HttpTransport> transport_;
   absl::Mutex auth_provider_mutex_;
@@ -510,19 +575,32 @@ void AddUniqueQueryParameterToDisableCaching(std::string& url) {
 struct ReadTask : public RateLimiterNode,
                   public internal::AtomicReferenceCount<ReadTask> {
   IntrusivePtr<GcsKeyValueStore> owner;
+  std::string key;
   std::string resource;
   kvstore::ReadOptions options;
   Promise<kvstore::ReadResult> promise;
 
+  // Byte range of the first part when the read is split into parallel
+  // ranged requests.
+  std::optional<OptionalByteRangeRequest> first_part_;
+  int64_t total_size_ = -1;
+
   int attempt_ = 0;
   absl::Time start_time_;
 
-  ReadTask(IntrusivePtr<GcsKeyValueStore> owner, std::string resource,
-           kvstore::ReadOptions options, Promise<kvstore::ReadResult> promise)
+  ReadTask(IntrusivePtr<GcsKeyValueStore> owner, std::string key,
+           std::string resource, kvstore::ReadOptions options,
+           Promise<kvstore::ReadResult> promise, bool allow_parallel_read)
       : owner(std::move(owner)),
+        key(std::move(key)),
         resource(std::move(resource)),
         options(std::move(options)),
-        promise(std::move(promise)) {}
+        promise(std::move(promise)) {
+    if (allow_parallel_read) {
+      first_part_ = internal_http::GetParallelReadFirstPart(
+          this->options.byte_range, this->owner->GetParallelReadPartSize());
+    }
+  }
 
   ~ReadTask() { owner->admission_queue().Finish(this); }
 
@@ -577,7 +655,9 @@ struct ReadTask : public RateLimiterNode,
     if (maybe_auth_header.value().has_value()) {
       request_builder.ParseAndAddHeader(*maybe_auth_header.value());
     }
-    if (options.byte_range.size() != 0) {
+    if (first_part_) {
+      request_builder.MaybeAddRangeHeader(*first_part_);
+    } else if (options.byte_range.size() != 0) {
       request_builder.MaybeAddRangeHeader(options.byte_range);
     }
 
@@ -600,6 +680,14 @@ struct ReadTask : public RateLimiterNode,
     ABSL_LOG_IF(INFO, gcs_http_logging.Level(1) && response.ok())
         << "ReadTask " << *response;
 
+    if (first_part_ && response.ok() && response->status_code == 416) {
+      // The first part starts at or beyond the end of the value; issue the
+      // original read, which returns either an empty value or an error.
+      first_part_ = std::nullopt;
+      Retry();
+      return;
+    }
+
     bool is_retryable = IsRetriable(response.status());
     absl::Status status = [&]() -> absl::Status {
       if (!response.ok()) return response.status();
@@ -622,15 +710,34 @@ struct ReadTask : public RateLimiterNode,
     }
     if (!status.ok()) {
       promise.SetResult(status);
-    } else {
-      promise.SetResult(FinishResponse(response.value()));
+      return;
+    }
+    auto read_result = FinishResponse(response.value());
+    if (!first_part_ || !read_result.ok() || !read_result->has_value()) {
+      promise.SetResult(std::move(read_result));
+      return;
     }
+    // Read the remaining parts concurrently.  Parts, and the retry of the whole
+    // read if the value changes meanwhile, are issued as single requests.
+    internal_http::ReadRemainingParts(
+        *std::move(read_result), std::move(options), total_size_,
+        owner->GetParallelReadPartSize(),
+        [owner = owner, key = key](kvstore::ReadOptions part_options) {
+          return owner->ReadImpl(std::string(key), std::move(part_options),
+                                 /*allow_parallel_read=*/false);
+        },
+        std::move(promise));
   }
 
   Result<kvstore::ReadResult> FinishResponse(const HttpResponse& httpresponse) {
     gcs_metrics.bytes_read.IncrementBy(httpresponse.payload.size());
     auto latency = absl::Now() - start_time_;
     gcs_metrics.read_latency_ms.Observe(absl::ToInt64Milliseconds(latency));
+    if (options.byte_range.size() != 0 && (httpresponse.status_code == 200 ||
+                                           httpresponse.status_code == 206)) {
+      owner->coalescing_policy_.RecordRequest(httpresponse.payload.size(),
+                                              latency);
+    }
 
     // Parse `Date` header from response to correctly handle cached responses.
     // The GCS servers always send a `date` header.
@@ -654,7 +761,12 @@ struct ReadTask : public RateLimiterNode,
 
     absl::Cord value;
     ObjectMetadata metadata;
-    if (options.byte_range.size() != 0) {
+    if (first_part_) {
+      TENSORSTORE_RETURN_IF_ERROR(
+          internal_http::ValidateParallelReadFirstPartResponse(
+              httpresponse, *first_part_, value, total_size_));
+      SetObjectMetadataFromHeaders(httpresponse.headers, &metadata);
+    } else if (options.byte_range.size() != 0) {
       // Currently unused
       ByteRange byte_range;
       int64_t total_size;
@@ -693,8 +805,8 @@ Future<kvstore::ReadResult> GcsKeyValueStore::Read(Key key,
       *this, std::move(key), std::move(options));
 }
 
-Future<kvstore::ReadResult> GcsKeyValueStore::ReadImpl(Key&& key,
-                                                       ReadOptions&& options) {
+Future<kvstore::ReadResult> GcsKeyValueStore::ReadImpl(
+    Key&& key, ReadOptions&& options, bool allow_parallel_read) {
   gcs_metrics.batch_read.Increment();
   auto encoded_object_name = internal_uri::PercentEncodeUriComponent(key);
   std::string resource = tensorstore::internal::JoinPath(resource_root_, "/o/",
@@ -702,8 +814,9 @@ Future<kvstore::ReadResult> GcsKeyValueStore::ReadImpl(Key&& key,
 
   auto op = PromiseFuturePair<ReadResult>::Make();
   auto state = internal::MakeIntrusivePtr<ReadTask>(
-      internal::IntrusivePtr<GcsKeyValueStore>(this), std::move(resource),
-      std::move(options), std::move(op.promise));
+      internal::IntrusivePtr<GcsKeyValueStore>(this), std::move(key),
+      std::move(resource), std::move(options), std::move(op.promise),
+      allow_parallel_read);
 
   intrusive_ptr_increment(state.get());  // adopted by ReadTask::Start.
   read_rate_limiter().Admit(state.get(), &ReadTask::Start);
@@ -877,6 +990,291 @@ struct WriteTask : public RateLimiterNode,
   }
 };
 
+// A ResumableUploadTask is a function object used to satisfy a
+// GcsKeyValueStore::Write request for values larger than the resumable upload
+// threshold.
+//
+// The value is uploaded in chunks to a resumable upload session, so that a
+// transient error only requires re-sending the chunk which was in flight
+// rather than the entire value.
+// https://cloud.google.com/storage/docs/performing-resumable-uploads
+struct ResumableUploadTask
+    : public RateLimiterNode,
+      public internal::AtomicReferenceCount<ResumableUploadTask> {
+  IntrusivePtr<GcsKeyValueStore> owner;
+  std::string encoded_object_name;
+  absl::Cord value;
+  kvstore::WriteOptions options;
+  Promise<TimestampedStorageGeneration> promise;
+
+  int attempt_ = 0;
+  absl::Time start_time_;
+
+  // Session URI returned when the upload is initiated; empty if the upload
+  // must be (re-)initiated.
+  std::string session_url_;
+  // Number of bytes persisted by the session.
+  size_t committed_ = 0;
+  // Whether the number of persisted bytes must be queried before sending the
+  // next chunk, because the previous chunk request failed.
+  bool query_status_ = false;
+
+  ResumableUploadTask(IntrusivePtr<GcsKeyValueStore> owner,
+                      std::string encoded_object_name, absl::Cord value,
+                      kvstore::WriteOptions options,
+                      Promise<TimestampedStorageGeneration> promise)
+      : owner(std::move(owner)),
+        encoded_object_name(std::move(encoded_object_name)),
+        value(std::move(value)),
+        options(std::move(options)),
+        promise(std::move(promise)) {}
+
+  ~ResumableUploadTask() { owner->admission_queue().Finish(this); }
+
+  static void Start(RateLimiterNode* task) {
+    auto* self = static_cast<ResumableUploadTask*>(task);
+    self->owner->write_rate_limiter().Finish(self);
+    self->owner->admission_queue().Admit(self, &ResumableUploadTask::Admit);
+  }
+  static void Admit(RateLimiterNode* task) {
+    auto* self = static_cast<ResumableUploadTask*>(task);
+    self->owner->executor()([state = IntrusivePtr<ResumableUploadTask>(
+                                 self, internal::adopt_object_ref)] {
+      state->Retry();
+    });
+  }
+
+  void Retry() {
+    if (!promise.result_needed()) {
+      return;
+    }
+    if (session_url_.empty()) {
+      Initiate();
+    } else {
+      IssueChunkRequest(query_status_);
+    }
+  }
+
+  // Initiates a resumable upload session.  Generation conditions are
+  // evaluated both when the session is initiated and when it is finalized.
+  void Initiate() {
+    std::string upload_url =
+        absl::StrCat(owner->upload_root(), "/o", "?uploadType=resumable",
+                     "&name=", encoded_object_name);
+    AddGenerationParam(&upload_url, true, "ifGenerationMatch",
+                       options.generation_conditions.if_equal);
+    AddUserProjectParam(&upload_url, true, owner->encoded_user_project());
+
+    auto maybe_auth_header = owner->GetAuthHeader();
+    if (!maybe_auth_header.ok()) {
+      absl::Status status = maybe_auth_header.status();
+      if (IsRetriable(status)) {
+        status =
+            owner->BackoffForAttemptAsync(std::move(status), attempt_++, this);
+        if (status.ok()) return;
+      }
+      promise.SetResult(std::move(status));
+      return;
+    }
+    HttpRequestBuilder request_builder("POST", upload_url);
+    if (maybe_auth_header.value().has_value()) {
+      request_builder.ParseAndAddHeader(*maybe_auth_header.value());
+    }
+    auto request =
+        request_builder
+            .AddHeader("x-upload-content-type", "application/octet-stream")
+            .AddHeader("x-upload-content-length", absl::StrCat(value.size()))
+            .AddHeader("content-length", "0")
+            .BuildRequest();
+    start_time_ = absl::Now();
+
+    ABSL_LOG_IF(INFO, gcs_http_logging)
+        << "ResumableUploadTask: " << request << " size=" << value.size();
+
+    auto future = owner->transport_->IssueRequest(
+        request, IssueRequestOptions().SetHttpVersion(GetHttpVersion()));
+    future.ExecuteWhenReady([self = IntrusivePtr<ResumableUploadTask>(this)](
+                                ReadyFuture<HttpResponse> response) {
+      self->OnInitiateResponse(response.result());
+    });
+  }
+
+  void OnInitiateResponse(const Result<HttpResponse>& response) {
+    if (!promise.result_needed()) {
+      return;
+    }
+    ABSL_LOG_IF(INFO, gcs_http_logging.Level(1) && response.ok())
+        << "ResumableUploadTask " << *response;
+
+    if (response.ok() && IsPreconditionFailure(response.value())) {
+      promise.SetResult(std::in_place, StorageGeneration::Unknown(),
+                        start_time_);
+      return;
+    }
+    bool is_retryable = IsRetriable(response.status());
+    absl::Status status =
+        response.ok() ? GcsHttpResponseToStatus(response.value(), is_retryable)
+                      : response.status();
+    if (status.ok()) {
+      auto it = response.value().headers.find("location");
+      if (it == response.value().headers.end()) {
+        status = absl::UnavailableError(
+            "Resumable upload session URI missing from response");
+        is_retryable = true;
+      } else {
+        session_url_ = it->second;
+        committed_ = 0;
+        query_status_ = false;
+        IssueChunkRequest(/*query_status=*/false);
+        return;
+      }
+    }
+    MaybeRetry(std::move(status), is_retryable);
+  }
+
+  // Uploads the next chunk of the value, or, if `query_status` is true,
+  // queries the number of bytes persisted by the session.
+  // https://cloud.google.com/storage/docs/performing-resumable-uploads#status-check
+  void IssueChunkRequest(bool query_status) {
+    const size_t total = value.size();
+    const size_t chunk_size =
+        query_status ? 0
+                     : std::min<size_t>(owner->GetResumableUploadChunkSize(),
+                                        total - committed_);
+    HttpRequestBuilder request_builder("PUT", session_url_);
+    request_builder.AddHeader("content-length", absl::StrCat(chunk_size));
+    if (query_status) {
+      request_builder.AddHeader("content-range",
+                                absl::StrCat("bytes */", total));
+    } else {
+      request_builder.AddHeader(
+          "content-range", absl::StrCat("bytes ", committed_, "-",
+                                        committed_ + chunk_size - 1, "/",
+                                        total));
+    }
+    auto request = request_builder.BuildRequest();
+
+    ABSL_LOG_IF(INFO, gcs_http_logging) << "ResumableUploadTask: " << request;
+
+    auto future = owner->transport_->IssueRequest(
+        request, IssueRequestOptions(value.Subcord(committed_, chunk_size))
+                     .SetHttpVersion(GetHttpVersion()));
+    future.ExecuteWhenReady([self = IntrusivePtr<ResumableUploadTask>(this)](
+                                ReadyFuture<HttpResponse> response) {
+      self->OnChunkResponse(response.result());
+    });
+  }
+
+  void OnChunkResponse(const Result<HttpResponse>& response) {
+    if (!promise.result_needed()) {
+      return;
+    }
+    ABSL_LOG_IF(INFO, gcs_http_logging.Level(1) && response.ok())
+        << "ResumableUploadTask " << *response;
+
+    if (response.ok()) {
+      const auto& httpresponse = response.value();
+      if (httpresponse.status_code == 308) {
+        // "Resume Incomplete": the `range` header, if present, indicates the
+        // persisted bytes as "bytes=0-N".
+        size_t committed = 0;
+        if (auto it = httpresponse.headers.find("range");
+            it != httpresponse.headers.end()) {
+          std::string_view range = it->second;
+          size_t last;
+          if (!absl::ConsumePrefix(&range, "bytes=0-") ||
+              !absl::SimpleAtoi(range, &last) || last >= value.size()) {
+            promise.SetResult(absl::InternalError(absl::StrCat(
+                "Invalid resumable upload range: ", it->second)));
+            return;
+          }
+          committed = last + 1;
+        }
+        const bool made_progress = committed > committed_;
+        const bool was_status_query = query_status_;
+        committed_ = committed;
+        query_status_ = false;
+        if (made_progress) {
+          // Progress resets the retry budget.
+          attempt_ = 0;
+        } else if (!was_status_query) {
+          MaybeRetry(absl::UnavailableError(
+                         "Resumable upload chunk was not persisted"),
+                     /*is_retryable=*/true);
+          return;
+        }
+        IssueChunkRequest(/*query_status=*/false);
+        return;
+      }
+      if (IsPreconditionFailure(httpresponse)) {
+        promise.SetResult(std::in_place, StorageGeneration::Unknown(),
+                          start_time_);
+        return;
+      }
+      if (httpresponse.status_code == 404 || httpresponse.status_code == 410) {
+        // The session has expired; restart the upload.
+        session_url_.clear();
+        MaybeRetry(absl::UnavailableError("Resumable upload session expired"),
+                   /*is_retryable=*/true);
+        return;
+      }
+    }
+
+    bool is_retryable = IsRetriable(response.status());
+    absl::Status status =
+        response.ok() ? GcsHttpResponseToStatus(response.value(), is_retryable)
+                      : response.status();
+    if (!status.ok()) {
+      // The chunk may have been partially persisted.
+      query_status_ = true;
+      MaybeRetry(std::move(status), is_retryable);
+      return;
+    }
+    promise.SetResult(FinishResponse(response.value()));
+  }
+
+  bool IsPreconditionFailure(const HttpResponse& httpresponse) {
+    switch (httpresponse.status_code) {
+      case 304:
+      case 412:
+        return true;
+      case 404:
+        // Only initiating the session returns 404 for a missing object.
+        return session_url_.empty() &&
+               !options.generation_conditions.MatchesNoValue();
+    }
+    return false;
+  }
+
+  void MaybeRetry(absl::Status status, bool is_retryable) {
+    if (is_retryable) {
+      status =
+          owner->BackoffForAttemptAsync(std::move(status), attempt_++, this);
+      if (status.ok()) {
+        return;
+      }
+    }
+    promise.SetResult(std::move(status));
+  }
+
+  Result<TimestampedStorageGeneration> FinishResponse(
+      const HttpResponse& httpresponse) {
+    auto latency = absl::Now() - start_time_;
+    gcs_metrics.write_latency_ms.Observe(absl::ToInt64Milliseconds(latency));
+    gcs_metrics.bytes_written.IncrementBy(value.size());
+
+    auto payload = httpresponse.payload;
+    auto parsed_object_metadata = ParseObjectMetadata(payload.Flatten());
+    TENSORSTORE_RETURN_IF_ERROR(parsed_object_metadata);
+
+    TimestampedStorageGeneration r;
+    r.time = start_time_;
+    r.generation =
+        StorageGeneration::FromUint64(parsed_object_metadata->generation);
+    return r;
+  }
+};
+
 // A DeleteTask is a function object used to satisfy a
 // GcsKeyValueStore::Delete request.
 struct DeleteTask : public RateLimiterNode,
@@ -1028,7 +1426,15 @@ Future<TimestampedStorageGeneration> GcsKeyValueStore::Write(
       internal_uri::PercentEncodeUriComponent(key);
   auto op = PromiseFuturePair<TimestampedStorageGeneration>::Make();
 
-  if (value) {
+  if (value && value->size() > GetResumableUploadThreshold()) {
+    auto state = internal::MakeIntrusivePtr<ResumableUploadTask>(
+        IntrusivePtr<GcsKeyValueStore>(this), std::move(encoded_object_name),
+        *std::move(value), std::move(options), std::move(op.promise));
+
+    // adopted by ResumableUploadTask::Start.
+    intrusive_ptr_increment(state.get());
+    write_rate_limiter().Admit(state.get(), &ResumableUploadTask::Start);
+  } else if (value) {
     auto state = internal::MakeIntrusivePtr<WriteTask>(
         IntrusivePtr<GcsKeyValueStore>(this), std::move(encoded_object_name),
         *std::move(value), std::move(options), std::move(op.promise));
@@ -78,7 +78,9 @@ using ::tensorstore::Result;
 using ::tensorstore::StatusIs;
 using ::tensorstore::StorageGeneration;
 using ::tensorstore::internal::KeyValueStoreOpsTestParameters;
+using ::tensorstore::internal::MatchesKvsReadResult;
 using ::tensorstore::internal::MatchesListEntry;
+using ::tensorstore::internal::MatchesTimestampedStorageGeneration;
 using ::tensorstore::internal::ScheduleAt;
 using ::tensorstore::internal_http::ApplyResponseToHandler;
 using ::tensorstore::internal_http::HttpRequest;
@@ -254,6 +256,134 @@ TENSORSTORE_GLOBAL_INITIALIZER {
   RegisterKeyValueStoreOpsTests(params);
 }
 
+TENSORSTORE_GLOBAL_INITIALIZER {
+  KeyValueStoreOpsTestParameters params;
+  params.test_name = "ResumableUpload";
+  params.get_store = [](auto callback) {
+    auto mock_transport = std::make_shared<MyMockTransport>();
+    DefaultHttpTransportSetter mock_transport_setter{mock_transport};
+
+    GCSMockStorageBucket bucket("my-bucket");
+    mock_transport->buckets_.push_back(&bucket);
+
+    auto context = DefaultTestContext();
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto store, kvstore::Open({{"driver", kDriver},
+                                   {"bucket", "my-bucket"},
+                                   {"resumable_upload_threshold", 0}},
+                                  context)
+                        .result());
+    callback(store);
+  };
+  RegisterKeyValueStoreOpsTests(params);
+}
+
+TENSORSTORE_GLOBAL_INITIALIZER {
+  KeyValueStoreOpsTestParameters params;
+  params.test_name = "ParallelRead";
+  params.get_store = [](auto callback) {
+    auto mock_transport = std::make_shared<MyMockTransport>();
+    DefaultHttpTransportSetter mock_transport_setter{mock_transport};
+
+    GCSMockStorageBucket bucket("my-bucket");
+    mock_transport->buckets_.push_back(&bucket);
+
+    auto context = DefaultTestContext();
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto store, kvstore::Open({{"driver", kDriver},
+                                   {"bucket", "my-bucket"},
+                                   {"parallel_read_part_size", 2}},
+                                  context)
+                        .result());
+    callback(store);
+  };
+  RegisterKeyValueStoreOpsTests(params);
+}
+
+TEST(GcsKeyValueStoreTest, ResumableUpload) {
+  auto mock_transport = std::make_shared<MyMockTransport>();
+  DefaultHttpTransportSetter mock_transport_setter{mock_transport};
+
+  GCSMockStorageBucket bucket("my-bucket");
+  mock_transport->buckets_.push_back(&bucket);
+
+  auto context = DefaultTestContext();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store, kvstore::Open({{"driver", kDriver},
+                                 {"bucket", "my-bucket"},
+                                 {"resumable_upload_threshold", 1 << 18},
+                                 {"resumable_upload_chunk_size", 1 << 18}},
+                                context)
+                      .result());
+
+  // A value spanning three chunks.
+  std::string data(600 * 1024, '\0');
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<char>(i % 251);
+  }
+  absl::Cord value(data);
+
+  bucket.TriggerErrors(2);
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto stamp,
+                                   kvstore::Write(store, "big", value).result());
+  EXPECT_THAT(kvstore::Read(store, "big").result(),
+              MatchesKvsReadResult(value, stamp.generation));
+
+  // Generation conditions are respected.
+  EXPECT_THAT(
+      kvstore::Write(store, "big", value, {StorageGeneration::NoValue()})
+          .result(),
+      MatchesTimestampedStorageGeneration(StorageGeneration::Unknown()));
+  TENSORSTORE_EXPECT_OK(
+      kvstore::Write(store, "big", absl::Cord(data.substr(1)),
+                     {stamp.generation})
+          .result());
+  EXPECT_THAT(kvstore::Read(store, "big").result(),
+              MatchesKvsReadResult(absl::Cord(data.substr(1))));
+}
+
+TEST(GcsKeyValueStoreTest, ParallelRead) {
+  auto mock_transport = std::make_shared<MyMockTransport>();
+  DefaultHttpTransportSetter mock_transport_setter{mock_transport};
+
+  GCSMockStorageBucket bucket("my-bucket");
+  mock_transport->buckets_.push_back(&bucket);
+
+  auto context = DefaultTestContext();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store, kvstore::Open({{"driver", kDriver},
+                                 {"bucket", "my-bucket"},
+                                 {"parallel_read_part_size", 1000}},
+                                context)
+                      .result());
+
+  std::string data(10000, '\0');
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<char>(i % 251);
+  }
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto stamp, kvstore::Write(store, "big", absl::Cord(data)).result());
+
+  bucket.TriggerErrors(3);
+  EXPECT_THAT(kvstore::Read(store, "big").result(),
+              MatchesKvsReadResult(absl::Cord(data), stamp.generation));
+
+  kvstore::ReadOptions options;
+  options.byte_range = tensorstore::OptionalByteRangeRequest::Range(500, 2700);
+  EXPECT_THAT(kvstore::Read(store, "big", options).result(),
+              MatchesKvsReadResult(absl::Cord(data.substr(500, 2200)),
+                                   stamp.generation));
+
+  options.byte_range = tensorstore::OptionalByteRangeRequest::Suffix(8500);
+  EXPECT_THAT(
+      kvstore::Read(store, "big", options).result(),
+      MatchesKvsReadResult(absl::Cord(data.substr(8500)), stamp.generation));
+
+  options.byte_range = tensorstore::OptionalByteRangeRequest::Range(500, 12000);
+  EXPECT_THAT(kvstore::Read(store, "big", options).result(),
+              StatusIs(absl::StatusCode::kOutOfRange));
+}
+
 TEST(GcsKeyValueStoreTest, SimpleSpecToJson) {
   auto context = DefaultTestContext();
   TENSORSTORE_ASSERT_OK_AND_ASSIGN(
@@ -495,6 +625,14 @@ TEST(GcsKeyValueStoreTest, InvalidSpec) {
       kvstore::Open({{"driver", kDriver}, {"bucket", 5}}, context).result(),
       StatusIs(absl::StatusCode::kInvalidArgument));
 
+  // Test with invalid `"resumable_upload_chunk_size"`.
+  EXPECT_THAT(kvstore::Open({{"driver", kDriver},
+                             {"bucket", "my-bucket"},
+                             {"resumable_upload_chunk_size", 1000}},
+                            context)
+                  .result(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+
   // Test with invalid `"path"`
   EXPECT_THAT(
       kvstore::Open(
@@ -196,6 +196,8 @@ GCSMockStorageBucket::Match(const HttpRequest& request, absl::Cord payload) {
               R"({ "error": { "code": 400, "message": "Uploads must be sent to the upload URL." } })")};
     }
     return HandleInsertRequest(path, params, payload);
+  } else if (path == "/o" && request.method == "PUT" && is_upload) {
+    return HandleResumableUploadRequest(request, params, payload);
   } else if (absl::StartsWith(path, "/o/") && request.method == "GET") {
     // GET request on an object.
     return HandleGetRequest(request, path, params);
@@ -205,7 +207,7 @@ GCSMockStorageBucket::Match(const HttpRequest& request, absl::Cord payload) {
   }
 
   // NOT HANDLED
-  // update (PUT request)
+  // update (PUT request on an object)
   // .../compose
   // .../watch
   // .../rewrite/...
@@ -283,48 +285,143 @@ GCSMockStorageBucket::HandleInsertRequest(std::string_view path,
   do {
     /// TODO: What does GCS return if these values are bad?
     auto uploadType = params.find("uploadType");
-    if (uploadType == params.end() || uploadType->second != "media") break;
+    if (uploadType == params.end()) break;
 
     auto name_it = params.find("name");
     if (name_it == params.end() || name_it->second.empty()) break;
     std::string name(name_it->second.data(), name_it->second.length());
 
+    if (uploadType->second == "media") {
+      return InsertObject(std::move(name), parsed_parameters.ifGenerationMatch,
+                          parsed_parameters.ifGenerationNotMatch,
+                          std::move(payload));
+    }
+    if (uploadType->second != "resumable") break;
+
+    // https://cloud.google.com/storage/docs/performing-resumable-uploads
+    // Preconditions are checked both when the session is initiated and when
+    // the upload is finalized.
     auto it = data_.find(name);
-    if (parsed_parameters.ifGenerationMatch.has_value()) {
-      const int64_t v = parsed_parameters.ifGenerationMatch.value();
-      if (v == 0) {
-        if (it != data_.end()) {
-          // Live version => failure
-          return HttpResponse{412, absl::Cord()};
-        }
-        // No live versions => success;
-      } else if (it == data_.end() || v != it->second.generation) {
-        // generation does not match.
-        return HttpResponse{412, absl::Cord()};
-      }
+    if (auto v = parsed_parameters.ifGenerationMatch;
+        v.has_value() &&
+        (*v == 0 ? it != data_.end()
+                 : (it == data_.end() || *v != it->second.generation))) {
+      return HttpResponse{412, absl::Cord()};
     }
 
-    if (parsed_parameters.ifGenerationNotMatch.has_value()) {
-      const int64_t v = parsed_parameters.ifGenerationNotMatch.value();
-      if (it != data_.end() && v == it->second.generation) {
-        // generation matches.
+    std::string upload_id = absl::StrCat(++next_upload_id_);
+    auto& session = uploads_[upload_id];
+    session.name = std::move(name);
+    session.if_generation_match = parsed_parameters.ifGenerationMatch;
+    session.if_generation_not_match = parsed_parameters.ifGenerationNotMatch;
+
+    ABSL_LOG(INFO) << "Initiated upload: " << session.name << " " << upload_id;
+
+    HttpResponse response{200, absl::Cord()};
+    response.headers.SetHeader(
+        "location", absl::StrCat("https://", upload_prefix_,
+                                 "/o?uploadType=resumable&upload_id=",
+                                 upload_id));
+    return response;
+  } while (false);
+
+  return HttpResponse{404, absl::Cord()};
+}
+
+std::variant<std::monostate, HttpResponse, absl::Status>
+GCSMockStorageBucket::HandleResumableUploadRequest(const HttpRequest& request,
+                                                   const ParamMap& params,
+                                                   absl::Cord payload) {
+  // https://cloud.google.com/storage/docs/performing-resumable-uploads#chunked-upload
+  auto upload_id = params.find("upload_id");
+  if (upload_id == params.end()) {
+    return HttpResponse{404, absl::Cord()};
+  }
+  auto session_it = uploads_.find(upload_id->second);
+  if (session_it == uploads_.end()) {
+    return HttpResponse{404, absl::Cord()};
+  }
+  auto& session = session_it->second;
+
+  // The content-range is either "bytes */total" to query the upload status,
+  // or "bytes first-last/total" to upload a chunk.
+  static LazyRE2 kContentRange = {R"(bytes (?:\*|(\d+)-(\d+))/(\d+))"};
+  auto content_range = request.headers.find("content-range");
+  std::optional<int64_t> first, last;
+  int64_t total;
+  if (content_range == request.headers.end() ||
+      !RE2::FullMatch(content_range->second, *kContentRange, &first, &last,
+                      &total)) {
+    return HttpResponse{400, absl::Cord("Invalid content-range")};
+  }
+
+  if (first.has_value()) {
+    const int64_t committed = session.data.size();
+    if (*first > committed || *last < *first ||
+        static_cast<int64_t>(payload.size()) != *last - *first + 1) {
+      return HttpResponse{400, absl::Cord("Invalid content-range")};
+    }
+    if (*last >= committed) {
+      session.data.Append(
+          payload.Subcord(committed - *first, *last + 1 - committed));
+    }
+  }
+
+  if (static_cast<int64_t>(session.data.size()) == total) {
+    UploadSession completed = std::move(session);
+    uploads_.erase(session_it);
+    return InsertObject(std::move(completed.name),
+                        completed.if_generation_match,
+                        completed.if_generation_not_match,
+                        std::move(completed.data));
+  }
+
+  // "Resume Incomplete"
+  HttpResponse response{308, absl::Cord()};
+  if (!session.data.empty()) {
+    response.headers.SetHeader(
+        "range", absl::StrCat("bytes=0-", session.data.size() - 1));
+  }
+  return response;
+}
+
+std::variant<std::monostate, HttpResponse, absl::Status>
+GCSMockStorageBucket::InsertObject(
+    std::string name, std::optional<int64_t> if_generation_match,
+    std::optional<int64_t> if_generation_not_match, absl::Cord payload) {
+  auto it = data_.find(name);
+  if (if_generation_match.has_value()) {
+    const int64_t v = if_generation_match.value();
+    if (v == 0) {
+      if (it != data_.end()) {
+        // Live version => failure
         return HttpResponse{412, absl::Cord()};
       }
+      // No live versions => success;
+    } else if (it == data_.end() || v != it->second.generation) {
+      // generation does not match.
+      return HttpResponse{412, absl::Cord()};
     }
+  }
 
-    auto& obj = data_[name];
-    if (obj.name.empty()) {
-      obj.name = std::move(name);
+  if (if_generation_not_match.has_value()) {
+    const int64_t v = if_generation_not_match.value();
+    if (it != data_.end() && v == it->second.generation) {
+      // generation matches.
+      return HttpResponse{412, absl::Cord()};
     }
-    obj.generation = ++next_generation_;
-    obj.data = payload;
+  }
 
-    ABSL_LOG(INFO) << "Uploaded: " << obj.name << " " << obj.generation;
+  auto& obj = data_[name];
+  if (obj.name.empty()) {
+    obj.name = std::move(name);
+  }
+  obj.generation = ++next_generation_;
+  obj.data = std::move(payload);
 
-    return ObjectMetadataResponse(obj);
-  } while (false);
+  ABSL_LOG(INFO) << "Uploaded: " << obj.name << " " << obj.generation;
 
-  return HttpResponse{404, absl::Cord()};
+  return ObjectMetadataResponse(obj);
 }
 
 std::optional<OptionalByteRangeRequest> ParseRangeFieldValue(
@@ -82,6 +82,11 @@ class GCSMockStorageBucket {
   HandleInsertRequest(std::string_view path, const ParamMap& params,
                       absl::Cord payload);
 
+  // Upload a chunk of a resumable upload, or query the status of the upload.
+  std::variant<std::monostate, internal_http::HttpResponse, absl::Status>
+  HandleResumableUploadRequest(const internal_http::HttpRequest& request,
+                               const ParamMap& params, absl::Cord payload);
+
   // Get an object, which might be the data or the metadata.
   std::variant<std::monostate, internal_http::HttpResponse, absl::Status>
   HandleGetRequest(const internal_http::HttpRequest& request,
@@ -91,6 +96,12 @@ class GCSMockStorageBucket {
   std::variant<std::monostate, internal_http::HttpResponse, absl::Status>
   HandleDeleteRequest(std::string_view path, const ParamMap& params);
 
+  // Stores an object, subject to the generation preconditions.
+  std::variant<std::monostate, internal_http::HttpResponse, absl::Status>
+  InsertObject(std::string name, std::optional<int64_t> if_generation_match,
+               std::optional<int64_t> if_generation_not_match,
+               absl::Cord payload);
+
   // Construct an object metadata response.
   internal_http::HttpResponse ObjectMetadataResponse(const Object& object);
 
@@ -129,6 +140,16 @@ class GCSMockStorageBucket {
 
   using Map = std::map<std::string, Object, std::less<>>;
   Map data_;
+
+  // An in-progress resumable upload.
+  struct UploadSession {
+    std::string name;
+    std::optional<int64_t> if_generation_match;
+    std::optional<int64_t> if_generation_not_match;
+    absl::Cord data;
+  };
+  int64_t next_upload_id_ = 0;
+  std::map<std::string, UploadSession, std::less<>> uploads_;
 };
 
 }  // namespace tensorstore
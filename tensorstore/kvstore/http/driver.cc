@@ -17,6 +17,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -52,11 +53,13 @@
 #include "tensorstore/internal/uri/ascii_set.h"
 #include "tensorstore/internal/uri/parse.h"
 #include "tensorstore/internal/uri/percent_coder.h"
+#include "tensorstore/kvstore/adaptive_coalescing.h"
 #include "tensorstore/kvstore/batch_util.h"
 #include "tensorstore/kvstore/byte_range.h"
 #include "tensorstore/kvstore/generation.h"
 #include "tensorstore/kvstore/generic_coalescing_batch_util.h"
 #include "tensorstore/kvstore/http/byte_range_util.h"
+#include "tensorstore/kvstore/http/parallel_read_util.h"
 #include "tensorstore/kvstore/operations.h"
 #include "tensorstore/kvstore/read_result.h"
 #include "tensorstore/kvstore/registry.h"
@@ -148,9 +151,11 @@ struct HttpKeyValueStoreSpecData {
   Context::Resource<HttpRequestConcurrencyResource> request_concurrency;
   Context::Resource<HttpRequestRetries> retries;
   std::vector<std::string> headers;
+  std::optional<uint64_t> parallel_read_part_size;
 
   constexpr static auto ApplyMembers = [](auto& x, auto f) {
-    return f(x.base_url, x.request_concurrency, x.retries, x.headers);
+    return f(x.base_url, x.request_concurrency, x.retries, x.headers,
+             x.parallel_read_part_size);
   };
 
   constexpr static auto default_json_binder = jb::Object(
@@ -173,7 +178,17 @@ struct HttpKeyValueStoreSpecData {
           HttpRequestConcurrencyResource::id,
           jb::Projection<&HttpKeyValueStoreSpecData::request_concurrency>()),
       jb::Member(HttpRequestRetries::id,
-                 jb::Projection<&HttpKeyValueStoreSpecData::retries>())
+                 jb::Projection<&HttpKeyValueStoreSpecData::retries>()),
+      jb::Member(
+          "parallel_read_part_size",
+          jb::Projection<&HttpKeyValueStoreSpecData::parallel_read_part_size>(
+              jb::Validate([](const auto& options, const auto* x) {
+                if (x->has_value() && **x == 0) {
+                  return absl::InvalidArgumentError(
+                      "\"parallel_read_part_size\" must be positive");
+                }
+                return absl::OkStatus();
+              })))
       /**/
   );
 
@@ -246,16 +261,26 @@ class HttpKeyValueStore
  public:
   internal_kvstore_batch::CoalescingOptions GetBatchReadCoalescingOptions()
       const {
-    return internal_kvstore_batch::kDefaultRemoteStorageCoalescingOptions;
+    return coalescing_policy_.GetCoalescingOptions();
   }
 
   Future<ReadResult> Read(Key key, ReadOptions options) override;
-  Future<ReadResult> ReadImpl(Key&& key, ReadOptions&& options);
+
+  /// Reads `key`.  If `allow_parallel_read` is `false`, the read is issued as
+  /// a single request even if it exceeds the parallel read part size.
+  Future<ReadResult> ReadImpl(Key&& key, ReadOptions&& options,
+                              bool allow_parallel_read = true);
 
   const Executor& executor() const {
     return spec_.request_concurrency->executor;
   }
 
+  /// Returns the part size used to split large reads, or 0 if reads are not
+  /// split.
+  int64_t GetParallelReadPartSize() const {
+    return static_cast<int64_t>(spec_.parallel_read_part_size.value_or(0));
+  }
+
   absl::Status GetBoundSpecData(SpecData& spec) const {
     spec = spec_;
     return absl::OkStatus();
@@ -266,6 +291,8 @@ class HttpKeyValueStore
   }
 
   HttpKeyValueStoreSpecData spec_;
+  internal_kvstore_batch::AdaptiveCoalescingPolicy coalescing_policy_{
+      internal_kvstore_batch::RemoteStorageAdaptiveCoalescingOptions("http")};
 
   std::shared_ptr<HttpTransport> transport_;
 };
@@ -284,6 +311,11 @@ struct ReadTask {
   std::string url;
   kvstore::ReadOptions options;
 
+  /// Byte range of the first part when the read is split into parallel
+  /// ranged requests.
+  std::optional<OptionalByteRangeRequest> first_part;
+  int64_t total_size = -1;
+
   HttpResponse httpresponse;
 
   absl::Status DoRead() {
@@ -292,7 +324,9 @@ struct ReadTask {
     for (const auto& header : owner->spec_.headers) {
       request_builder.ParseAndAddHeader(header);
     }
-    if (options.byte_range.size() != 0) {
+    if (first_part) {
+      request_builder.MaybeAddRangeHeader(*first_part);
+    } else if (options.byte_range.size() != 0) {
       request_builder.MaybeAddRangeHeader(options.byte_range);
     }
 
@@ -320,10 +354,16 @@ struct ReadTask {
 
     ABSL_LOG_IF(INFO, http_logging) << "[http] Read: " << request;
 
+    const absl::Time request_start = absl::Now();
     auto response = owner->transport_->IssueRequest(request, {}).result();
     if (!response.ok()) return response.status();
     httpresponse = *std::move(response);
     http_bytes_read.IncrementBy(httpresponse.payload.size());
+    if (options.byte_range.size() != 0 &&
+        (httpresponse.status_code == 200 || httpresponse.status_code == 206)) {
+      owner->coalescing_policy_.RecordRequest(httpresponse.payload.size(),
+                                              absl::Now() - request_start);
+    }
     ABSL_LOG_IF(INFO, http_logging.Level(1))
         << "[http] Read response: " << httpresponse;
 
@@ -382,7 +422,11 @@ struct ReadTask {
     }
 
     absl::Cord value;
-    if (options.byte_range.size() != 0) {
+    if (first_part) {
+      TENSORSTORE_RETURN_IF_ERROR(
+          internal_http::ValidateParallelReadFirstPartResponse(
+              httpresponse, *first_part, value, total_size));
+    } else if (options.byte_range.size() != 0) {
       // Currently unused
       ByteRange byte_range;
       int64_t total_size;
@@ -456,12 +500,52 @@ Future<kvstore::ReadResult> HttpKeyValueStore::Read(Key key,
       *this, std::move(key), std::move(options));
 }
 
-Future<kvstore::ReadResult> HttpKeyValueStore::ReadImpl(Key&& key,
-                                                        ReadOptions&& options) {
+Future<kvstore::ReadResult> HttpKeyValueStore::ReadImpl(
+    Key&& key, ReadOptions&& options, bool allow_parallel_read) {
   http_batch_read.Increment();
   std::string url = spec_.GetUrl(key);
-  return MapFuture(executor(), ReadTask{IntrusivePtr<HttpKeyValueStore>(this),
-                                        std::move(url), std::move(options)});
+  std::optional<OptionalByteRangeRequest> first_part;
+  if (allow_parallel_read) {
+    first_part = internal_http::GetParallelReadFirstPart(
+        options.byte_range, GetParallelReadPartSize());
+  }
+  if (!first_part) {
+    return MapFuture(executor(),
+                     ReadTask{IntrusivePtr<HttpKeyValueStore>(this),
+                              std::move(url), std::move(options)});
+  }
+
+  // Read the first part, which also determines the total size, and then read
+  // the remaining parts concurrently.  Parts, and the retry of the whole read
+  // if the value changes meanwhile, are issued as single requests.
+  auto op = PromiseFuturePair<ReadResult>::Make();
+  executor()([task = ReadTask{IntrusivePtr<HttpKeyValueStore>(this),
+                              std::move(url), std::move(options), first_part},
+              key = std::move(key),
+              promise = std::move(op.promise)]() mutable {
+    if (!promise.result_needed()) return;
+    auto read_result = task();
+    if (!read_result.ok() && task.httpresponse.status_code == 416) {
+      // The first part starts at or beyond the end of the value; issue the
+      // original read, which returns either an empty value or an error.
+      task.first_part = std::nullopt;
+      read_result = task();
+    }
+    if (!read_result.ok() || !read_result->has_value()) {
+      promise.SetResult(std::move(read_result));
+      return;
+    }
+    auto owner = task.owner;
+    internal_http::ReadRemainingParts(
+        *std::move(read_result), std::move(task.options), task.total_size,
+        owner->GetParallelReadPartSize(),
+        [owner, key = std::move(key)](kvstore::ReadOptions part_options) {
+          return owner->ReadImpl(std::string(key), std::move(part_options),
+                                 /*allow_parallel_read=*/false);
+        },
+        std::move(promise));
+  });
+  return std::move(op.future);
 }
 
 Result<kvstore::Spec> ParseHttpUrl(std::string_view url) {
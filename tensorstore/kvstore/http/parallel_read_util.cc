@@ -0,0 +1,143 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/http/parallel_read_util.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/str_format.h"
+#include "tensorstore/internal/http/http_response.h"
+#include "tensorstore/kvstore/byte_range.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
+
+namespace tensorstore {
+namespace internal_http {
+
+std::optional<OptionalByteRangeRequest> GetParallelReadFirstPart(
+    const OptionalByteRangeRequest& byte_range, int64_t part_size) {
+  if (part_size <= 0 || byte_range.IsSuffixLength() || byte_range.IsStat()) {
+    return std::nullopt;
+  }
+  if (int64_t size = byte_range.size(); size != -1 && size <= part_size) {
+    return std::nullopt;
+  }
+  return OptionalByteRangeRequest::Range(byte_range.inclusive_min,
+                                         byte_range.inclusive_min + part_size);
+}
+
+absl::Status ValidateParallelReadFirstPartResponse(
+    const HttpResponse& response, const OptionalByteRangeRequest& first_part,
+    absl::Cord& value, int64_t& total_size) {
+  value = response.payload;
+  if (response.status_code != 206) {
+    // The server sent the entire value, which may happen when the requested
+    // part covers the entire value.
+    total_size = value.size();
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto byte_range,
+        OptionalByteRangeRequest::Suffix(first_part.inclusive_min)
+            .Validate(total_size));
+    byte_range.exclusive_max =
+        std::min(byte_range.exclusive_max, first_part.exclusive_max);
+    value = internal::GetSubCord(value, byte_range);
+    return absl::OkStatus();
+  }
+
+  TENSORSTORE_ASSIGN_OR_RETURN(auto content_range,
+                               ParseContentRangeHeader(response));
+  total_size = content_range.total_size;
+  if (content_range.inclusive_min != first_part.inclusive_min ||
+      content_range.exclusive_max - content_range.inclusive_min !=
+          static_cast<int64_t>(value.size()) ||
+      total_size == -1 ||
+      (content_range.exclusive_max != first_part.exclusive_max &&
+       content_range.exclusive_max != total_size)) {
+    return absl::OutOfRangeError(absl::StrFormat(
+        "Requested byte range %v was not satisfied by response with byte "
+        "range [%d, %d) and total size %d",
+        first_part, content_range.inclusive_min, content_range.exclusive_max,
+        total_size));
+  }
+  return absl::OkStatus();
+}
+
+void ReadRemainingParts(kvstore::ReadResult first, kvstore::ReadOptions options,
+                        int64_t total_size, int64_t part_size,
+                        ReadPartFunction read_part,
+                        Promise<kvstore::ReadResult> promise) {
+  if (!first.has_value()) {
+    promise.SetResult(std::move(first));
+    return;
+  }
+  auto byte_range = options.byte_range.Validate(total_size);
+  if (!byte_range.ok()) {
+    promise.SetResult(std::move(byte_range).status());
+    return;
+  }
+  const int64_t end = byte_range->exclusive_max;
+  int64_t offset = byte_range->inclusive_min + first.value.size();
+  if (offset >= end) {
+    first.value = first.value.Subcord(0, byte_range->size());
+    promise.SetResult(std::move(first));
+    return;
+  }
+
+  // Each part is conditioned on the generation of the first part so that the
+  // parts are consistent.
+  std::vector<Future<kvstore::ReadResult>> parts;
+  parts.reserve((end - offset + part_size - 1) / part_size);
+  for (; offset < end; offset += part_size) {
+    kvstore::ReadOptions part_options;
+    part_options.generation_conditions.if_equal = first.stamp.generation;
+    part_options.staleness_bound = options.staleness_bound;
+    part_options.byte_range = OptionalByteRangeRequest::Range(
+        offset, std::min(offset + part_size, end));
+    parts.push_back(read_part(std::move(part_options)));
+  }
+
+  auto all_parts = WaitAllFuture(tensorstore::span(parts));
+  LinkValue(
+      [first = std::move(first), parts = std::move(parts),
+       options = std::move(options), read_part = std::move(read_part)](
+          Promise<kvstore::ReadResult> promise,
+          ReadyFuture<void> future) mutable {
+        for (auto& part : parts) {
+          const kvstore::ReadResult& part_result = part.value();
+          if (!part_result.has_value() ||
+              part_result.stamp.generation != first.stamp.generation) {
+            // The value changed while the parts were read; retry the whole
+            // read as a single request.
+            LinkResult(std::move(promise), read_part(std::move(options)));
+            return;
+          }
+          first.value.Append(part_result.value);
+        }
+        promise.SetResult(std::move(first));
+      },
+      std::move(promise), std::move(all_parts));
+}
+
+}  // namespace internal_http
+}  // namespace tensorstore
@@ -0,0 +1,90 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_KVSTORE_HTTP_PARALLEL_READ_UTIL_H_
+#define TENSORSTORE_KVSTORE_HTTP_PARALLEL_READ_UTIL_H_
+
+/// \file
+///
+/// Utilities for splitting a single large read on an HTTP-based kvstore into
+/// concurrent byte-range requests.
+///
+/// The first part of the requested range is read by the driver, which obtains
+/// the total size of the value from the response.  The remaining parts are
+/// then read concurrently, each conditioned on the generation returned for
+/// the first part, and are appended to the first part without copying.
+
+#include <stdint.h>
+
+#include <optional>
+
+#include "absl/functional/any_invocable.h"
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "tensorstore/internal/http/http_response.h"
+#include "tensorstore/kvstore/byte_range.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/util/future.h"
+
+namespace tensorstore {
+namespace internal_http {
+
+/// Returns the byte range to request for the first part of a read of
+/// `byte_range` split into parts of `part_size` bytes, or `std::nullopt` if
+/// the read should be issued as a single request.
+///
+/// Reads are not split when `part_size <= 0`, for suffix-length and stat
+/// requests, or when the requested range is no larger than `part_size`.
+std::optional<OptionalByteRangeRequest> GetParallelReadFirstPart(
+    const OptionalByteRangeRequest& byte_range, int64_t part_size);
+
+/// Validates the response to a request for `first_part`, as returned by
+/// `GetParallelReadFirstPart`.
+///
+/// Unlike `ValidateResponseByteRange`, the response may end before
+/// `first_part.exclusive_max` if it extends to the end of the value.
+///
+/// Assigns the validated content to `value` and the total size of the value
+/// to `total_size`.
+absl::Status ValidateParallelReadFirstPartResponse(
+    const HttpResponse& response, const OptionalByteRangeRequest& first_part,
+    absl::Cord& value, int64_t& total_size);
+
+/// Reads a single part of a value.
+using ReadPartFunction =
+    absl::AnyInvocable<Future<kvstore::ReadResult>(kvstore::ReadOptions)>;
+
+/// Completes a parallel read after the first part has been read.
+///
+/// \param first Result of reading the first part.  If it is not a value, it
+///     is the result of the read.
+/// \param options Options of the original read.
+/// \param total_size Total size of the value.
+/// \param part_size Size of each part.
+/// \param read_part Issues a read of a single part as a single request.  Also
+///     used to re-issue the original read, at most once, if the value changes
+///     while the parts are read; it must not split that read into parts
+///     again, so that a value which changes continuously cannot cause
+///     unbounded retries.
+/// \param promise Promise to resolve with the result of the original read.
+void ReadRemainingParts(kvstore::ReadResult first, kvstore::ReadOptions options,
+                        int64_t total_size, int64_t part_size,
+                        ReadPartFunction read_part,
+                        Promise<kvstore::ReadResult> promise);
+
+}  // namespace internal_http
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_KVSTORE_HTTP_PARALLEL_READ_UTIL_H_
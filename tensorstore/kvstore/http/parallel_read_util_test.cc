@@ -0,0 +1,211 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/http/parallel_read_util.h"
+
+#include <stdint.h>
+
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/str_cat.h"
+#include "absl/time/clock.h"
+#include "tensorstore/internal/http/http_header.h"
+#include "tensorstore/internal/http/http_response.h"
+#include "tensorstore/kvstore/byte_range.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/kvstore/test_matchers.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+namespace kvstore = ::tensorstore::kvstore;
+
+using ::tensorstore::Future;
+using ::tensorstore::MakeReadyFuture;
+using ::tensorstore::OptionalByteRangeRequest;
+using ::tensorstore::PromiseFuturePair;
+using ::tensorstore::StatusIs;
+using ::tensorstore::StorageGeneration;
+using ::tensorstore::TimestampedStorageGeneration;
+using ::tensorstore::internal::MatchesKvsReadResult;
+using ::tensorstore::internal_http::GetParallelReadFirstPart;
+using ::tensorstore::internal_http::HeaderMap;
+using ::tensorstore::internal_http::HttpResponse;
+using ::tensorstore::internal_http::ReadRemainingParts;
+using ::tensorstore::internal_http::ValidateParallelReadFirstPartResponse;
+using ::testing::ElementsAre;
+using ::testing::Optional;
+
+TEST(GetParallelReadFirstPartTest, Basic) {
+  EXPECT_EQ(std::nullopt, GetParallelReadFirstPart({}, 0));
+  EXPECT_EQ(std::nullopt,
+            GetParallelReadFirstPart(OptionalByteRangeRequest::Stat(), 10));
+  EXPECT_EQ(std::nullopt, GetParallelReadFirstPart(
+                              OptionalByteRangeRequest::SuffixLength(100), 10));
+  EXPECT_EQ(std::nullopt, GetParallelReadFirstPart(
+                              OptionalByteRangeRequest::Range(5, 15), 10));
+  EXPECT_THAT(GetParallelReadFirstPart({}, 10),
+              Optional(OptionalByteRangeRequest::Range(0, 10)));
+  EXPECT_THAT(
+      GetParallelReadFirstPart(OptionalByteRangeRequest::Suffix(5), 10),
+      Optional(OptionalByteRangeRequest::Range(5, 15)));
+  EXPECT_THAT(
+      GetParallelReadFirstPart(OptionalByteRangeRequest::Range(5, 16), 10),
+      Optional(OptionalByteRangeRequest::Range(5, 15)));
+}
+
+TEST(ValidateParallelReadFirstPartResponseTest, PartialContent) {
+  absl::Cord value;
+  int64_t total_size;
+  TENSORSTORE_EXPECT_OK(ValidateParallelReadFirstPartResponse(
+      HttpResponse{206, absl::Cord("bcde"),
+                   HeaderMap{{"content-range", "bytes 1-4/10"}}},
+      OptionalByteRangeRequest::Range(1, 5), value, total_size));
+  EXPECT_EQ("bcde", value);
+  EXPECT_EQ(10, total_size);
+
+  // The response may be truncated at the end of the value.
+  TENSORSTORE_EXPECT_OK(ValidateParallelReadFirstPartResponse(
+      HttpResponse{206, absl::Cord("bc"),
+                   HeaderMap{{"content-range", "bytes 1-2/3"}}},
+      OptionalByteRangeRequest::Range(1, 5), value, total_size));
+  EXPECT_EQ("bc", value);
+  EXPECT_EQ(3, total_size);
+
+  EXPECT_THAT(ValidateParallelReadFirstPartResponse(
+                  HttpResponse{206, absl::Cord("bc"),
+                               HeaderMap{{"content-range", "bytes 1-2/10"}}},
+                  OptionalByteRangeRequest::Range(1, 5), value, total_size),
+              StatusIs(absl::StatusCode::kOutOfRange));
+  EXPECT_THAT(ValidateParallelReadFirstPartResponse(
+                  HttpResponse{206, absl::Cord("bcde"),
+                               HeaderMap{{"content-range", "bytes 1-4/*"}}},
+                  OptionalByteRangeRequest::Range(1, 5), value, total_size),
+              StatusIs(absl::StatusCode::kOutOfRange));
+}
+
+TEST(ValidateParallelReadFirstPartResponseTest, EntireValue) {
+  absl::Cord value;
+  int64_t total_size;
+  TENSORSTORE_EXPECT_OK(ValidateParallelReadFirstPartResponse(
+      HttpResponse{200, absl::Cord("abc")},
+      OptionalByteRangeRequest::Range(1, 5), value, total_size));
+  EXPECT_EQ("bc", value);
+  EXPECT_EQ(3, total_size);
+
+  TENSORSTORE_EXPECT_OK(ValidateParallelReadFirstPartResponse(
+      HttpResponse{200, absl::Cord("abcdefgh")},
+      OptionalByteRangeRequest::Range(1, 5), value, total_size));
+  EXPECT_EQ("bcde", value);
+  EXPECT_EQ(8, total_size);
+}
+
+class ReadRemainingPartsTest : public ::testing::Test {
+ public:
+  ReadRemainingPartsTest() {
+    store_ = kvstore::Open("memory://").value();
+    TENSORSTORE_CHECK_OK(
+        kvstore::Write(store_, "key", absl::Cord("abcdefghij")).result());
+  }
+
+  // Reads `byte_range` of "key" as parts of `part_size` bytes, recording the
+  // byte range of each part.
+  Future<kvstore::ReadResult> Read(OptionalByteRangeRequest byte_range,
+                                   int64_t part_size) {
+    kvstore::ReadOptions first_options;
+    first_options.byte_range =
+        *GetParallelReadFirstPart(byte_range, part_size);
+    auto first = kvstore::Read(store_, "key", first_options).value();
+    auto [promise, future] = PromiseFuturePair<kvstore::ReadResult>::Make();
+    kvstore::ReadOptions options;
+    options.byte_range = byte_range;
+    ReadRemainingParts(
+        std::move(first), std::move(options), /*total_size=*/10, part_size,
+        [this](kvstore::ReadOptions options) {
+          part_byte_ranges_.push_back(options.byte_range);
+          return kvstore::Read(store_, "key", std::move(options));
+        },
+        std::move(promise));
+    return std::move(future);
+  }
+
+  kvstore::KvStore store_;
+  std::vector<OptionalByteRangeRequest> part_byte_ranges_;
+};
+
+TEST_F(ReadRemainingPartsTest, Full) {
+  EXPECT_THAT(Read({}, 3).result(),
+              MatchesKvsReadResult(absl::Cord("abcdefghij")));
+  EXPECT_THAT(part_byte_ranges_,
+              ElementsAre(OptionalByteRangeRequest::Range(3, 6),
+                          OptionalByteRangeRequest::Range(6, 9),
+                          OptionalByteRangeRequest::Range(9, 10)));
+}
+
+TEST_F(ReadRemainingPartsTest, Range) {
+  EXPECT_THAT(Read(OptionalByteRangeRequest::Range(1, 8), 4).result(),
+              MatchesKvsReadResult(absl::Cord("bcdefgh")));
+  EXPECT_THAT(part_byte_ranges_,
+              ElementsAre(OptionalByteRangeRequest::Range(5, 8)));
+}
+
+TEST_F(ReadRemainingPartsTest, OutOfRange) {
+  EXPECT_THAT(Read(OptionalByteRangeRequest::Range(1, 12), 4).result(),
+              StatusIs(absl::StatusCode::kOutOfRange));
+}
+
+// Every part reports a new generation, as for a value that changes
+// continuously.  The whole read is re-issued exactly once, as a single read of
+// the original byte range, rather than being split into parts again.
+TEST(ReadRemainingPartsChangedValueTest, RetriesOnceAsSingleRead) {
+  int generation = 0;
+  auto make_stamp = [&] {
+    return TimestampedStorageGeneration(
+        StorageGeneration::FromString(absl::StrCat("g", generation)),
+        absl::Now());
+  };
+  auto first = kvstore::ReadResult::Value(absl::Cord("abc"), make_stamp());
+  std::vector<OptionalByteRangeRequest> byte_ranges;
+  auto [promise, future] = PromiseFuturePair<kvstore::ReadResult>::Make();
+  ReadRemainingParts(
+      std::move(first), kvstore::ReadOptions{}, /*total_size=*/10,
+      /*part_size=*/3,
+      [&](kvstore::ReadOptions options) {
+        byte_ranges.push_back(options.byte_range);
+        ++generation;
+        return MakeReadyFuture<kvstore::ReadResult>(
+            kvstore::ReadResult::Value(absl::Cord("retried"), make_stamp()));
+      },
+      std::move(promise));
+  EXPECT_THAT(future.result(),
+              MatchesKvsReadResult(absl::Cord("retried"),
+                                   StorageGeneration::FromString("g4")));
+  EXPECT_THAT(byte_ranges, ElementsAre(OptionalByteRangeRequest::Range(3, 6),
+                                       OptionalByteRangeRequest::Range(6, 9),
+                                       OptionalByteRangeRequest::Range(9, 10),
+                                       OptionalByteRangeRequest()));
+}
+
+}  // namespace
@@ -430,7 +430,9 @@ class MinishardIndexCache
                                const ShardingSpec& sharding_spec)
       : Base(kvstore::DriverPtr(new MinishardIndexKeyValueStore(
             std::move(base_kvstore), executor, std::move(key_prefix),
-            sharding_spec))) {}
+            sharding_spec))) {
+    SetPriority(internal::CachePriority::kHigh);
+  }
 
   MinishardIndexKeyValueStore* kvstore_driver() {
     return static_cast<MinishardIndexKeyValueStore*>(
@@ -0,0 +1,152 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/ocdbt/non_distributed/bulk_load.h"
+
+#include <stddef.h>
+
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/str_format.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/context.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/ocdbt/driver.h"
+#include "tensorstore/kvstore/ocdbt/test_util.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/test_matchers.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+namespace kvstore = ::tensorstore::kvstore;
+using ::tensorstore::StatusIs;
+using ::tensorstore::internal::MatchesKvsReadResult;
+using ::tensorstore::internal::MatchesKvsReadResultNotFound;
+using ::tensorstore::internal_ocdbt::BtreeBulkLoader;
+using ::tensorstore::internal_ocdbt::GetOcdbtIoHandle;
+using ::tensorstore::internal_ocdbt::OcdbtDriver;
+using ::tensorstore::internal_ocdbt::ReadManifest;
+
+std::string Key(size_t i) { return absl::StrFormat("key_%06d", i); }
+
+// Mixes values that are stored inline and out-of-line.
+std::string Value(size_t i) {
+  return absl::StrFormat("value_%d_%s", i, std::string(i % 3 * 100, 'x'));
+}
+
+void TestBulkLoad(::nlohmann::json config_json, size_t num_keys) {
+  auto context = tensorstore::Context::Default();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      kvstore::Open(
+          {{"driver", "ocdbt"}, {"config", config_json}, {"base", "memory://"}},
+          context)
+          .result());
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto loader, BtreeBulkLoader::Make(GetOcdbtIoHandle(*store.driver)));
+  for (size_t i = 0; i < num_keys; ++i) {
+    TENSORSTORE_ASSERT_OK(loader->Add(Key(i), absl::Cord(Value(i))));
+  }
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto generation, loader->Finish());
+  EXPECT_EQ(2, generation.generation_number);
+  EXPECT_EQ(num_keys, generation.root.statistics.num_keys);
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto manifest, ReadManifest(static_cast<OcdbtDriver&>(*store.driver)));
+  ASSERT_TRUE(manifest);
+  EXPECT_EQ(generation, manifest->latest_version());
+
+  for (size_t i = 0; i < num_keys; ++i) {
+    EXPECT_THAT(kvstore::Read(store, Key(i)).result(),
+                MatchesKvsReadResult(absl::Cord(Value(i))))
+        << "i=" << i;
+  }
+  EXPECT_THAT(kvstore::Read(store, Key(num_keys)).result(),
+              MatchesKvsReadResultNotFound());
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto list_entries,
+                                   kvstore::ListFuture(store).result());
+  ASSERT_EQ(num_keys, list_entries.size());
+  for (size_t i = 0; i < num_keys; ++i) {
+    EXPECT_EQ(Key(i), list_entries[i].key);
+  }
+}
+
+TEST(BulkLoadTest, Empty) { TestBulkLoad(::nlohmann::json::object_t(), 0); }
+
+TEST(BulkLoadTest, SingleLeafNode) {
+  TestBulkLoad(::nlohmann::json::object_t(), 10);
+}
+
+TEST(BulkLoadTest, MultipleLevels) {
+  TestBulkLoad({{"max_decoded_node_bytes", 500}}, 5000);
+}
+
+TEST(BulkLoadTest, MinimalNodes) {
+  TestBulkLoad({{"max_decoded_node_bytes", 1}}, 100);
+}
+
+TEST(BulkLoadTest, Compression) {
+  TestBulkLoad(
+      {{"max_decoded_node_bytes", 500}, {"compression", {{"id", "zstd"}}}},
+      1000);
+}
+
+TEST(BulkLoadTest, UnsortedKeys) {
+  auto context = tensorstore::Context::Default();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      kvstore::Open({{"driver", "ocdbt"}, {"base", "memory://"}}, context)
+          .result());
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto loader, BtreeBulkLoader::Make(GetOcdbtIoHandle(*store.driver)));
+  TENSORSTORE_ASSERT_OK(loader->Add("b", absl::Cord("1")));
+  EXPECT_THAT(loader->Add("a", absl::Cord("2")),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(loader->Add("b", absl::Cord("2")),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(BulkLoadTest, NonEmptyDatabase) {
+  auto context = tensorstore::Context::Default();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      kvstore::Open({{"driver", "ocdbt"}, {"base", "memory://"}}, context)
+          .result());
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "a", absl::Cord("1")));
+  EXPECT_THAT(BtreeBulkLoader::Make(GetOcdbtIoHandle(*store.driver)),
+              StatusIs(absl::StatusCode::kFailedPrecondition));
+}
+
+TEST(BulkLoadTest, ConcurrentModification) {
+  auto context = tensorstore::Context::Default();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      kvstore::Open({{"driver", "ocdbt"}, {"base", "memory://"}}, context)
+          .result());
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto loader, BtreeBulkLoader::Make(GetOcdbtIoHandle(*store.driver)));
+  TENSORSTORE_ASSERT_OK(loader->Add("a", absl::Cord("1")));
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "b", absl::Cord("2")));
+  EXPECT_THAT(loader->Finish(), StatusIs(absl::StatusCode::kAborted));
+  EXPECT_THAT(kvstore::Read(store, "a").result(),
+              MatchesKvsReadResultNotFound());
+}
+
+}  // namespace
@@ -16,17 +16,23 @@
 
 #include <stdint.h>
 
+#include <array>
 #include <atomic>
+#include <string>
 #include <string_view>
 #include <tuple>
 #include <type_traits>
 
 #include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/escaping.h"
 #include "absl/strings/str_format.h"
 #include "absl/synchronization/mutex.h"
 #include <nlohmann/json.hpp>
 #include "riegeli/zstd/zstd_writer.h"
+#include "tensorstore/internal/digest/sha256.h"
 #include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/json/value_as.h"
 #include "tensorstore/internal/json_binding/bindable.h"
 #include "tensorstore/internal/json_binding/enum.h"
 #include "tensorstore/internal/json_binding/json_binding.h"
@@ -38,6 +44,7 @@
 #include "tensorstore/kvstore/ocdbt/format/version_tree.h"
 #include "tensorstore/kvstore/supported_features.h"
 #include "tensorstore/util/result.h"
+#include "tensorstore/util/quote_string.h"
 #include "tensorstore/util/status.h"
 
 namespace tensorstore {
@@ -46,6 +53,27 @@ namespace internal_ocdbt {
 namespace jb = ::tensorstore::internal_json_binding;
 
 constexpr auto NoCompressionJsonBinder = jb::Constant([] { return nullptr; });
+
+// Binds the contents of a zstd dictionary as a base64-encoded string.
+constexpr auto ZstdDictionaryDataJsonBinder =
+    [](auto is_loading, const auto& options, std::string* obj,
+       ::nlohmann::json* j) -> absl::Status {
+  if constexpr (is_loading) {
+    const auto* s = j->get_ptr<const std::string*>();
+    if (!s || !absl::Base64Unescape(*s, obj)) {
+      return internal_json::ExpectedError(*j, "base64-encoded string");
+    }
+    if (obj->empty() || obj->size() > kMaxZstdDictionaryLength) {
+      return absl::InvalidArgumentError(absl::StrFormat(
+          "Zstd dictionary of %d bytes is outside valid range [1, %d]",
+          obj->size(), kMaxZstdDictionaryLength));
+    }
+  } else {
+    *j = absl::Base64Escape(*obj);
+  }
+  return absl::OkStatus();
+};
+
 constexpr auto ZstdCompressionJsonBinder = jb::Object(
     jb::Member("id", jb::Constant([] { return "zstd"; })),
     jb::Member(
@@ -53,10 +81,57 @@ constexpr auto ZstdCompressionJsonBinder = jb::Object(
         jb::Projection<&Config::ZstdCompression::level>(
             jb::DefaultInitializedValue(jb::Integer<int32_t>(
                 riegeli::ZstdWriterBase::Options::kMinCompressionLevel,
-                riegeli::ZstdWriterBase::Options::kMaxCompressionLevel)))));
+                riegeli::ZstdWriterBase::Options::kMaxCompressionLevel)))),
+    jb::Member("dictionary",
+               jb::Projection<&Config::ZstdCompression::dictionary>(
+                   jb::Optional(jb::Object(jb::Member(
+                       "sha256",
+                       jb::Projection<&Config::ZstdDictionary::sha256>(
+                           jb::RawBytesHex)))))));
 constexpr auto ConfigCompressionJsonBinder =
     jb::Variant(NoCompressionJsonBinder, ZstdCompressionJsonBinder);
 
+// Binds `ConfigConstraints::compression` along with
+// `ConfigConstraints::zstd_dictionary`.
+//
+// The zstd ``"dictionary"`` may be specified either by its contents, as a
+// base64-encoded string, or only by its digest, as ``{"sha256": ...}``, which
+// suffices to validate an existing database.
+constexpr auto ConfigConstraintsCompressionJsonBinder =
+    [](auto is_loading, const auto& options, auto* obj,
+       ::nlohmann::json* j) -> absl::Status {
+  constexpr auto binder = jb::Projection<&ConfigConstraints::compression>(
+      jb::Optional(ConfigCompressionJsonBinder));
+  if constexpr (is_loading) {
+    obj->zstd_dictionary = std::nullopt;
+    if (auto* j_obj = j->template get_ptr<::nlohmann::json::object_t*>()) {
+      if (auto it = j_obj->find("dictionary");
+          it != j_obj->end() && it->second.is_string()) {
+        std::string data;
+        TENSORSTORE_RETURN_IF_ERROR(
+            ZstdDictionaryDataJsonBinder(is_loading, options, &data,
+                                         &it->second),
+            _.Format("Error parsing object member %v",
+                     QuoteString("dictionary")));
+        const auto digest = GetZstdDictionaryDigest(data);
+        it->second = ::nlohmann::json::object_t{
+            {"sha256", absl::BytesToHexString(std::string_view(
+                           reinterpret_cast<const char*>(digest.data()),
+                           digest.size()))}};
+        obj->zstd_dictionary = std::move(data);
+      }
+    }
+    return binder(is_loading, options, obj, j);
+  } else {
+    TENSORSTORE_RETURN_IF_ERROR(binder(is_loading, options, obj, j));
+    if (obj->zstd_dictionary && j->is_object()) {
+      TENSORSTORE_RETURN_IF_ERROR(ZstdDictionaryDataJsonBinder(
+          is_loading, options, &*obj->zstd_dictionary, &(*j)["dictionary"]));
+    }
+    return absl::OkStatus();
+  }
+};
+
 constexpr auto ManifestKindJsonBinder = [](auto is_loading, const auto& options,
                                            auto* obj, auto* j) {
   // This is defined as a lambda that forwards to the function returned by
@@ -86,9 +161,7 @@ TENSORSTORE_DEFINE_JSON_DEFAULT_BINDER(
                    jb::Projection<&ConfigConstraints::version_tree_arity_log2>(
                        jb::Optional(
                            jb::Integer<uint8_t>(1, kMaxVersionTreeArityLog2)))),
-        jb::Member("compression",
-                   jb::Projection<&ConfigConstraints::compression>(
-                       jb::Optional(ConfigCompressionJsonBinder)))))
+        jb::Member("compression", ConfigConstraintsCompressionJsonBinder)))
 
 void to_json(::nlohmann::json& j, const Config::Compression& compression) {
   ConfigCompressionJsonBinder(/*is_loading=*/std::false_type{},
@@ -174,6 +247,12 @@ absl::Status CreateConfig(const ConfigConstraints& constraints,
       default_config.version_tree_arity_log2);
   config.compression =
       constraints.compression.value_or(default_config.compression);
+  if (auto* dictionary = GetZstdDictionary(config);
+      dictionary && !constraints.zstd_dictionary) {
+    return absl::InvalidArgumentError(
+        "Cannot create OCDBT database with zstd dictionary specified only by "
+        "its digest");
+  }
   return absl::OkStatus();
 }
 
@@ -192,6 +271,10 @@ Result<ConfigStatePtr> ConfigState::Make(
   self->constraints_ = constraints;
   self->supported_features_for_manifest_ = supported_features_for_manifest;
   self->assume_config_ = assume_config;
+  if (constraints.zstd_dictionary) {
+    self->zstd_dictionary_.set_data(*constraints.zstd_dictionary);
+    self->zstd_dictionary_set_.store(true, std::memory_order_release);
+  }
   if (assume_config) {
     TENSORSTORE_ASSIGN_OR_RETURN(self->assumed_config_,
                                  self->CreateNewConfig());
@@ -199,6 +282,42 @@ Result<ConfigStatePtr> ConfigState::Make(
   return self;
 }
 
+std::array<uint8_t, 32> GetZstdDictionaryDigest(std::string_view data) {
+  internal::SHA256Digester digester;
+  digester.Write(data);
+  return digester.Digest();
+}
+
+const riegeli::ZstdDictionary* ConfigState::GetZstdDictionary() const {
+  if (!zstd_dictionary_set_.load(std::memory_order_acquire)) {
+    return nullptr;
+  }
+  return &zstd_dictionary_;
+}
+
+absl::Status ConfigState::SetZstdDictionary(
+    const Config::ZstdDictionary& dictionary, const absl::Cord& data) {
+  if (data.empty() || data.size() > kMaxZstdDictionaryLength) {
+    return absl::DataLossError(absl::StrFormat(
+        "Zstd dictionary of %d bytes is outside valid range [1, %d]",
+        data.size(), kMaxZstdDictionaryLength));
+  }
+  internal::SHA256Digester digester;
+  digester.Write(data);
+  if (digester.Digest() != dictionary.sha256) {
+    return absl::DataLossError(
+        absl::StrFormat("Zstd dictionary %v does not match its digest",
+                        dictionary.location));
+  }
+  absl::MutexLock lock(mutex_);
+  if (zstd_dictionary_set_.load(std::memory_order_relaxed)) {
+    return absl::OkStatus();
+  }
+  zstd_dictionary_.set_data(std::string(data));
+  zstd_dictionary_set_.store(true, std::memory_order_release);
+  return absl::OkStatus();
+}
+
 absl::Status ConfigState::ValidateNewConfig(const Config& config) {
   if (!config_set_.load(std::memory_order_acquire)) {
     absl::MutexLock lock(mutex_);
@@ -257,10 +376,10 @@ ConfigConstraints ConfigState::GetConstraints() const {
 bool operator==(const ConfigConstraints& lhs, const ConfigConstraints& rhs) {
   return std::tie(lhs.uuid, lhs.manifest_kind, lhs.max_inline_value_bytes,
                   lhs.max_decoded_node_bytes, lhs.version_tree_arity_log2,
-                  lhs.compression) ==
+                  lhs.compression, lhs.zstd_dictionary) ==
          std::tie(rhs.uuid, rhs.manifest_kind, rhs.max_inline_value_bytes,
                   rhs.max_decoded_node_bytes, rhs.version_tree_arity_log2,
-                  rhs.compression);
+                  rhs.compression, rhs.zstd_dictionary);
 }
 
 }  // namespace internal_ocdbt
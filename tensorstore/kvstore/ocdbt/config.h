@@ -17,11 +17,16 @@
 
 #include <stdint.h>
 
+#include <array>
 #include <atomic>
 #include <optional>
+#include <string>
+#include <string_view>
 
 #include "absl/status/status.h"
+#include "absl/strings/cord.h"
 #include "absl/synchronization/mutex.h"
+#include "riegeli/zstd/zstd_dictionary.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/json_binding/bindable.h"
 #include "tensorstore/json_serialization_options_base.h"
@@ -43,6 +48,11 @@ struct ConfigConstraints {
   std::optional<uint8_t> version_tree_arity_log2;
   std::optional<Config::Compression> compression;
 
+  /// Contents of the zstd dictionary specified by `compression`, which are
+  /// needed to create a new database.  In the JSON representation, specified
+  /// as a base64-encoded ``"dictionary"`` member of ``"compression"``.
+  std::optional<std::string> zstd_dictionary;
+
   friend bool operator==(const ConfigConstraints& a,
                          const ConfigConstraints& b);
   friend bool operator!=(const ConfigConstraints& a,
@@ -57,10 +67,13 @@ struct ConfigConstraints {
   constexpr static auto ApplyMembers = [](auto&& x, auto f) {
     return f(x.uuid, x.manifest_kind, x.max_inline_value_bytes,
              x.max_decoded_node_bytes, x.version_tree_arity_log2,
-             x.compression);
+             x.compression, x.zstd_dictionary);
   };
 };
 
+/// Returns the digest that identifies a zstd dictionary.
+std::array<uint8_t, 32> GetZstdDictionaryDigest(std::string_view data);
+
 class ConfigState;
 using ConfigStatePtr = internal::IntrusivePtr<ConfigState>;
 
@@ -103,6 +116,22 @@ class ConfigState : public internal::AtomicReferenceCount<ConfigState> {
   Result<Config> CreateNewConfig();
   ConfigConstraints GetConstraints() const;
 
+  /// Returns the prepared zstd dictionary specified by the configuration, or
+  /// `nullptr` if there is none or it has not yet been loaded.
+  ///
+  /// If the dictionary contents were specified by the constraints, the
+  /// dictionary is available immediately.  Otherwise, it is loaded by
+  /// `IoHandle::GetManifest` once the configuration is known.  Copies of the
+  /// returned dictionary share the prepared compression and decompression
+  /// state.
+  const riegeli::ZstdDictionary* GetZstdDictionary() const;
+
+  /// Sets the zstd dictionary specified by `dictionary` from its contents.
+  ///
+  /// Returns an error if `data` does not match the digest.
+  absl::Status SetZstdDictionary(const Config::ZstdDictionary& dictionary,
+                                 const absl::Cord& data);
+
   bool assume_config() const { return assume_config_; }
 
  private:
@@ -115,6 +144,8 @@ class ConfigState : public internal::AtomicReferenceCount<ConfigState> {
   kvstore::SupportedFeatures supported_features_for_manifest_;
   std::atomic<bool> config_set_{false};
   bool assume_config_{false};
+  riegeli::ZstdDictionary zstd_dictionary_;
+  std::atomic<bool> zstd_dictionary_set_{false};
 };
 
 absl::Status ValidateConfig(const Config& config,
@@ -523,8 +523,9 @@ void NodeCommitOperation::ApplyMutationsForEntry(
       });
   BtreeNodeHeight height = commit_op->height;
   const std::string key_prefix = commit_op->key_prefix;
-  BtreeNodeEncoder<Entry> node_encoder(commit_op->existing_manifest->config,
-                                       height, key_prefix);
+  BtreeNodeEncoder<Entry> node_encoder(
+      commit_op->existing_manifest->config, height, key_prefix,
+      commit_op->server->io_handle_->config_state->GetZstdDictionary());
   ComparePrefixedKeyToUnprefixedKey compare_existing_and_new_keys{key_prefix};
   bool modified = false;
   span<const Entry> existing_entries;
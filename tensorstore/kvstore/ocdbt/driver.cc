@@ -205,6 +205,11 @@ TENSORSTORE_DEFINE_JSON_DEFAULT_BINDER(
             "experimental_read_coalescing_interval",
             jb::Projection<
                 &OcdbtDriverSpecData::experimental_read_coalescing_interval>()),
+        jb::Member(
+            "experimental_list_concurrency",
+            jb::Projection<
+                &OcdbtDriverSpecData::experimental_list_concurrency>(
+                jb::Optional(jb::Integer<size_t>(1)))),
         jb::Member(
             "target_data_file_size",
             jb::Projection<&OcdbtDriverSpecData::target_data_file_size>()),
@@ -266,6 +271,8 @@ Future<kvstore::DriverPtr> OcdbtDriverSpec::DoOpen() const {
             spec->data_.experimental_read_coalescing_merged_bytes;
         driver->experimental_read_coalescing_interval_ =
             spec->data_.experimental_read_coalescing_interval;
+        driver->experimental_list_concurrency_ =
+            spec->data_.experimental_list_concurrency;
         driver->target_data_file_size_ = spec->data_.target_data_file_size;
         driver->version_spec_ = spec->data_.version_spec;
 
@@ -361,6 +368,7 @@ absl::Status OcdbtDriver::GetBoundSpecData(OcdbtDriverSpecData& spec) const {
       experimental_read_coalescing_merged_bytes_;
   spec.experimental_read_coalescing_interval =
       experimental_read_coalescing_interval_;
+  spec.experimental_list_concurrency = experimental_list_concurrency_;
   spec.target_data_file_size = target_data_file_size_;
   spec.coordinator = coordinator_;
   spec.version_spec = version_spec_;
@@ -384,7 +392,8 @@ void OcdbtDriver::ListImpl(kvstore::ListOptions options,
                            ListReceiver receiver) {
   ocdbt_metrics.list.Increment();
   return internal_ocdbt::NonDistributedList(
-      io_handle_, version_spec_, std::move(options), std::move(receiver));
+      io_handle_, version_spec_, std::move(options), std::move(receiver),
+      experimental_list_concurrency_.value_or(kDefaultListConcurrency));
 }
 
 namespace {
@@ -87,6 +87,7 @@ struct OcdbtDriverSpecData {
   std::optional<size_t> experimental_read_coalescing_threshold_bytes;
   std::optional<size_t> experimental_read_coalescing_merged_bytes;
   std::optional<absl::Duration> experimental_read_coalescing_interval;
+  std::optional<size_t> experimental_list_concurrency;
   std::optional<size_t> target_data_file_size;
   bool assume_config = false;
   Context::Resource<OcdbtCoordinatorResource> coordinator;
@@ -102,7 +103,8 @@ struct OcdbtDriverSpecData {
              x.data_copy_concurrency,
              x.experimental_read_coalescing_threshold_bytes,
              x.experimental_read_coalescing_merged_bytes,
-             x.experimental_read_coalescing_interval, x.target_data_file_size,
+             x.experimental_read_coalescing_interval,
+             x.experimental_list_concurrency, x.target_data_file_size,
              x.coordinator, x.version_spec);
   };
 };
@@ -177,6 +179,7 @@ class OcdbtDriver
   std::optional<size_t> experimental_read_coalescing_threshold_bytes_;
   std::optional<size_t> experimental_read_coalescing_merged_bytes_;
   std::optional<absl::Duration> experimental_read_coalescing_interval_;
+  std::optional<size_t> experimental_list_concurrency_;
   std::optional<size_t> target_data_file_size_;
   Context::Resource<OcdbtCoordinatorResource> coordinator_;
   std::optional<VersionSpec> version_spec_;
@@ -19,6 +19,7 @@
 #include <initializer_list>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -27,6 +28,7 @@
 #include <gtest/gtest.h>
 #include "absl/status/status.h"
 #include "absl/strings/cord.h"
+#include "absl/strings/escaping.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/time/clock.h"
@@ -424,6 +426,26 @@ TEST(OcdbtTest, SimpleMinArity) {
                              })));
 }
 
+TEST(OcdbtTest, ListConcurrencyMinArity) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      tensorstore::kvstore::Open({{"driver", "ocdbt"},
+                                  {"base", "memory://"},
+                                  {"config", {{"max_decoded_node_bytes", 1}}},
+                                  {"experimental_list_concurrency", 1}})
+          .result());
+  std::vector<std::string> keys;
+  for (int i = 0; i < 20; ++i) {
+    keys.push_back(absl::StrFormat("key%02d", i));
+    TENSORSTORE_ASSERT_OK(kvstore::Write(store, keys.back(), absl::Cord("x")));
+  }
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto entries,
+                                   kvstore::ListFuture(store).result());
+  std::vector<std::string> listed_keys;
+  for (const auto& entry : entries) listed_keys.push_back(entry.key);
+  EXPECT_THAT(listed_keys, ::testing::UnorderedElementsAreArray(keys));
+}
+
 TEST(OcdbtTest, DeleteRangeMinArity) {
   TENSORSTORE_ASSERT_OK_AND_ASSIGN(
       auto store,
@@ -1081,6 +1103,84 @@ TEST(OcdbtTest, VersionedOpenReadOnly) {
   }
 }
 
+// Tests that a zstd dictionary specified when creating a database is stored as
+// a separate data file and loaded when reopening the database without it.
+TEST(OcdbtTest, ZstdDictionary) {
+  tensorstore::internal_testing::ScopedTemporaryDirectory tempdir;
+  ::nlohmann::json base_spec{{"driver", "file"},
+                             {"path", tempdir.path() + "/"}};
+  std::string dictionary;
+  for (int i = 0; i < 100; ++i) {
+    absl::StrAppend(&dictionary, "key", i, "value", i);
+  }
+  const auto digest =
+      tensorstore::internal_ocdbt::GetZstdDictionaryDigest(dictionary);
+  const std::string digest_hex = absl::BytesToHexString(std::string_view(
+      reinterpret_cast<const char*>(digest.data()), digest.size()));
+
+  {
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto store,
+        kvstore::Open({{"driver", "ocdbt"},
+                       {"base", base_spec},
+                       {"config",
+                        {{"compression",
+                          {{"id", "zstd"},
+                           {"dictionary", absl::Base64Escape(dictionary)}}}}}},
+                      Context::Default())
+            .result());
+    for (int i = 0; i < 100; ++i) {
+      TENSORSTORE_ASSERT_OK(kvstore::Write(store, absl::StrCat("key", i),
+                                           absl::Cord(absl::StrCat("value", i)))
+                                .result());
+    }
+  }
+
+  // Reopen with a new context, so that nothing is cached.
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      kvstore::Open({{"driver", "ocdbt"}, {"base", base_spec}},
+                    Context::Default())
+          .result());
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_THAT(kvstore::Read(store, absl::StrCat("key", i)).result(),
+                MatchesKvsReadResult(absl::Cord(absl::StrCat("value", i))));
+  }
+  EXPECT_THAT(store.spec().value().ToJson(),
+              ::testing::Optional(JsonSubValueMatches(
+                  "/config/compression/dictionary/sha256", digest_hex)));
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "new", absl::Cord("x")));
+  EXPECT_THAT(kvstore::Read(store, "key0").result(),
+              MatchesKvsReadResult(absl::Cord("value0")));
+
+  // The digest alone suffices to validate the existing database.
+  TENSORSTORE_EXPECT_OK(
+      kvstore::Open({{"driver", "ocdbt"},
+                     {"base", base_spec},
+                     {"config",
+                      {{"compression",
+                        {{"id", "zstd"},
+                         {"dictionary", {{"sha256", digest_hex}}}}}}}},
+                    Context::Default())
+          .result());
+}
+
+TEST(OcdbtTest, ZstdDictionaryDigestOnlyCreate) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      kvstore::Open(
+          {{"driver", "ocdbt"},
+           {"base", "memory://"},
+           {"config",
+            {{"compression",
+              {{"id", "zstd"},
+               {"dictionary", {{"sha256", std::string(64, '0')}}}}}}}})
+          .result());
+  EXPECT_THAT(kvstore::Write(store, "a", absl::Cord("x")).result(),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       HasSubstr("specified only by its digest")));
+}
+
 TEST(OcdbtTest, UrlRoundtrip) {
   tensorstore::internal::TestKeyValueStoreUrlRoundtrip(
       {{"driver", "ocdbt"},
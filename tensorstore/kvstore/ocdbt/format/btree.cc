@@ -19,6 +19,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cstring>
+#include <limits>
 #include <memory>
 #include <ostream>
 #include <string_view>
@@ -36,6 +37,7 @@
 #include "tensorstore/kvstore/ocdbt/format/data_file_id.h"
 #include "tensorstore/kvstore/ocdbt/format/data_file_id_codec.h"
 #include "tensorstore/kvstore/ocdbt/format/indirect_data_reference.h"
+#include "tensorstore/util/endian.h"
 #include "tensorstore/util/quote_string.h"
 #include "tensorstore/util/result.h"
 #include "tensorstore/util/span.h"
@@ -201,8 +203,9 @@ bool ReadBtreeNodeEntries(riegeli::Reader& reader,
 
 }  // namespace
 
-Result<BtreeNode> DecodeBtreeNode(const absl::Cord& encoded,
-                                  const BasePath& base_path) {
+Result<BtreeNode> DecodeBtreeNode(
+    const absl::Cord& encoded, const BasePath& base_path,
+    const riegeli::ZstdDictionary* zstd_dictionary) {
   BtreeNode node;
   auto status = DecodeWithOptionalCompression(
       encoded, kBtreeNodeMagic, kBtreeNodeFormatVersion,
@@ -231,8 +234,12 @@ Result<BtreeNode> DecodeBtreeNode(const absl::Cord& encoded,
           return ReadBtreeNodeEntries<InteriorNodeEntry>(
               reader, data_file_table, num_entries, node);
         }
-      });
+      },
+      zstd_dictionary);
   TENSORSTORE_RETURN_IF_ERROR(status).Format("Error decoding b-tree node");
+  node.key_heads = std::visit(
+      [](const auto& entries) { return ComputeBtreeKeyHeads(entries); },
+      node.entries);
 #ifndef NDEBUG
   CheckBtreeNodeInvariants(node);
 #endif
@@ -327,46 +334,115 @@ std::ostream& operator<<(std::ostream& os, const InteriorNodeEntry& e) {
   return os << absl::StreamFormat("%v", e);
 }
 
+uint64_t GetBtreeKeyHead(std::string_view key) {
+  unsigned char head[8] = {};
+  std::memcpy(head, key.data(), std::min(key.size(), sizeof(head)));
+  return big_endian::Load64(head);
+}
+
+namespace {
+
+template <typename Entry>
+std::vector<uint64_t> ComputeBtreeKeyHeadsImpl(span<const Entry> entries) {
+  std::vector<uint64_t> key_heads(entries.size());
+  for (size_t i = 0; i < entries.size(); ++i) {
+    key_heads[i] = GetBtreeKeyHead(entries[i].key);
+  }
+  return key_heads;
+}
+
+// Returns the index of the first element of `key_heads` that is not less than
+// `key_head`.
+//
+// The loop body compiles to a conditional move rather than a branch, and the
+// number of iterations depends only on `key_heads.size()`, which avoids
+// branch mispredictions.
+size_t KeyHeadLowerBound(span<const uint64_t> key_heads, uint64_t key_head) {
+  if (key_heads.empty()) return 0;
+  const uint64_t* base = key_heads.data();
+  size_t n = key_heads.size();
+  while (n > 1) {
+    const size_t half = n / 2;
+    base = (base[half] < key_head) ? base + half : base;
+    n -= half;
+  }
+  return (base - key_heads.data()) + (*base < key_head);
+}
+
+// Returns the first entry for which `pred(entry.key, key)` is `false`, where
+// `pred` must be equivalent to either `std::less<>` or `std::less_equal<>`.
+//
+// Since key heads are ordered consistently with keys, only the entries with a
+// key head equal to that of `key` must be compared by `pred`.
+template <typename Entry, typename Predicate>
+const Entry* PartitionBtreeEntries(span<const Entry> entries,
+                                   span<const uint64_t> key_heads,
+                                   std::string_view key, Predicate pred) {
+  const Entry* first = entries.data();
+  const Entry* last = entries.data() + entries.size();
+  if (!key_heads.empty()) {
+    assert(key_heads.size() == entries.size());
+    const uint64_t key_head = GetBtreeKeyHead(key);
+    const size_t lower = KeyHeadLowerBound(key_heads, key_head);
+    size_t upper = key_heads.size();
+    if (key_head != std::numeric_limits<uint64_t>::max()) {
+      upper = lower +
+              KeyHeadLowerBound(key_heads.subspan(lower), key_head + 1);
+    }
+    last = first + upper;
+    first += lower;
+  }
+  return std::partition_point(
+      first, last, [&](const Entry& entry) { return pred(entry.key, key); });
+}
+
+bool KeyLess(std::string_view a, std::string_view b) { return a < b; }
+bool KeyLessEqual(std::string_view a, std::string_view b) { return a <= b; }
+
+}  // namespace
+
+std::vector<uint64_t> ComputeBtreeKeyHeads(span<const LeafNodeEntry> entries) {
+  return ComputeBtreeKeyHeadsImpl(entries);
+}
+
+std::vector<uint64_t> ComputeBtreeKeyHeads(
+    span<const InteriorNodeEntry> entries) {
+  return ComputeBtreeKeyHeadsImpl(entries);
+}
+
 const LeafNodeEntry* FindBtreeEntry(span<const LeafNodeEntry> entries,
-                                    std::string_view key) {
-  const LeafNodeEntry* entry = FindBtreeEntryLowerBound(entries, key);
+                                    std::string_view key,
+                                    span<const uint64_t> key_heads) {
+  const LeafNodeEntry* entry =
+      FindBtreeEntryLowerBound(entries, key, key_heads);
   if (entry == entries.data() + entries.size() || entry->key != key) {
     return nullptr;
   }
   return entry;
 }
 
-const LeafNodeEntry* FindBtreeEntryLowerBound(span<const LeafNodeEntry> entries,
-                                              std::string_view inclusive_min) {
-  return std::lower_bound(
-      entries.data(), entries.data() + entries.size(), inclusive_min,
-      [](const LeafNodeEntry& entry, std::string_view inclusive_min) {
-        return entry.key < inclusive_min;
-      });
+const LeafNodeEntry* FindBtreeEntryLowerBound(
+    span<const LeafNodeEntry> entries, std::string_view inclusive_min,
+    span<const uint64_t> key_heads) {
+  return PartitionBtreeEntries(entries, key_heads, inclusive_min, KeyLess);
 }
 
-span<const LeafNodeEntry> FindBtreeEntryRange(span<const LeafNodeEntry> entries,
-                                              std::string_view inclusive_min,
-                                              std::string_view exclusive_max) {
-  const LeafNodeEntry* lower = FindBtreeEntryLowerBound(entries, inclusive_min);
+span<const LeafNodeEntry> FindBtreeEntryRange(
+    span<const LeafNodeEntry> entries, std::string_view inclusive_min,
+    std::string_view exclusive_max, span<const uint64_t> key_heads) {
+  const LeafNodeEntry* lower =
+      FindBtreeEntryLowerBound(entries, inclusive_min, key_heads);
   const LeafNodeEntry* upper = entries.data() + entries.size();
   if (!exclusive_max.empty()) {
-    upper = std::lower_bound(
-        lower, upper, exclusive_max,
-        [](const LeafNodeEntry& entry, std::string_view exclusive_max) {
-          return entry.key < exclusive_max;
-        });
+    upper = PartitionBtreeEntries(entries, key_heads, exclusive_max, KeyLess);
   }
-  return {lower, upper};
+  return {lower, std::max(lower, upper)};
 }
 
 const InteriorNodeEntry* FindBtreeEntry(span<const InteriorNodeEntry> entries,
-                                        std::string_view key) {
-  auto it = std::lower_bound(
-      entries.data(), entries.data() + entries.size(), key,
-      [](const InteriorNodeEntry& entry, std::string_view inclusive_min) {
-        return entry.key <= inclusive_min;
-      });
+                                        std::string_view key,
+                                        span<const uint64_t> key_heads) {
+  auto it = PartitionBtreeEntries(entries, key_heads, key, KeyLessEqual);
   if (it == entries.data()) {
     // Key not present.
     return nullptr;
@@ -375,34 +451,34 @@ const InteriorNodeEntry* FindBtreeEntry(span<const InteriorNodeEntry> entries,
 }
 
 const InteriorNodeEntry* FindBtreeEntryLowerBound(
-    span<const InteriorNodeEntry> entries, std::string_view inclusive_min) {
-  auto it = std::lower_bound(
-      entries.data(), entries.data() + entries.size(), inclusive_min,
-      [](const InteriorNodeEntry& entry, std::string_view inclusive_min) {
-        return entry.key <= inclusive_min;
-      });
+    span<const InteriorNodeEntry> entries, std::string_view inclusive_min,
+    span<const uint64_t> key_heads) {
+  auto it =
+      PartitionBtreeEntries(entries, key_heads, inclusive_min, KeyLessEqual);
   if (it != entries.data()) --it;
   return it;
 }
 
 span<const InteriorNodeEntry> FindBtreeEntryRange(
     span<const InteriorNodeEntry> entries, std::string_view inclusive_min,
-    std::string_view exclusive_max) {
+    std::string_view exclusive_max, span<const uint64_t> key_heads) {
   const InteriorNodeEntry* lower =
-      FindBtreeEntryLowerBound(entries, inclusive_min);
+      FindBtreeEntryLowerBound(entries, inclusive_min, key_heads);
   const InteriorNodeEntry* upper = entries.data() + entries.size();
   if (!exclusive_max.empty()) {
-    upper = std::lower_bound(
-        lower, upper, exclusive_max,
-        [](const InteriorNodeEntry& entry, std::string_view exclusive_max) {
-          return entry.key < exclusive_max;
-        });
+    upper = PartitionBtreeEntries(entries, key_heads, exclusive_max, KeyLess);
   }
-  return {lower, upper};
+  return {lower, std::max(lower, upper)};
 }
 
 #ifndef NDEBUG
 void CheckBtreeNodeInvariants(const BtreeNode& node) {
+  if (!node.key_heads.empty()) {
+    auto compute_key_heads = [](const auto& entries) {
+      return ComputeBtreeKeyHeads(entries);
+    };
+    assert(node.key_heads == std::visit(compute_key_heads, node.entries));
+  }
   if (node.height == 0) {
     assert(std::holds_alternative<BtreeNode::LeafNodeEntries>(node.entries));
     auto& entries = std::get<BtreeNode::LeafNodeEntries>(node.entries);
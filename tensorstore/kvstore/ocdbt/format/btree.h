@@ -39,6 +39,7 @@
 #include "absl/status/status.h"
 #include "absl/strings/cord.h"
 #include "absl/strings/str_format.h"
+#include "riegeli/zstd/zstd_dictionary.h"
 #include "tensorstore/internal/estimate_heap_usage/estimate_heap_usage.h"
 #include "tensorstore/kvstore/ocdbt/format/data_file_id.h"
 #include "tensorstore/kvstore/ocdbt/format/indirect_data_reference.h"
@@ -250,8 +251,13 @@ struct BtreeNode {
   /// Concatenated key data, referenced by `key_prefix` and `entries`.
   KeyBuffer key_buffer;
 
+  /// Search index over `entries`, computed by `ComputeBtreeKeyHeads`.
+  ///
+  /// Either empty, or specifies `GetBtreeKeyHead(entry.key)` for each entry.
+  std::vector<uint64_t> key_heads;
+
   constexpr static auto ApplyMembers = [](auto&& x, auto f) {
-    return f(x.height, x.key_prefix, x.entries, x.key_buffer);
+    return f(x.height, x.key_prefix, x.entries, x.key_buffer, x.key_heads);
   };
 };
 
@@ -315,8 +321,12 @@ BtreeNodeStatistics GetBtreeNodeLocalStatistics(const BtreeNode& node,
                                                 uint64_t own_size);
 
 /// Decodes a b+tree node.
-Result<BtreeNode> DecodeBtreeNode(const absl::Cord& encoded,
-                                  const BasePath& base_path);
+///
+/// \param zstd_dictionary Dictionary specified by the database config, or
+///     `nullptr` if none.
+Result<BtreeNode> DecodeBtreeNode(
+    const absl::Cord& encoded, const BasePath& base_path,
+    const riegeli::ZstdDictionary* zstd_dictionary = nullptr);
 
 /// Function object where `ComparePrefixedKeyToUnprefixedKey{prefix}(a, b)`
 /// returns `(prefix + a).compare(b)`.
@@ -333,40 +343,62 @@ struct ComparePrefixedKeyToUnprefixedKey {
   }
 };
 
+/// Returns the first 8 bytes of `key`, zero-padded, as a big endian integer.
+///
+/// Comparing the key heads of two keys is consistent with comparing the keys
+/// themselves, except that distinct keys may have equal key heads.
+uint64_t GetBtreeKeyHead(std::string_view key);
+
+/// Returns `GetBtreeKeyHead(entry.key)` for each entry.
+std::vector<uint64_t> ComputeBtreeKeyHeads(span<const LeafNodeEntry> entries);
+std::vector<uint64_t> ComputeBtreeKeyHeads(
+    span<const InteriorNodeEntry> entries);
+
+/// The `FindBtreeEntry*` functions below binary search `entries` by key.
+///
+/// If `key_heads` is non-empty, it must equal `ComputeBtreeKeyHeads(entries)`.
+/// The search is then first narrowed using the key heads, which are contiguous
+/// in memory and compared without branching, and the keys themselves are only
+/// compared among entries with equal key heads.
+
 /// Returns the entry with key equal to `key`, or `nullptr` if there is no such
 /// entry.
 const LeafNodeEntry* FindBtreeEntry(span<const LeafNodeEntry> entries,
-                                    std::string_view key);
+                                    std::string_view key,
+                                    span<const uint64_t> key_heads = {});
 
 /// Returns a pointer to the first entry with a key not less than
 /// `inclusive_min`, or a pointer one past the end of `entries` if there is no
 /// such entry.
-const LeafNodeEntry* FindBtreeEntryLowerBound(span<const LeafNodeEntry> entries,
-                                              std::string_view inclusive_min);
+const LeafNodeEntry* FindBtreeEntryLowerBound(
+    span<const LeafNodeEntry> entries, std::string_view inclusive_min,
+    span<const uint64_t> key_heads = {});
 
 /// Returns the sub-span of entries with keys greater or equal to
 /// `inclusive_min` and less than `exclusive_max` (where, as for `KeyRange`, an
 /// empty string for `exclusive_max` indicates no upper bound).
-span<const LeafNodeEntry> FindBtreeEntryRange(span<const LeafNodeEntry> entries,
-                                              std::string_view inclusive_min,
-                                              std::string_view exclusive_max);
+span<const LeafNodeEntry> FindBtreeEntryRange(
+    span<const LeafNodeEntry> entries, std::string_view inclusive_min,
+    std::string_view exclusive_max, span<const uint64_t> key_heads = {});
 
 /// Returns a pointer to the entry whose subtree may contain `key`, or `nullptr`
 /// if no entry has a subtree that may contain `key`.
 const InteriorNodeEntry* FindBtreeEntry(span<const InteriorNodeEntry> entries,
-                                        std::string_view key);
+                                        std::string_view key,
+                                        span<const uint64_t> key_heads = {});
 
 /// Returns a pointer to the first entry whose key range intersects the set of
 /// keys that are not less than `inclusive_min`.
 const InteriorNodeEntry* FindBtreeEntryLowerBound(
-    span<const InteriorNodeEntry> entries, std::string_view inclusive_min);
+    span<const InteriorNodeEntry> entries, std::string_view inclusive_min,
+    span<const uint64_t> key_heads = {});
 
 /// Returns the sub-span of entries whose subtrees intersect the key range
 /// `[inclusive_min, exclusive_max)` (where, as for `KeyRange`, an empty string
 /// for `exclusive_max` indicates no upper bound).
 span<const InteriorNodeEntry> FindBtreeEntryRange(
     span<const InteriorNodeEntry> entries, std::string_view inclusive_min,
-    std::string_view exclusive_max);
+    std::string_view exclusive_max, span<const uint64_t> key_heads = {});
 
 #ifndef NDEBUG
 /// Checks invariants.
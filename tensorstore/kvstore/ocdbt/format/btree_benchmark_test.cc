@@ -0,0 +1,81 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "absl/random/random.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/str_format.h"
+#include "tensorstore/kvstore/ocdbt/format/btree.h"
+#include "tensorstore/util/span.h"
+
+namespace {
+
+using ::tensorstore::span;
+using ::tensorstore::internal_ocdbt::ComputeBtreeKeyHeads;
+using ::tensorstore::internal_ocdbt::FindBtreeEntry;
+using ::tensorstore::internal_ocdbt::LeafNodeEntry;
+
+// Leaf node with `num_entries` chunk keys of the form `"<i>/<j>/<k>"`, as
+// remain after the common `"c/"` prefix is stripped from zarr v3 chunk keys.
+// Many of the keys share the same first 8 bytes.
+struct LeafNode {
+  explicit LeafNode(size_t num_entries) {
+    for (size_t i = 0; i < num_entries; ++i) {
+      keys.push_back(absl::StrFormat("%d/%d/%d", 10 + i / 10000,
+                                     1000 + i / 100 % 100, 100 + i % 100));
+    }
+    std::sort(keys.begin(), keys.end());
+    for (const auto& key : keys) {
+      entries.push_back({/*.key =*/key, /*.value_reference =*/absl::Cord()});
+    }
+    key_heads = ComputeBtreeKeyHeads(span<const LeafNodeEntry>(entries));
+  }
+
+  std::vector<std::string> keys;
+  std::vector<LeafNodeEntry> entries;
+  std::vector<uint64_t> key_heads;
+};
+
+// Point lookups of random keys present in a node with `state.range(0)`
+// entries, with or without the key head index.
+template <bool kUseKeyHeads>
+void BM_FindLeafEntry(benchmark::State& state) {
+  LeafNode node(state.range(0));
+  absl::BitGen gen;
+  std::vector<std::string> lookup_keys(4096);
+  for (auto& key : lookup_keys) {
+    key = node.keys[absl::Uniform<size_t>(gen, 0, node.keys.size())];
+  }
+  span<const uint64_t> key_heads;
+  if (kUseKeyHeads) key_heads = node.key_heads;
+  size_t i = 0;
+  for (auto s : state) {
+    benchmark::DoNotOptimize(
+        FindBtreeEntry(node.entries, lookup_keys[i], key_heads));
+    i = (i + 1) % lookup_keys.size();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_FindLeafEntry, false)->Range(16, 16384);
+BENCHMARK_TEMPLATE(BM_FindLeafEntry, true)->Range(16, 16384);
+
+}  // namespace
@@ -160,10 +160,14 @@ bool WriteKeys(riegeli::Writer& writer, KeyLength excluded_prefix_length,
 }  // namespace
 
 template <typename Entry>
-BtreeNodeEncoder<Entry>::BtreeNodeEncoder(const Config& config,
-                                          BtreeNodeHeight height,
-                                          std::string_view existing_prefix)
-    : config_(config), height_(height), existing_prefix_(existing_prefix) {
+BtreeNodeEncoder<Entry>::BtreeNodeEncoder(
+    const Config& config, BtreeNodeHeight height,
+    std::string_view existing_prefix,
+    const riegeli::ZstdDictionary* zstd_dictionary)
+    : config_(config),
+      height_(height),
+      existing_prefix_(existing_prefix),
+      zstd_dictionary_(zstd_dictionary) {
   if constexpr (std::is_same_v<Entry, LeafNodeEntry>) {
     assert(height_ == 0);
   }
@@ -304,7 +308,7 @@ Result<EncodedNode> EncodeEntries(
     const Config& config, BtreeNodeHeight height,
     std::string_view existing_prefix,
     span<typename BtreeNodeEncoder<Entry>::BufferedEntry> entries,
-    bool is_root) {
+    bool is_root, const riegeli::ZstdDictionary* zstd_dictionary) {
   EncodedNode encoded;
   auto result = EncodeWithOptionalCompression(
       config, kBtreeNodeMagic, kBtreeNodeFormatVersion,
@@ -313,7 +317,8 @@ Result<EncodedNode> EncodeEntries(
         if (!writer.WriteByte(height)) return false;
         return EncodeEntriesInner<Entry>(writer, height, existing_prefix,
                                          entries, is_root, encoded.info);
-      });
+      },
+      zstd_dictionary);
   TENSORSTORE_ASSIGN_OR_RETURN(encoded.encoded_node, std::move(result),
                                _.Format("Error encoding b-tree node"));
   encoded.info.statistics.num_tree_bytes += encoded.encoded_node.size();
@@ -382,7 +387,8 @@ Result<std::vector<EncodedNode>> BtreeNodeEncoder<Entry>::Finalize(
         EncodeEntries<Entry>(
             config_, height_, existing_prefix_,
             span(buffered_entries_.data() + start_i, end_i - start_i),
-            may_be_root && start_i == 0 && end_i == buffered_entries_.size()));
+            may_be_root && start_i == 0 && end_i == buffered_entries_.size(),
+            zstd_dictionary_));
     encoded_nodes.push_back(std::move(encoded_node));
     start_i = end_i;
     prev_size_estimate = buffered_entries_[end_i - 1].cumulative_size;
@@ -20,6 +20,7 @@
 #include <vector>
 
 #include "absl/strings/cord.h"
+#include "riegeli/zstd/zstd_dictionary.h"
 #include "tensorstore/kvstore/ocdbt/format/btree.h"
 #include "tensorstore/kvstore/ocdbt/format/config.h"
 #include "tensorstore/util/result.h"
@@ -62,8 +63,11 @@ class BtreeNodeEncoder {
   /// \param height Height of the nodes being encoded.  Must be 0 if, and only
   ///     if, `Entry` is equal to `LeafNodeEntry`.
   /// \param existing_prefix Implicit key prefix for all existing entries.
+  /// \param zstd_dictionary Prepared dictionary specified by `config`, or
+  ///     `nullptr` to compress without a dictionary.
   BtreeNodeEncoder(const Config& config, BtreeNodeHeight height,
-                   std::string_view existing_prefix);
+                   std::string_view existing_prefix,
+                   const riegeli::ZstdDictionary* zstd_dictionary = nullptr);
 
   /// Adds a new or existing entry.
   ///
@@ -96,6 +100,7 @@ class BtreeNodeEncoder {
   const Config& config_;
   BtreeNodeHeight height_;
   std::string_view existing_prefix_;
+  const riegeli::ZstdDictionary* zstd_dictionary_;
 
   std::vector<BufferedEntry> buffered_entries_;
   size_t common_prefix_length_ = 0;
@@ -30,6 +30,7 @@
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "riegeli/bytes/writer.h"
+#include "riegeli/zstd/zstd_dictionary.h"
 #include "tensorstore/kvstore/ocdbt/format/btree_codec.h"
 #include "tensorstore/kvstore/ocdbt/format/btree_node_encoder.h"
 #include "tensorstore/kvstore/ocdbt/format/codec_util.h"
@@ -37,20 +38,27 @@
 #include "tensorstore/kvstore/ocdbt/format/indirect_data_reference.h"
 #include "tensorstore/util/quote_string.h"
 #include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
 #include "tensorstore/util/status_testutil.h"
 
 namespace {
 
 using ::tensorstore::Result;
+using ::tensorstore::span;
 using ::tensorstore::StatusIs;
 using ::tensorstore::internal_ocdbt::BtreeNode;
 using ::tensorstore::internal_ocdbt::BtreeNodeEncoder;
 using ::tensorstore::internal_ocdbt::BtreeNodeReference;
 using ::tensorstore::internal_ocdbt::BtreeNodeStatistics;
+using ::tensorstore::internal_ocdbt::ComputeBtreeKeyHeads;
 using ::tensorstore::internal_ocdbt::Config;
 using ::tensorstore::internal_ocdbt::DataFileId;
 using ::tensorstore::internal_ocdbt::DecodeBtreeNode;
 using ::tensorstore::internal_ocdbt::EncodedNode;
+using ::tensorstore::internal_ocdbt::FindBtreeEntry;
+using ::tensorstore::internal_ocdbt::FindBtreeEntryLowerBound;
+using ::tensorstore::internal_ocdbt::FindBtreeEntryRange;
+using ::tensorstore::internal_ocdbt::GetBtreeKeyHead;
 using ::tensorstore::internal_ocdbt::IndirectDataReference;
 using ::tensorstore::internal_ocdbt::InteriorNodeEntry;
 using ::tensorstore::internal_ocdbt::kMaxNodeArity;
@@ -58,13 +66,15 @@ using ::tensorstore::internal_ocdbt::LeafNodeEntry;
 using ::tensorstore::internal_ocdbt::LeafNodeValueReference;
 using ::testing::HasSubstr;
 
-Result<std::vector<EncodedNode>> EncodeExistingNode(const Config& config,
-                                                    const BtreeNode& node) {
+Result<std::vector<EncodedNode>> EncodeExistingNode(
+    const Config& config, const BtreeNode& node,
+    const riegeli::ZstdDictionary* zstd_dictionary = nullptr) {
   return std::visit(
       [&](const auto& entries) {
         using Entry = typename std::decay_t<decltype(entries)>::value_type;
         BtreeNodeEncoder<Entry> encoder(config, /*height=*/node.height,
-                                        /*existing_prefix=*/node.key_prefix);
+                                        /*existing_prefix=*/node.key_prefix,
+                                        zstd_dictionary);
         for (const auto& entry : entries) {
           encoder.AddEntry(/*existing=*/true, Entry(entry));
         }
@@ -97,6 +107,8 @@ void TestBtreeNodeRoundTrip(const Config& config, const BtreeNode& node) {
                                decoded_node.key_prefix));
         EXPECT_THAT(decoded_node.entries,
                     ::testing::VariantWith<std::vector<Entry>>(entries));
+        EXPECT_EQ(ComputeBtreeKeyHeads(span<const Entry>(entries)),
+                  decoded_node.key_heads);
       },
       node.entries);
 }
@@ -115,6 +127,33 @@ TEST(BtreeNodeTest, LeafNodeRoundTrip) {
   TestBtreeNodeRoundTrip(config, node);
 }
 
+TEST(BtreeNodeTest, LeafNodeZstdDictionary) {
+  Config config;
+  config.compression =
+      Config::ZstdCompression{/*.level=*/0, Config::ZstdDictionary{}};
+  riegeli::ZstdDictionary zstd_dictionary;
+  zstd_dictionary.set_data("value1value2value3value4");
+  BtreeNode node;
+  node.height = 0;
+  auto& entries = node.entries.emplace<BtreeNode::LeafNodeEntries>();
+  entries.push_back({/*.key =*/"c",
+                     /*.value_reference =*/absl::Cord("value1")});
+  entries.push_back({/*.key =*/"d",
+                     /*.value_reference =*/absl::Cord("value2")});
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto encoded_nodes, EncodeExistingNode(config, node, &zstd_dictionary));
+  ASSERT_EQ(1, encoded_nodes.size());
+  const auto& encoded = encoded_nodes[0].encoded_node;
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto decoded_node, DecodeBtreeNode(encoded, {}, &zstd_dictionary));
+  EXPECT_THAT(decoded_node.entries,
+              ::testing::VariantWith<BtreeNode::LeafNodeEntries>(entries));
+
+  EXPECT_THAT(DecodeBtreeNode(encoded, {}),
+              StatusIs(absl::StatusCode::kDataLoss, HasSubstr("dictionary")));
+}
+
 TEST(BtreeNodeTest, InteriorNodeRoundTrip) {
   Config config;
   BtreeNode node;
@@ -326,6 +365,88 @@ TEST(BtreeNodeTest, MaxArity) {
             std::get<BtreeNode::LeafNodeEntries>(decoded_node2.entries).size());
 }
 
+TEST(BtreeFormatTest, GetBtreeKeyHead) {
+  EXPECT_EQ(0u, GetBtreeKeyHead(""));
+  EXPECT_EQ(0x6100000000000000u, GetBtreeKeyHead("a"));
+  EXPECT_EQ(0x6162636465666768u, GetBtreeKeyHead("abcdefgh"));
+  EXPECT_EQ(0x6162636465666768u, GetBtreeKeyHead("abcdefghi"));
+  EXPECT_EQ(0xff00000000000000u, GetBtreeKeyHead("\xff"));
+}
+
+// Keys for which the key heads are frequently equal, including keys that only
+// differ by trailing zero bytes.
+std::vector<std::string> GetKeyHeadTestKeys() {
+  std::vector<std::string> keys = {
+      "",
+      std::string("\0", 1),
+      std::string("a\0", 2),
+      "a",
+      "ab",
+      "abcdefg",
+      std::string("abcdefg\0", 8),
+      std::string("abcdefg\0\0", 9),
+      "abcdefgh",
+      "abcdefgha",
+      "abcdefghb",
+      "abcdefghbb",
+      "abcdefgi",
+      "b",
+      "\xff\xff\xff\xff\xff\xff\xff\xff",
+      "\xff\xff\xff\xff\xff\xff\xff\xff\xff",
+  };
+  std::sort(keys.begin(), keys.end());
+  return keys;
+}
+
+TEST(BtreeFormatTest, FindLeafEntryWithKeyHeads) {
+  auto keys = GetKeyHeadTestKeys();
+  // Only store every other key, so that both present and missing keys are
+  // searched.
+  std::vector<LeafNodeEntry> entries;
+  for (size_t i = 0; i < keys.size(); i += 2) {
+    entries.push_back({/*.key =*/keys[i], /*.value_reference =*/absl::Cord()});
+  }
+  auto key_heads = ComputeBtreeKeyHeads(span<const LeafNodeEntry>(entries));
+  for (const auto& key : keys) {
+    SCOPED_TRACE(tensorstore::QuoteString(key));
+    EXPECT_EQ(FindBtreeEntry(entries, key),
+              FindBtreeEntry(entries, key, key_heads));
+    EXPECT_EQ(FindBtreeEntryLowerBound(entries, key),
+              FindBtreeEntryLowerBound(entries, key, key_heads));
+    for (const auto& exclusive_max : keys) {
+      auto expected = FindBtreeEntryRange(entries, key, exclusive_max);
+      auto actual = FindBtreeEntryRange(entries, key, exclusive_max, key_heads);
+      EXPECT_EQ(expected.data(), actual.data());
+      EXPECT_EQ(expected.size(), actual.size());
+    }
+  }
+}
+
+TEST(BtreeFormatTest, FindInteriorEntryWithKeyHeads) {
+  auto keys = GetKeyHeadTestKeys();
+  std::vector<InteriorNodeEntry> entries;
+  for (size_t i = 1; i < keys.size(); i += 2) {
+    InteriorNodeEntry entry;
+    entry.key = keys[i];
+    entry.subtree_common_prefix_length = 0;
+    entries.push_back(entry);
+  }
+  auto key_heads = ComputeBtreeKeyHeads(span<const InteriorNodeEntry>(entries));
+  for (const auto& key : keys) {
+    SCOPED_TRACE(tensorstore::QuoteString(key));
+    EXPECT_EQ(FindBtreeEntry(entries, key),
+              FindBtreeEntry(entries, key, key_heads));
+    EXPECT_EQ(FindBtreeEntryLowerBound(entries, key),
+              FindBtreeEntryLowerBound(entries, key, key_heads));
+    for (const auto& exclusive_max : keys) {
+      auto expected = FindBtreeEntryRange(entries, key, exclusive_max);
+      auto actual = FindBtreeEntryRange(entries, key, exclusive_max, key_heads);
+      EXPECT_EQ(expected.data(), actual.data());
+      EXPECT_EQ(expected.size(), actual.size());
+    }
+  }
+}
+
 TEST(BtreeFormatTest, AbslStringify) {
   BtreeNodeStatistics stats{10, 200, 30};
   EXPECT_EQ("{num_indirect_value_bytes=10, num_tree_bytes=200, num_keys=30}",
@@ -20,6 +20,7 @@
 #include <algorithm>
 #include <limits>
 #include <string_view>
+#include <utility>
 #include <variant>
 
 #include "absl/crc/crc32c.h"
@@ -41,6 +42,7 @@
 #include "riegeli/endian/endian_writing.h"
 #include "riegeli/varint/varint_reading.h"
 #include "riegeli/varint/varint_writing.h"
+#include "riegeli/zstd/zstd_dictionary.h"
 #include "riegeli/zstd/zstd_reader.h"
 #include "riegeli/zstd/zstd_writer.h"
 #include "tensorstore/kvstore/ocdbt/format/config.h"
@@ -89,7 +91,8 @@ absl::Status DecodeWithOptionalCompression(
     const absl::Cord& encoded, uint32_t expected_magic,
     uint32_t max_version_number,
     absl::FunctionRef<bool(riegeli::Reader& reader, uint32_t version)>
-        decode_decompressed) {
+        decode_decompressed,
+    const riegeli::ZstdDictionary* zstd_dictionary) {
   constexpr size_t kMinLength = 4     // magic
                                 + 8   // length
                                 + 4;  // crc32.
@@ -152,8 +155,19 @@ absl::Status DecodeWithOptionalCompression(
         // Uncompressed
         success = decode_decompressed(digesting_reader, version);
         break;
-      case 1: {
-        riegeli::ZstdReader zstd_reader(&digesting_reader);
+      case 1:
+      case 2: {
+        riegeli::ZstdReaderBase::Options options;
+        if (compression_format == 2) {
+          if (!zstd_dictionary) {
+            digesting_reader.Fail(absl::DataLossError(
+                "Compressed with a zstd dictionary, but the database "
+                "configuration does not specify one"));
+            return false;
+          }
+          options.set_dictionary(*zstd_dictionary);
+        }
+        riegeli::ZstdReader zstd_reader(&digesting_reader, std::move(options));
         success = decode_decompressed(zstd_reader, version) &&
                   zstd_reader.VerifyEndAndClose();
         if (!success && !zstd_reader.ok()) {
@@ -186,7 +200,8 @@ absl::Status DecodeWithOptionalCompression(
 
 Result<absl::Cord> EncodeWithOptionalCompression(
     const Config& config, uint32_t magic, uint32_t version_number,
-    absl::FunctionRef<bool(riegeli::Writer& writer)> encode) {
+    absl::FunctionRef<bool(riegeli::Writer& writer)> encode,
+    const riegeli::ZstdDictionary* zstd_dictionary) {
   absl::Cord encoded;
   riegeli::CordWriter writer(&encoded);
   bool success = [&] {
@@ -204,13 +219,18 @@ Result<absl::Cord> EncodeWithOptionalCompression(
       if (!riegeli::WriteVarint32(0, digesting_writer)) return false;
       if (!encode(digesting_writer)) return false;
     } else {
-      if (!riegeli::WriteVarint32(1, digesting_writer)) return false;
       const auto& zstd_config =
           std::get<Config::ZstdCompression>(config.compression);
-      riegeli::ZstdWriter zstd_writer(
-          &digesting_writer,
-          riegeli::ZstdWriterBase::Options().set_compression_level(
-              zstd_config.level));
+      riegeli::ZstdWriterBase::Options options;
+      options.set_compression_level(zstd_config.level);
+      if (zstd_dictionary && zstd_config.dictionary) {
+        if (!riegeli::WriteVarint32(2, digesting_writer)) return false;
+        // Copies share the prepared dictionary.
+        options.set_dictionary(*zstd_dictionary);
+      } else {
+        if (!riegeli::WriteVarint32(1, digesting_writer)) return false;
+      }
+      riegeli::ZstdWriter zstd_writer(&digesting_writer, std::move(options));
       if (!encode(zstd_writer) || !zstd_writer.Close()) {
         digesting_writer.Fail(zstd_writer.status());
         return false;
@@ -38,6 +38,7 @@
 #include "riegeli/endian/endian_reading.h"
 #include "riegeli/endian/endian_writing.h"
 #include "riegeli/varint/varint_writing.h"
+#include "riegeli/zstd/zstd_dictionary.h"
 #include "tensorstore/kvstore/ocdbt/format/config.h"
 #include "tensorstore/util/result.h"
 
@@ -132,11 +133,14 @@ struct NoOpCodec {
 /// \param max_version_number Maximum allowed version number in header.
 /// \param decode_compressed Callback to be invoked to encode the uncompressed
 ///     body.
+/// \param zstd_dictionary Dictionary specified by the database config, required
+///     to decode data compressed with a dictionary.
 absl::Status DecodeWithOptionalCompression(
     const absl::Cord& encoded, uint32_t expected_magic,
     uint32_t max_version_number,
     absl::FunctionRef<bool(riegeli::Reader& reader, uint32_t version)>
-        decode_decompressed);
+        decode_decompressed,
+    const riegeli::ZstdDictionary* zstd_dictionary = nullptr);
 
 /// Encodes with the common compression header.
 ///
@@ -144,9 +148,13 @@ absl::Status DecodeWithOptionalCompression(
 /// \param magic Magic number to include at start of header.
 /// \param version_number Version number to include in header.
 /// \param encode Callback to be invoked to encode the uncompressed body.
+/// \param zstd_dictionary Prepared dictionary specified by `config`, or
+///     `nullptr` to compress without a dictionary.  Must be `nullptr` for the
+///     manifest, which is decoded before the dictionary is known.
 Result<absl::Cord> EncodeWithOptionalCompression(
     const Config& config, uint32_t magic, uint32_t version_number,
-    absl::FunctionRef<bool(riegeli::Writer& writer)> encode);
+    absl::FunctionRef<bool(riegeli::Writer& writer)> encode,
+    const riegeli::ZstdDictionary* zstd_dictionary = nullptr);
 
 /// Closes `reader`, verifying that the end has been reached and
 /// `success == true`.
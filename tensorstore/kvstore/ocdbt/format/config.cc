@@ -46,11 +46,16 @@ std::ostream& operator<<(std::ostream& os, Config::NoCompression x) {
   return os << absl::StreamFormat("%v", x);
 }
 
-bool operator==(Config::ZstdCompression a, Config::ZstdCompression b) {
-  return a.level == b.level;
+bool operator==(const Config::ZstdCompression& a,
+                const Config::ZstdCompression& b) {
+  return a.level == b.level && a.dictionary == b.dictionary;
 }
 
-std::ostream& operator<<(std::ostream& os, Config::ZstdCompression x) {
+std::ostream& operator<<(std::ostream& os, const Config::ZstdDictionary& x) {
+  return os << absl::StreamFormat("%v", x);
+}
+
+std::ostream& operator<<(std::ostream& os, const Config::ZstdCompression& x) {
   return os << absl::StreamFormat("%v", x);
 }
 
@@ -70,5 +75,13 @@ std::ostream& operator<<(std::ostream& os, const Config& x) {
   return os << absl::StreamFormat("%v", x);
 }
 
+const Config::ZstdDictionary* GetZstdDictionary(const Config& config) {
+  if (auto* zstd = std::get_if<Config::ZstdCompression>(&config.compression);
+      zstd && zstd->dictionary) {
+    return &*zstd->dictionary;
+  }
+  return nullptr;
+}
+
 }  // namespace internal_ocdbt
 }  // namespace tensorstore
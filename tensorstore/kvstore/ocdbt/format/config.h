@@ -20,11 +20,13 @@
 
 #include <array>
 #include <iosfwd>
+#include <optional>
 #include <string_view>
 #include <variant>
 
 #include "absl/strings/escaping.h"
 #include "absl/strings/str_format.h"
+#include "tensorstore/kvstore/ocdbt/format/indirect_data_reference.h"
 #include "tensorstore/util/apply_members/std_array.h"
 
 namespace tensorstore {
@@ -93,24 +95,71 @@ struct Config {
     friend void AbslStringify(Sink& sink, NoCompression);
   };
 
+  /// Zstd dictionary used to compress version tree and b+tree nodes.
+  ///
+  /// The dictionary itself is stored in a separate data file, rather than in
+  /// the manifest, since the manifest is rewritten on every commit.
+  struct ZstdDictionary {
+    /// SHA-256 digest of the dictionary.
+    ///
+    /// This identifies the dictionary: configs that differ only in `location`
+    /// are equivalent.
+    std::array<uint8_t, 32> sha256 = {};
+
+    /// Location of the dictionary, or `IndirectDataReference::Missing()` if
+    /// it has not yet been written.
+    IndirectDataReference location = IndirectDataReference::Missing();
+
+    friend bool operator==(const ZstdDictionary& a, const ZstdDictionary& b) {
+      return a.sha256 == b.sha256;
+    }
+    friend bool operator!=(const ZstdDictionary& a, const ZstdDictionary& b) {
+      return !(a == b);
+    }
+    friend std::ostream& operator<<(std::ostream& os, const ZstdDictionary& x);
+    template <typename Sink>
+    friend void AbslStringify(Sink& sink, const ZstdDictionary& x) {
+      absl::Format(&sink, "{sha256=%s, location=%v}",
+                   absl::BytesToHexString(std::string_view(
+                       reinterpret_cast<const char*>(x.sha256.data()),
+                       x.sha256.size())),
+                   x.location);
+    }
+
+    // `location` is only meaningful within a manifest, and is excluded.
+    constexpr static auto ApplyMembers = [](auto&& x, auto f) {
+      return f(x.sha256);
+    };
+  };
+
   struct ZstdCompression {
     int32_t level;
-    friend bool operator==(ZstdCompression a, ZstdCompression b);
-    friend bool operator!=(ZstdCompression a, ZstdCompression b) {
+
+    /// Dictionary used to compress version tree and b+tree nodes, or
+    /// `std::nullopt` to compress without a dictionary.  The manifest itself
+    /// is always compressed without a dictionary.
+    std::optional<ZstdDictionary> dictionary;
+
+    friend bool operator==(const ZstdCompression& a,
+                           const ZstdCompression& b);
+    friend bool operator!=(const ZstdCompression& a,
+                           const ZstdCompression& b) {
       return !(a == b);
     }
-    friend std::ostream& operator<<(std::ostream& os, ZstdCompression x);
+    friend std::ostream& operator<<(std::ostream& os,
+                                    const ZstdCompression& x);
     template <typename Sink>
-    friend void AbslStringify(Sink& sink, ZstdCompression x);
+    friend void AbslStringify(Sink& sink, const ZstdCompression& x);
 
     constexpr static auto ApplyMembers = [](auto&& x, auto f) {
-      return f(x.level);
+      return f(x.level, x.dictionary);
     };
   };
 
   /// Encoded as:
   ///   0 -> no compression
   ///   1 -> zstd
+  ///   2 -> zstd with dictionary
   using Compression = std::variant<NoCompression, ZstdCompression>;
   Compression compression = ZstdCompression{0};
 
@@ -138,8 +187,13 @@ struct Config {
   }
 
   template <typename Sink>
-  friend void AbslStringify(Sink& sink, ZstdCompression x) {
-    absl::Format(&sink, "zstd{level=%v}", x.level);
+  friend void AbslStringify(Sink& sink, const ZstdCompression& x) {
+    if (!x.dictionary) {
+      absl::Format(&sink, "zstd{level=%v}", x.level);
+    } else {
+      absl::Format(&sink, "zstd{level=%v, dictionary=%v}", x.level,
+                   *x.dictionary);
+    }
   }
 
   template <typename Sink>
@@ -164,6 +218,13 @@ using ManifestKind = Config::ManifestKind;
 
 constexpr size_t kMaxInlineValueLength = 1024 * 1024;
 
+/// Maximum size of a zstd dictionary.
+constexpr size_t kMaxZstdDictionaryLength = 1024 * 1024;
+
+/// Returns the zstd dictionary specified by `config`, or `nullptr` if nodes are
+/// compressed without a dictionary.
+const Config::ZstdDictionary* GetZstdDictionary(const Config& config);
+
 }  // namespace internal_ocdbt
 }  // namespace tensorstore
 
@@ -17,6 +17,9 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <array>
+#include <cassert>
+#include <utility>
 #include <variant>
 
 #include "absl/status/status.h"
@@ -26,6 +29,9 @@
 #include "riegeli/zstd/zstd_writer.h"
 #include "tensorstore/kvstore/ocdbt/format/codec_util.h"
 #include "tensorstore/kvstore/ocdbt/format/config.h"
+#include "tensorstore/kvstore/ocdbt/format/data_file_id_codec.h"
+#include "tensorstore/kvstore/ocdbt/format/indirect_data_reference_codec.h"
+#include "tensorstore/util/status.h"
 
 namespace tensorstore {
 namespace internal_ocdbt {
@@ -51,6 +57,55 @@ struct ZstdCompressionOptionsCodec {
   }
 };
 
+// Encodes the dictionary digest, followed by its location as a single-entry
+// data file table and the index, offset and length into that table, as used
+// for other `IndirectDataReference` values.
+struct ZstdDictionaryCodec {
+  [[nodiscard]] bool operator()(riegeli::Reader& reader,
+                                Config::ZstdDictionary& value) const {
+    if (!RawBytesCodec<std::array<uint8_t, 32>>{}(reader, value.sha256)) {
+      return false;
+    }
+    DataFileTable data_file_table;
+    if (!ReadDataFileTable(reader, /*transitive_path=*/{}, data_file_table)) {
+      return false;
+    }
+    auto& location = value.location;
+    if (!DataFileIdCodec<riegeli::Reader>{data_file_table}(reader,
+                                                           location.file_id) ||
+        !DataFileOffsetCodec{}(reader, location.offset) ||
+        !DataFileLengthCodec{}(reader, location.length)) {
+      return false;
+    }
+    TENSORSTORE_RETURN_IF_ERROR(location.Validate(/*allow_missing=*/false))
+        .With([&](absl::Status status) {
+          reader.Fail(std::move(status));
+          return false;
+        });
+    if (location.length == 0 || location.length > kMaxZstdDictionaryLength) {
+      reader.Fail(absl::DataLossError(absl::StrFormat(
+          "Zstd dictionary length %d is outside valid range [1, %d]",
+          location.length, kMaxZstdDictionaryLength)));
+      return false;
+    }
+    return true;
+  }
+
+  [[nodiscard]] bool operator()(riegeli::Writer& writer,
+                                const Config::ZstdDictionary& value) const {
+    // The dictionary must be written before the config is encoded.
+    assert(!value.location.IsMissing());
+    DataFileTableBuilder data_file_table;
+    data_file_table.Add(value.location.file_id);
+    return RawBytesCodec<std::array<uint8_t, 32>>{}(writer, value.sha256) &&
+           data_file_table.Finalize(writer) &&
+           DataFileIdCodec<riegeli::Writer>{data_file_table}(
+               writer, value.location.file_id) &&
+           DataFileOffsetCodec{}(writer, value.location.offset) &&
+           DataFileLengthCodec{}(writer, value.location.length);
+  }
+};
+
 using CompressionMethodCodec = VarintCodec<uint32_t>;
 }  // namespace
 
@@ -68,6 +123,14 @@ bool CompressionConfigCodec::operator()(riegeli::Reader& reader,
         return false;
       }
       break;
+    case 2: {
+      auto& zstd = value.emplace<Config::ZstdCompression>();
+      if (!ZstdCompressionOptionsCodec{}(reader, zstd) ||
+          !ZstdDictionaryCodec{}(reader, zstd.dictionary.emplace())) {
+        return false;
+      }
+      break;
+    }
     default:
       reader.Fail(absl::InvalidArgumentError(absl::StrFormat(
           "Invalid compression method: %d", compression_method)));
@@ -83,10 +146,20 @@ bool CompressionConfigCodec::operator()(
       return false;
     }
   } else {
-    if (!CompressionMethodCodec{}(writer, 1) ||
-        !ZstdCompressionOptionsCodec{}(
-            writer, std::get<Config::ZstdCompression>(value))) {
-      return false;
+    // Databases without a dictionary remain readable by versions that do not
+    // support dictionaries.
+    const auto& zstd = std::get<Config::ZstdCompression>(value);
+    if (!zstd.dictionary) {
+      if (!CompressionMethodCodec{}(writer, 1) ||
+          !ZstdCompressionOptionsCodec{}(writer, zstd)) {
+        return false;
+      }
+    } else {
+      if (!CompressionMethodCodec{}(writer, 2) ||
+          !ZstdCompressionOptionsCodec{}(writer, zstd) ||
+          !ZstdDictionaryCodec{}(writer, *zstd.dictionary)) {
+        return false;
+      }
     }
   }
   return true;
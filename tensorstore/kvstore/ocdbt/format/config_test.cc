@@ -51,6 +51,21 @@ TEST(ConfigFormatTest, AbslStringify) {
       "max_inline_value_bytes=100, max_decoded_node_bytes=8388608, "
       "version_tree_arity_log2=4, compression=zstd{level=3}}",
       absl::StrCat(config));
+
+  Config::ZstdDictionary dictionary;
+  dictionary.sha256[0] = 0xab;
+  dictionary.location.file_id.relative_path = "d/x";
+  dictionary.location.offset = 1;
+  dictionary.location.length = 2;
+  config.compression = Config::ZstdCompression{3, dictionary};
+  EXPECT_EQ(
+      "{uuid=00000000000000000000000000000000, manifest_kind=single, "
+      "max_inline_value_bytes=100, max_decoded_node_bytes=8388608, "
+      "version_tree_arity_log2=4, "
+      "compression=zstd{level=3, dictionary={sha256="
+      "ab00000000000000000000000000000000000000000000000000000000000000, "
+      "location={file_id=\"\"+\"d/x\", offset=1, length=2}}}}",
+      absl::StrCat(config));
 }
 
 }  // namespace
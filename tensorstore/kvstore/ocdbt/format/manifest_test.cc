@@ -39,7 +39,9 @@ namespace {
 using ::tensorstore::Result;
 using ::tensorstore::StatusIs;
 using ::tensorstore::internal_ocdbt::CommitTime;
+using ::tensorstore::internal_ocdbt::Config;
 using ::tensorstore::internal_ocdbt::DecodeManifest;
+using ::tensorstore::internal_ocdbt::GetZstdDictionary;
 using ::tensorstore::internal_ocdbt::Manifest;
 using ::testing::HasSubstr;
 using ::testing::MatchesRegex;
@@ -90,6 +92,26 @@ Manifest GetSimpleManifest() {
 
 TEST(ManifestTest, RoundTrip) { TestManifestRoundTrip(GetSimpleManifest()); }
 
+TEST(ManifestTest, RoundTripZstdDictionary) {
+  auto manifest = GetSimpleManifest();
+  Config::ZstdDictionary dictionary;
+  dictionary.sha256[0] = 1;
+  dictionary.sha256[31] = 2;
+  dictionary.location.file_id.base_path = "abc";
+  dictionary.location.file_id.relative_path = "d/dict";
+  dictionary.location.offset = 5;
+  dictionary.location.length = 100;
+  manifest.config.compression =
+      Config::ZstdCompression{/*.level=*/3, /*.dictionary=*/dictionary};
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto encoded, EncodeManifest(manifest));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto decoded, DecodeManifest(encoded));
+  EXPECT_EQ(manifest, decoded);
+  auto* decoded_dictionary = GetZstdDictionary(decoded.config);
+  ASSERT_TRUE(decoded_dictionary);
+  EXPECT_EQ(dictionary.sha256, decoded_dictionary->sha256);
+  EXPECT_EQ(dictionary.location, decoded_dictionary->location);
+}
+
 TEST(ManifestTest, RoundTripNonZeroHeight) {
   Manifest manifest;
   {
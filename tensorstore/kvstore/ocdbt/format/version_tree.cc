@@ -168,8 +168,9 @@ GetVersionTreeLeafNodeRangeContainingGeneration(
   return true;
 }
 
-Result<VersionTreeNode> DecodeVersionTreeNode(const absl::Cord& encoded,
-                                              const BasePath& base_path) {
+Result<VersionTreeNode> DecodeVersionTreeNode(
+    const absl::Cord& encoded, const BasePath& base_path,
+    const riegeli::ZstdDictionary* zstd_dictionary) {
   VersionTreeNode node;
   auto status = DecodeWithOptionalCompression(
       encoded, kVersionTreeNodeMagic, kVersionTreeNodeFormatVersion,
@@ -193,7 +194,8 @@ Result<VersionTreeNode> DecodeVersionTreeNode(const absl::Cord& encoded,
               node.height,
               node.entries.emplace<VersionTreeNode::InteriorNodeEntries>());
         }
-      });
+      },
+      zstd_dictionary);
   TENSORSTORE_RETURN_IF_ERROR(status).Format(
       "Error decoding version tree node");
 #ifndef NDEBUG
@@ -202,8 +204,9 @@ Result<VersionTreeNode> DecodeVersionTreeNode(const absl::Cord& encoded,
   return node;
 }
 
-Result<absl::Cord> EncodeVersionTreeNode(const Config& config,
-                                         const VersionTreeNode& node) {
+Result<absl::Cord> EncodeVersionTreeNode(
+    const Config& config, const VersionTreeNode& node,
+    const riegeli::ZstdDictionary* zstd_dictionary) {
 #ifndef NDEBUG
   assert(node.version_tree_arity_log2 == config.version_tree_arity_log2);
   CheckVersionTreeNodeInvariants(node);
@@ -229,7 +232,8 @@ Result<absl::Cord> EncodeVersionTreeNode(const Config& config,
                                                  data_file_table, entries);
             },
             node.entries);
-      });
+      },
+      zstd_dictionary);
 }
 
 absl::Status ValidateVersionTreeNodeReference(
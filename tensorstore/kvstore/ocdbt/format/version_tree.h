@@ -38,6 +38,7 @@
 #include "absl/strings/cord.h"
 #include "absl/strings/str_format.h"
 #include "absl/time/time.h"
+#include "riegeli/zstd/zstd_dictionary.h"
 #include "tensorstore/kvstore/ocdbt/format/btree.h"
 #include "tensorstore/kvstore/ocdbt/format/config.h"
 #include "tensorstore/kvstore/ocdbt/format/data_file_id.h"
@@ -252,14 +253,22 @@ absl::Status ValidateVersionTreeLeafNodeEntries(
     const VersionTreeNode::LeafNodeEntries& entries);
 
 /// Decodes a version tree node, and validates invariants.
-Result<VersionTreeNode> DecodeVersionTreeNode(const absl::Cord& encoded,
-                                              const BasePath& base_path);
+///
+/// \param zstd_dictionary Dictionary specified by the database config, or
+///     `nullptr` if none.
+Result<VersionTreeNode> DecodeVersionTreeNode(
+    const absl::Cord& encoded, const BasePath& base_path,
+    const riegeli::ZstdDictionary* zstd_dictionary = nullptr);
 
 /// Encodes a version tree node.
 ///
 /// If `NDEBUG` is not defined, also CHECKs invariants.
-Result<absl::Cord> EncodeVersionTreeNode(const Config& config,
-                                         const VersionTreeNode& node);
+///
+/// \param zstd_dictionary Prepared dictionary specified by `config`, or
+///     `nullptr` to compress without a dictionary.
+Result<absl::Cord> EncodeVersionTreeNode(
+    const Config& config, const VersionTreeNode& node,
+    const riegeli::ZstdDictionary* zstd_dictionary = nullptr);
 
 /// Validates that a version tree node has the expected generation number,
 /// height and configuration.
@@ -82,20 +82,60 @@ class IoHandleImpl : public IoHandle {
   internal::CachePtr<VersionTreeNodeCache> version_tree_node_cache_;
   IndirectDataWriterPtr indirect_data_writer_[kNumIndirectDataKinds];
   kvstore::DriverPtr indirect_data_kvstore_driver_;
+  internal::CachePool::WeakPtr cache_pool_;
+  Context::Resource<internal::DataCopyConcurrencyResource>
+      data_copy_concurrency_;
+
+  // Used instead of `btree_node_cache_` and `version_tree_node_cache_` if the
+  // config specifies a zstd dictionary.  Guarded by
+  // `dictionary_node_caches_mutex_`.
+  mutable absl::Mutex dictionary_node_caches_mutex_;
+  mutable internal::CachePtr<BtreeNodeCache> dictionary_btree_node_cache_;
+  mutable internal::CachePtr<VersionTreeNodeCache>
+      dictionary_version_tree_node_cache_;
 
   mutable absl::Mutex manifest_mutex_;
   mutable ManifestWithTime cached_top_level_manifest_{nullptr,
                                                       absl::InfinitePast()};
   mutable ManifestWithTime cached_numbered_manifest_{nullptr,
                                                      absl::InfinitePast()};
+
+  // Returns `cache`, or if the config specifies a zstd dictionary, a cache
+  // that decodes using the dictionary.
+  //
+  // The config and dictionary are not known until the manifest has been
+  // read, and therefore the latter cache is created on first use.  Nodes are
+  // only read after `GetManifest` has loaded the dictionary, and neither can
+  // change once known.
+  template <typename Cache>
+  Cache& GetNodeCache(const internal::CachePtr<Cache>& cache,
+                      internal::CachePtr<Cache>& dictionary_cache) const {
+    const Config* config = config_state->GetExistingConfig();
+    if (!config) return *cache;
+    const auto* dictionary = GetZstdDictionary(*config);
+    if (!dictionary) return *cache;
+    const auto* zstd_dictionary = config_state->GetZstdDictionary();
+    if (!zstd_dictionary) return *cache;
+    absl::MutexLock lock(dictionary_node_caches_mutex_);
+    if (!dictionary_cache) {
+      dictionary_cache = GetDecodedIndirectDataCache<Cache>(
+          cache_pool_.get(), indirect_data_kvstore_driver_,
+          data_copy_concurrency_, zstd_dictionary, dictionary->sha256);
+    }
+    return *dictionary_cache;
+  }
+
   Future<const std::shared_ptr<const BtreeNode>> GetBtreeNode(
       const IndirectDataReference& ref) const final {
-    return btree_node_cache_->ReadEntry(ref);
+    return GetNodeCache(btree_node_cache_, dictionary_btree_node_cache_)
+        .ReadEntry(ref);
   }
 
   Future<const std::shared_ptr<const VersionTreeNode>> GetVersionTreeNode(
       const IndirectDataReference& ref) const final {
-    return version_tree_node_cache_->ReadEntry(ref);
+    return GetNodeCache(version_tree_node_cache_,
+                        dictionary_version_tree_node_cache_)
+        .ReadEntry(ref);
   }
 
   // Returns the cached "top-level" manifest at `manifest.ocdbt`.
@@ -247,11 +287,59 @@ class IoHandleImpl : public IoHandle {
     }
   };
 
+  // Ensures the zstd dictionary specified by the config of the manifest
+  // returned by `future`, if any, has been loaded into `config_state` before
+  // the manifest is returned.
+  //
+  // The dictionary is stored as a separate data file referenced by the config
+  // and, unless it was specified by the spec, is read at most once.
+  Future<const ManifestWithTime> LoadZstdDictionary(
+      Future<const ManifestWithTime> future) const {
+    if (config_state->GetZstdDictionary()) return future;
+    return PromiseFuturePair<ManifestWithTime>::LinkValue(
+               [self = Ptr(this)](
+                   Promise<ManifestWithTime> promise,
+                   ReadyFuture<const ManifestWithTime> future) {
+                 const auto& manifest_with_time = future.value();
+                 const Config::ZstdDictionary* dictionary =
+                     manifest_with_time.manifest
+                         ? GetZstdDictionary(
+                               manifest_with_time.manifest->config)
+                         : nullptr;
+                 if (!dictionary || self->config_state->GetZstdDictionary()) {
+                   promise.SetResult(manifest_with_time);
+                   return;
+                 }
+                 auto read_future =
+                     self->ReadIndirectData(dictionary->location, {});
+                 LinkValue(
+                     [self, dictionary = *dictionary, manifest_with_time](
+                         Promise<ManifestWithTime> promise,
+                         ReadyFuture<kvstore::ReadResult> future) {
+                       auto& read_result = future.value();
+                       if (!read_result.has_value()) {
+                         promise.SetResult(absl::DataLossError(
+                             absl::StrFormat("Missing zstd dictionary %v",
+                                             dictionary.location)));
+                         return;
+                       }
+                       TENSORSTORE_RETURN_IF_ERROR(
+                           self->config_state->SetZstdDictionary(
+                               dictionary, read_result.value),
+                           static_cast<void>(promise.SetResult(_)));
+                       promise.SetResult(manifest_with_time);
+                     },
+                     std::move(promise), std::move(read_future));
+               },
+               std::move(future))
+        .future;
+  }
+
   Future<const ManifestWithTime> GetManifest(
       absl::Time staleness_bound) const final {
     auto [promise, future] = PromiseFuturePair<ManifestWithTime>::Make();
     GetManifestOp::Start(this, std::move(promise), staleness_bound);
-    return std::move(future);
+    return LoadZstdDictionary(std::move(future));
   }
 
   Future<kvstore::ReadResult> ReadIndirectData(
@@ -479,6 +567,8 @@ IoHandle::Ptr MakeIoHandle(
   }
   impl->indirect_data_kvstore_driver_ =
       internal_ocdbt::MakeIndirectDataKvStoreDriver(data_kvstore);
+  impl->cache_pool_ = internal::CachePool::WeakPtr(cache_pool);
+  impl->data_copy_concurrency_ = data_copy_concurrency;
   impl->btree_node_cache_ =
       internal_ocdbt::GetDecodedIndirectDataCache<BtreeNodeCache>(
           cache_pool, impl->indirect_data_kvstore_driver_,
@@ -23,6 +23,7 @@
 
 #include "absl/status/status.h"
 #include "tensorstore/internal/cache/async_cache.h"
+#include "tensorstore/internal/cache/cache.h"
 #include "tensorstore/internal/estimate_heap_usage/estimate_heap_usage.h"
 #include "tensorstore/internal/estimate_heap_usage/std_vector.h"
 #include "tensorstore/kvstore/ocdbt/format/manifest.h"
@@ -45,7 +46,9 @@ class ManifestCache : public internal::AsyncCache {
 
   explicit ManifestCache(kvstore::DriverPtr kvstore_driver, Executor executor)
       : kvstore_driver_(std::move(kvstore_driver)),
-        executor_(std::move(executor)) {}
+        executor_(std::move(executor)) {
+    SetPriority(internal::CachePriority::kHigh);
+  }
 
   class Entry : public Base::Entry {
    public:
@@ -119,7 +122,9 @@ class NumberedManifestCache : public internal::AsyncCache {
   explicit NumberedManifestCache(kvstore::DriverPtr kvstore_driver,
                                  Executor executor)
       : kvstore_driver_(std::move(kvstore_driver)),
-        executor_(std::move(executor)) {}
+        executor_(std::move(executor)) {
+    SetPriority(internal::CachePriority::kHigh);
+  }
 
   class Entry : public Base::Entry {
    public:
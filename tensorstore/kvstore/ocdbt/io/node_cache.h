@@ -16,16 +16,20 @@
 #define TENSORSTORE_KVSTORE_OCDBT_IO_NODE_CACHE_H_
 
 #include <stddef.h>
+#include <stdint.h>
 
+#include <array>
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <utility>
 
 #include "absl/log/absl_check.h"
 #include "absl/status/status.h"
 #include "absl/strings/cord.h"
 #include "absl/time/time.h"
+#include "riegeli/zstd/zstd_dictionary.h"
 #include "tensorstore/context.h"
 #include "tensorstore/internal/cache/async_cache.h"
 #include "tensorstore/internal/cache/cache.h"
@@ -57,9 +61,16 @@ class DecodedIndirectDataCache
                                         internal::AsyncCache>;
 
  public:
-  explicit DecodedIndirectDataCache(kvstore::DriverPtr kvstore_driver,
-                                    Executor executor)
-      : Base(std::move(kvstore_driver)), executor_(std::move(executor)) {}
+  /// Constructs a cache that decodes using `zstd_dictionary`, if not
+  /// `nullptr`.
+  explicit DecodedIndirectDataCache(
+      kvstore::DriverPtr kvstore_driver, Executor executor,
+      const riegeli::ZstdDictionary* zstd_dictionary = nullptr)
+      : Base(std::move(kvstore_driver)), executor_(std::move(executor)) {
+    // Nodes near the root are accessed by every operation.
+    this->SetPriority(internal::CachePriority::kHigh);
+    if (zstd_dictionary) zstd_dictionary_ = *zstd_dictionary;
+  }
 
   using ReadData = T;
 
@@ -82,12 +93,17 @@ class DecodedIndirectDataCache
       IndirectDataReference ref;
       ABSL_CHECK(ref.DecodeCacheKey(this->key()));
 
-      GetOwningCache(*this).executor()(
+      auto& cache = GetOwningCache(*this);
+      cache.executor()(
           [value = *std::move(value), base_path = ref.file_id.base_path,
+           zstd_dictionary = cache.zstd_dictionary_,
            receiver = std::move(receiver)]() mutable {
             auto read_data = std::make_shared<T>();
             TENSORSTORE_ASSIGN_OR_RETURN(
-                *read_data, Derived::Decode(value, base_path),
+                *read_data,
+                Derived::Decode(
+                    value, base_path,
+                    zstd_dictionary.empty() ? nullptr : &zstd_dictionary),
                 static_cast<void>(execution::set_error(receiver, _)));
             execution::set_value(receiver, std::move(read_data));
           });
@@ -127,19 +143,34 @@ class DecodedIndirectDataCache
   const Executor& executor() { return executor_; }
 
   Executor executor_;
+
+  // Copies share the prepared dictionary.
+  riegeli::ZstdDictionary zstd_dictionary_;
 };
 
+/// Returns the cache of decoded nodes read from `kvstore_driver`.
+///
+/// \param zstd_dictionary Prepared dictionary specified by the database
+///     config, or `nullptr` if none.
+/// \param zstd_dictionary_sha256 Digest identifying `zstd_dictionary`, used
+///     in place of its contents in the cache key.
 template <typename Derived>
 internal::CachePtr<Derived> GetDecodedIndirectDataCache(
     internal::CachePool* pool, const kvstore::DriverPtr& kvstore_driver,
     const Context::Resource<internal::DataCopyConcurrencyResource>&
-        data_copy_concurrency) {
+        data_copy_concurrency,
+    const riegeli::ZstdDictionary* zstd_dictionary = nullptr,
+    const std::array<uint8_t, 32>& zstd_dictionary_sha256 = {}) {
   std::string cache_identifier;
-  internal::EncodeCacheKey(&cache_identifier, data_copy_concurrency,
-                           kvstore_driver);
+  internal::EncodeCacheKey(
+      &cache_identifier, data_copy_concurrency, kvstore_driver,
+      zstd_dictionary ? std::string_view(reinterpret_cast<const char*>(
+                                             zstd_dictionary_sha256.data()),
+                                         zstd_dictionary_sha256.size())
+                      : std::string_view());
   return internal::GetCache<Derived>(pool, cache_identifier, [&] {
-    return std::make_unique<Derived>(kvstore_driver,
-                                     data_copy_concurrency->executor);
+    return std::make_unique<Derived>(
+        kvstore_driver, data_copy_concurrency->executor, zstd_dictionary);
   });
 }
 
@@ -150,9 +181,10 @@ class BtreeNodeCache
  public:
   using Base::Base;
 
-  static Result<BtreeNode> Decode(const absl::Cord& encoded,
-                                  const BasePath& base_path) {
-    return DecodeBtreeNode(encoded, base_path);
+  static Result<BtreeNode> Decode(
+      const absl::Cord& encoded, const BasePath& base_path,
+      const riegeli::ZstdDictionary* zstd_dictionary) {
+    return DecodeBtreeNode(encoded, base_path, zstd_dictionary);
   }
 };
 
@@ -165,9 +197,10 @@ class VersionTreeNodeCache
  public:
   using Base::Base;
 
-  static Result<VersionTreeNode> Decode(const absl::Cord& encoded,
-                                        const BasePath& base_path) {
-    return DecodeVersionTreeNode(encoded, base_path);
+  static Result<VersionTreeNode> Decode(
+      const absl::Cord& encoded, const BasePath& base_path,
+      const riegeli::ZstdDictionary* zstd_dictionary) {
+    return DecodeVersionTreeNode(encoded, base_path, zstd_dictionary);
   }
 };
 
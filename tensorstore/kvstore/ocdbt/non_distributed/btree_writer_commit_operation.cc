@@ -167,6 +167,7 @@ void BtreeWriterCommitOperationBase::RootNodeTraversalState::ApplyMutations() {
     auto mutations = std::exchange(this->mutations_, {});
     UpdateParent(*this, /*existing_relative_child_key=*/{},
                  EncodeUpdatedInteriorNodes(this->writer_->existing_config(),
+                                            this->writer_->zstd_dictionary(),
                                             this->height_,
                                             /*existing_prefix=*/{},
                                             /*existing_entries=*/{}, mutations,
@@ -192,8 +193,8 @@ void BtreeWriterCommitOperationBase::InteriorNodeTraversalState::
   UpdateParent(
       *parent_state_, existing_relative_child_key_,
       EncodeUpdatedInteriorNodes(
-          this->writer_->existing_config(), this->height_,
-          this->existing_subtree_key_prefix_,
+          this->writer_->existing_config(), this->writer_->zstd_dictionary(),
+          this->height_, this->existing_subtree_key_prefix_,
           std::get<BtreeNode::InteriorNodeEntries>(existing_node_->entries),
           this->mutations_,
           /*may_be_root=*/parent_state_->is_root_parent()));
@@ -234,8 +235,8 @@ void BtreeWriterCommitOperationBase::UpdateParent(
 
 Result<std::vector<EncodedNode>>
 BtreeWriterCommitOperationBase::EncodeUpdatedInteriorNodes(
-    const Config& config, BtreeNodeHeight height,
-    std::string_view existing_prefix,
+    const Config& config, const riegeli::ZstdDictionary* zstd_dictionary,
+    BtreeNodeHeight height, std::string_view existing_prefix,
     span<const InteriorNodeEntry> existing_entries,
     span<InteriorNodeMutation> mutations, bool may_be_root) {
   // Sort by key order, with deletions before additions, which allows the code
@@ -247,7 +248,8 @@ BtreeWriterCommitOperationBase::EncodeUpdatedInteriorNodes(
               return a.add < b.add;
             });
 
-  BtreeInteriorNodeEncoder encoder(config, height, existing_prefix);
+  BtreeInteriorNodeEncoder encoder(config, height, existing_prefix,
+                                   zstd_dictionary);
   auto existing_it = existing_entries.begin();
   auto mutation_it = mutations.begin();
 
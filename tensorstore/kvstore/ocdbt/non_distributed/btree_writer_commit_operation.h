@@ -79,6 +79,7 @@
 #include "absl/strings/str_cat.h"
 #include "absl/synchronization/mutex.h"
 #include "absl/time/time.h"
+#include "riegeli/zstd/zstd_dictionary.h"
 #include "tensorstore/internal/container/intrusive_red_black_tree.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/log/verbose_flag.h"
@@ -351,6 +352,10 @@ class BtreeWriterCommitOperationBase {
     return *config;
   }
 
+  const riegeli::ZstdDictionary* zstd_dictionary() {
+    return io_handle_->config_state->GetZstdDictionary();
+  }
+
   FlushPromise flush_promise_;
   absl::Time staleness_bound_ = absl::InfinitePast();
 
@@ -495,6 +500,7 @@ class BtreeWriterCommitOperationBase {
   //
   // Args:
   //   config: Configuration to use.
+  //   zstd_dictionary: Dictionary specified by `config`, if loaded.
   //   height: Height of the node.
   //   existing_prefix: Key prefix that applies to `existing_entries`.
   //   existing_entries: Existing children of the node.
@@ -502,7 +508,8 @@ class BtreeWriterCommitOperationBase {
   //   may_be_root: Whether the updated node will be the root node, if applying
   //     the mutations results in just a single node.
   static Result<std::vector<EncodedNode>> EncodeUpdatedInteriorNodes(
-      const Config& config, BtreeNodeHeight height,
+      const Config& config, const riegeli::ZstdDictionary* zstd_dictionary,
+      BtreeNodeHeight height,
       std::string_view existing_prefix,
       span<const InteriorNodeEntry> existing_entries,
       span<InteriorNodeMutation> mutations, bool may_be_root);
@@ -918,7 +925,8 @@ void BtreeWriterCommitOperation<MutationEntry>::VisitLeafNode(
         std::get<BtreeNode::LeafNodeEntries>(params.node->entries);
   }
   BtreeLeafNodeEncoder encoder(params.parent_state->writer_->existing_config(),
-                               /*height=*/0, params.full_prefix);
+                               /*height=*/0, params.full_prefix,
+                               params.parent_state->writer_->zstd_dictionary());
   ComparePrefixedKeyToUnprefixedKey compare_existing_and_new_keys{
       params.full_prefix};
   bool modified = false;
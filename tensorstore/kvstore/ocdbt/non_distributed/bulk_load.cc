@@ -0,0 +1,243 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/ocdbt/non_distributed/bulk_load.h"
+
+#include <stddef.h>
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/str_format.h"
+#include "absl/time/clock.h"
+#include "tensorstore/kvstore/ocdbt/format/btree.h"
+#include "tensorstore/kvstore/ocdbt/format/btree_codec.h"
+#include "tensorstore/kvstore/ocdbt/format/btree_node_encoder.h"
+#include "tensorstore/kvstore/ocdbt/format/config.h"
+#include "tensorstore/kvstore/ocdbt/format/indirect_data_reference.h"
+#include "tensorstore/kvstore/ocdbt/format/manifest.h"
+#include "tensorstore/kvstore/ocdbt/format/version_tree.h"
+#include "tensorstore/kvstore/ocdbt/io_handle.h"
+#include "tensorstore/kvstore/ocdbt/non_distributed/create_new_manifest.h"
+#include "tensorstore/kvstore/ocdbt/non_distributed/write_nodes.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/quote_string.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/status.h"
+
+namespace tensorstore {
+namespace internal_ocdbt {
+namespace {
+
+// Buffered entries are encoded once they fill this many nodes, such that all
+// but the last of the nodes produced by `BtreeNodeEncoder::Finalize` are close
+// to the target size.
+constexpr size_t kNodesPerBatch = 4;
+
+size_t EstimateEntrySize(const InteriorNodeEntryData<std::string>& entry) {
+  return entry.key.size() + kInteriorNodeFixedSize +
+         entry.node.location.file_id.size();
+}
+
+}  // namespace
+
+BtreeBulkLoader::BtreeBulkLoader(
+    IoHandle::Ptr io_handle, std::shared_ptr<const Manifest> existing_manifest,
+    BtreeBulkLoaderOptions options)
+    : io_handle_(std::move(io_handle)),
+      existing_manifest_(std::move(existing_manifest)),
+      config_(existing_manifest_->config),
+      options_(options) {}
+
+Result<std::unique_ptr<BtreeBulkLoader>> BtreeBulkLoader::Make(
+    IoHandle::Ptr io_handle, BtreeBulkLoaderOptions options) {
+  TENSORSTORE_ASSIGN_OR_RETURN(auto time,
+                               EnsureExistingManifest(io_handle).result());
+  TENSORSTORE_ASSIGN_OR_RETURN(auto manifest_with_time,
+                               io_handle->GetManifest(time).result());
+  auto& manifest = manifest_with_time.manifest;
+  if (!manifest) {
+    return absl::FailedPreconditionError("Manifest not found");
+  }
+  if (!manifest->latest_version().root.location.IsMissing()) {
+    return absl::FailedPreconditionError(
+        "Bulk load requires an empty database");
+  }
+  return std::unique_ptr<BtreeBulkLoader>(
+      new BtreeBulkLoader(std::move(io_handle), std::move(manifest), options));
+}
+
+absl::Status BtreeBulkLoader::Add(std::string_view key, absl::Cord value) {
+  if (has_last_key_ && key <= last_key_) {
+    return absl::InvalidArgumentError(absl::StrFormat(
+        "Key %s is not greater than the previous key %s", QuoteString(key),
+        QuoteString(last_key_)));
+  }
+  if (key.size() > kMaxKeyLength) {
+    return absl::InvalidArgumentError(
+        absl::StrFormat("Key length %d exceeds maximum of %d", key.size(),
+                        kMaxKeyLength));
+  }
+  last_key_ = key;
+  has_last_key_ = true;
+
+  LeafNodeEntry entry;
+  entry.key = key;
+  if (value.size() > config_.max_inline_value_bytes) {
+    unflushed_bytes_ += value.size();
+    flush_promise_.Link(io_handle_->WriteData(
+        IndirectDataKind::kValue, std::move(value),
+        entry.value_reference.emplace<IndirectDataReference>()));
+  } else {
+    entry.value_reference = std::move(value);
+  }
+  leaf_estimated_size_ +=
+      key.size() + EstimateDecodedEntrySizeExcludingKey(entry);
+  leaf_entries_.push_back(
+      PendingLeafEntry{std::string(key), std::move(entry.value_reference)});
+
+  if (ShouldEncode(leaf_estimated_size_, leaf_entries_.size())) {
+    TENSORSTORE_RETURN_IF_ERROR(EncodeLeafNodes(/*may_be_root=*/false));
+  }
+  return MaybeFlush();
+}
+
+bool BtreeBulkLoader::ShouldEncode(size_t estimated_size,
+                                   size_t num_entries) const {
+  if (num_entries >= kNodesPerBatch * kMaxNodeArity) return true;
+  return config_.max_decoded_node_bytes != 0 &&
+         estimated_size >= kNodesPerBatch * config_.max_decoded_node_bytes;
+}
+
+absl::Status BtreeBulkLoader::EncodeLeafNodes(bool may_be_root) {
+  BtreeLeafNodeEncoder encoder(config_, /*height=*/0,
+                               /*existing_prefix=*/{},
+                               io_handle_->config_state->GetZstdDictionary());
+  for (auto& pending : leaf_entries_) {
+    LeafNodeEntry entry;
+    entry.key = pending.key;
+    entry.value_reference = std::move(pending.value_reference);
+    encoder.AddEntry(/*existing=*/false, std::move(entry));
+  }
+  TENSORSTORE_ASSIGN_OR_RETURN(auto encoded_nodes,
+                               encoder.Finalize(may_be_root));
+  leaf_entries_.clear();
+  leaf_estimated_size_ = 0;
+  return AddNodes(/*height=*/0, std::move(encoded_nodes));
+}
+
+absl::Status BtreeBulkLoader::EncodeInteriorNodes(BtreeNodeHeight height) {
+  auto& children = levels_[height - 1];
+  BtreeInteriorNodeEncoder encoder(
+      config_, height, /*existing_prefix=*/{},
+      io_handle_->config_state->GetZstdDictionary());
+  for (const auto& entry : children.entries) {
+    AddNewInteriorEntry(encoder, entry);
+  }
+  TENSORSTORE_ASSIGN_OR_RETURN(auto encoded_nodes,
+                               encoder.Finalize(/*may_be_root=*/false));
+  children.entries.clear();
+  children.estimated_size = 0;
+  return AddNodes(height, std::move(encoded_nodes));
+}
+
+absl::Status BtreeBulkLoader::AddNodes(BtreeNodeHeight height,
+                                       std::vector<EncodedNode> encoded_nodes) {
+  for (const auto& encoded_node : encoded_nodes) {
+    unflushed_bytes_ += encoded_node.encoded_node.size();
+  }
+  auto new_entries =
+      WriteNodes(*io_handle_, flush_promise_, std::move(encoded_nodes));
+  if (levels_.size() <= height) {
+    levels_.resize(height + 1);
+  }
+  auto& level = levels_[height];
+  for (auto& entry : new_entries) {
+    level.estimated_size += EstimateEntrySize(entry);
+    level.entries.push_back(std::move(entry));
+  }
+  if (!ShouldEncode(level.estimated_size, level.entries.size())) {
+    return absl::OkStatus();
+  }
+  if (height == std::numeric_limits<BtreeNodeHeight>::max()) {
+    return absl::DataLossError("Maximum B+tree height exceeded");
+  }
+  return EncodeInteriorNodes(height + 1);
+}
+
+absl::Status BtreeBulkLoader::MaybeFlush() {
+  if (unflushed_bytes_ < options_.flush_threshold_bytes) {
+    return absl::OkStatus();
+  }
+  unflushed_bytes_ = 0;
+  // Wait for the previous batch, to bound the amount of buffered data.
+  if (!pending_flush_.null()) {
+    TENSORSTORE_RETURN_IF_ERROR(pending_flush_.status());
+  }
+  pending_flush_ = std::move(flush_promise_).future();
+  if (!pending_flush_.null()) {
+    pending_flush_.Force();
+  }
+  return absl::OkStatus();
+}
+
+Result<BtreeGenerationReference> BtreeBulkLoader::Finish() {
+  // Encode the remaining entries at each level, except for the highest level,
+  // whose entries are passed to `WriteRootNode`.  A single leaf node may only
+  // be the root if no leaf nodes have been written previously.
+  TENSORSTORE_RETURN_IF_ERROR(
+      EncodeLeafNodes(/*may_be_root=*/levels_.empty()));
+  for (size_t height = 1; height < levels_.size(); ++height) {
+    TENSORSTORE_RETURN_IF_ERROR(EncodeInteriorNodes(height));
+  }
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto new_generation,
+      WriteRootNode(*io_handle_, flush_promise_, levels_.size() - 1,
+                    std::move(levels_.back().entries)));
+  levels_.clear();
+
+  if (!pending_flush_.null()) {
+    TENSORSTORE_RETURN_IF_ERROR(pending_flush_.status());
+  }
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto new_manifest_with_flush,
+      CreateNewManifest(io_handle_, existing_manifest_, new_generation)
+          .result());
+  auto& [new_manifest, manifest_flush_future] = new_manifest_with_flush;
+  flush_promise_.Link(std::move(manifest_flush_future));
+  auto flush_future = std::move(flush_promise_).future();
+  if (!flush_future.null()) {
+    flush_future.Force();
+    TENSORSTORE_RETURN_IF_ERROR(flush_future.status());
+  }
+
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto update_result,
+      io_handle_->TryUpdateManifest(existing_manifest_, new_manifest,
+                                    absl::Now())
+          .result());
+  if (!update_result.success) {
+    return absl::AbortedError("Manifest was modified concurrently");
+  }
+  return new_manifest->latest_version();
+}
+
+}  // namespace internal_ocdbt
+}  // namespace tensorstore
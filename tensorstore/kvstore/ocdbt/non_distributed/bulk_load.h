@@ -0,0 +1,145 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_KVSTORE_OCDBT_NON_DISTRIBUTED_BULK_LOAD_H_
+#define TENSORSTORE_KVSTORE_OCDBT_NON_DISTRIBUTED_BULK_LOAD_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "tensorstore/kvstore/ocdbt/format/btree.h"
+#include "tensorstore/kvstore/ocdbt/format/btree_node_encoder.h"
+#include "tensorstore/kvstore/ocdbt/format/config.h"
+#include "tensorstore/kvstore/ocdbt/format/manifest.h"
+#include "tensorstore/kvstore/ocdbt/format/version_tree.h"
+#include "tensorstore/kvstore/ocdbt/io_handle.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/result.h"
+
+// This module implements bulk loading of a B+tree from a sorted stream of
+// key/value pairs.
+//
+// In contrast to `BtreeWriter`, which applies mutations top-down and therefore
+// reads and rewrites interior nodes on every commit, the bulk loader builds the
+// tree bottom-up in a single pass:
+//
+// 1. Values that exceed `max_inline_value_bytes` are written to data files as
+//    they are added.
+//
+// 2. Leaf entries are buffered until they fill several nodes, and are then
+//    encoded using `BtreeLeafNodeEncoder`, which splits them into nodes of at
+//    most `max_decoded_node_bytes`.  The entries referencing the new nodes are
+//    buffered at the next level, which is encoded in the same way.
+//
+// 3. Once all entries have been added, the remaining buffered entries at each
+//    level are encoded, the root is written, and a single new manifest is
+//    committed.
+//
+// Memory usage is bounded by the `flush_threshold_bytes` of pending data files
+// and a few nodes' worth of entries per level of the tree.
+
+namespace tensorstore {
+namespace internal_ocdbt {
+
+struct BtreeBulkLoaderOptions {
+  /// Number of bytes of values and nodes that are buffered before the pending
+  /// data files are written.  At most two such batches are outstanding at
+  /// once; `Add` blocks until the earlier batch has been written.
+  size_t flush_threshold_bytes = size_t{64} << 20;
+};
+
+/// Builds the B+tree of an empty database from key/value pairs added in
+/// strictly increasing key order.
+///
+/// The resultant tree is committed as a single new generation by `Finish`.
+/// Nothing is committed if `Finish` is not called or fails; any data files
+/// already written are then unreferenced.
+///
+/// `Make`, `Add` and `Finish` block, and must not be called from the executor
+/// of `io_handle`.
+class BtreeBulkLoader {
+ public:
+  /// Starts a bulk load into the database accessed via `io_handle`, creating
+  /// the manifest if it does not yet exist.
+  ///
+  /// \error `absl::StatusCode::kFailedPrecondition` if the latest version of
+  ///     the database is not empty.
+  static Result<std::unique_ptr<BtreeBulkLoader>> Make(
+      IoHandle::Ptr io_handle, BtreeBulkLoaderOptions options = {});
+
+  /// Adds a key/value pair.
+  ///
+  /// \error `absl::StatusCode::kInvalidArgument` if `key` is not greater than
+  ///     the previously added key, or exceeds the maximum key length.
+  absl::Status Add(std::string_view key, absl::Cord value);
+
+  /// Writes the remaining nodes and commits the new generation.
+  ///
+  /// \error `absl::StatusCode::kAborted` if the manifest was modified
+  ///     concurrently.
+  Result<BtreeGenerationReference> Finish();
+
+ private:
+  struct PendingLeafEntry {
+    std::string key;
+    LeafNodeValueReference value_reference;
+  };
+
+  // Entries referencing the nodes of a given height that have been written,
+  // but not yet added to a parent node.
+  struct PendingLevel {
+    std::vector<InteriorNodeEntryData<std::string>> entries;
+    size_t estimated_size = 0;
+  };
+
+  BtreeBulkLoader(IoHandle::Ptr io_handle,
+                  std::shared_ptr<const Manifest> existing_manifest,
+                  BtreeBulkLoaderOptions options);
+
+  bool ShouldEncode(size_t estimated_size, size_t num_entries) const;
+  absl::Status EncodeLeafNodes(bool may_be_root);
+  absl::Status EncodeInteriorNodes(BtreeNodeHeight height);
+  absl::Status AddNodes(BtreeNodeHeight height,
+                        std::vector<EncodedNode> encoded_nodes);
+  absl::Status MaybeFlush();
+
+  IoHandle::Ptr io_handle_;
+  std::shared_ptr<const Manifest> existing_manifest_;
+  const Config& config_;
+  BtreeBulkLoaderOptions options_;
+
+  std::string last_key_;
+  bool has_last_key_ = false;
+
+  std::vector<PendingLeafEntry> leaf_entries_;
+  size_t leaf_estimated_size_ = 0;
+
+  // Indexed by height.
+  std::vector<PendingLevel> levels_;
+
+  FlushPromise flush_promise_;
+  size_t unflushed_bytes_ = 0;
+  Future<const void> pending_flush_;
+};
+
+}  // namespace internal_ocdbt
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_KVSTORE_OCDBT_NON_DISTRIBUTED_BULK_LOAD_H_
@@ -32,11 +32,13 @@
 #include <limits>
 #include <memory>
 #include <utility>
+#include <variant>
 #include <vector>
 
 #include "absl/base/attributes.h"
 #include "absl/log/absl_log.h"
 #include "absl/status/status.h"
+#include "absl/strings/cord.h"
 #include "absl/strings/str_format.h"
 #include "absl/time/clock.h"
 #include "absl/time/time.h"
@@ -71,6 +73,25 @@ struct CreateNewManifestOperation
 using ManifestWithFlushFuture =
     std::pair<std::shared_ptr<Manifest>, Future<const void>>;
 
+// Writes the zstd dictionary specified by a newly-created `config`, if any, as
+// a separate data file and sets its location in `config`.
+//
+// Returns a null future if there is nothing to write.
+Future<const void> WriteZstdDictionary(const IoHandle& io_handle,
+                                       Config& config) {
+  auto* zstd = std::get_if<Config::ZstdCompression>(&config.compression);
+  if (!zstd || !zstd->dictionary ||
+      !zstd->dictionary->location.IsMissing()) {
+    return {};
+  }
+  // `CreateConfig` ensures the dictionary contents are known.
+  auto* zstd_dictionary = io_handle.config_state->GetZstdDictionary();
+  assert(zstd_dictionary);
+  return io_handle.WriteData(IndirectDataKind::kValue,
+                             absl::Cord(zstd_dictionary->data()),
+                             zstd->dictionary->location);
+}
+
 struct ExistingVersionTreeNodeReady {
   CreateNewManifestOperation::Ptr op_;
   size_t i_;
@@ -107,7 +128,10 @@ struct ExistingVersionTreeNodeReady {
                         existing_children.end());
     new_children.push_back(new_child_ref_);
     TENSORSTORE_ASSIGN_OR_RETURN(
-        auto encoded, EncodeVersionTreeNode(new_manifest_->config, new_node),
+        auto encoded,
+        EncodeVersionTreeNode(
+            new_manifest_->config, new_node,
+            op_->io_handle->config_state->GetZstdDictionary()),
         static_cast<void>(SetDeferredResult(promise, _)));
     new_node_ref.commit_time = new_children.front().commit_time;
     op_->flush_promise.Link(
@@ -152,7 +176,8 @@ CreateNewManifest(IoHandle::Ptr io_handle,
     TENSORSTORE_ASSIGN_OR_RETURN(new_manifest->config,
                                  io_handle->config_state->CreateNewConfig());
     new_manifest->versions.push_back(new_generation);
-    return ManifestWithFlushFuture{new_manifest, {}};
+    return ManifestWithFlushFuture{
+        new_manifest, WriteZstdDictionary(*io_handle, new_manifest->config)};
   }
 
   new_manifest->config = existing_manifest->config;
@@ -214,7 +239,10 @@ CreateNewManifest(IoHandle::Ptr io_handle,
     auto& children = new_node.entries.emplace<VersionTreeNode::LeafNodeEntries>(
         existing_manifest->versions);
     TENSORSTORE_ASSIGN_OR_RETURN(
-        auto encoded, EncodeVersionTreeNode(new_manifest->config, new_node));
+        auto encoded,
+        EncodeVersionTreeNode(
+            new_manifest->config, new_node,
+            op->io_handle->config_state->GetZstdDictionary()));
     new_height0_node_ref.generation_number = children.back().generation_number;
     new_height0_node_ref.num_generations = children.size();
     new_height0_node_ref.commit_time = children.front().commit_time;
@@ -305,7 +333,10 @@ CreateNewManifest(IoHandle::Ptr io_handle,
           new_node.entries.emplace<VersionTreeNode::InteriorNodeEntries>();
       children.push_back(*new_child_ref);
       TENSORSTORE_ASSIGN_OR_RETURN(
-          auto encoded, EncodeVersionTreeNode(new_manifest->config, new_node),
+          auto encoded,
+          EncodeVersionTreeNode(
+              new_manifest->config, new_node,
+              op->io_handle->config_state->GetZstdDictionary()),
           (static_cast<void>(SetDeferredResult(promise, _)), op_value_future));
       new_node_ref.commit_time = new_child_ref->commit_time;
       new_node_ref.generation_number = new_child_ref->generation_number;
@@ -368,17 +399,29 @@ Future<absl::Time> EnsureExistingManifest(IoHandle::Ptr io_handle) {
         ref.generation_number = 1;
         new_manifest->versions.push_back(ref);
 
-        auto update_future = io_handle->TryUpdateManifest(
-            /*old_manifest=*/{}, /*new_manifest=*/std::move(new_manifest),
-            /*time=*/absl::Now());
+        // The dictionary must be persisted before the manifest that
+        // references it.
+        auto write_future =
+            WriteZstdDictionary(*io_handle, new_manifest->config);
+        if (write_future.null()) write_future = MakeReadyFuture();
         LinkValue(
-            [io_handle = std::move(io_handle)](
+            [io_handle = std::move(io_handle),
+             new_manifest = std::move(new_manifest)](
                 Promise<absl::Time> promise,
-                ReadyFuture<TryUpdateManifestResult> future) mutable {
-              auto& result = future.value();
-              promise.SetResult(result.time);
+                ReadyFuture<const void> future) mutable {
+              auto update_future = io_handle->TryUpdateManifest(
+                  /*old_manifest=*/{},
+                  /*new_manifest=*/std::move(new_manifest),
+                  /*time=*/absl::Now());
+              LinkValue(
+                  [](Promise<absl::Time> promise,
+                     ReadyFuture<TryUpdateManifestResult> future) {
+                    auto& result = future.value();
+                    promise.SetResult(result.time);
+                  },
+                  std::move(promise), std::move(update_future));
             },
-            std::move(promise), std::move(update_future));
+            std::move(promise), std::move(write_future));
       },
       std::move(promise), std::move(read_future));
   return std::move(future);
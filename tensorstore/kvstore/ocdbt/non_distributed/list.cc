@@ -17,6 +17,7 @@
 #include <stddef.h>
 
 #include <algorithm>
+#include <deque>
 #include <memory>
 #include <optional>
 #include <string>
@@ -25,10 +26,12 @@
 #include <vector>
 
 #include "absl/base/attributes.h"
+#include "absl/base/thread_annotations.h"
 #include "absl/log/absl_log.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/time/time.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/log/verbose_flag.h"
@@ -65,12 +68,13 @@ using ::tensorstore::kvstore::ListReceiver;
 // 1. Resolve the root b+tree node by reading the manifest.
 //
 // 2. Recursively descend the tree in parallel, reading all nodes that
-//    intersect the key range specified in `list_options`.
+//    intersect the key range specified in `list_options`.  Nodes to read are
+//    queued by height, and at most `max_concurrent_node_reads` are read
+//    concurrently.  The lowest queued nodes are read first, which limits the
+//    number of queued nodes, and keeps the reads of consecutive leaf nodes in
+//    flight while their parent's siblings are still being expanded.
 //
 // 3. Emit matching leaf-node keys to the receiver.
-//
-// TODO(jbms): Currently memory usage is not bounded.  That needs to be
-// addressed, e.g. by limiting the number of in-flight nodes.
 struct ListOperation
     : public internal::FlowSenderOperationState<std::string_view,
                                                 span<const LeafNodeEntry>> {
@@ -82,6 +86,22 @@ struct ListOperation
 
   ReadonlyIoHandle::Ptr io_handle;
   KeyRange range;
+  size_t max_concurrent_node_reads;
+
+  // B+tree node that has not yet been read.
+  struct PendingNodeRead {
+    IndirectDataReference location;
+    std::string inclusive_min_key;
+    KeyLength subtree_common_prefix_length;
+  };
+
+  absl::Mutex mutex;
+
+  size_t num_node_reads_in_flight ABSL_GUARDED_BY(mutex) = 0;
+
+  // Queued node reads, indexed by node height.
+  std::vector<std::deque<PendingNodeRead>> pending_node_reads
+      ABSL_GUARDED_BY(mutex);
 
   // Prepares the asynchronous list operation.
   //
@@ -89,11 +109,15 @@ struct ListOperation
   //   io_handle: I/O handle to use.
   //   range: Key range constraint.
   //   receiver: Receiver of the results.
+  //   max_concurrent_node_reads: Limit on the number of concurrent node reads.
   static Ptr Initialize(ReadonlyIoHandle::Ptr&& io_handle, KeyRange&& range,
-                        BaseReceiver&& receiver) {
+                        BaseReceiver&& receiver,
+                        size_t max_concurrent_node_reads) {
     auto op = internal::MakeIntrusivePtr<ListOperation>(std::move(receiver));
     op->io_handle = std::move(io_handle);
     op->range = std::move(range);
+    op->max_concurrent_node_reads =
+        std::max<size_t>(1, max_concurrent_node_reads);
     return op;
   }
 
@@ -123,18 +147,62 @@ struct ListOperation
                            BtreeNodeHeight node_height,
                            std::string inclusive_min_key,
                            KeyLength subtree_common_prefix_length) {
+    {
+      absl::MutexLock lock(op->mutex);
+      op->QueueNodeRead(node_ref, node_height, std::move(inclusive_min_key),
+                        subtree_common_prefix_length);
+    }
+    StartNodeReads(std::move(op));
+  }
+
+  void QueueNodeRead(const BtreeNodeReference& node_ref,
+                     BtreeNodeHeight node_height,
+                     std::string inclusive_min_key,
+                     KeyLength subtree_common_prefix_length)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex) {
     ABSL_LOG_IF(INFO, ocdbt_logging)
         << "List: node=" << node_ref
         << ", node_height=" << static_cast<int>(node_height)
         << ", subtree_common_prefix_length=" << subtree_common_prefix_length
         << ", inclusive_min_key=" << tensorstore::QuoteString(inclusive_min_key)
-        << ", key_range=" << op->range;
-    auto* op_ptr = op.get();
-    Link(WithExecutor(op_ptr->io_handle->executor,
-                      NodeReadyCallback{std::move(op), node_height,
-                                        std::move(inclusive_min_key),
-                                        subtree_common_prefix_length}),
-         op_ptr->promise, op_ptr->io_handle->GetBtreeNode(node_ref.location));
+        << ", key_range=" << range;
+    if (pending_node_reads.size() <= node_height) {
+      pending_node_reads.resize(node_height + 1);
+    }
+    pending_node_reads[node_height].push_back(
+        PendingNodeRead{node_ref.location, std::move(inclusive_min_key),
+                        subtree_common_prefix_length});
+  }
+
+  // Starts reading queued nodes, up to the concurrency limit.
+  static void StartNodeReads(ListOperation::Ptr op) {
+    std::vector<std::pair<BtreeNodeHeight, PendingNodeRead>> reads;
+    {
+      absl::MutexLock lock(op->mutex);
+      if (op->cancelled()) {
+        op->pending_node_reads.clear();
+        return;
+      }
+      for (size_t height = 0; height < op->pending_node_reads.size() &&
+                              op->num_node_reads_in_flight <
+                                  op->max_concurrent_node_reads;) {
+        auto& queue = op->pending_node_reads[height];
+        if (queue.empty()) {
+          ++height;
+          continue;
+        }
+        reads.emplace_back(height, std::move(queue.front()));
+        queue.pop_front();
+        ++op->num_node_reads_in_flight;
+      }
+    }
+    for (auto& [height, read] : reads) {
+      Link(WithExecutor(op->io_handle->executor,
+                        NodeReadyCallback{op, height,
+                                          std::move(read.inclusive_min_key),
+                                          read.subtree_common_prefix_length}),
+           op->promise, op->io_handle->GetBtreeNode(read.location));
+    }
   }
 
   // Called when a B+tree node lookup completes.
@@ -169,20 +237,26 @@ struct ListOperation
       auto key_range = KeyRange::RemovePrefix(subtree_key_prefix, op->range);
 
       if (node->height > 0) {
-        VisitInteriorNode(std::move(op), *node, subtree_key_prefix, key_range);
+        VisitInteriorNode(*op, *node, subtree_key_prefix, key_range);
       } else {
-        VisitLeafNode(std::move(op), *node, subtree_key_prefix, key_range);
+        VisitLeafNode(*op, *node, subtree_key_prefix, key_range);
       }
+
+      {
+        absl::MutexLock lock(op->mutex);
+        --op->num_node_reads_in_flight;
+      }
+      StartNodeReads(std::move(op));
     }
   };
 
-  // Recursively visits matching children.
-  static void VisitInteriorNode(ListOperation::Ptr op, const BtreeNode& node,
+  // Queues the matching children for reading.
+  static void VisitInteriorNode(ListOperation& op, const BtreeNode& node,
                                 std::string_view subtree_key_prefix,
                                 const KeyRange& key_range) {
     auto& all_entries = std::get<BtreeNode::InteriorNodeEntries>(node.entries);
     auto entries = FindBtreeEntryRange(all_entries, key_range.inclusive_min,
-                                       key_range.exclusive_max);
+                                       key_range.exclusive_max, node.key_heads);
     ABSL_LOG_IF(INFO, ocdbt_logging)
         << "VisitInteriorNode: subtree_key_prefix="
         << tensorstore::QuoteString(subtree_key_prefix)
@@ -193,22 +267,24 @@ struct ListOperation
         << ", num matches=" << entries.size();
     // Note: It is safe to access `all_entries.front()` and `all_entries.back()`
     // because B+tree nodes are guaranteed to have at least one entry.
+    absl::MutexLock lock(op.mutex);
     for (const auto& entry : entries) {
-      VisitSubtree(op, entry.node, node.height - 1,
-                   /*inclusive_min_key=*/
-                   absl::StrCat(subtree_key_prefix, entry.key),
-                   /*subtree_common_prefix_length=*/subtree_key_prefix.size() +
-                       entry.subtree_common_prefix_length);
+      op.QueueNodeRead(entry.node, node.height - 1,
+                       /*inclusive_min_key=*/
+                       absl::StrCat(subtree_key_prefix, entry.key),
+                       /*subtree_common_prefix_length=*/
+                       subtree_key_prefix.size() +
+                           entry.subtree_common_prefix_length);
     }
   }
 
   // Emits matches in the leaf node.
-  static void VisitLeafNode(ListOperation::Ptr op, const BtreeNode& node,
+  static void VisitLeafNode(ListOperation& op, const BtreeNode& node,
                             std::string_view subtree_key_prefix,
                             const KeyRange& key_range) {
     auto& all_entries = std::get<BtreeNode::LeafNodeEntries>(node.entries);
     auto entries = FindBtreeEntryRange(all_entries, key_range.inclusive_min,
-                                       key_range.exclusive_max);
+                                       key_range.exclusive_max, node.key_heads);
     ABSL_LOG_IF(INFO, ocdbt_logging)
         << "VisitLeafNode: subtree_key_prefix="
         << QuoteString(subtree_key_prefix) << ", key_range=" << key_range
@@ -218,7 +294,7 @@ struct ListOperation
     // Note: It is safe to access `all_entries.front()` and `all_entries.back()`
     // because B+tree nodes are guaranteed to have at least one entry.
     if (entries.empty()) return;
-    op->YieldValue(subtree_key_prefix, entries);
+    op.YieldValue(subtree_key_prefix, entries);
   }
 };
 
@@ -264,10 +340,12 @@ struct KeyReceiverAdapter {
 
 void NonDistributedList(ReadonlyIoHandle::Ptr io_handle,
                         std::optional<VersionSpec> version_spec,
-                        kvstore::ListOptions options, ListReceiver&& receiver) {
+                        kvstore::ListOptions options, ListReceiver&& receiver,
+                        size_t max_concurrent_node_reads) {
   auto op = ListOperation::Initialize(
       std::move(io_handle), std::move(options.range),
-      KeyReceiverAdapter{std::move(receiver), options.strip_prefix_length});
+      KeyReceiverAdapter{std::move(receiver), options.strip_prefix_length},
+      max_concurrent_node_reads);
   auto* op_ptr = op.get();
   LinkValue(
       WithExecutor(op_ptr->io_handle->executor,
@@ -303,9 +381,11 @@ void NonDistributedListSubtree(
     BtreeNodeHeight node_height, std::string subtree_key_prefix,
     KeyRange&& key_range,
     AnyFlowReceiver<absl::Status, std::string_view, span<const LeafNodeEntry>>&&
-        receiver) {
-  auto op = ListOperation::Initialize(
-      std::move(io_handle), std::move(key_range), std::move(receiver));
+        receiver,
+    size_t max_concurrent_node_reads) {
+  auto op = ListOperation::Initialize(std::move(io_handle),
+                                      std::move(key_range), std::move(receiver),
+                                      max_concurrent_node_reads);
   const size_t subtree_common_prefix_length = subtree_key_prefix.size();
   ListOperation::VisitSubtree(std::move(op), node_ref, node_height,
                               std::move(subtree_key_prefix),
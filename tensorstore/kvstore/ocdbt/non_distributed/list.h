@@ -15,6 +15,9 @@
 #ifndef TENSORSTORE_KVSTORE_OCDBT_NON_DISTRIBUTED_LIST_H_
 #define TENSORSTORE_KVSTORE_OCDBT_NON_DISTRIBUTED_LIST_H_
 
+#include <stddef.h>
+
+#include <optional>
 #include <string>
 #include <string_view>
 
@@ -30,17 +33,29 @@
 namespace tensorstore {
 namespace internal_ocdbt {
 
-void NonDistributedList(ReadonlyIoHandle::Ptr io_handle,
-                        std::optional<VersionSpec> version_spec,
-                        kvstore::ListOptions options,
-                        kvstore::ListReceiver&& receiver);
+/// Default limit on the number of concurrent B+tree node reads issued by a
+/// single list operation.
+constexpr size_t kDefaultListConcurrency = 256;
+
+/// Lists the keys within `options.range`.
+///
+/// All children of a visited interior node that intersect the range are
+/// queued for reading, and up to `max_concurrent_node_reads` queued nodes are
+/// read concurrently.  Lower nodes, and within a given height, nodes with
+/// smaller keys, are read first, such that the reads of sibling leaf nodes are
+/// pipelined and the number of queued nodes remains bounded.
+void NonDistributedList(
+    ReadonlyIoHandle::Ptr io_handle, std::optional<VersionSpec> version_spec,
+    kvstore::ListOptions options, kvstore::ListReceiver&& receiver,
+    size_t max_concurrent_node_reads = kDefaultListConcurrency);
 
 void NonDistributedListSubtree(
     ReadonlyIoHandle::Ptr io_handle, const BtreeNodeReference& node_ref,
     BtreeNodeHeight node_height, std::string subtree_key_prefix,
     KeyRange&& key_range,
     AnyFlowReceiver<absl::Status, std::string_view, span<const LeafNodeEntry>>&&
-        receiver);
+        receiver,
+    size_t max_concurrent_node_reads = kDefaultListConcurrency);
 
 }  // namespace internal_ocdbt
 }  // namespace tensorstore
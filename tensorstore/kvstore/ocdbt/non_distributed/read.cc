@@ -231,7 +231,7 @@ struct ReadOperation : public internal::AtomicReferenceCount<ReadOperation> {
                                 std::string_view unmatched_key_suffix) {
     auto* entry =
         FindBtreeEntry(std::get<BtreeNode::InteriorNodeEntries>(node.entries),
-                       unmatched_key_suffix);
+                       unmatched_key_suffix, node.key_heads);
     if (!entry) {
       op->KeyNotPresent(promise);
       return;
@@ -264,7 +264,7 @@ struct ReadOperation : public internal::AtomicReferenceCount<ReadOperation> {
                             std::string_view unmatched_key_suffix) {
     auto* entry =
         FindBtreeEntry(std::get<BtreeNode::LeafNodeEntries>(node.entries),
-                       unmatched_key_suffix);
+                       unmatched_key_suffix, node.key_heads);
     if (!entry) {
       op->KeyNotPresent(promise);
       return;
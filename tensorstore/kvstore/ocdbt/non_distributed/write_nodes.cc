@@ -77,8 +77,9 @@ Result<BtreeGenerationReference> WriteRootNode(
     ++height;
     auto* config = io_handle.config_state->GetExistingConfig();
     assert(config);
-    BtreeInteriorNodeEncoder node_encoder(*config, height,
-                                          /*existing_prefix=*/{});
+    BtreeInteriorNodeEncoder node_encoder(
+        *config, height, /*existing_prefix=*/{},
+        io_handle.config_state->GetZstdDictionary());
     for (auto& entry : new_entries) {
       internal_ocdbt::AddNewInteriorEntry(node_encoder, entry);
     }
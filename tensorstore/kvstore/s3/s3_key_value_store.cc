@@ -15,6 +15,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
 #include <memory>
@@ -23,6 +24,7 @@
 #include <string_view>
 #include <utility>
 #include <variant>
+#include <vector>
 
 #include "absl/base/attributes.h"
 #include "absl/log/absl_check.h"
@@ -58,12 +60,14 @@
 #include "tensorstore/internal/thread/schedule_at.h"
 #include "tensorstore/internal/uri/parse.h"
 #include "tensorstore/internal/uri/percent_coder.h"
+#include "tensorstore/kvstore/adaptive_coalescing.h"
 #include "tensorstore/kvstore/batch_util.h"
 #include "tensorstore/kvstore/byte_range.h"
 #include "tensorstore/kvstore/common_metrics.h"
 #include "tensorstore/kvstore/generation.h"
 #include "tensorstore/kvstore/generic_coalescing_batch_util.h"
 #include "tensorstore/kvstore/http/byte_range_util.h"
+#include "tensorstore/kvstore/http/parallel_read_util.h"
 #include "tensorstore/kvstore/key_range.h"
 #include "tensorstore/kvstore/operations.h"
 #include "tensorstore/kvstore/read_result.h"
@@ -158,6 +162,20 @@ static constexpr char kEmptySha256[] =
 
 static constexpr size_t kMaxS3PutSize = size_t{5} * 1024 * 1024 * 1024;  // 5GB
 
+// https://docs.aws.amazon.com/AmazonS3/latest/userguide/qfacts.html
+static constexpr size_t kMaxS3MultipartUploadSize =
+    size_t{5} * 1024 * 1024 * 1024 * 1024;  // 5TB
+static constexpr size_t kMaxS3MultipartUploadParts = 10000;
+// All parts other than the last must be at least this size.
+static constexpr size_t kMinS3MultipartUploadPartSize =
+    size_t{5} * 1024 * 1024;  // 5MB
+
+// Values larger than this are written using a multipart upload by default.
+static constexpr size_t kDefaultMultipartUploadThreshold =
+    size_t{64} * 1024 * 1024;
+static constexpr size_t kDefaultMultipartUploadPartSize =
+    size_t{16} * 1024 * 1024;
+
 // Adds the generation header to the provided builder.
 bool AddGenerationHeader(S3RequestBuilder* builder, std::string_view header,
                          const StorageGeneration& gen) {
@@ -211,6 +229,9 @@ struct S3KeyValueStoreSpecData {
   std::optional<std::string> host_header;
   std::string aws_region;
   std::optional<bool> use_conditional_write;
+  std::optional<uint64_t> multipart_upload_threshold;
+  std::optional<uint64_t> multipart_upload_part_size;
+  std::optional<uint64_t> parallel_read_part_size;
 
   Context::Resource<AwsCredentialsResource> aws_credentials;
   Context::Resource<S3ConcurrencyResource> request_concurrency;
@@ -220,7 +241,9 @@ struct S3KeyValueStoreSpecData {
 
   constexpr static auto ApplyMembers = [](auto& x, auto f) {
     return f(x.bucket, x.requester_pays, x.endpoint, x.host_header,
-             x.aws_region, x.use_conditional_write, x.aws_credentials,
+             x.aws_region, x.use_conditional_write,
+             x.multipart_upload_threshold, x.multipart_upload_part_size,
+             x.parallel_read_part_size, x.aws_credentials,
              x.request_concurrency, x.rate_limiter, x.retries,
              x.data_copy_concurrency);
   };
@@ -242,6 +265,16 @@ struct S3KeyValueStoreSpecData {
                 "\"endpoint\"");
           }
         }
+        if (x->multipart_upload_part_size &&
+            *x->multipart_upload_part_size < kMinS3MultipartUploadPartSize) {
+          return absl::InvalidArgumentError(absl::StrFormat(
+              "\"multipart_upload_part_size\" must be at least %d",
+              kMinS3MultipartUploadPartSize));
+        }
+        if (x->parallel_read_part_size && *x->parallel_read_part_size == 0) {
+          return absl::InvalidArgumentError(
+              "\"parallel_read_part_size\" must be positive");
+        }
         return absl::OkStatus();
       },
       jb::Object(
@@ -260,6 +293,17 @@ struct S3KeyValueStoreSpecData {
           jb::Member("use_conditional_write",
                      jb::Projection<
                          &S3KeyValueStoreSpecData::use_conditional_write>()),
+          jb::Member(
+              "multipart_upload_threshold",
+              jb::Projection<
+                  &S3KeyValueStoreSpecData::multipart_upload_threshold>()),
+          jb::Member(
+              "multipart_upload_part_size",
+              jb::Projection<
+                  &S3KeyValueStoreSpecData::multipart_upload_part_size>()),
+          jb::Member("parallel_read_part_size",
+                     jb::Projection<
+                         &S3KeyValueStoreSpecData::parallel_read_part_size>()),
           jb::Member(
               AwsCredentialsResource::id,
               jb::Projection<&S3KeyValueStoreSpecData::aws_credentials>()),
@@ -312,15 +356,15 @@ class S3KeyValueStore
 
   internal_kvstore_batch::CoalescingOptions GetBatchReadCoalescingOptions()
       const {
-    internal_kvstore_batch::CoalescingOptions options;
-    options.max_extra_read_bytes = 4095;
-    options.target_coalesced_size = 128 * 1024 * 1024;
-    return options;
+    return coalescing_policy_.GetCoalescingOptions();
   }
 
   Future<ReadResult> Read(Key key, ReadOptions options) override;
 
-  Future<ReadResult> ReadImpl(Key&& key, ReadOptions&& options);
+  /// Reads `key`.  If `allow_parallel_read` is `false`, the read is issued as
+  /// a single request even if it exceeds the parallel read part size.
+  Future<ReadResult> ReadImpl(Key&& key, ReadOptions&& options,
+                              bool allow_parallel_read = true);
 
   Future<TimestampedStorageGeneration> Write(Key key,
                                              std::optional<Value> value,
@@ -354,6 +398,28 @@ class S3KeyValueStore
 
   RateLimiter& admission_queue() { return *spec_.request_concurrency->queue; }
 
+  // Returns whether a value of `size` bytes is written using a multipart
+  // upload rather than a single PUT.
+  bool UseMultipartUpload(size_t size) const {
+    return size > std::min<uint64_t>(spec_.multipart_upload_threshold.value_or(
+                                         kDefaultMultipartUploadThreshold),
+                                     kMaxS3PutSize);
+  }
+
+  // Returns the part size used for a multipart upload of `size` bytes.
+  size_t GetMultipartUploadPartSize(size_t size) const {
+    size_t part_size = spec_.multipart_upload_part_size.value_or(
+        kDefaultMultipartUploadPartSize);
+    return std::max(part_size, (size + kMaxS3MultipartUploadParts - 1) /
+                                   kMaxS3MultipartUploadParts);
+  }
+
+  // Returns the part size used to split large reads, or 0 if reads are not
+  // split.
+  int64_t GetParallelReadPartSize() const {
+    return static_cast<int64_t>(spec_.parallel_read_part_size.value_or(0));
+  }
+
   Future<AwsCredentials> GetCredentials() {
     return GetAwsCredentials(provider_.get());
   }
@@ -386,6 +452,8 @@ class S3KeyValueStore
   }
 
   internal::NoRateLimiter no_rate_limiter_;
+  internal_kvstore_batch::AdaptiveCoalescingPolicy coalescing_policy_{
+      internal_kvstore_batch::RemoteStorageAdaptiveCoalescingOptions("s3")};
   std::shared_ptr<HttpTransport> transport_;
   S3KeyValueStoreSpecData spec_;
   std::string host_header_;
@@ -407,6 +475,11 @@ struct ReadTask : public RateLimiterNode,
   ReadyFuture<const S3EndpointRegion> endpoint_region_;
   Promise<kvstore::ReadResult> promise;
 
+  // Byte range of the first part when the read is split into parallel
+  // ranged requests.
+  std::optional<OptionalByteRangeRequest> first_part_;
+  int64_t total_size_ = -1;
+
   int attempt_ = 0;
   absl::Time start_time_;
 
@@ -414,14 +487,19 @@ struct ReadTask : public RateLimiterNode,
            kvstore::ReadOptions options, std::string read_url,
            AwsCredentials credentials,
            ReadyFuture<const S3EndpointRegion> endpoint_region,
-           Promise<kvstore::ReadResult> promise)
+           Promise<kvstore::ReadResult> promise, bool allow_parallel_read)
       : owner(std::move(owner)),
         object_name(std::move(object_name)),
         options(std::move(options)),
         read_url_(std::move(read_url)),
         credentials_(std::move(credentials)),
         endpoint_region_(std::move(endpoint_region)),
-        promise(std::move(promise)) {}
+        promise(std::move(promise)) {
+    if (allow_parallel_read) {
+      first_part_ = internal_http::GetParallelReadFirstPart(
+          this->options.byte_range, this->owner->GetParallelReadPartSize());
+    }
+  }
 
   ~ReadTask() { owner->admission_queue().Finish(this); }
 
@@ -451,7 +529,9 @@ struct ReadTask : public RateLimiterNode,
     AddGenerationHeader(&request_builder, "if-match",
                         options.generation_conditions.if_equal);
 
-    if (options.byte_range.size() != 0) {
+    if (first_part_) {
+      request_builder.MaybeAddRangeHeader(*first_part_);
+    } else if (options.byte_range.size() != 0) {
       request_builder.MaybeAddRangeHeader(options.byte_range);
       if (options.byte_range.IsFull()) {
         // Checksum validation is only supported when reading the entire object,
@@ -482,6 +562,14 @@ struct ReadTask : public RateLimiterNode,
     ABSL_LOG_IF(INFO, s3_logging.Level(1) && response.ok())
         << "ReadTask " << *response;
 
+    if (first_part_ && response.ok() && response->status_code == 416) {
+      // The first part starts at or beyond the end of the value; issue the
+      // original read, which returns either an empty value or an error.
+      first_part_ = std::nullopt;
+      Retry();
+      return;
+    }
+
     bool is_retryable = false;
     absl::Status status = [&]() -> absl::Status {
       if (!response.ok()) {
@@ -507,15 +595,34 @@ struct ReadTask : public RateLimiterNode,
     }
     if (!status.ok()) {
       promise.SetResult(status);
-    } else {
-      promise.SetResult(FinishResponse(response.value()));
+      return;
     }
+    auto read_result = FinishResponse(response.value());
+    if (!first_part_ || !read_result.ok() || !read_result->has_value()) {
+      promise.SetResult(std::move(read_result));
+      return;
+    }
+    // Read the remaining parts concurrently.  Parts, and the retry of the whole
+    // read if the value changes meanwhile, are issued as single requests.
+    internal_http::ReadRemainingParts(
+        *std::move(read_result), std::move(options), total_size_,
+        owner->GetParallelReadPartSize(),
+        [owner = owner, key = object_name](kvstore::ReadOptions part_options) {
+          return owner->ReadImpl(std::string(key), std::move(part_options),
+                                 /*allow_parallel_read=*/false);
+        },
+        std::move(promise));
   }
 
   Result<kvstore::ReadResult> FinishResponse(const HttpResponse& httpresponse) {
     s3_metrics.bytes_read.IncrementBy(httpresponse.payload.size());
     auto latency = absl::Now() - start_time_;
     s3_metrics.read_latency_ms.Observe(absl::ToInt64Milliseconds(latency));
+    if (options.byte_range.size() != 0 && (httpresponse.status_code == 200 ||
+                                           httpresponse.status_code == 206)) {
+      owner->coalescing_policy_.RecordRequest(httpresponse.payload.size(),
+                                              latency);
+    }
 
     switch (httpresponse.status_code) {
       case 204:
@@ -555,7 +662,11 @@ struct ReadTask : public RateLimiterNode,
     }
 
     absl::Cord value;
-    if (options.byte_range.size() != 0) {
+    if (first_part_) {
+      TENSORSTORE_RETURN_IF_ERROR(
+          internal_http::ValidateParallelReadFirstPartResponse(
+              httpresponse, *first_part_, value, total_size_));
+    } else if (options.byte_range.size() != 0) {
       // Currently unused
       ByteRange byte_range;
       int64_t total_size;
@@ -587,22 +698,22 @@ Future<kvstore::ReadResult> S3KeyValueStore::Read(Key key,
       *this, std::move(key), std::move(options));
 }
 
-Future<kvstore::ReadResult> S3KeyValueStore::ReadImpl(Key&& key,
-                                                      ReadOptions&& options) {
+Future<kvstore::ReadResult> S3KeyValueStore::ReadImpl(
+    Key&& key, ReadOptions&& options, bool allow_parallel_read) {
   s3_metrics.batch_read.Increment();
   auto op = PromiseFuturePair<ReadResult>::Make();
 
   LinkValue(
       [self = IntrusivePtr<S3KeyValueStore>(this), key = std::move(key),
-       options = std::move(options)](auto promise,
-                                     ReadyFuture<const S3EndpointRegion> ready,
-                                     ReadyFuture<AwsCredentials> credentials) {
+       options = std::move(options), allow_parallel_read](
+          auto promise, ReadyFuture<const S3EndpointRegion> ready,
+          ReadyFuture<AwsCredentials> credentials) {
         auto read_url = absl::StrCat(ready.value().endpoint, "/", key);
 
         auto state = internal::MakeIntrusivePtr<ReadTask>(
             std::move(self), std::move(key), std::move(options),
             std::move(read_url), std::move(credentials.value()),
-            std::move(ready), std::move(promise));
+            std::move(ready), std::move(promise), allow_parallel_read);
         intrusive_ptr_increment(state.get());  // adopted by ReadTask::Start.
         state->owner->read_rate_limiter().Admit(state.get(), &ReadTask::Start);
       },
@@ -611,6 +722,443 @@ Future<kvstore::ReadResult> S3KeyValueStore::ReadImpl(Key&& key,
   return std::move(op.future);
 }
 
+// MultipartUploadTask writes a value using a multipart upload, which is used
+// by WriteTask for values larger than the configured threshold.
+// https://docs.aws.amazon.com/AmazonS3/latest/userguide/mpuoverview.html
+//
+// The upload is initiated with CreateMultipartUpload, the parts are then
+// uploaded concurrently by UploadPartTask (each of which is independently
+// admitted and retried), and the object is finally assembled with
+// CompleteMultipartUpload, which carries any generation conditions. On
+// failure or cancellation, the upload is aborted on a best-effort basis.
+struct MultipartUploadTask
+    : public internal::AtomicReferenceCount<MultipartUploadTask> {
+  IntrusivePtr<S3KeyValueStore> owner;
+  kvstore::WriteOptions options_;
+  ReadyFuture<const S3EndpointRegion> endpoint_region_;
+  std::string object_url_;
+  absl::Cord value_;
+  AwsCredentials credentials_;
+  Promise<TimestampedStorageGeneration> promise;
+  size_t part_size_;
+  int attempt_ = 0;
+  absl::Time start_time_;
+
+  // Set once the upload has been initiated.
+  std::string upload_id_;
+  // ETag of each uploaded part.
+  std::vector<std::string> part_etags_;
+  std::atomic<size_t> remaining_parts_{0};
+  std::atomic<bool> aborted_{false};
+
+  MultipartUploadTask(IntrusivePtr<S3KeyValueStore> o,
+                      kvstore::WriteOptions options,
+                      ReadyFuture<const S3EndpointRegion> endpoint_region,
+                      std::string object_url, absl::Cord value,
+                      AwsCredentials credentials,
+                      Promise<TimestampedStorageGeneration> promise)
+      : owner(std::move(o)),
+        options_(std::move(options)),
+        endpoint_region_(std::move(endpoint_region)),
+        object_url_(std::move(object_url)),
+        value_(std::move(value)),
+        credentials_(std::move(credentials)),
+        promise(std::move(promise)),
+        part_size_(owner->GetMultipartUploadPartSize(value_.size())) {}
+
+  size_t num_parts() const {
+    return (value_.size() + part_size_ - 1) / part_size_;
+  }
+
+  bool IsCancelled() { return !promise.result_needed(); }
+  void Fail(absl::Status status) {
+    ABSL_LOG_IF(INFO, s3_logging.Level(2))
+        << "MultipartUploadTask Fail " << status;
+    promise.SetResult(std::move(status));
+    MaybeAbort();
+  }
+
+  void Success(StorageGeneration g) {
+    ABSL_LOG_IF(INFO, s3_logging.Level(1))
+        << "MultipartUploadTask Success " << g;
+    promise.SetResult(std::in_place, std::move(g), start_time_);
+  }
+
+  // Invoked by BackoffForAttemptAsync; re-issues the pending
+  // CreateMultipartUpload or CompleteMultipartUpload request.
+  void Retry() {
+    if (IsCancelled()) {
+      MaybeAbort();
+      return;
+    }
+    if (upload_id_.empty()) {
+      Initiate();
+    } else {
+      Complete();
+    }
+  }
+
+  // https://docs.aws.amazon.com/AmazonS3/latest/API/API_CreateMultipartUpload.html
+  void Initiate() {
+    start_time_ = absl::Now();
+    const auto& ehr = endpoint_region_.value();
+    auto request =
+        S3RequestBuilder("POST", object_url_)
+            .AddQueryParameter("uploads", "")
+            .AddHeader("content-type", "application/octet-stream")
+            .MaybeAddRequesterPayer(owner->spec_.requester_pays)
+            .BuildRequest(owner->host_header_, credentials_, ehr.aws_region,
+                          kEmptySha256, start_time_);
+
+    ABSL_LOG_IF(INFO, s3_logging) << "MultipartUploadTask: " << request;
+
+    auto future = owner->transport_->IssueRequest(request, {});
+    future.ExecuteWhenReady([self = IntrusivePtr<MultipartUploadTask>(this)](
+                                ReadyFuture<HttpResponse> response) {
+      self->OnInitiateResponse(response.result());
+    });
+  }
+
+  void OnInitiateResponse(const Result<HttpResponse>& response) {
+    ABSL_LOG_IF(INFO, s3_logging.Level(1) && response.ok())
+        << "MultipartUploadTask (Initiate) " << *response;
+
+    bool is_retryable = DefaultIsRetryableCode(response.status().code());
+    absl::Status status =
+        response.ok() ? AwsHttpResponseToStatus(response.value(), is_retryable)
+                      : response.status();
+    if (!status.ok()) {
+      if (IsCancelled()) {
+        return;
+      }
+      if (is_retryable &&
+          owner->BackoffForAttemptAsync(status, attempt_++, this).ok()) {
+        return;
+      }
+      Fail(std::move(status));
+      return;
+    }
+
+    auto cord = response->payload;
+    auto payload = cord.Flatten();
+    tinyxml2::XMLDocument xmlDocument;
+    if (int xmlcode = xmlDocument.Parse(payload.data(), payload.size());
+        xmlcode != tinyxml2::XML_SUCCESS) {
+      Fail(absl::InvalidArgumentError(absl::StrCat(
+          "Malformed CreateMultipartUpload response: ", xmlcode)));
+      return;
+    }
+    auto* root = xmlDocument.FirstChildElement("InitiateMultipartUploadResult");
+    std::string upload_id =
+        root ? GetNodeText(root->FirstChildElement("UploadId")) : "";
+    if (upload_id.empty()) {
+      Fail(absl::InvalidArgumentError(
+          "Malformed CreateMultipartUpload response: missing <UploadId>"));
+      return;
+    }
+    upload_id_ = std::move(upload_id);
+    if (IsCancelled()) {
+      // The upload was initiated, so it must be aborted.
+      MaybeAbort();
+      return;
+    }
+    attempt_ = 0;
+    StartParts();
+  }
+
+  // Issues an UploadPartTask for each part; defined below UploadPartTask.
+  void StartParts();
+
+  // Invoked by UploadPartTask when a part has been uploaded.
+  void OnPartUploaded(size_t part_index, std::string etag) {
+    part_etags_[part_index] = std::move(etag);
+    if (remaining_parts_.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+      return;
+    }
+    if (IsCancelled()) {
+      MaybeAbort();
+      return;
+    }
+    Complete();
+  }
+
+  // https://docs.aws.amazon.com/AmazonS3/latest/API/API_CompleteMultipartUpload.html
+  void Complete() {
+    absl::Cord body;
+    body.Append(
+        "<CompleteMultipartUpload "
+        "xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">");
+    for (size_t i = 0; i < part_etags_.size(); ++i) {
+      body.Append(absl::StrCat("<Part><ETag>", part_etags_[i],
+                               "</ETag><PartNumber>", i + 1,
+                               "</PartNumber></Part>"));
+    }
+    body.Append("</CompleteMultipartUpload>");
+
+    const auto& ehr = endpoint_region_.value();
+    auto builder = S3RequestBuilder("POST", object_url_);
+    builder.AddQueryParameter("uploadId", upload_id_)
+        .AddHeader("content-type", "application/xml")
+        .AddHeader("content-length", absl::StrCat(body.size()))
+        .MaybeAddRequesterPayer(owner->spec_.requester_pays);
+    if (owner->spec_.use_conditional_write.value_or(
+            ehr.write_mode != ConditionalWriteMode::kDisabled) &&
+        !StorageGeneration::IsUnknown(
+            options_.generation_conditions.if_equal)) {
+      if (StorageGeneration::IsNoValue(
+              options_.generation_conditions.if_equal)) {
+        builder.AddHeader("if-none-match", "*");
+      } else {
+        AddGenerationHeader(&builder, "if-match",
+                            options_.generation_conditions.if_equal);
+      }
+    }
+    auto request =
+        builder.BuildRequest(owner->host_header_, credentials_, ehr.aws_region,
+                             PayloadSha256Hex(body), absl::Now());
+
+    ABSL_LOG_IF(INFO, s3_logging) << "MultipartUploadTask: " << request;
+
+    auto future = owner->transport_->IssueRequest(
+        request, internal_http::IssueRequestOptions(std::move(body)));
+    future.ExecuteWhenReady([self = IntrusivePtr<MultipartUploadTask>(this)](
+                                ReadyFuture<HttpResponse> response) {
+      self->OnCompleteResponse(response.result());
+    });
+  }
+
+  void OnCompleteResponse(const Result<HttpResponse>& response) {
+    if (IsCancelled()) {
+      MaybeAbort();
+      return;
+    }
+    ABSL_LOG_IF(INFO, s3_logging.Level(1) && response.ok())
+        << "MultipartUploadTask (Complete) " << *response;
+
+    if (!response.ok()) {
+      if (DefaultIsRetryableCode(response.status().code()) &&
+          owner->BackoffForAttemptAsync(response.status(), attempt_++, this)
+              .ok()) {
+        return;
+      }
+      Fail(response.status());
+      return;
+    }
+
+    auto latency = absl::Now() - start_time_;
+    bool is_retryable = false;
+    auto status = AwsHttpResponseToStatus(response.value(), is_retryable);
+    if (response.value().status_code == 409) {
+      // Conflict implies that there was a conflict in the concurrent operation.
+      if (owner->BackoffForAttemptAsync(status, attempt_++, this).ok()) {
+        return;
+      }
+      Fail(std::move(status));
+      return;
+    } else if (response.value().status_code == 304 ||
+               response.value().status_code == 412) {
+      // The generation did not match; the uploaded parts are discarded.
+      Success(StorageGeneration::Unknown());
+      MaybeAbort();
+      return;
+    } else if (response.value().status_code == 404 &&
+               !StorageGeneration::IsUnknown(
+                   options_.generation_conditions.if_equal) &&
+               GetAwsErrorCode(response.value()) != "NoSuchUpload") {
+      // The object does not exist, so the if-match condition failed.  A
+      // NoSuchUpload error instead indicates that the upload itself is gone,
+      // and is reported as a failure below.
+      Success(StorageGeneration::Unknown());
+      MaybeAbort();
+      return;
+    } else if (!status.ok()) {
+      if (is_retryable &&
+          owner->BackoffForAttemptAsync(status, attempt_++, this).ok()) {
+        return;
+      }
+      Fail(std::move(status));
+      return;
+    }
+
+    // CompleteMultipartUpload may fail after returning a 200 response, in
+    // which case the body contains an <Error> element and the request should
+    // be retried.
+    auto cord = response->payload;
+    auto payload = cord.Flatten();
+    tinyxml2::XMLDocument xmlDocument;
+    if (int xmlcode = xmlDocument.Parse(payload.data(), payload.size());
+        xmlcode != tinyxml2::XML_SUCCESS) {
+      Fail(absl::InvalidArgumentError(absl::StrCat(
+          "Malformed CompleteMultipartUpload response: ", xmlcode)));
+      return;
+    }
+    auto* root =
+        xmlDocument.FirstChildElement("CompleteMultipartUploadResult");
+    if (root == nullptr) {
+      auto* error = xmlDocument.FirstChildElement("Error");
+      status = absl::UnavailableError(absl::StrCat(
+          "CompleteMultipartUpload failed: ",
+          error ? GetNodeText(error->FirstChildElement("Code")) : ""));
+      if (owner->BackoffForAttemptAsync(status, attempt_++, this).ok()) {
+        return;
+      }
+      Fail(std::move(status));
+      return;
+    }
+
+    auto etag = GetNodeText(root->FirstChildElement("ETag"));
+    if (etag.empty()) {
+      auto generation = StorageGenerationFromHeaders(response.value().headers);
+      if (!generation.ok()) {
+        Fail(std::move(generation).status());
+        return;
+      }
+      Success(std::move(generation).value());
+    } else {
+      Success(StorageGeneration::FromString(etag));
+    }
+    s3_metrics.write_latency_ms.Observe(absl::ToInt64Milliseconds(latency));
+  }
+
+  // Aborts the upload, at most once, so that the uploaded parts are
+  // discarded.  Failures are ignored; a bucket lifecycle rule is required to
+  // clean up uploads which cannot be aborted.
+  // https://docs.aws.amazon.com/AmazonS3/latest/API/API_AbortMultipartUpload.html
+  void MaybeAbort() {
+    if (upload_id_.empty() || aborted_.exchange(true)) {
+      return;
+    }
+    const auto& ehr = endpoint_region_.value();
+    auto request =
+        S3RequestBuilder("DELETE", object_url_)
+            .AddQueryParameter("uploadId", upload_id_)
+            .MaybeAddRequesterPayer(owner->spec_.requester_pays)
+            .BuildRequest(owner->host_header_, credentials_, ehr.aws_region,
+                          kEmptySha256, absl::Now());
+
+    ABSL_LOG_IF(INFO, s3_logging) << "MultipartUploadTask: " << request;
+
+    owner->transport_->IssueRequest(request, {}).ExecuteWhenReady(
+        [self = IntrusivePtr<MultipartUploadTask>(this)](
+            ReadyFuture<HttpResponse> response) {
+          ABSL_LOG_IF(INFO, s3_logging.Level(1) && response.result().ok())
+              << "MultipartUploadTask (Abort) " << response.value();
+        });
+  }
+};
+
+// UploadPartTask uploads a single part of a MultipartUploadTask.
+// https://docs.aws.amazon.com/AmazonS3/latest/API/API_UploadPart.html
+struct UploadPartTask : public RateLimiterNode,
+                        public internal::AtomicReferenceCount<UploadPartTask> {
+  IntrusivePtr<MultipartUploadTask> upload;
+  size_t part_index_;
+  absl::Cord value_;
+  int attempt_ = 0;
+  absl::Time start_time_;
+
+  UploadPartTask(IntrusivePtr<MultipartUploadTask> upload, size_t part_index,
+                 absl::Cord value)
+      : upload(std::move(upload)),
+        part_index_(part_index),
+        value_(std::move(value)) {}
+
+  ~UploadPartTask() { upload->owner->admission_queue().Finish(this); }
+
+  static void Start(RateLimiterNode* task) {
+    auto* self = static_cast<UploadPartTask*>(task);
+    self->upload->owner->write_rate_limiter().Finish(self);
+    self->upload->owner->admission_queue().Admit(self, &UploadPartTask::Admit);
+  }
+
+  static void Admit(RateLimiterNode* task) {
+    auto* self = static_cast<UploadPartTask*>(task);
+    self->upload->owner->executor()(
+        [state =
+             IntrusivePtr<UploadPartTask>(self, internal::adopt_object_ref)] {
+          state->Retry();
+        });
+  }
+
+  bool IsCancelled() {
+    return upload->IsCancelled() ||
+           upload->aborted_.load(std::memory_order_relaxed);
+  }
+
+  void Retry() {
+    if (IsCancelled()) {
+      upload->MaybeAbort();
+      return;
+    }
+    start_time_ = absl::Now();
+    const auto& ehr = upload->endpoint_region_.value();
+    auto request =
+        S3RequestBuilder("PUT", upload->object_url_)
+            .AddQueryParameter("partNumber", absl::StrCat(part_index_ + 1))
+            .AddQueryParameter("uploadId", upload->upload_id_)
+            .AddHeader("content-length", absl::StrCat(value_.size()))
+            .MaybeAddRequesterPayer(upload->owner->spec_.requester_pays)
+            .BuildRequest(upload->owner->host_header_, upload->credentials_,
+                          ehr.aws_region, PayloadSha256Hex(value_),
+                          start_time_);
+
+    ABSL_LOG_IF(INFO, s3_logging)
+        << "UploadPartTask: " << request << " size=" << value_.size();
+
+    auto future = upload->owner->transport_->IssueRequest(
+        request, internal_http::IssueRequestOptions(value_));
+    future.ExecuteWhenReady([self = IntrusivePtr<UploadPartTask>(this)](
+                                ReadyFuture<HttpResponse> response) {
+      self->OnResponse(response.result());
+    });
+  }
+
+  void OnResponse(const Result<HttpResponse>& response) {
+    if (IsCancelled()) {
+      upload->MaybeAbort();
+      return;
+    }
+    ABSL_LOG_IF(INFO, s3_logging.Level(1) && response.ok())
+        << "UploadPartTask " << *response;
+
+    auto& owner = upload->owner;
+    bool is_retryable = DefaultIsRetryableCode(response.status().code());
+    absl::Status status =
+        response.ok() ? AwsHttpResponseToStatus(response.value(), is_retryable)
+                      : response.status();
+    if (!status.ok()) {
+      if (is_retryable &&
+          owner->BackoffForAttemptAsync(status, attempt_++, this).ok()) {
+        return;
+      }
+      upload->Fail(std::move(status));
+      return;
+    }
+    auto it = response.value().headers.find("etag");
+    if (it == response.value().headers.end()) {
+      upload->Fail(
+          absl::NotFoundError("etag not found in UploadPart response headers"));
+      return;
+    }
+    s3_metrics.bytes_written.IncrementBy(value_.size());
+    upload->OnPartUploaded(part_index_, it->second);
+  }
+};
+
+void MultipartUploadTask::StartParts() {
+  const size_t n = num_parts();
+  part_etags_.resize(n);
+  remaining_parts_.store(n, std::memory_order_relaxed);
+  for (size_t i = 0; i < n; ++i) {
+    size_t offset = i * part_size_;
+    auto part = internal::MakeIntrusivePtr<UploadPartTask>(
+        IntrusivePtr<MultipartUploadTask>(this), i,
+        value_.Subcord(offset, std::min(part_size_, value_.size() - offset)));
+    intrusive_ptr_increment(part.get());  // adopted by UploadPartTask::Start.
+    owner->write_rate_limiter().Admit(part.get(), &UploadPartTask::Start);
+  }
+}
+
 // WriteTask is a function object used to satisfy S3KeyValueStore::Write.
 // https://docs.aws.amazon.com/AmazonS3/latest/API/API_PutObject.html
 //
@@ -734,6 +1282,17 @@ struct WriteTask : public RateLimiterNode,
   }
 
   void AfterHeadRequest() {
+    if (owner->UseMultipartUpload(value_.size())) {
+      // Hand off to a multipart upload; this releases the admission slot held
+      // by this task so that the parts may be admitted.
+      auto upload = internal::MakeIntrusivePtr<MultipartUploadTask>(
+          owner, std::move(options_), std::move(endpoint_region_),
+          std::move(object_url_), std::move(value_), std::move(credentials_),
+          std::move(promise));
+      upload->Initiate();
+      return;
+    }
+
     // NOTE: This was changed from POST to PUT as a basic POST does not work
     // Some more headers need to be added to allow POST to work:
     // https://docs.aws.amazon.com/AmazonS3/latest/API/sigv4-authentication-HTTPPOST.html
@@ -1030,12 +1589,10 @@ Future<TimestampedStorageGeneration> S3KeyValueStore::Write(
   if (!IsValidStorageGeneration(options.generation_conditions.if_equal)) {
     return absl::InvalidArgumentError("Malformed StorageGeneration");
   }
-  if (value && value->size() > kMaxS3PutSize) {
-    // TODO: Support multi-part uploads of files larger than 5GB.
-    // Generally, aws-cli splits uploads which exceed ~8MB into multiple
-    // parts.
-    return absl::InvalidArgumentError(absl::StrFormat(
-        "Object size %d exceeds S3 limit of %d", value->size(), kMaxS3PutSize));
+  if (value && value->size() > kMaxS3MultipartUploadSize) {
+    return absl::InvalidArgumentError(
+        absl::StrFormat("Object size %d exceeds S3 limit of %d", value->size(),
+                        kMaxS3MultipartUploadSize));
   }
 
   auto op = PromiseFuturePair<TimestampedStorageGeneration>::Make();
@@ -1067,6 +1624,13 @@ Future<TimestampedStorageGeneration> S3KeyValueStore::Write(
             std::move(credentials.value()), std::move(promise));
 
         intrusive_ptr_increment(state.get());  // adopted by WriteTask::Admit.
+        if (state->owner->UseMultipartUpload(state->value_.size())) {
+          // Each part of a multipart upload is admitted by the write rate
+          // limiter, so the value as a whole is not.
+          state->owner->admission_queue().Admit(state.get(),
+                                                &WriteTask::Admit);
+          return;
+        }
         state->owner->write_rate_limiter().Admit(state.get(),
                                                  &WriteTask::Start);
       },
@@ -20,6 +20,7 @@
 #include "absl/status/status.h"
 #include "absl/strings/cord.h"
 #include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
 #include "tensorstore/context.h"
 #include "tensorstore/internal/http/default_transport.h"
 #include "tensorstore/internal/http/http_header.h"
@@ -378,6 +379,154 @@ TEST(S3KeyValueStoreTest, MockWrite_Conflict) {
 }
 
 // TODO: Add tests for various responses
+TEST(S3KeyValueStoreTest, SimpleMock_MultipartWrite) {
+  constexpr size_t kPartSize = 5 * 1024 * 1024;
+  constexpr char kObjectUrl[] =
+      "https://s3.us-east-1.amazonaws.com/my.bucket/key_write";
+  auto mock_transport = std::make_shared<DefaultMockHttpTransport>(
+      DefaultMockHttpTransport::Responses{
+          // initial HEAD request responds with an x-amz-bucket-region header.
+          {"HEAD https://s3.amazonaws.com/my.bucket",
+           HttpResponse{200, absl::Cord(),
+                        HeaderMap{{"x-amz-bucket-region", "us-east-1"}}}},
+
+          {absl::StrCat("POST ", kObjectUrl, "?uploads"),
+           HttpResponse{200, absl::Cord(R"(<?xml version="1.0" encoding="UTF-8"?>
+<InitiateMultipartUploadResult>
+  <Bucket>my.bucket</Bucket>
+  <Key>key_write</Key>
+  <UploadId>upload1</UploadId>
+</InitiateMultipartUploadResult>)"),
+                        {}}},
+
+          // The second part is retried once.
+          {absl::StrCat("PUT ", kObjectUrl, "?partNumber=2&uploadId=upload1"),
+           HttpResponse{503, absl::Cord(), {}}},
+
+          {absl::StrCat("PUT ", kObjectUrl, "?partNumber=1&uploadId=upload1"),
+           HttpResponse{200, absl::Cord(), HeaderMap{{"etag", "\"part1\""}}}},
+          {absl::StrCat("PUT ", kObjectUrl, "?partNumber=2&uploadId=upload1"),
+           HttpResponse{200, absl::Cord(), HeaderMap{{"etag", "\"part2\""}}}},
+          {absl::StrCat("PUT ", kObjectUrl, "?partNumber=3&uploadId=upload1"),
+           HttpResponse{200, absl::Cord(), HeaderMap{{"etag", "\"part3\""}}}},
+
+          {absl::StrCat("POST ", kObjectUrl, "?uploadId=upload1"),
+           HttpResponse{200, absl::Cord(R"(<?xml version="1.0" encoding="UTF-8"?>
+<CompleteMultipartUploadResult>
+  <Bucket>my.bucket</Bucket>
+  <Key>key_write</Key>
+  <ETag>"900150983cd24fb0d6963f7d28e17f72-3"</ETag>
+</CompleteMultipartUploadResult>)"),
+                        {}}},
+      });
+
+  DefaultHttpTransportSetter mock_transport_setter{mock_transport};
+
+  auto context = DefaultTestContext();
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store, kvstore::Open({{"driver", "s3"},
+                                 {"bucket", "my.bucket"},
+                                 {"aws_region", "us-east-1"},
+                                 {"multipart_upload_threshold", 4},
+                                 {"multipart_upload_part_size", kPartSize}},
+                                context)
+                      .result());
+
+  // The last part is smaller than the others.
+  EXPECT_THAT(kvstore::Write(store, "key_write",
+                             absl::Cord(std::string(2 * kPartSize + 2, 'x')))
+                  .result(),
+              MatchesTimestampedStorageGeneration(StorageGeneration::FromString(
+                  "\"900150983cd24fb0d6963f7d28e17f72-3\"")));
+
+  int part_requests = 0;
+  for (const auto& request : mock_transport->requests()) {
+    if (request.method == "PUT") {
+      EXPECT_THAT(request.url, testing::HasSubstr("uploadId=upload1"));
+      part_requests++;
+    } else if (request.method == "POST" &&
+               absl::EndsWith(request.url, "uploadId=upload1")) {
+      EXPECT_THAT(request.headers,
+                  Contains(Pair("content-type", "application/xml")));
+    }
+  }
+  EXPECT_EQ(4, part_requests);
+}
+
+TEST(S3KeyValueStoreTest, MultipartUploadInvalidSpec) {
+  auto context = DefaultTestContext();
+  EXPECT_THAT(kvstore::Open({{"driver", "s3"},
+                             {"bucket", "my-bucket"},
+                             {"multipart_upload_part_size", 0}},
+                            context)
+                  .result(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  // S3 requires parts other than the last to be at least 5MiB.
+  EXPECT_THAT(kvstore::Open({{"driver", "s3"},
+                             {"bucket", "my-bucket"},
+                             {"multipart_upload_part_size",
+                              5 * 1024 * 1024 - 1}},
+                            context)
+                  .result(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(S3KeyValueStoreTest, SimpleMock_MultipartWriteNoSuchUpload) {
+  constexpr size_t kPartSize = 5 * 1024 * 1024;
+  constexpr char kObjectUrl[] =
+      "https://s3.us-east-1.amazonaws.com/my.bucket/key_write";
+  auto mock_transport = std::make_shared<DefaultMockHttpTransport>(
+      DefaultMockHttpTransport::Responses{
+          {"HEAD https://s3.amazonaws.com/my.bucket",
+           HttpResponse{200, absl::Cord(),
+                        HeaderMap{{"x-amz-bucket-region", "us-east-1"}}}},
+
+          {absl::StrCat("POST ", kObjectUrl, "?uploads"),
+           HttpResponse{200, absl::Cord(R"(<?xml version="1.0" encoding="UTF-8"?>
+<InitiateMultipartUploadResult>
+  <UploadId>upload1</UploadId>
+</InitiateMultipartUploadResult>)"),
+                        {}}},
+          {absl::StrCat("PUT ", kObjectUrl, "?partNumber=1&uploadId=upload1"),
+           HttpResponse{200, absl::Cord(), HeaderMap{{"etag", "\"part1\""}}}},
+          {absl::StrCat("PUT ", kObjectUrl, "?partNumber=2&uploadId=upload1"),
+           HttpResponse{200, absl::Cord(), HeaderMap{{"etag", "\"part2\""}}}},
+
+          // The upload no longer exists; this is not a generation mismatch.
+          {absl::StrCat("POST ", kObjectUrl, "?uploadId=upload1"),
+           HttpResponse{404, absl::Cord(R"(<?xml version="1.0" encoding="UTF-8"?>
+<Error>
+  <Code>NoSuchUpload</Code>
+  <Message>The specified upload does not exist.</Message>
+</Error>)"),
+                        {}}},
+      });
+
+  DefaultHttpTransportSetter mock_transport_setter{mock_transport};
+
+  auto context = DefaultTestContext();
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store, kvstore::Open({{"driver", "s3"},
+                                 {"bucket", "my.bucket"},
+                                 {"aws_region", "us-east-1"},
+                                 {"use_conditional_write", true},
+                                 {"multipart_upload_threshold", 4},
+                                 {"multipart_upload_part_size", kPartSize}},
+                                context)
+                      .result());
+
+  kvstore::WriteOptions options;
+  options.generation_conditions.if_equal =
+      StorageGeneration::FromString("\"abc\"");
+  EXPECT_THAT(kvstore::Write(store, "key_write",
+                             absl::Cord(std::string(kPartSize + 1, 'x')),
+                             options)
+                  .result(),
+              StatusIs(absl::StatusCode::kNotFound));
+}
+
 TEST(S3KeyValueStoreTest, SimpleMock_Endpoint) {
   // Mocks for s3
   auto mock_transport = std::make_shared<DefaultMockHttpTransport>(
@@ -216,6 +216,24 @@ Result<StorageGeneration> StorageGenerationFromHeaders(
   return absl::NotFoundError("etag not found in response headers");
 }
 
+std::string GetAwsErrorCode(const HttpResponse& response) {
+  if (auto error_header = response.headers.find("x-amzn-errortype");
+      error_header != response.headers.end()) {
+    return error_header->second;
+  }
+  auto payload = response.payload;
+  auto payload_str = payload.Flatten();
+  if (payload_str.empty()) return {};
+  tinyxml2::XMLDocument xmlDocument;
+  if (int xmlcode = xmlDocument.Parse(payload_str.data(), payload_str.size());
+      xmlcode != tinyxml2::XML_SUCCESS) {
+    return {};
+  }
+  auto* root_node = xmlDocument.FirstChildElement("Error");
+  if (root_node == nullptr) return {};
+  return GetNodeText(root_node->FirstChildElement("Code"));
+}
+
 absl::Status AwsHttpResponseToStatus(const HttpResponse& response,
                                      bool& retryable, SourceLocation loc) {
   auto absl_status_code = internal_http::HttpResponseCodeToStatusCode(response);
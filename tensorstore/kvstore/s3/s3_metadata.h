@@ -59,6 +59,11 @@ std::optional<absl::Time> GetNodeTimestamp(tinyxml2::XMLNode* node);
 Result<StorageGeneration> StorageGenerationFromHeaders(
     const internal_http::HeaderMap& headers);
 
+/// Returns the AWS error code of an error response, such as "NoSuchKey", or an
+/// empty string if the response does not specify one.
+/// https://docs.aws.amazon.com/AmazonS3/latest/API/ErrorResponses.html
+std::string GetAwsErrorCode(const internal_http::HttpResponse& response);
+
 /// Constructs an absl::Status from an Aws HttpResponse.
 absl::Status AwsHttpResponseToStatus(
     const internal_http::HttpResponse& response, bool& retryable,
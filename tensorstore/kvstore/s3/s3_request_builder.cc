@@ -33,9 +33,11 @@
 #include "absl/log/absl_log.h"
 #include "absl/strings/ascii.h"
 #include "absl/strings/escaping.h"
+#include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
+#include "absl/strings/str_split.h"
 #include "absl/time/time.h"
 #include <openssl/evp.h>  // IWYU pragma: keep
 #include <openssl/hmac.h>
@@ -81,13 +83,28 @@ void ComputeHmac(unsigned char (&key)[kHmacSize], std::string_view message,
              md_len == kHmacSize);
 }
 
+/// Returns the canonical query string, in which parameters without a value,
+/// such as the `uploads` parameter of CreateMultipartUpload, are followed by
+/// an `=`.
+std::string CanonicalQueryString(std::string_view query) {
+  std::string canonical;
+  if (query.empty()) return canonical;
+  for (std::string_view param : absl::StrSplit(query, '&')) {
+    if (!canonical.empty()) canonical.push_back('&');
+    absl::StrAppend(&canonical, param);
+    if (!absl::StrContains(param, '=')) canonical.push_back('=');
+  }
+  return canonical;
+}
+
 /// https://docs.aws.amazon.com/AmazonS3/latest/API/sig-v4-header-based-auth.html
 std::string CanonicalRequest(
     std::string_view method, std::string_view path, std::string_view query,
     std::string_view payload_hash,
     const std::vector<std::pair<std::string, std::string_view>>& headers) {
   std::string canonical =
-      absl::StrCat(method, "\n", S3UriObjectKeyEncode(path), "\n", query, "\n");
+      absl::StrCat(method, "\n", S3UriObjectKeyEncode(path), "\n",
+                   CanonicalQueryString(query), "\n");
 
   // Canonical Headers
   std::vector<std::string_view> signed_headers;
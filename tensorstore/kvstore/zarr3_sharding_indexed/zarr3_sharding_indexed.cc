@@ -17,6 +17,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
 #include <memory>
@@ -210,7 +211,10 @@ class ShardIndexCache
             params.index_codec_state->encoded_size()))),
         base_kvstore_path_(std::move(base_kvstore_path)),
         executor_(std::move(executor)),
-        shard_index_params_(std::move(params)) {}
+        shard_index_params_(std::move(params)) {
+    // Shard indices are accessed by every read of the shard.
+    SetPriority(internal::CachePriority::kHigh);
+  }
 
   ShardIndexKeyValueStore* shard_index_kvstore_driver() {
     return static_cast<ShardIndexKeyValueStore*>(this->Base::kvstore_driver());
@@ -1195,6 +1199,23 @@ class ReadOperationState
                                       self->driver().shard_index_params()),
         internal_kvstore_batch::SetCommonResult(self->request_batch.requests,
                                                 _));
+    const int64_t shard_size = read_result.value.size();
+
+    // Complete the requests in order of entry offset, and drop the portion of
+    // the shard preceding each entry once it is reached.  Each chunk of the
+    // shard is then released as soon as the entries referencing it have been
+    // consumed, rather than once all of the requests have completed.
+    const auto entry_offset = [&](const Request& request) {
+      const auto index_entry = shard_index[request.entry_id];
+      return index_entry.IsMissing() ? uint64_t{0} : index_entry.offset;
+    };
+    auto& requests = self->request_batch.requests;
+    std::sort(requests.begin(), requests.end(),
+              [&](const Request& a, const Request& b) {
+                return entry_offset(a) < entry_offset(b);
+              });
+    int64_t released = 0;
+
     const auto complete_request = [&](Request& request) {
       const auto index_entry = shard_index[request.entry_id];
       if (index_entry.IsMissing()) {
@@ -1203,17 +1224,20 @@ class ReadOperationState
         return;
       }
       TENSORSTORE_RETURN_IF_ERROR(
-          index_entry.Validate(request.entry_id, read_result.value.size()))
+          index_entry.Validate(request.entry_id, shard_size))
           .With([&](absl::Status error) {
             request.promise.SetResult(std::move(error));
           });
+      // Since the requests are sorted, the entry does not precede the portion
+      // already released, and starts at the beginning of the remaining value.
+      const int64_t offset = static_cast<int64_t>(index_entry.offset);
+      read_result.value.RemovePrefix(offset - released);
+      released = offset;
 
       TENSORSTORE_ASSIGN_OR_RETURN(
           auto validated_byte_range,
           request.byte_range.Validate(index_entry.length),
           static_cast<void>(request.promise.SetResult(_)));
-      validated_byte_range.inclusive_min += index_entry.offset;
-      validated_byte_range.exclusive_max += index_entry.offset;
       kvstore::ReadResult request_read_result;
       request_read_result.stamp = read_result.stamp;
       request_read_result.state = kvstore::ReadResult::kValue;
@@ -1221,7 +1245,7 @@ class ReadOperationState
           internal::GetSubCord(read_result.value, validated_byte_range);
       request.promise.SetResult(std::move(request_read_result));
     };
-    for (auto& request : self->request_batch.requests) {
+    for (auto& request : requests) {
       complete_request(request);
     }
   }
@@ -0,0 +1,930 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/tscli/lib/ocdbt_compact.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/status/status.h"
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tensorstore/context.h"
+#include "tensorstore/internal/cache/cache_pool_resource.h"
+#include "tensorstore/internal/data_copy_concurrency_resource.h"
+#include "tensorstore/internal/path.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/ocdbt/config.h"
+#include "tensorstore/kvstore/ocdbt/format/btree.h"
+#include "tensorstore/kvstore/ocdbt/format/btree_node_encoder.h"
+#include "tensorstore/kvstore/ocdbt/format/config.h"
+#include "tensorstore/kvstore/ocdbt/format/indirect_data_reference.h"
+#include "tensorstore/kvstore/ocdbt/format/manifest.h"
+#include "tensorstore/kvstore/ocdbt/format/version_tree.h"
+#include "tensorstore/kvstore/ocdbt/io/io_handle_impl.h"
+#include "tensorstore/kvstore/ocdbt/io_handle.h"
+#include "tensorstore/kvstore/ocdbt/non_distributed/write_nodes.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/kvstore/spec.h"
+#include "tensorstore/tscli/lib/ocdbt_check_reporter.h"
+#include "tensorstore/tscli/lib/ocdbt_file_usage_tracker.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/quote_string.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
+#include "tensorstore/util/status.h"
+#include "tensorstore/util/status_builder.h"
+
+namespace tensorstore {
+namespace cli {
+namespace {
+
+using ::tensorstore::QuoteString;
+using ::tensorstore::internal_ocdbt::BtreeGenerationReference;
+using ::tensorstore::internal_ocdbt::BtreeInteriorNodeEncoder;
+using ::tensorstore::internal_ocdbt::BtreeLeafNodeEncoder;
+using ::tensorstore::internal_ocdbt::BtreeNode;
+using ::tensorstore::internal_ocdbt::BtreeNodeHeight;
+using ::tensorstore::internal_ocdbt::CommitTime;
+using ::tensorstore::internal_ocdbt::Config;
+using ::tensorstore::internal_ocdbt::ConfigState;
+using ::tensorstore::internal_ocdbt::DataFilePrefixes;
+using ::tensorstore::internal_ocdbt::FlushPromise;
+using ::tensorstore::internal_ocdbt::GenerationNumber;
+using ::tensorstore::internal_ocdbt::IndirectDataKind;
+using ::tensorstore::internal_ocdbt::IndirectDataReference;
+using ::tensorstore::internal_ocdbt::InteriorNodeEntry;
+using ::tensorstore::internal_ocdbt::InteriorNodeEntryData;
+using ::tensorstore::internal_ocdbt::IoHandle;
+using ::tensorstore::internal_ocdbt::LeafNodeEntry;
+using ::tensorstore::internal_ocdbt::Manifest;
+using ::tensorstore::internal_ocdbt::VersionNodeReference;
+using ::tensorstore::internal_ocdbt::VersionSpec;
+using ::tensorstore::internal_ocdbt::VersionTreeHeight;
+using ::tensorstore::internal_ocdbt::VersionTreeNode;
+
+// Prefix of newly-written data files, matching the default
+// `data_file_prefixes` of the ocdbt driver.
+constexpr std::string_view kDataFilePrefix = "d/";
+
+using NodeEntries = std::vector<InteriorNodeEntryData<std::string>>;
+
+// B+tree node reachable from a retained version.
+struct NodeInfo {
+  BtreeNodeHeight height = 0;
+
+  // Full key prefix of the entries of the node.
+  std::string full_prefix;
+
+  // Indicates whether the node is the root of a retained version.
+  bool is_root = false;
+
+  // Data files referenced by the node itself or its values.
+  std::vector<std::string> files;
+
+  // Locations of the child nodes.
+  std::vector<IndirectDataReference> children;
+
+  // Indicates whether the node, or any of its descendants, references a data
+  // file that is being compacted.
+  bool dirty = false;
+
+  // Entries that replace the reference to the node, if `dirty`.
+  NodeEntries new_entries;
+};
+
+// Reference to a B+tree node encountered while scanning.
+struct NodeTask {
+  IndirectDataReference location;
+  std::string inclusive_min_key;
+  size_t subtree_common_prefix_length;
+  bool is_root;
+};
+
+class OcdbtCompactRunner {
+ public:
+  OcdbtCompactRunner(IoHandle::Ptr io_handle, kvstore::KvStore base_kvstore,
+                     const OcdbtCompactOptions& options,
+                     OcdbtCheckReporter& reporter)
+      : io_handle_(std::move(io_handle)),
+        base_kvstore_(std::move(base_kvstore)),
+        options_(options),
+        reporter_(reporter) {}
+
+  absl::Status Run() {
+    TENSORSTORE_RETURN_IF_ERROR(ListFiles());
+    TENSORSTORE_RETURN_IF_ERROR(ReadVersions());
+    TENSORSTORE_RETURN_IF_ERROR(SelectRetainedVersions());
+    TENSORSTORE_RETURN_IF_ERROR(ScanBtrees());
+    TENSORSTORE_RETURN_IF_ERROR(SelectFilesToCompact());
+
+    // A new manifest is only needed if versions are dropped or nodes are
+    // rewritten.
+    const bool commit = num_dropped_versions_ > 0 || !compacted_files_.empty();
+    if (!commit) {
+      reporter_.ReportInfo("Nothing to compact.");
+    } else if (!options_.dry_run) {
+      TENSORSTORE_RETURN_IF_ERROR(RewriteNodes());
+      TENSORSTORE_RETURN_IF_ERROR(CommitNewManifest());
+    }
+    if (options_.delete_unreferenced_files) {
+      TENSORSTORE_RETURN_IF_ERROR(DeleteUnreferencedFiles(commit));
+    }
+    return absl::OkStatus();
+  }
+
+ private:
+  absl::Status ListFiles() {
+    list_time_ = absl::Now();
+    TENSORSTORE_ASSIGN_OR_RETURN(auto entries,
+                                 kvstore::ListFuture(base_kvstore_).result(),
+                                 tensorstore::StatusBuilder(_).Format(
+                                     "Error listing base kvstore"));
+    for (const auto& entry : entries) {
+      on_disk_files_[entry.key] = entry.size;
+    }
+    tracker_.SetOnDiskFiles(on_disk_files_);
+    return absl::OkStatus();
+  }
+
+  // Reads all versions referenced by the manifest, in order of increasing
+  // generation number.
+  absl::Status ReadVersions() {
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto manifest_with_time, io_handle_->GetManifest(absl::Now()).result(),
+        tensorstore::StatusBuilder(_).Format("Error reading manifest"));
+    if (!manifest_with_time.manifest) {
+      return absl::NotFoundError("Manifest not found");
+    }
+    existing_manifest_ = std::move(manifest_with_time.manifest);
+    if (auto* dictionary =
+            internal_ocdbt::GetZstdDictionary(existing_manifest_->config)) {
+      // The dictionary remains referenced by the config of the new manifest.
+      const auto& location = dictionary->location;
+      dictionary_file_ = location.file_id.FullPath();
+      tracker_.RegisterUsedRange(dictionary_file_, location.offset,
+                                 location.length);
+    }
+    for (const auto& node_ref : existing_manifest_->version_tree_nodes) {
+      TENSORSTORE_RETURN_IF_ERROR(ReadVersionTreeNode(node_ref));
+    }
+    versions_.insert(versions_.end(), existing_manifest_->versions.begin(),
+                     existing_manifest_->versions.end());
+    return absl::OkStatus();
+  }
+
+  absl::Status ReadVersionTreeNode(const VersionNodeReference& node_ref) {
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto node, io_handle_->GetVersionTreeNode(node_ref.location).result(),
+        tensorstore::StatusBuilder(_).Format("Error reading version node %v",
+                                             node_ref.location));
+    TENSORSTORE_RETURN_IF_ERROR(ValidateVersionTreeNodeReference(
+        *node, existing_manifest_->config, node_ref.generation_number,
+        node_ref.height));
+    version_node_files_.push_back(node_ref.location.file_id.FullPath());
+    if (auto* entries =
+            std::get_if<VersionTreeNode::LeafNodeEntries>(&node->entries)) {
+      versions_.insert(versions_.end(), entries->begin(), entries->end());
+      return absl::OkStatus();
+    }
+    for (const auto& child :
+         std::get<VersionTreeNode::InteriorNodeEntries>(node->entries)) {
+      TENSORSTORE_RETURN_IF_ERROR(ReadVersionTreeNode(child));
+    }
+    return absl::OkStatus();
+  }
+
+  absl::Status SelectRetainedVersions() {
+    size_t first = 0;
+    if (options_.min_version) {
+      TENSORSTORE_ASSIGN_OR_RETURN(
+          VersionSpec version_spec,
+          internal_ocdbt::ParseVersionSpecFromUrl(*options_.min_version));
+      // Retain the latest version not newer than `version_spec`.
+      auto it = std::upper_bound(
+          versions_.begin(), versions_.end(), version_spec,
+          [](const VersionSpec& spec, const BtreeGenerationReference& ref) {
+            return internal_ocdbt::CompareVersionSpecToVersion(spec, ref) < 0;
+          });
+      if (it != versions_.begin()) {
+        first = it - versions_.begin() - 1;
+      }
+    }
+    if (options_.max_versions) {
+      if (*options_.max_versions == 0) {
+        return absl::InvalidArgumentError("max_versions must be positive");
+      }
+      if (*options_.max_versions < versions_.size()) {
+        first = std::max(first, static_cast<size_t>(versions_.size() -
+                                                    *options_.max_versions));
+      }
+    }
+    retained_versions_.assign(versions_.begin() + first, versions_.end());
+    num_dropped_versions_ = first;
+    reporter_.ReportInfo(
+        "Retaining %d of %d versions (generations %d to %d).",
+        retained_versions_.size(), versions_.size(),
+        retained_versions_.front().generation_number,
+        retained_versions_.back().generation_number);
+    return absl::OkStatus();
+  }
+
+  // Reads the B+tree nodes at `locations`, at most `concurrency` at a time,
+  // and invokes `func(i, node)` for each.
+  template <typename Func>
+  absl::Status ReadNodes(span<const IndirectDataReference> locations,
+                         Func func) {
+    const size_t concurrency = options_.concurrency;
+    std::vector<Future<const std::shared_ptr<const BtreeNode>>> futures;
+    for (size_t start = 0; start < locations.size(); start += concurrency) {
+      const size_t end = std::min(locations.size(), start + concurrency);
+      futures.clear();
+      for (size_t i = start; i < end; ++i) {
+        futures.push_back(io_handle_->GetBtreeNode(locations[i]));
+      }
+      for (size_t i = start; i < end; ++i) {
+        TENSORSTORE_ASSIGN_OR_RETURN(
+            auto node, futures[i - start].result(),
+            tensorstore::StatusBuilder(_).Format("Error reading B-tree node %v",
+                                                 locations[i]));
+        TENSORSTORE_RETURN_IF_ERROR(func(i, *node));
+      }
+    }
+    return absl::OkStatus();
+  }
+
+  // Traverses the B+trees of the retained versions, recording the referenced
+  // ranges of each data file.
+  //
+  // Nodes are visited in order of decreasing height, such that all references
+  // to a node are known before it is read.
+  absl::Status ScanBtrees() {
+    reporter_.ReportInfo("Scanning B-tree nodes...");
+    std::map<BtreeNodeHeight, std::vector<NodeTask>, std::greater<>> pending;
+    for (const auto& version : retained_versions_) {
+      if (version.root.location.IsMissing()) continue;
+      pending[version.root_height].push_back(
+          NodeTask{version.root.location, "", 0, /*is_root=*/true});
+    }
+    while (!pending.empty()) {
+      const BtreeNodeHeight height = pending.begin()->first;
+      auto tasks = std::move(pending.begin()->second);
+      pending.erase(pending.begin());
+
+      std::vector<const NodeTask*> new_tasks;
+      std::vector<IndirectDataReference> locations;
+      for (const auto& task : tasks) {
+        auto [it, inserted] = nodes_.try_emplace(task.location);
+        it->second.is_root |= task.is_root;
+        if (!inserted) continue;
+        new_tasks.push_back(&task);
+        locations.push_back(task.location);
+      }
+      if (nodes_by_height_.size() <= height) {
+        nodes_by_height_.resize(height + 1);
+      }
+      nodes_by_height_[height].insert(nodes_by_height_[height].end(),
+                                      locations.begin(), locations.end());
+
+      TENSORSTORE_RETURN_IF_ERROR(ReadNodes(
+          locations, [&](size_t i, const BtreeNode& node) -> absl::Status {
+            const NodeTask& task = *new_tasks[i];
+            std::string_view inclusive_min_key = task.inclusive_min_key;
+            TENSORSTORE_RETURN_IF_ERROR(ValidateBtreeNodeReference(
+                node, height,
+                inclusive_min_key.substr(task.subtree_common_prefix_length)));
+            NodeInfo& info = nodes_.at(task.location);
+            info.height = height;
+            info.full_prefix = absl::StrCat(
+                inclusive_min_key.substr(0, task.subtree_common_prefix_length),
+                node.key_prefix);
+            RegisterReference(info, task.location);
+            if (auto* entries =
+                    std::get_if<BtreeNode::LeafNodeEntries>(&node.entries)) {
+              for (const auto& entry : *entries) {
+                if (auto* ref = std::get_if<IndirectDataReference>(
+                        &entry.value_reference)) {
+                  RegisterReference(info, *ref);
+                }
+              }
+              return absl::OkStatus();
+            }
+            auto& children = pending[height - 1];
+            for (const auto& entry :
+                 std::get<BtreeNode::InteriorNodeEntries>(node.entries)) {
+              info.children.push_back(entry.node.location);
+              children.push_back(NodeTask{
+                  entry.node.location,
+                  absl::StrCat(info.full_prefix, entry.key),
+                  info.full_prefix.size() + entry.subtree_common_prefix_length,
+                  /*is_root=*/false});
+            }
+            return absl::OkStatus();
+          }));
+      reporter_.PrintProgress("Scanned %d B-tree nodes", nodes_.size());
+    }
+    reporter_.ReportInfo("Scanned %d B-tree nodes.", nodes_.size());
+    return absl::OkStatus();
+  }
+
+  void RegisterReference(NodeInfo& info, const IndirectDataReference& ref) {
+    std::string file_path = ref.file_id.FullPath();
+    tracker_.RegisterUsedRange(file_path, ref.offset, ref.length);
+    if (std::find(info.files.begin(), info.files.end(), file_path) ==
+        info.files.end()) {
+      info.files.push_back(std::move(file_path));
+    }
+  }
+
+  // Selects the sparsely-used data files to compact, and marks the nodes that
+  // reference them, directly or through their descendants, as dirty.
+  absl::Status SelectFilesToCompact() {
+    uint64_t total_bytes = 0;
+    uint64_t total_unused_bytes = 0;
+    uint64_t compacted_live_bytes = 0;
+    TENSORSTORE_RETURN_IF_ERROR(tracker_.ForEachFileUnusedBytes(
+        options_.alignment, [&](std::string_view file_path, uint64_t file_size,
+                                uint64_t unused_bytes) {
+          total_bytes += file_size;
+          total_unused_bytes += unused_bytes;
+          const uint64_t live_bytes = file_size - unused_bytes;
+          if (static_cast<double>(live_bytes) >=
+              options_.min_live_fraction * static_cast<double>(file_size)) {
+            return;
+          }
+          compacted_files_.insert(std::string(file_path));
+          compacted_live_bytes += live_bytes;
+          if (reporter_.detailed()) {
+            reporter_.ReportInfo("  %s: %d of %d bytes referenced", file_path,
+                                 live_bytes, file_size);
+          }
+        }));
+    reporter_.ReportInfo(
+        "Referenced files: %d bytes, of which %d bytes are unused.",
+        total_bytes, total_unused_bytes);
+    reporter_.ReportInfo(
+        "Compacting %d sparsely-used files with %d referenced bytes.",
+        compacted_files_.size(), compacted_live_bytes);
+
+    size_t num_dirty_nodes = 0;
+    for (const auto& locations : nodes_by_height_) {
+      for (const auto& location : locations) {
+        NodeInfo& info = nodes_.at(location);
+        info.dirty =
+            std::any_of(info.files.begin(), info.files.end(),
+                        [&](const std::string& file_path) {
+                          return compacted_files_.contains(file_path);
+                        }) ||
+            std::any_of(info.children.begin(), info.children.end(),
+                        [&](const IndirectDataReference& child) {
+                          return nodes_.at(child).dirty;
+                        });
+        num_dirty_nodes += info.dirty;
+      }
+    }
+    if (!compacted_files_.empty()) {
+      reporter_.ReportInfo("Rewriting %d of %d B-tree nodes.", num_dirty_nodes,
+                           nodes_.size());
+    }
+    return absl::OkStatus();
+  }
+
+  bool IsCompacted(const IndirectDataReference& ref) const {
+    return compacted_files_.contains(ref.file_id.FullPath());
+  }
+
+  // Rewrites the dirty nodes, in order of increasing height, such that the
+  // replacement entries for the children of a node are known before it is
+  // rewritten.
+  absl::Status RewriteNodes() {
+    const Config& config = existing_manifest_->config;
+    for (const auto& all_locations : nodes_by_height_) {
+      std::vector<IndirectDataReference> locations;
+      for (const auto& location : all_locations) {
+        if (nodes_.at(location).dirty) locations.push_back(location);
+      }
+      TENSORSTORE_RETURN_IF_ERROR(ReadNodes(
+          locations, [&](size_t i, const BtreeNode& node) -> absl::Status {
+            NodeInfo& info = nodes_.at(locations[i]);
+            TENSORSTORE_ASSIGN_OR_RETURN(
+                auto encoded_nodes,
+                node.height == 0 ? RewriteLeafNode(config, info, node)
+                                 : RewriteInteriorNode(config, info, node));
+            info.new_entries = internal_ocdbt::WriteNodes(
+                *io_handle_, flush_promise_, std::move(encoded_nodes));
+            return absl::OkStatus();
+          }));
+      reporter_.PrintProgress("Rewrote %d values (%d bytes)",
+                              num_rewritten_values_, num_rewritten_bytes_);
+    }
+    reporter_.ReportInfo("Rewrote %d values (%d bytes).",
+                         num_rewritten_values_, num_rewritten_bytes_);
+    return absl::OkStatus();
+  }
+
+  Result<std::vector<internal_ocdbt::EncodedNode>> RewriteLeafNode(
+      const Config& config, NodeInfo& info, const BtreeNode& node) {
+    const auto& entries = std::get<BtreeNode::LeafNodeEntries>(node.entries);
+
+    // Read all values stored in compacted files concurrently.
+    std::vector<Future<kvstore::ReadResult>> value_futures(entries.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+      auto* ref =
+          std::get_if<IndirectDataReference>(&entries[i].value_reference);
+      if (ref && IsCompacted(*ref)) {
+        value_futures[i] = io_handle_->ReadIndirectData(*ref, {});
+      }
+    }
+
+    BtreeLeafNodeEncoder encoder(config, /*height=*/0, info.full_prefix,
+                                 io_handle_->config_state->GetZstdDictionary());
+    for (size_t i = 0; i < entries.size(); ++i) {
+      LeafNodeEntry entry = entries[i];
+      if (!value_futures[i].null()) {
+        TENSORSTORE_ASSIGN_OR_RETURN(auto read_result,
+                                     value_futures[i].result());
+        if (!read_result.has_value()) {
+          return absl::DataLossError(
+              absl::StrFormat("Value for key %s is missing",
+                              QuoteString(absl::StrCat(info.full_prefix,
+                                                       entry.key))));
+        }
+        ++num_rewritten_values_;
+        num_rewritten_bytes_ += read_result.value.size();
+        flush_promise_.Link(io_handle_->WriteData(
+            IndirectDataKind::kValue, std::move(read_result.value),
+            entry.value_reference.emplace<IndirectDataReference>()));
+      }
+      encoder.AddEntry(/*existing=*/true, std::move(entry));
+    }
+    return encoder.Finalize(/*may_be_root=*/info.is_root);
+  }
+
+  Result<std::vector<internal_ocdbt::EncodedNode>> RewriteInteriorNode(
+      const Config& config, NodeInfo& info, const BtreeNode& node) {
+    BtreeInteriorNodeEncoder encoder(
+        config, node.height, info.full_prefix,
+        io_handle_->config_state->GetZstdDictionary());
+    for (const auto& entry :
+         std::get<BtreeNode::InteriorNodeEntries>(node.entries)) {
+      const NodeInfo& child = nodes_.at(entry.node.location);
+      if (!child.dirty) {
+        encoder.AddEntry(/*existing=*/true, InteriorNodeEntry(entry));
+        continue;
+      }
+      for (const auto& new_entry : child.new_entries) {
+        internal_ocdbt::AddNewInteriorEntry(encoder, new_entry);
+      }
+    }
+    return encoder.Finalize(/*may_be_root=*/info.is_root);
+  }
+
+  // Writes a version tree node referencing `versions`, which must all fall
+  // within the generation range of a single node of the specified `height`.
+  Result<VersionNodeReference> WriteVersionTreeNode(
+      const Config& config, span<const BtreeGenerationReference> versions,
+      VersionTreeHeight height) {
+    VersionTreeNode node;
+    node.height = height;
+    node.version_tree_arity_log2 = config.version_tree_arity_log2;
+    if (height == 0) {
+      node.entries.emplace<VersionTreeNode::LeafNodeEntries>(versions.begin(),
+                                                            versions.end());
+    } else {
+      auto& children =
+          node.entries.emplace<VersionTreeNode::InteriorNodeEntries>();
+      // Each child covers `2**(height * version_tree_arity_log2)`
+      // generations.
+      const int shift = height * config.version_tree_arity_log2;
+      for (size_t i = 0; i < versions.size();) {
+        const GenerationNumber child_index =
+            (versions[i].generation_number - 1) >> shift;
+        size_t end = i + 1;
+        while (end < versions.size() &&
+               ((versions[end].generation_number - 1) >> shift) ==
+                   child_index) {
+          ++end;
+        }
+        TENSORSTORE_ASSIGN_OR_RETURN(
+            auto child, WriteVersionTreeNode(config,
+                                             versions.subspan(i, end - i),
+                                             height - 1));
+        children.push_back(std::move(child));
+        i = end;
+      }
+    }
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto encoded,
+        internal_ocdbt::EncodeVersionTreeNode(
+            config, node, io_handle_->config_state->GetZstdDictionary()));
+    VersionNodeReference node_ref;
+    node_ref.height = height;
+    node_ref.generation_number = versions.back().generation_number;
+    node_ref.num_generations = versions.size();
+    node_ref.commit_time = versions.front().commit_time;
+    flush_promise_.Link(io_handle_->WriteData(IndirectDataKind::kVersionNode,
+                                              std::move(encoded),
+                                              node_ref.location));
+    return node_ref;
+  }
+
+  // Populates the version tree of `manifest` with `versions`, which must be
+  // ordered by generation number, writing any necessary version tree nodes.
+  //
+  // The structure of the version tree is determined by the latest generation
+  // number, as for `internal_ocdbt::CreateNewManifest`.
+  absl::Status BuildVersionTree(span<const BtreeGenerationReference> versions,
+                                Manifest& manifest) {
+    const Config& config = manifest.config;
+    const GenerationNumber latest_generation =
+        versions.back().generation_number;
+    const GenerationNumber inline_min_generation =
+        internal_ocdbt::GetVersionTreeLeafNodeRangeContainingGeneration(
+            config.version_tree_arity_log2, latest_generation)
+            .first;
+    auto by_generation = [](const BtreeGenerationReference& ref,
+                            GenerationNumber generation_number) {
+      return ref.generation_number < generation_number;
+    };
+    auto inline_begin = std::lower_bound(versions.begin(), versions.end(),
+                                         inline_min_generation, by_generation);
+    manifest.versions.assign(inline_begin, versions.end());
+
+    absl::Status status;
+    internal_ocdbt::ForEachManifestVersionTreeNodeRef(
+        latest_generation, config.version_tree_arity_log2,
+        [&](GenerationNumber min_generation_number,
+            GenerationNumber max_generation_number, VersionTreeHeight height) {
+          if (!status.ok()) return;
+          auto begin = std::lower_bound(versions.begin(), inline_begin,
+                                        min_generation_number, by_generation);
+          auto end = std::lower_bound(begin, inline_begin,
+                                      max_generation_number + 1, by_generation);
+          if (begin == end) return;
+          auto node_ref = WriteVersionTreeNode(
+              config,
+              span<const BtreeGenerationReference>(&*begin, end - begin),
+              height);
+          if (!node_ref.ok()) {
+            status = node_ref.status();
+            return;
+          }
+          manifest.version_tree_nodes.push_back(*std::move(node_ref));
+        });
+    TENSORSTORE_RETURN_IF_ERROR(status);
+    // `ForEachManifestVersionTreeNodeRef` proceeds in order of increasing
+    // height, but the manifest lists nodes in order of decreasing height.
+    std::reverse(manifest.version_tree_nodes.begin(),
+                 manifest.version_tree_nodes.end());
+    return absl::OkStatus();
+  }
+
+  // Commits a new manifest referencing the rewritten retained versions, along
+  // with a new version that is identical in content to the latest version.
+  absl::Status CommitNewManifest() {
+    std::vector<BtreeGenerationReference> versions = retained_versions_;
+    for (auto& version : versions) {
+      if (version.root.location.IsMissing()) continue;
+      const NodeInfo& info = nodes_.at(version.root.location);
+      if (!info.dirty) continue;
+      TENSORSTORE_ASSIGN_OR_RETURN(
+          auto new_root,
+          internal_ocdbt::WriteRootNode(*io_handle_, flush_promise_,
+                                        version.root_height, info.new_entries));
+      version.root = new_root.root;
+      version.root_height = new_root.root_height;
+    }
+
+    BtreeGenerationReference new_version = versions.back();
+    if (new_version.generation_number >=
+        std::numeric_limits<GenerationNumber>::max() - 1) {
+      return absl::FailedPreconditionError(absl::StrFormat(
+          "Existing generation number is already at maximum: %d",
+          new_version.generation_number));
+    }
+    ++new_version.generation_number;
+    // Ensure that the commit time is monotonically increasing.
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        new_version.commit_time,
+        CommitTime::FromAbslTime(std::max(
+            absl::Now(), static_cast<absl::Time>(new_version.commit_time) +
+                             absl::Nanoseconds(1))));
+    versions.push_back(new_version);
+
+    auto new_manifest = std::make_shared<Manifest>();
+    new_manifest->config = existing_manifest_->config;
+    TENSORSTORE_RETURN_IF_ERROR(BuildVersionTree(versions, *new_manifest));
+
+    auto flush_future = std::move(flush_promise_).future();
+    if (!flush_future.null()) {
+      flush_future.Force();
+      TENSORSTORE_RETURN_IF_ERROR(
+          flush_future.status(),
+          tensorstore::StatusBuilder(_).Format("Error writing data files"));
+    }
+
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto update_result,
+        io_handle_
+            ->TryUpdateManifest(existing_manifest_, new_manifest, absl::Now())
+            .result());
+    if (!update_result.success) {
+      return absl::AbortedError(
+          "Manifest was modified concurrently; compaction was not committed");
+    }
+    reporter_.ReportInfo("Committed generation %d.",
+                         new_version.generation_number);
+    return absl::OkStatus();
+  }
+
+  // Returns the files referenced by any version of `manifest`, including its
+  // version tree nodes and zstd dictionary.
+  Result<absl::flat_hash_set<std::string>> GetReferencedFiles(
+      const Manifest& manifest) {
+    absl::flat_hash_set<std::string> files;
+    if (auto* dictionary = internal_ocdbt::GetZstdDictionary(manifest.config)) {
+      files.insert(dictionary->location.file_id.FullPath());
+    }
+    std::vector<BtreeGenerationReference> versions(manifest.versions.begin(),
+                                                   manifest.versions.end());
+    std::vector<VersionNodeReference> version_nodes(
+        manifest.version_tree_nodes.begin(), manifest.version_tree_nodes.end());
+    while (!version_nodes.empty()) {
+      const auto node_ref = version_nodes.back();
+      version_nodes.pop_back();
+      files.insert(node_ref.location.file_id.FullPath());
+      TENSORSTORE_ASSIGN_OR_RETURN(
+          auto node, io_handle_->GetVersionTreeNode(node_ref.location).result(),
+          tensorstore::StatusBuilder(_).Format(
+              "Error reading version node %v", node_ref.location));
+      if (auto* entries =
+              std::get_if<VersionTreeNode::LeafNodeEntries>(&node->entries)) {
+        versions.insert(versions.end(), entries->begin(), entries->end());
+        continue;
+      }
+      const auto& children =
+          std::get<VersionTreeNode::InteriorNodeEntries>(node->entries);
+      version_nodes.insert(version_nodes.end(), children.begin(),
+                           children.end());
+    }
+
+    absl::flat_hash_set<IndirectDataReference> visited;
+    std::vector<IndirectDataReference> locations;
+    for (const auto& version : versions) {
+      const auto& location = version.root.location;
+      if (!location.IsMissing() && visited.insert(location).second) {
+        locations.push_back(location);
+      }
+    }
+    while (!locations.empty()) {
+      std::vector<IndirectDataReference> children;
+      TENSORSTORE_RETURN_IF_ERROR(ReadNodes(
+          locations, [&](size_t i, const BtreeNode& node) -> absl::Status {
+            files.insert(locations[i].file_id.FullPath());
+            if (auto* entries =
+                    std::get_if<BtreeNode::LeafNodeEntries>(&node.entries)) {
+              for (const auto& entry : *entries) {
+                if (auto* ref = std::get_if<IndirectDataReference>(
+                        &entry.value_reference)) {
+                  files.insert(ref->file_id.FullPath());
+                }
+              }
+              return absl::OkStatus();
+            }
+            for (const auto& entry :
+                 std::get<BtreeNode::InteriorNodeEntries>(node.entries)) {
+              if (visited.insert(entry.node.location).second) {
+                children.push_back(entry.node.location);
+              }
+            }
+            return absl::OkStatus();
+          }));
+      locations = std::move(children);
+    }
+    return files;
+  }
+
+  // Deletes the files that are unreferenced and at least
+  // `min_unreferenced_file_age` old.
+  //
+  // A file is only deleted if it is unreferenced both in the snapshot taken
+  // before compaction and in a second snapshot of the listing and manifest
+  // taken after the grace period.  Files absent from the first listing are
+  // never deleted, which gives concurrent writers at least the grace period
+  // to commit files they have already written.  The second snapshot also
+  // accounts for any versions committed concurrently, including when
+  // compaction itself committed nothing.
+  //
+  // If `committed` is true, the compacted files and the version tree nodes of
+  // the previous manifest are no longer referenced by the first snapshot.
+  absl::Status DeleteUnreferencedFiles(bool committed) {
+    absl::flat_hash_set<std::string> referenced;
+    tracker_.ForEachFileUsedRange([&](std::string_view file_path,
+                                      const auto&) {
+      if (!committed || !compacted_files_.contains(file_path)) {
+        referenced.insert(std::string(file_path));
+      }
+    });
+    if (!committed) {
+      referenced.insert(version_node_files_.begin(), version_node_files_.end());
+    }
+    if (!dictionary_file_.empty()) referenced.insert(dictionary_file_);
+
+    std::vector<std::string> unreferenced;
+    for (const auto& [file_path, size] : on_disk_files_) {
+      if (absl::StartsWith(file_path, "manifest.") ||
+          referenced.contains(file_path)) {
+        continue;
+      }
+      unreferenced.push_back(file_path);
+    }
+    std::sort(unreferenced.begin(), unreferenced.end());
+    if (options_.dry_run) {
+      uint64_t unreferenced_bytes = 0;
+      for (const auto& file_path : unreferenced) {
+        unreferenced_bytes += on_disk_files_.at(file_path);
+        if (reporter_.detailed()) reporter_.ReportInfo("  %s", file_path);
+      }
+      reporter_.ReportInfo("Would delete %d unreferenced files (%d bytes).",
+                           unreferenced.size(), unreferenced_bytes);
+      return absl::OkStatus();
+    }
+    if (unreferenced.empty()) {
+      reporter_.ReportInfo("Deleted 0 unreferenced files (0 bytes).");
+      return absl::OkStatus();
+    }
+
+    const absl::Time delete_time =
+        list_time_ + options_.min_unreferenced_file_age;
+    if (const absl::Time now = absl::Now(); now < delete_time) {
+      reporter_.ReportInfo("Waiting %s before deleting unreferenced files.",
+                           absl::FormatDuration(delete_time - now));
+      absl::SleepFor(delete_time - now);
+    }
+
+    // Take the second snapshot.
+    TENSORSTORE_ASSIGN_OR_RETURN(auto entries,
+                                 kvstore::ListFuture(base_kvstore_).result(),
+                                 tensorstore::StatusBuilder(_).Format(
+                                     "Error listing base kvstore"));
+    absl::flat_hash_map<std::string, int64_t> on_disk_files;
+    for (const auto& entry : entries) {
+      on_disk_files[entry.key] = entry.size;
+    }
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto manifest_with_time, io_handle_->GetManifest(absl::Now()).result(),
+        tensorstore::StatusBuilder(_).Format("Error reading manifest"));
+    if (!manifest_with_time.manifest) {
+      return absl::FailedPreconditionError(
+          "Manifest was deleted concurrently; no files were deleted");
+    }
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto still_referenced,
+        GetReferencedFiles(*manifest_with_time.manifest));
+
+    std::vector<std::string> to_delete;
+    uint64_t unreferenced_bytes = 0;
+    for (auto& file_path : unreferenced) {
+      auto it = on_disk_files.find(file_path);
+      if (it == on_disk_files.end() || still_referenced.contains(file_path)) {
+        continue;
+      }
+      unreferenced_bytes += it->second;
+      to_delete.push_back(std::move(file_path));
+    }
+    if (to_delete.size() != unreferenced.size()) {
+      reporter_.ReportInfo(
+          "Retaining %d files referenced or removed concurrently.",
+          unreferenced.size() - to_delete.size());
+    }
+    if (reporter_.detailed()) {
+      for (const auto& file_path : to_delete) {
+        reporter_.ReportInfo("  %s", file_path);
+      }
+    }
+
+    absl::Status status;
+    const size_t concurrency = options_.concurrency;
+    std::vector<Future<TimestampedStorageGeneration>> futures;
+    for (size_t start = 0; start < to_delete.size(); start += concurrency) {
+      const size_t end = std::min(to_delete.size(), start + concurrency);
+      futures.clear();
+      for (size_t i = start; i < end; ++i) {
+        futures.push_back(kvstore::Delete(base_kvstore_, to_delete[i]));
+      }
+      for (size_t i = start; i < end; ++i) {
+        status.Update(futures[i - start].status());
+      }
+    }
+    TENSORSTORE_RETURN_IF_ERROR(
+        status, tensorstore::StatusBuilder(_).Format(
+                    "Error deleting unreferenced files"));
+    reporter_.ReportInfo("Deleted %d unreferenced files (%d bytes).",
+                         to_delete.size(), unreferenced_bytes);
+    return absl::OkStatus();
+  }
+
+  IoHandle::Ptr io_handle_;
+  kvstore::KvStore base_kvstore_;
+  const OcdbtCompactOptions& options_;
+  OcdbtCheckReporter& reporter_;
+  OcdbtFileUsageTracker tracker_;
+
+  // Size of each file in the base kvstore, as of `list_time_`.
+  absl::flat_hash_map<std::string, int64_t> on_disk_files_;
+  absl::Time list_time_;
+
+  std::shared_ptr<const Manifest> existing_manifest_;
+
+  // All versions, and the retained subset, in order of increasing generation
+  // number.
+  std::vector<BtreeGenerationReference> versions_;
+  std::vector<BtreeGenerationReference> retained_versions_;
+  size_t num_dropped_versions_ = 0;
+
+  // Files containing version tree nodes of the existing manifest.
+  std::vector<std::string> version_node_files_;
+
+  // File containing the zstd dictionary of the existing manifest, if any.
+  std::string dictionary_file_;
+
+  // B+tree nodes of the retained versions, and their locations grouped by
+  // height.
+  absl::flat_hash_map<IndirectDataReference, NodeInfo> nodes_;
+  std::vector<std::vector<IndirectDataReference>> nodes_by_height_;
+
+  absl::flat_hash_set<std::string> compacted_files_;
+
+  FlushPromise flush_promise_;
+  int64_t num_rewritten_values_ = 0;
+  int64_t num_rewritten_bytes_ = 0;
+};
+
+}  // namespace
+
+absl::Status OcdbtCompact(Context context,
+                          tensorstore::kvstore::Spec source_spec,
+                          std::ostream& output, OcdbtCompactOptions options) {
+  TENSORSTORE_ASSIGN_OR_RETURN(auto base,
+                               kvstore::Open(source_spec, context).result());
+
+  tensorstore::internal::EnsureDirectoryPath(base.path);
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto data_copy_concurrency_resource,
+      context
+          .GetResource<tensorstore::internal::DataCopyConcurrencyResource>());
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto cache_pool_resource,
+      context.GetResource<tensorstore::internal::CachePoolResource>());
+
+  DataFilePrefixes data_file_prefixes;
+  data_file_prefixes.value = kDataFilePrefix;
+  data_file_prefixes.btree_node = kDataFilePrefix;
+  data_file_prefixes.version_tree_node = kDataFilePrefix;
+  auto io_handle = tensorstore::internal_ocdbt::MakeIoHandle(
+      data_copy_concurrency_resource, cache_pool_resource->get(), base, base,
+      /*config_state=*/
+      ConfigState::Make().value(), data_file_prefixes,
+      options.target_data_file_size);
+
+  if (options.concurrency < 1) {
+    options.concurrency = 1;
+  }
+
+  OcdbtCheckReporter reporter(output, options.detailed);
+  OcdbtCompactRunner runner(std::move(io_handle), base, options, reporter);
+  return runner.Run();
+}
+
+}  // namespace cli
+}  // namespace tensorstore
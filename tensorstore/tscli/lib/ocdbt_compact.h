@@ -0,0 +1,106 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_TSCLI_LIB_OCDBT_COMPACT_H_
+#define TENSORSTORE_TSCLI_LIB_OCDBT_COMPACT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <optional>
+#include <ostream>
+#include <string>
+
+#include "absl/status/status.h"
+#include "absl/time/time.h"
+#include "tensorstore/context.h"
+#include "tensorstore/kvstore/spec.h"
+
+namespace tensorstore {
+namespace cli {
+
+inline constexpr size_t kOcdbtCompactDefaultConcurrency = 256;
+
+struct OcdbtCompactOptions {
+  /// Oldest version to retain (e.g. "v5" or a timestamp).  The version that
+  /// would be read at `min_version`, and all later versions, are retained;
+  /// older versions are dropped.  If omitted, all versions are retained.
+  std::optional<std::string> min_version;
+
+  /// Maximum number of existing versions to retain, counting back from the
+  /// latest version.  If omitted, the number of versions is not limited.
+  std::optional<uint64_t> max_versions;
+
+  /// Data files in which less than this fraction of the bytes are referenced
+  /// by the retained versions are rewritten.
+  double min_live_fraction = 0.5;
+
+  /// Byte alignment of data files, used to exclude trailing padding when
+  /// computing the referenced fraction.
+  uint64_t alignment = 4096;
+
+  /// Target size of newly-written data files.
+  size_t target_data_file_size = size_t{64} << 20;
+
+  /// If true, deletes files that are not referenced by the database.
+  bool delete_unreferenced_files = false;
+
+  /// Minimum time between listing the files at the start of compaction and
+  /// deleting any of them.  Files written after the listing are never
+  /// deleted, so this is the time allowed for concurrent writers to commit
+  /// files they have already written.  Deletion waits as needed.
+  absl::Duration min_unreferenced_file_age = absl::Minutes(10);
+
+  /// If true, only reports what would be rewritten and deleted.
+  bool dry_run = false;
+
+  /// If true, provides more verbose output.
+  bool detailed = false;
+
+  /// Limit on concurrent reads and deletes.
+  size_t concurrency = kOcdbtCompactDefaultConcurrency;
+};
+
+/// Compacts an OCDBT database and deletes unreferenced files.
+///
+/// Versions outside the range selected by `options` are dropped.  Values and
+/// B+tree nodes of the retained versions that are stored in sparsely-used
+/// data files are rewritten into new data files, along with the B+tree nodes
+/// and version tree nodes that reference them, and the result is committed as
+/// a new version that is identical in content to the latest version.  Finally,
+/// if `options.delete_unreferenced_files` is true, files no longer referenced
+/// by any version are deleted.
+///
+/// The new manifest is committed atomically, and fails with
+/// `absl::StatusCode::kAborted` if the database was modified concurrently, in
+/// which case no files are deleted.  Files are only deleted if they are
+/// unreferenced both before compaction and after
+/// `options.min_unreferenced_file_age` has elapsed, when the manifest is read
+/// again.  However, files written by a transaction that takes longer than
+/// that to commit are indistinguishable from unreferenced files, and readers
+/// that have already resolved a dropped version may fail.
+///
+/// \param context Context to use for opening the kvstore.
+/// \param source_spec Spec of the base kvstore containing the OCDBT database.
+/// \param output Stream to write progress to.
+/// \param options Optional settings for the compaction.
+absl::Status OcdbtCompact(Context context,
+                          tensorstore::kvstore::Spec source_spec,
+                          std::ostream& output,
+                          OcdbtCompactOptions options = {});
+
+}  // namespace cli
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_TSCLI_LIB_OCDBT_COMPACT_H_
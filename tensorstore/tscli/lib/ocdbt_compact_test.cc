@@ -0,0 +1,274 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/tscli/lib/ocdbt_compact.h"
+
+#include <stddef.h>
+
+#include <sstream>
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/escaping.h"
+#include "absl/strings/str_cat.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/context.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/kvstore/spec.h"
+#include "tensorstore/kvstore/test_matchers.h"
+#include "tensorstore/transaction.h"
+#include "tensorstore/tscli/lib/ocdbt_check.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+namespace kvstore = ::tensorstore::kvstore;
+using ::tensorstore::StatusIs;
+using ::tensorstore::cli::OcdbtCompactOptions;
+using ::tensorstore::internal::MatchesKvsReadResult;
+using ::testing::HasSubstr;
+
+// Returns a value that is too large to be stored inline.
+std::string LargeValue(int key, int version) {
+  return absl::StrCat(std::string(200, 'a' + key), "_v", version);
+}
+
+class OcdbtCompactTest : public ::testing::Test {
+ protected:
+  // Creates a database in `memory://path/` in which each of 4 keys is
+  // overwritten in each of 8 generations.
+  void CreateDatabase(std::string path) {
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto ocdbt_store,
+        kvstore::Open({{"driver", "ocdbt"},
+                       {"config",
+                        {{"version_tree_arity_log2", 1},
+                         {"max_decoded_node_bytes", 256}}},
+                       {"base", absl::StrCat("memory://", path)}},
+                      context_)
+            .result());
+    for (int version = 0; version < 8; ++version) {
+      tensorstore::Transaction transaction(tensorstore::atomic_isolated);
+      for (int key = 0; key < 4; ++key) {
+        TENSORSTORE_ASSERT_OK(kvstore::Write(
+            (ocdbt_store | transaction).value(), absl::StrCat("key_", key),
+            absl::Cord(LargeValue(key, version))));
+      }
+      TENSORSTORE_ASSERT_OK(transaction.Commit());
+    }
+  }
+
+  kvstore::Spec BaseSpec(std::string path) {
+    return kvstore::Spec::FromJson({{"driver", "memory"}, {"path", path}})
+        .value();
+  }
+
+  size_t CountFiles(std::string path) {
+    auto base = kvstore::Open(BaseSpec(path), context_).value();
+    return kvstore::ListFuture(base).value().size();
+  }
+
+  // Reads all keys of the specified `generation` of the database, or of the
+  // latest generation if `generation == 0`, which must hold the values written
+  // in iteration `expected_version` of `CreateDatabase`.
+  void ExpectValues(std::string path, int generation, int expected_version) {
+    ::nlohmann::json spec{{"driver", "ocdbt"},
+                          {"base", absl::StrCat("memory://", path)}};
+    if (generation != 0) spec["version"] = generation;
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto ocdbt_store, kvstore::Open(spec, context_).result());
+    kvstore::ReadOptions options;
+    options.staleness_bound = absl::Now();
+    for (int key = 0; key < 4; ++key) {
+      EXPECT_THAT(kvstore::Read(ocdbt_store, absl::StrCat("key_", key),
+                                options)
+                      .result(),
+                  MatchesKvsReadResult(
+                      absl::Cord(LargeValue(key, expected_version))))
+          << "key=" << key << ", generation=" << generation;
+    }
+  }
+
+  void ExpectCheckSucceeds(std::string path) {
+    std::stringstream output;
+    auto status = tensorstore::cli::OcdbtCheck(context_, BaseSpec(path),
+                                               output);
+    EXPECT_TRUE(status.ok()) << status << "\nOutput:\n" << output.str();
+    EXPECT_THAT(output.str(), HasSubstr("Total errors found: 0"));
+  }
+
+  tensorstore::Context context_ = tensorstore::Context::Default();
+};
+
+TEST_F(OcdbtCompactTest, LatestVersionOnly) {
+  CreateDatabase("latest/");
+  const size_t initial_files = CountFiles("latest/");
+
+  OcdbtCompactOptions options;
+  options.max_versions = 1;
+  options.delete_unreferenced_files = true;
+  options.min_unreferenced_file_age = absl::ZeroDuration();
+  std::stringstream output;
+  auto status = tensorstore::cli::OcdbtCompact(context_, BaseSpec("latest/"),
+                                               output, options);
+  EXPECT_TRUE(status.ok()) << status << "\nOutput:\n" << output.str();
+  EXPECT_THAT(output.str(), HasSubstr("Retaining 1 of 8 versions"));
+  EXPECT_THAT(output.str(), HasSubstr("Committed generation 9."));
+
+  ExpectValues("latest/", 0, 7);
+  ExpectValues("latest/", 9, 7);
+  ExpectCheckSucceeds("latest/");
+  EXPECT_LT(CountFiles("latest/"), initial_files);
+}
+
+TEST_F(OcdbtCompactTest, RetainAllVersions) {
+  CreateDatabase("all/");
+
+  OcdbtCompactOptions options;
+  options.min_live_fraction = 1;
+  std::stringstream output;
+  auto status = tensorstore::cli::OcdbtCompact(context_, BaseSpec("all/"),
+                                               output, options);
+  EXPECT_TRUE(status.ok()) << status << "\nOutput:\n" << output.str();
+  EXPECT_THAT(output.str(), HasSubstr("Retaining 8 of 8 versions"));
+
+  ExpectValues("all/", 0, 7);
+  for (int version = 0; version < 8; ++version) {
+    ExpectValues("all/", version + 1, version);
+  }
+  ExpectCheckSucceeds("all/");
+}
+
+TEST_F(OcdbtCompactTest, MinVersion) {
+  CreateDatabase("min_version/");
+
+  OcdbtCompactOptions options;
+  options.min_version = "v6";
+  std::stringstream output;
+  auto status = tensorstore::cli::OcdbtCompact(
+      context_, BaseSpec("min_version/"), output, options);
+  EXPECT_TRUE(status.ok()) << status << "\nOutput:\n" << output.str();
+  EXPECT_THAT(output.str(), HasSubstr("Retaining 3 of 8 versions"));
+
+  for (int version = 5; version < 8; ++version) {
+    ExpectValues("min_version/", version + 1, version);
+  }
+  ExpectCheckSucceeds("min_version/");
+}
+
+TEST_F(OcdbtCompactTest, DryRun) {
+  CreateDatabase("dry_run/");
+  const size_t initial_files = CountFiles("dry_run/");
+
+  OcdbtCompactOptions options;
+  options.max_versions = 1;
+  options.delete_unreferenced_files = true;
+  options.dry_run = true;
+  std::stringstream output;
+  auto status = tensorstore::cli::OcdbtCompact(context_, BaseSpec("dry_run/"),
+                                               output, options);
+  EXPECT_TRUE(status.ok()) << status << "\nOutput:\n" << output.str();
+  EXPECT_THAT(output.str(), HasSubstr("Would delete"));
+
+  EXPECT_EQ(initial_files, CountFiles("dry_run/"));
+  for (int version = 0; version < 8; ++version) {
+    ExpectValues("dry_run/", version + 1, version);
+  }
+}
+
+TEST_F(OcdbtCompactTest, NoDeleteByDefault) {
+  CreateDatabase("no_delete/");
+  const size_t initial_files = CountFiles("no_delete/");
+
+  OcdbtCompactOptions options;
+  options.max_versions = 1;
+  std::stringstream output;
+  auto status = tensorstore::cli::OcdbtCompact(
+      context_, BaseSpec("no_delete/"), output, options);
+  EXPECT_TRUE(status.ok()) << status << "\nOutput:\n" << output.str();
+  EXPECT_THAT(output.str(), HasSubstr("Committed generation 9."));
+  EXPECT_THAT(output.str(), ::testing::Not(HasSubstr("Deleted")));
+
+  ExpectValues("no_delete/", 0, 7);
+  ExpectCheckSucceeds("no_delete/");
+  EXPECT_GE(CountFiles("no_delete/"), initial_files);
+}
+
+// Tests that deleting files after compaction committed nothing accounts for
+// the manifest as of the deletion, and retains the zstd dictionary.
+TEST_F(OcdbtCompactTest, DeleteWithoutCommitRetainsDictionary) {
+  const std::string dictionary = LargeValue(0, 0);
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto ocdbt_store,
+      kvstore::Open({{"driver", "ocdbt"},
+                     {"config",
+                      {{"compression",
+                        {{"id", "zstd"},
+                         {"dictionary", absl::Base64Escape(dictionary)}}}}},
+                     {"base", "memory://dictionary/"}},
+                    context_)
+          .result());
+  for (int key = 0; key < 4; ++key) {
+    TENSORSTORE_ASSERT_OK(kvstore::Write(ocdbt_store, absl::StrCat("key_", key),
+                                         absl::Cord(LargeValue(key, 0))));
+  }
+  const size_t initial_files = CountFiles("dictionary/");
+
+  OcdbtCompactOptions options;
+  options.min_live_fraction = 0;
+  options.delete_unreferenced_files = true;
+  options.min_unreferenced_file_age = absl::ZeroDuration();
+  std::stringstream output;
+  auto status = tensorstore::cli::OcdbtCompact(
+      context_, BaseSpec("dictionary/"), output, options);
+  EXPECT_TRUE(status.ok()) << status << "\nOutput:\n" << output.str();
+  EXPECT_THAT(output.str(), HasSubstr("Nothing to compact."));
+  EXPECT_THAT(output.str(), HasSubstr("Deleted 0 unreferenced files"));
+  EXPECT_EQ(initial_files, CountFiles("dictionary/"));
+
+  // Reopen with a separate cache pool, which must read the dictionary.
+  context_ = tensorstore::Context(
+      tensorstore::Context::Spec::FromJson(
+          {{"cache_pool", ::nlohmann::json::object_t()}})
+          .value(),
+      context_);
+  ExpectValues("dictionary/", 0, 0);
+}
+
+TEST_F(OcdbtCompactTest, InvalidMaxVersions) {
+  CreateDatabase("invalid/");
+
+  OcdbtCompactOptions options;
+  options.max_versions = 0;
+  std::stringstream output;
+  EXPECT_THAT(tensorstore::cli::OcdbtCompact(context_, BaseSpec("invalid/"),
+                                             output, options),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST_F(OcdbtCompactTest, MissingManifest) {
+  std::stringstream output;
+  EXPECT_THAT(
+      tensorstore::cli::OcdbtCompact(context_, BaseSpec("empty/"), output),
+      StatusIs(absl::StatusCode::kNotFound));
+}
+
+}  // namespace
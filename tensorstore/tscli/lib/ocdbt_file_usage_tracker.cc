@@ -239,5 +239,37 @@ void OcdbtFileUsageTracker::CheckUnusedRanges(OcdbtCheckReporter& reporter,
   }
 }
 
+absl::Status OcdbtFileUsageTracker::ForEachFileUnusedBytes(
+    uint64_t alignment,
+    absl::FunctionRef<void(std::string_view file_path, uint64_t file_size,
+                           uint64_t unused_bytes)>
+        func) {
+  absl::MutexLock lock(mutex_);
+  for (auto& [file_path, intervals] : referenced_files_) {
+    auto it = on_disk_files_.find(file_path);
+    if (it == on_disk_files_.end() || it->second < 0) {
+      return tensorstore::StatusBuilder(absl::StatusCode::kDataLoss)
+          .Format("File %s is referenced but not present in kvstore listing",
+                  file_path);
+    }
+    uint64_t actual_size = static_cast<uint64_t>(it->second);
+    auto merged_intervals = MergeIntervals(intervals);
+    if (!merged_intervals.empty() &&
+        actual_size <
+            merged_intervals.back().offset + merged_intervals.back().length) {
+      return tensorstore::StatusBuilder(absl::StatusCode::kDataLoss)
+          .Format("File %s is truncated. Size on disk: %d", file_path,
+                  actual_size);
+    }
+    uint64_t unused_bytes = 0;
+    for (const auto& gap :
+         ComputeUnusedRanges(merged_intervals, actual_size, alignment)) {
+      unused_bytes += gap.length;
+    }
+    func(file_path, actual_size, unused_bytes);
+  }
+  return absl::OkStatus();
+}
+
 }  // namespace cli
 }  // namespace tensorstore
@@ -25,6 +25,7 @@
 #include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/functional/function_ref.h"
+#include "absl/status/status.h"
 #include "absl/synchronization/mutex.h"
 #include "tensorstore/tscli/lib/ocdbt_check_reporter.h"
 
@@ -66,6 +67,16 @@ class OcdbtFileUsageTracker {
   void CheckOrphanedFiles(OcdbtCheckReporter& reporter);
   void CheckUnusedRanges(OcdbtCheckReporter& reporter, uint64_t alignment);
 
+  // Invokes `func` with the size on disk and the number of unused bytes, as
+  // computed by `CheckUnusedRanges`, of each referenced file.
+  //
+  // Returns an error if a referenced file is missing or truncated.
+  absl::Status ForEachFileUnusedBytes(
+      uint64_t alignment,
+      absl::FunctionRef<void(std::string_view file_path, uint64_t file_size,
+                             uint64_t unused_bytes)>
+          func);
+
  private:
   absl::flat_hash_map<std::string, int64_t> on_disk_files_
       ABSL_GUARDED_BY(mutex_);
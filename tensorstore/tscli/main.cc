@@ -37,6 +37,7 @@
 #include "tensorstore/tscli/copy_command.h"
 #include "tensorstore/tscli/list_command.h"
 #include "tensorstore/tscli/ocdbt_check_command.h"
+#include "tensorstore/tscli/ocdbt_compact_command.h"
 #include "tensorstore/tscli/ocdbt_dump_command.h"
 #include "tensorstore/tscli/print_spec_command.h"
 #include "tensorstore/tscli/print_stats_command.h"
@@ -67,10 +68,13 @@ tensorstore::span<Command*> AllCommands() {
   static absl::NoDestructor<::tensorstore::cli::PrintStatsCommand> print_stats;
   static absl::NoDestructor<::tensorstore::cli::OcdbtDumpCommand> ocdbt_dump;
   static absl::NoDestructor<::tensorstore::cli::OcdbtCheckCommand> ocdbt_check;
+  static absl::NoDestructor<::tensorstore::cli::OcdbtCompactCommand>
+      ocdbt_compact;
 
-  static std::array<Command*, 7> commands{
-      copy.get(),        list.get(),       search.get(),     print_spec.get(),
-      print_stats.get(), ocdbt_dump.get(), ocdbt_check.get()};
+  static std::array<Command*, 8> commands{
+      copy.get(),       list.get(),        search.get(),
+      print_spec.get(), print_stats.get(), ocdbt_dump.get(),
+      ocdbt_check.get(), ocdbt_compact.get()};
   return commands;
 }
 
@@ -0,0 +1,180 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/tscli/ocdbt_compact_command.h"
+
+#include <stdint.h>
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/time/time.h"
+#include "tensorstore/context.h"
+#include "tensorstore/kvstore/spec.h"
+#include "tensorstore/tscli/command.h"
+#include "tensorstore/tscli/lib/ocdbt_compact.h"
+#include "tensorstore/util/json_absl_flag.h"
+
+namespace tensorstore {
+namespace cli {
+namespace {
+
+static constexpr const char kCommand[] =
+    R"(Garbage collect and compact an OCDBT database
+
+Drops old versions, rewrites sparsely-used data files, and commits the result
+as a new version.  With --delete, also deletes files that are no longer
+referenced.
+
+Files are only deleted if they remain unreferenced after --min-file-age has
+elapsed since compaction started, which allows concurrent writers that much
+time to commit files they have already written.
+)";
+
+static constexpr const char kSource[] = R"(Source kvstore spec. Required.
+
+kvstore spec must refer to a prefix/directory containing an OCDBT database.
+)";
+
+static constexpr const char kMinVersion[] =
+    R"(Oldest version to retain; older versions are dropped.
+
+Can be a generation number (e.g., `v1`) or a timestamp (e.g., `2023-01-01T00:00:00Z`).
+)";
+
+}  // namespace
+
+OcdbtCompactCommand::OcdbtCompactCommand()
+    : Command("ocdbt_compact", kCommand) {
+  parser().AddLongOption("--source", kSource, [this](std::string_view value) {
+    tensorstore::JsonAbslFlag<tensorstore::kvstore::Spec> spec;
+    std::string error;
+    if (!AbslParseFlag(value, &spec, &error)) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("Invalid spec: ", value, " ", error));
+    }
+    specs_.push_back(spec.value);
+    return absl::OkStatus();
+  });
+
+  parser().AddLongOption("--min-version", kMinVersion,
+                         [this](std::string_view value) {
+                           options_.min_version = std::string(value);
+                           return absl::OkStatus();
+                         });
+
+  parser().AddLongOption(
+      "--max-versions",
+      "Maximum number of versions to retain, counting back from the latest.",
+      [this](std::string_view value) {
+        uint64_t max_versions;
+        if (!absl::SimpleAtoi(value, &max_versions) || max_versions == 0) {
+          return absl::InvalidArgumentError("Invalid max-versions value");
+        }
+        options_.max_versions = max_versions;
+        return absl::OkStatus();
+      });
+
+  parser().AddLongOption(
+      "--min-live-fraction",
+      "Data files in which less than this fraction of the bytes are "
+      "referenced are rewritten. Defaults to 0.5. Set to 0 to only drop "
+      "versions.",
+      [this](std::string_view value) {
+        if (!absl::SimpleAtod(value, &options_.min_live_fraction) ||
+            !(options_.min_live_fraction >= 0 &&
+              options_.min_live_fraction <= 1)) {
+          return absl::InvalidArgumentError("Invalid min-live-fraction value");
+        }
+        return absl::OkStatus();
+      });
+
+  parser().AddLongOption(
+      "--alignment",
+      "Byte alignment used when calculating unused ranges. Defaults to 4096.",
+      [this](std::string_view value) {
+        if (!absl::SimpleAtoi(value, &options_.alignment) ||
+            options_.alignment == 0) {
+          return absl::InvalidArgumentError("Invalid alignment value");
+        }
+        return absl::OkStatus();
+      });
+
+  parser().AddLongOption(
+      "--target-data-file-size",
+      "Target size in bytes of newly-written data files.",
+      [this](std::string_view value) {
+        if (!absl::SimpleAtoi(value, &options_.target_data_file_size)) {
+          return absl::InvalidArgumentError(
+              "Invalid target-data-file-size value");
+        }
+        return absl::OkStatus();
+      });
+
+  parser().AddBoolOption(
+      "--delete", "Delete unreferenced files.",
+      [this]() { options_.delete_unreferenced_files = true; });
+
+  parser().AddLongOption(
+      "--min-file-age",
+      "Minimum age of deleted files (e.g., `10m`). Defaults to 10 minutes.",
+      [this](std::string_view value) {
+        if (!absl::ParseDuration(value, &options_.min_unreferenced_file_age) ||
+            options_.min_unreferenced_file_age < absl::ZeroDuration()) {
+          return absl::InvalidArgumentError("Invalid min-file-age value");
+        }
+        return absl::OkStatus();
+      });
+
+  parser().AddBoolOption(
+      "--dry-run", "Report what would be rewritten and deleted.",
+      [this]() { options_.dry_run = true; });
+
+  parser().AddBoolOption(
+      "--detailed",
+      "Output detailed lists of compacted and deleted files.",
+      [this]() { options_.detailed = true; });
+
+  parser().AddLongOption(
+      "--concurrency", "Limit on concurrent reads and deletes.",
+      [this](std::string_view value) {
+        if (!absl::SimpleAtoi(value, &options_.concurrency) ||
+            options_.concurrency == 0) {
+          return absl::InvalidArgumentError("Invalid concurrency value");
+        }
+        return absl::OkStatus();
+      });
+}
+
+absl::Status OcdbtCompactCommand::Run(Context::Spec context_spec) {
+  tensorstore::Context context(context_spec);
+
+  if (specs_.empty()) {
+    return absl::InvalidArgumentError("Must specify --source");
+  }
+
+  absl::Status status;
+  for (const auto& spec : specs_) {
+    status.Update(OcdbtCompact(context, spec, std::cout, options_));
+  }
+  return status;
+}
+
+}  // namespace cli
+}  // namespace tensorstore